@@ -32,6 +32,9 @@
 #include "umutex.h"
 #include "uresimp.h"
 #include "ubrkimpl.h"
+#include "ucln_cmn.h"
+#include "udatamem.h"
+#include "umapfile.h"
 
 U_NAMESPACE_BEGIN
 
@@ -77,7 +80,8 @@ int32_t
 UnhandledEngine::findBreaks( UText *text,
                              int32_t /* startPos */,
                              int32_t endPos,
-                             UVector32 &/*foundBreaks*/ ) const {
+                             UVector32 &/*foundBreaks*/,
+                             UBool /* bestPath */ ) const {
     UChar32 c = utext_current32(text); 
     while((int32_t)utext_getNativeIndex(text) < endPos && fHandled->contains(c)) {
         utext_next32(text);            // TODO:  recast loop to work with post-increment operations.
@@ -159,6 +163,103 @@ ICULanguageBreakFactory::getEngineFor(UChar32 c) {
     return lbe;
 }
 
+/**
+ * Create the dictionary-based engine for a script, adopting the matcher.
+ * Returns NULL, deleting the matcher, if there is no engine for the script
+ * or if the engine could not be created.
+ */
+static LanguageBreakEngine *
+createEngineFor(UScriptCode code, DictionaryMatcher *m, UErrorCode &status) {
+    LanguageBreakEngine *engine = NULL;
+    switch(code) {
+    case USCRIPT_THAI:
+        engine = new ThaiBreakEngine(m, status);
+        break;
+    case USCRIPT_LAO:
+        engine = new LaoBreakEngine(m, status);
+        break;
+    case USCRIPT_MYANMAR:
+        engine = new BurmeseBreakEngine(m, status);
+        break;
+    case USCRIPT_KHMER:
+        engine = new KhmerBreakEngine(m, status);
+        break;
+
+#if !UCONFIG_NO_NORMALIZATION
+        // CJK not available w/o normalization
+    case USCRIPT_HANGUL:
+        engine = new CjkBreakEngine(m, kKorean, status);
+        break;
+
+    // use same BreakEngine and dictionary for both Chinese and Japanese
+    case USCRIPT_HIRAGANA:
+    case USCRIPT_KATAKANA:
+    case USCRIPT_HAN:
+        engine = new CjkBreakEngine(m, kChineseJapanese, status);
+        break;
+#if 0
+    // TODO: Have to get some characters with script=common handled
+    // by CjkBreakEngine (e.g. U+309B). Simply subjecting
+    // them to CjkBreakEngine does not work. The engine has to
+    // special-case them.
+    case USCRIPT_COMMON:
+    {
+        UBlockCode block = ublock_getCode(code);
+        if (block == UBLOCK_HIRAGANA || block == UBLOCK_KATAKANA)
+           engine = new CjkBreakEngine(dict, kChineseJapanese, status);
+        break;
+    }
+#endif
+#endif
+
+    default:
+        break;
+    }
+    if (engine == NULL) {
+        delete m;
+    }
+    else if (U_FAILURE(status)) {
+        delete engine;
+        engine = NULL;
+    }
+    return engine;
+}
+
+/**
+ * Create a DictionaryMatcher over dictionary data, adopting the UDataMemory.
+ * Returns NULL, closing the data, if the trie type is unknown or if
+ * memory allocation failed.
+ */
+static DictionaryMatcher *
+createDictionaryMatcher(UDataMemory *file, UErrorCode &status) {
+    const uint8_t *data = (const uint8_t *)udata_getMemory(file);
+    const int32_t *indexes = (const int32_t *)data;
+    const int32_t offset = indexes[DictionaryData::IX_STRING_TRIE_OFFSET];
+    const int32_t trieType = indexes[DictionaryData::IX_TRIE_TYPE] & DictionaryData::TRIE_TYPE_MASK;
+    DictionaryMatcher *m = NULL;
+    if (trieType == DictionaryData::TRIE_TYPE_BYTES) {
+        const int32_t transform = indexes[DictionaryData::IX_TRANSFORM];
+        const char *characters = (const char *)(data + offset);
+        m = new BytesDictionaryMatcher(characters, transform, file);
+    }
+    else if (trieType == DictionaryData::TRIE_TYPE_UCHARS) {
+        const UChar *characters = (const UChar *)(data + offset);
+        m = new UCharsDictionaryMatcher(characters, file);
+    }
+    else {
+        status = U_INVALID_FORMAT_ERROR;
+    }
+    if (m == NULL) {
+        // no matcher exists to take ownership - either we are an invalid 
+        // type or memory allocation failed
+        if (U_SUCCESS(status)) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+        }
+        udata_close(file);
+    }
+    return m;
+}
+
 const LanguageBreakEngine *
 ICULanguageBreakFactory::loadEngineFor(UChar32 c) {
     UErrorCode status = U_ZERO_ERROR;
@@ -166,59 +267,7 @@ ICULanguageBreakFactory::loadEngineFor(UChar32 c) {
     if (U_SUCCESS(status)) {
         DictionaryMatcher *m = loadDictionaryMatcherFor(code);
         if (m != NULL) {
-            const LanguageBreakEngine *engine = NULL;
-            switch(code) {
-            case USCRIPT_THAI:
-                engine = new ThaiBreakEngine(m, status);
-                break;
-            case USCRIPT_LAO:
-                engine = new LaoBreakEngine(m, status);
-                break;
-            case USCRIPT_MYANMAR:
-                engine = new BurmeseBreakEngine(m, status);
-                break;
-            case USCRIPT_KHMER:
-                engine = new KhmerBreakEngine(m, status);
-                break;
-
-#if !UCONFIG_NO_NORMALIZATION
-                // CJK not available w/o normalization
-            case USCRIPT_HANGUL:
-                engine = new CjkBreakEngine(m, kKorean, status);
-                break;
-
-            // use same BreakEngine and dictionary for both Chinese and Japanese
-            case USCRIPT_HIRAGANA:
-            case USCRIPT_KATAKANA:
-            case USCRIPT_HAN:
-                engine = new CjkBreakEngine(m, kChineseJapanese, status);
-                break;
-#if 0
-            // TODO: Have to get some characters with script=common handled
-            // by CjkBreakEngine (e.g. U+309B). Simply subjecting
-            // them to CjkBreakEngine does not work. The engine has to
-            // special-case them.
-            case USCRIPT_COMMON:
-            {
-                UBlockCode block = ublock_getCode(code);
-                if (block == UBLOCK_HIRAGANA || block == UBLOCK_KATAKANA)
-                   engine = new CjkBreakEngine(dict, kChineseJapanese, status);
-                break;
-            }
-#endif
-#endif
-
-            default:
-                break;
-            }
-            if (engine == NULL) {
-                delete m;
-            }
-            else if (U_FAILURE(status)) {
-                delete engine;
-                engine = NULL;
-            }
-            return engine;
+            return createEngineFor(code, m, status);
         }
     }
     return NULL;
@@ -251,26 +300,7 @@ ICULanguageBreakFactory::loadDictionaryMatcherFor(UScriptCode script) {
     UDataMemory *file = udata_open(U_ICUDATA_BRKITR, ext.data(), dictnbuf.data(), &status);
     if (U_SUCCESS(status)) {
         // build trie
-        const uint8_t *data = (const uint8_t *)udata_getMemory(file);
-        const int32_t *indexes = (const int32_t *)data;
-        const int32_t offset = indexes[DictionaryData::IX_STRING_TRIE_OFFSET];
-        const int32_t trieType = indexes[DictionaryData::IX_TRIE_TYPE] & DictionaryData::TRIE_TYPE_MASK;
-        DictionaryMatcher *m = NULL;
-        if (trieType == DictionaryData::TRIE_TYPE_BYTES) {
-            const int32_t transform = indexes[DictionaryData::IX_TRANSFORM];
-            const char *characters = (const char *)(data + offset);
-            m = new BytesDictionaryMatcher(characters, transform, file);
-        }
-        else if (trieType == DictionaryData::TRIE_TYPE_UCHARS) {
-            const UChar *characters = (const UChar *)(data + offset);
-            m = new UCharsDictionaryMatcher(characters, file);
-        }
-        if (m == NULL) {
-            // no matcher exists to take ownership - either we are an invalid 
-            // type or memory allocation failed
-            udata_close(file);
-        }
-        return m;
+        return createDictionaryMatcher(file, status);
     } else if (dictfname != NULL) {
         // we don't have a dictionary matcher.
         // returning NULL here will cause us to fail to find a dictionary break engine, as expected
@@ -280,6 +310,224 @@ ICULanguageBreakFactory::loadDictionaryMatcherFor(UScriptCode script) {
     return NULL;
 }
 
+/*
+ ******************************************************************
+ * User-registered dictionaries
+ */
+
+SharedBreakEngine::~SharedBreakEngine() {
+    delete fEngine;
+}
+
+// One registration slot per dictionary-based engine. Han, Hiragana and
+// Katakana share the Chinese/Japanese dictionary, and so a slot.
+enum {
+    kUserDictThai,
+    kUserDictLao,
+    kUserDictMyanmar,
+    kUserDictKhmer,
+    kUserDictHangul,
+    kUserDictChineseJapanese,
+    kUserDictSlotCount
+};
+
+// Guarded by gBreakEngineMutex. Each registered engine holds one reference for the table.
+static const SharedBreakEngine *gUserEngines[kUserDictSlotCount] = {};
+
+// Incremented whenever gUserEngines changes, so that break iterators can notice
+// without taking the mutex.
+static u_atomic_int32_t gUserDictionaryGeneration = ATOMIC_INT32_T_INITIALIZER(0);
+
+U_CDECL_BEGIN
+static UBool U_CALLCONV brkeng_cleanup(void) {
+    for (int32_t i = 0; i < kUserDictSlotCount; ++i) {
+        if (gUserEngines[i] != NULL) {
+            gUserEngines[i]->removeRef();
+            gUserEngines[i] = NULL;
+        }
+    }
+    return TRUE;
+}
+U_CDECL_END
+
+static int32_t
+userDictionarySlot(UScriptCode script) {
+    switch(script) {
+    case USCRIPT_THAI:
+        return kUserDictThai;
+    case USCRIPT_LAO:
+        return kUserDictLao;
+    case USCRIPT_MYANMAR:
+        return kUserDictMyanmar;
+    case USCRIPT_KHMER:
+        return kUserDictKhmer;
+#if !UCONFIG_NO_NORMALIZATION
+    case USCRIPT_HANGUL:
+        return kUserDictHangul;
+    case USCRIPT_HIRAGANA:
+    case USCRIPT_KATAKANA:
+    case USCRIPT_HAN:
+        return kUserDictChineseJapanese;
+#endif
+    default:
+        return -1;
+    }
+}
+
+/**
+ * Memory-map a dictionary file and create a DictionaryMatcher over it.
+ * The mapping is released when the matcher is deleted.
+ */
+static DictionaryMatcher *
+mapDictionaryMatcher(const char *path, UErrorCode &status) {
+    // The file comes from the user, not from ICU's data. The header and the
+    // indexes are checked against the length of the mapping itself, so that the
+    // trie offsets lie within it; the trie contents are not validated and are
+    // trusted like those of ICU's own dictionaries.
+    UDataMemory mapped;
+    if (!uprv_mapFile(&mapped, path)) {
+        status = U_FILE_ACCESS_ERROR;
+        return NULL;
+    }
+    int32_t length = mapped.length;
+    if (length < 0) {
+        udata_close(&mapped);
+        status = U_FILE_ACCESS_ERROR;
+        return NULL;
+    }
+    // Check the header the way udata_openChoice() does, for the format written by gendict.
+    const DataHeader *header = mapped.pHeader;
+    const UDataInfo &info = header->info;
+    int32_t headerSize = 0;
+    const int32_t *indexes = NULL;
+    if ((size_t)length >= sizeof(DataHeader)) {
+        headerSize = header->dataHeader.headerSize;
+        if ((size_t)headerSize >= sizeof(DataHeader) && (headerSize & 3) == 0 &&
+                headerSize + (int32_t)(DictionaryData::IX_COUNT * sizeof(int32_t)) <= length) {
+            indexes = (const int32_t *)((const char *)header + headerSize);
+        }
+    }
+    if (!(indexes != NULL &&
+            header->dataHeader.magic1 == 0xda &&
+            header->dataHeader.magic2 == 0x27 &&
+            info.size >= sizeof(UDataInfo) &&
+            info.isBigEndian == U_IS_BIG_ENDIAN &&
+            info.charsetFamily == U_CHARSET_FAMILY &&
+            info.dataFormat[0] == 0x44 &&   // dataFormat="Dict"
+            info.dataFormat[1] == 0x69 &&
+            info.dataFormat[2] == 0x63 &&
+            info.dataFormat[3] == 0x74 &&
+            info.formatVersion[0] == 1 &&
+            indexes[DictionaryData::IX_STRING_TRIE_OFFSET] >= (int32_t)(DictionaryData::IX_COUNT * sizeof(int32_t)) &&
+            indexes[DictionaryData::IX_TOTAL_SIZE] > indexes[DictionaryData::IX_STRING_TRIE_OFFSET] &&
+            indexes[DictionaryData::IX_TOTAL_SIZE] <= length - headerSize)) {
+        udata_close(&mapped);
+        status = U_INVALID_FORMAT_ERROR;
+        return NULL;
+    }
+
+    // Hand the mapping over to a heap UDataMemory, which the matcher adopts.
+    UDataMemory *file = UDataMemory_createNewInstance(&status);
+    if (U_FAILURE(status)) {
+        udata_close(&mapped);
+        return NULL;
+    }
+    file->pHeader = mapped.pHeader;
+    file->mapAddr = mapped.mapAddr;
+    file->map     = mapped.map;
+    file->length  = mapped.length;
+    return createDictionaryMatcher(file, status);
+}
+
+/**
+ * Replace the engine in a registration slot, releasing the table's reference
+ * to the previous one. Break iterators using the previous engine hold their
+ * own references, so it is deleted only once they have all let go of it.
+ * Returns TRUE if the slot held an engine.
+ */
+static UBool
+setUserEngine(int32_t slot, const SharedBreakEngine *engine) {
+    const SharedBreakEngine *previous;
+    {
+        Mutex m(&gBreakEngineMutex);
+        previous = gUserEngines[slot];
+        if (previous == NULL && engine == NULL) {
+            return FALSE;
+        }
+        gUserEngines[slot] = engine;
+        umtx_atomic_inc(&gUserDictionaryGeneration);
+        ucln_common_registerCleanup(UCLN_COMMON_BREAKENGINE, brkeng_cleanup);
+    }
+    if (previous == NULL) {
+        return FALSE;
+    }
+    previous->removeRef();
+    return TRUE;
+}
+
+void
+ICULanguageBreakFactory::registerUserDictionary(UScriptCode script, const char *path, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    int32_t slot = userDictionarySlot(script);
+    if (slot < 0 || path == NULL) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    DictionaryMatcher *m = mapDictionaryMatcher(path, status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    LanguageBreakEngine *engine = createEngineFor(script, m, status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (engine == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    SharedBreakEngine *shared = new SharedBreakEngine(engine);
+    if (shared == NULL) {
+        delete engine;
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    shared->addRef();
+    setUserEngine(slot, shared);
+}
+
+UBool
+ICULanguageBreakFactory::unregisterUserDictionary(UScriptCode script, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return FALSE;
+    }
+    int32_t slot = userDictionarySlot(script);
+    if (slot < 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    return setUserEngine(slot, NULL);
+}
+
+const SharedBreakEngine *
+ICULanguageBreakFactory::getUserEngineFor(UChar32 c) {
+    Mutex m(&gBreakEngineMutex);
+    for (int32_t i = 0; i < kUserDictSlotCount; ++i) {
+        const SharedBreakEngine *shared = gUserEngines[i];
+        if (shared != NULL && shared->fEngine->handles(c)) {
+            shared->addRef();
+            return shared;
+        }
+    }
+    return NULL;
+}
+
+int32_t
+ICULanguageBreakFactory::getUserDictionaryGeneration() {
+    return umtx_loadAcquire(gUserDictionaryGeneration);
+}
+
 U_NAMESPACE_END
 
 #endif /* #if !UCONFIG_NO_BREAK_ITERATION */
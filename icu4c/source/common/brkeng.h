@@ -14,6 +14,7 @@
 #include "unicode/uobject.h"
 #include "unicode/utext.h"
 #include "unicode/uscript.h"
+#include "sharedobject.h"
 
 U_NAMESPACE_BEGIN
 
@@ -21,6 +22,7 @@ class UnicodeSet;
 class UStack;
 class UVector32;
 class DictionaryMatcher;
+class SharedBreakEngine;
 
 /*******************************************************************
  * LanguageBreakEngine
@@ -68,12 +70,16 @@ class LanguageBreakEngine : public UMemory {
   * @param startPos The start of the run within the supplied text.
   * @param endPos The end of the run within the supplied text.
   * @param foundBreaks A Vector of int32_t to receive the breaks.
+  * @param bestPath TRUE to divide up dictionary text with a best-path search
+  * rather than the engine's default heuristic, if it has one. See
+  * RuleBasedBreakIterator::setDictionaryBestPath().
   * @return The number of breaks found.
   */
   virtual int32_t findBreaks( UText *text,
                               int32_t startPos,
                               int32_t endPos,
-                              UVector32 &foundBreaks ) const = 0;
+                              UVector32 &foundBreaks,
+                              UBool bestPath ) const = 0;
 
 };
 
@@ -185,12 +191,14 @@ class UnhandledEngine : public LanguageBreakEngine {
   * @param startPos The start of the run within the supplied text.
   * @param endPos The end of the run within the supplied text.
   * @param foundBreaks An allocated C array of the breaks found, if any
+  * @param bestPath Ignored.
   * @return The number of breaks found.
   */
   virtual int32_t findBreaks( UText *text,
                               int32_t startPos,
                               int32_t endPos,
-                              UVector32 &foundBreaks ) const;
+                              UVector32 &foundBreaks,
+                              UBool bestPath ) const;
 
  /**
   * <p>Tell the engine to handle a particular character and break type.</p>
@@ -245,6 +253,47 @@ class ICULanguageBreakFactory : public LanguageBreakFactory {
   */
   virtual const LanguageBreakEngine *getEngineFor(UChar32 c);
 
+ /**
+  * <p>Register a dictionary file for the dictionary-based engine of a script,
+  * replacing any previously registered one. See
+  * RuleBasedBreakIterator::registerDictionary().</p>
+  *
+  * @param script The script whose dictionary is replaced.
+  * @param path The path of a dictionary file built by gendict.
+  * @param status Receives errors.
+  */
+  static void registerUserDictionary(UScriptCode script, const char *path, UErrorCode &status);
+
+ /**
+  * <p>Unregister the dictionary registered for a script.</p>
+  *
+  * @param script The script whose dictionary is unregistered.
+  * @param status Receives errors.
+  * @return TRUE if a dictionary was registered for the script.
+  */
+  static UBool unregisterUserDictionary(UScriptCode script, UErrorCode &status);
+
+ /**
+  * <p>Find the engine built from a user-registered dictionary that handles
+  * the supplied character, if any.</p>
+  *
+  * @param c A character that begins a run for which a LanguageBreakEngine is
+  * sought.
+  * @return A SharedBreakEngine with a reference added for the caller, who must
+  * call removeRef() when done with it, or NULL.
+  */
+  static const SharedBreakEngine *getUserEngineFor(UChar32 c);
+
+ /**
+  * <p>Get the generation of the set of user-registered dictionaries. It changes
+  * whenever a dictionary is registered or unregistered; engines obtained from
+  * getUserEngineFor() or getEngineFor() under an earlier generation should no
+  * longer be used to find new breaks.</p>
+  *
+  * @return The current generation.
+  */
+  static int32_t getUserDictionaryGeneration();
+
 protected:
  /**
   * <p>Create a LanguageBreakEngine for the set of characters to which
@@ -265,6 +314,37 @@ class ICULanguageBreakFactory : public LanguageBreakFactory {
   virtual DictionaryMatcher *loadDictionaryMatcherFor(UScriptCode script);
 };
 
+/*******************************************************************
+ * SharedBreakEngine
+ */
+
+/**
+ * <p>SharedBreakEngine holds a LanguageBreakEngine built from a
+ * user-registered dictionary. It is reference counted, so that the
+ * registration can be replaced while break iterators are still using
+ * the engine.</p>
+ */
+class SharedBreakEngine : public SharedObject {
+ public:
+
+  /**
+   * <p>Constructor.</p>
+   *
+   * @param adoptedEngine The engine, which is deleted with this object.
+   */
+  SharedBreakEngine(LanguageBreakEngine *adoptedEngine) : fEngine(adoptedEngine) {}
+
+  /**
+   * <p>Virtual destructor.</p>
+   */
+  virtual ~SharedBreakEngine();
+
+  /**
+   * The engine, owned by this object.
+   */
+  LanguageBreakEngine *fEngine;
+};
+
 U_NAMESPACE_END
 
     /* BRKENG_H */
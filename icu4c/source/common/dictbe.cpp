@@ -44,7 +44,8 @@ int32_t
 DictionaryBreakEngine::findBreaks( UText *text,
                                  int32_t startPos,
                                  int32_t endPos,
-                                 UVector32 &foundBreaks ) const {
+                                 UVector32 &foundBreaks,
+                                 UBool bestPath ) const {
     (void)startPos;            // TODO: remove this param?
     int32_t result = 0;
 
@@ -63,7 +64,11 @@ DictionaryBreakEngine::findBreaks( UText *text,
     }
     rangeStart = start;
     rangeEnd = current;
-    result = divideUpDictionaryRange(text, rangeStart, rangeEnd, foundBreaks);
+    if (bestPath) {
+        result = divideUpDictionaryRangeBestPath(text, rangeStart, rangeEnd, foundBreaks);
+    } else {
+        result = divideUpDictionaryRange(text, rangeStart, rangeEnd, foundBreaks);
+    }
     utext_setNativeIndex(text, current);
     
     return result;
@@ -76,6 +81,135 @@ DictionaryBreakEngine::setCharacters( const UnicodeSet &set ) {
     fSet.compact();
 }
 
+int32_t
+DictionaryBreakEngine::divideUpDictionaryRangeBestPath( UText *text,
+                                                        int32_t rangeStart,
+                                                        int32_t rangeEnd,
+                                                        UVector32 &foundBreaks ) const {
+    return divideUpDictionaryRange(text, rangeStart, rangeEnd, foundBreaks);
+}
+
+// Maximum number of dictionary words starting at one position; see POSSIBLE_WORD_LIST_MAX.
+static const int32_t kBestPathMaxCandidates = 20;
+
+// Typical ranges are short enough for the best-path working arrays to live on the stack;
+// longer ones fall back to the heap, and to divideUpDictionaryRange() if that fails.
+static const int32_t kBestPathStackRangeLength = 128;
+
+int32_t
+DictionaryBreakEngine::divideUpRangeBestPath( UText *text,
+                                              int32_t rangeStart,
+                                              int32_t rangeEnd,
+                                              const DictionaryMatcher *dictionary,
+                                              const UnicodeSet &markSet,
+                                              const UnicodeSet *suffixSet,
+                                              int32_t minWordSpan,
+                                              UVector32 &foundBreaks ) const {
+    utext_setNativeIndex(text, rangeStart);
+    utext_moveIndex32(text, minWordSpan);
+    if (utext_getNativeIndex(text) >= rangeEnd) {
+        return 0;       // Not enough characters for two words
+    }
+
+    // Positions in the search are code point indexes in the range.
+    // nativeIndex[i] is the text index of code point i, and attached[i] is TRUE
+    // if a word never begins with it; it goes with the code points before it.
+    int32_t capacity = rangeEnd - rangeStart + 1;
+    MaybeStackArray<int32_t, kBestPathStackRangeLength> nativeIndex(capacity);
+    MaybeStackArray<UBool, kBestPathStackRangeLength> attached(capacity);
+    if (nativeIndex.getCapacity() < capacity || attached.getCapacity() < capacity) {
+        return divideUpDictionaryRange(text, rangeStart, rangeEnd, foundBreaks);
+    }
+    int32_t numCodePts = 0;
+    int32_t index;
+    UTEXT_SETNATIVEINDEX(text, rangeStart);
+    while ((index = (int32_t)UTEXT_GETNATIVEINDEX(text)) < rangeEnd) {
+        UChar32 c = UTEXT_NEXT32(text);
+        nativeIndex[numCodePts] = index;
+        attached[numCodePts] = markSet.contains(c) || (suffixSet != NULL && suffixSet->contains(c));
+        ++numCodePts;
+    }
+    nativeIndex[numCodePts] = rangeEnd;
+    attached[numCodePts] = FALSE;
+
+    // The best division of the first i code points leaves unmatched[i] code points
+    // outside of dictionary words, in words[i] words. Its last word or run of
+    // unmatched code points begins at prev[i]; inWord[i] is TRUE for a dictionary word.
+    MaybeStackArray<int32_t, kBestPathStackRangeLength> unmatched(numCodePts + 1);
+    MaybeStackArray<int32_t, kBestPathStackRangeLength> words(numCodePts + 1);
+    MaybeStackArray<int32_t, kBestPathStackRangeLength> prev(numCodePts + 1);
+    MaybeStackArray<UBool, kBestPathStackRangeLength> inWord(numCodePts + 1);
+    if (unmatched.getCapacity() <= numCodePts || words.getCapacity() <= numCodePts ||
+            prev.getCapacity() <= numCodePts || inWord.getCapacity() <= numCodePts) {
+        return divideUpDictionaryRange(text, rangeStart, rangeEnd, foundBreaks);
+    }
+    unmatched[0] = 0;
+    words[0] = 0;
+    prev[0] = -1;
+    inWord[0] = TRUE;
+    for (int32_t i = 1; i <= numCodePts; i++) {
+        unmatched[i] = INT32_MAX;
+        words[i] = 0;
+        prev[i] = -1;
+        inWord[i] = FALSE;
+    }
+
+    int32_t cpLengths[kBestPathMaxCandidates];
+    for (int32_t i = 0; i < numCodePts; i++) {
+        if (unmatched[i] == INT32_MAX) {
+            continue;
+        }
+
+        // All of the dictionary words at this position come from one walk of the
+        // trie, and are considered once; nothing after them is matched again.
+        UTEXT_SETNATIVEINDEX(text, nativeIndex[i]);
+        int32_t count = dictionary->matches(text, rangeEnd - nativeIndex[i], kBestPathMaxCandidates,
+                                            NULL, cpLengths, NULL, NULL);
+
+        // The candidates are the dictionary words, and a single code point outside
+        // of the dictionary, which continues a run of them without adding a word.
+        // Attached code points after either are outside of the dictionary word, so
+        // that a word is not preferred when it ends in the middle of a cluster.
+        for (int32_t j = 0; j <= count; j++) {
+            UBool isWord = j < count;
+            int32_t wordEnd = i + (isWord ? cpLengths[j] : 0);
+            int32_t end = isWord ? wordEnd : i + 1;
+            while (end < numCodePts && attached[end]) {
+                end++;
+            }
+            int32_t newUnmatched = unmatched[i] + (end - wordEnd);
+            int32_t newWords = words[i] + ((isWord || inWord[i]) ? 1 : 0);
+            if (newUnmatched < unmatched[end] ||
+                    (newUnmatched == unmatched[end] && newWords < words[end])) {
+                unmatched[end] = newUnmatched;
+                words[end] = newWords;
+                prev[end] = i;
+                inWord[end] = isWord;
+            }
+        }
+    }
+
+    // Collect the boundaries from the end of the best division back, leaving out
+    // the ones within runs of unmatched code points, and those at the ends of the range.
+    MaybeStackArray<int32_t, kBestPathStackRangeLength> boundaries(numCodePts + 1);
+    if (boundaries.getCapacity() <= numCodePts) {
+        return divideUpDictionaryRange(text, rangeStart, rangeEnd, foundBreaks);
+    }
+    int32_t numBreaks = 0;
+    UBool nextInWord = inWord[numCodePts];
+    for (int32_t i = prev[numCodePts]; i > 0; i = prev[i]) {
+        if (inWord[i] || nextInWord) {
+            boundaries[numBreaks++] = i;
+        }
+        nextInWord = inWord[i];
+    }
+    UErrorCode status = U_ZERO_ERROR;
+    for (int32_t i = numBreaks - 1; i >= 0 && U_SUCCESS(status); i--) {
+        foundBreaks.push(nativeIndex[boundaries[i]], status);
+    }
+    return U_SUCCESS(status) ? numBreaks : 0;
+}
+
 /*
  ******************************************************************
  * PossibleWord
@@ -128,17 +262,17 @@ class PossibleWord {
 
 int32_t PossibleWord::candidates( UText *text, DictionaryMatcher *dict, int32_t rangeEnd ) {
     // TODO: If getIndex is too slow, use offset < 0 and add discardAll()
-    int32_t start = (int32_t)utext_getNativeIndex(text);
+    int32_t start = (int32_t)UTEXT_GETNATIVEINDEX(text);
     if (start != offset) {
         offset = start;
         count = dict->matches(text, rangeEnd-start, UPRV_LENGTHOF(cuLengths), cuLengths, cpLengths, NULL, &prefix);
         // Dictionary leaves text after longest prefix, not longest word. Back up.
         if (count <= 0) {
-            utext_setNativeIndex(text, start);
+            UTEXT_SETNATIVEINDEX(text, start);
         }
     }
     if (count > 0) {
-        utext_setNativeIndex(text, start+cuLengths[count-1]);
+        UTEXT_SETNATIVEINDEX(text, start+cuLengths[count-1]);
     }
     current = count-1;
     mark = current;
@@ -147,7 +281,7 @@ int32_t PossibleWord::candidates( UText *text, DictionaryMatcher *dict, int32_t
 
 int32_t
 PossibleWord::acceptMarked( UText *text ) {
-    utext_setNativeIndex(text, offset + cuLengths[mark]);
+    UTEXT_SETNATIVEINDEX(text, offset + cuLengths[mark]);
     return cuLengths[mark];
 }
 
@@ -155,7 +289,8 @@ PossibleWord::acceptMarked( UText *text ) {
 UBool
 PossibleWord::backUp( UText *text ) {
     if (current > 0) {
-        utext_setNativeIndex(text, offset + cuLengths[--current]);
+        --current;
+        UTEXT_SETNATIVEINDEX(text, offset + cuLengths[current]);
         return TRUE;
     }
     return FALSE;
@@ -217,6 +352,15 @@ ThaiBreakEngine::~ThaiBreakEngine() {
     delete fDictionary;
 }
 
+int32_t
+ThaiBreakEngine::divideUpDictionaryRangeBestPath( UText *text,
+                                                  int32_t rangeStart,
+                                                  int32_t rangeEnd,
+                                                  UVector32 &foundBreaks ) const {
+    return divideUpRangeBestPath(text, rangeStart, rangeEnd, fDictionary, fMarkSet, &fSuffixSet,
+                                 THAI_MIN_WORD_SPAN, foundBreaks);
+}
+
 int32_t
 ThaiBreakEngine::divideUpDictionaryRange( UText *text,
                                                 int32_t rangeStart,
@@ -456,6 +600,15 @@ LaoBreakEngine::~LaoBreakEngine() {
     delete fDictionary;
 }
 
+int32_t
+LaoBreakEngine::divideUpDictionaryRangeBestPath( UText *text,
+                                                 int32_t rangeStart,
+                                                 int32_t rangeEnd,
+                                                 UVector32 &foundBreaks ) const {
+    return divideUpRangeBestPath(text, rangeStart, rangeEnd, fDictionary, fMarkSet, NULL,
+                                 LAO_MIN_WORD_SPAN, foundBreaks);
+}
+
 int32_t
 LaoBreakEngine::divideUpDictionaryRange( UText *text,
                                                 int32_t rangeStart,
@@ -649,6 +802,15 @@ BurmeseBreakEngine::~BurmeseBreakEngine() {
     delete fDictionary;
 }
 
+int32_t
+BurmeseBreakEngine::divideUpDictionaryRangeBestPath( UText *text,
+                                                     int32_t rangeStart,
+                                                     int32_t rangeEnd,
+                                                     UVector32 &foundBreaks ) const {
+    return divideUpRangeBestPath(text, rangeStart, rangeEnd, fDictionary, fMarkSet, NULL,
+                                 BURMESE_MIN_WORD_SPAN, foundBreaks);
+}
+
 int32_t
 BurmeseBreakEngine::divideUpDictionaryRange( UText *text,
                                                 int32_t rangeStart,
@@ -854,6 +1016,15 @@ KhmerBreakEngine::~KhmerBreakEngine() {
     delete fDictionary;
 }
 
+int32_t
+KhmerBreakEngine::divideUpDictionaryRangeBestPath( UText *text,
+                                                   int32_t rangeStart,
+                                                   int32_t rangeEnd,
+                                                   UVector32 &foundBreaks ) const {
+    return divideUpRangeBestPath(text, rangeStart, rangeEnd, fDictionary, fMarkSet, NULL,
+                                 KHMER_MIN_WORD_SPAN, foundBreaks);
+}
+
 int32_t
 KhmerBreakEngine::divideUpDictionaryRange( UText *text,
                                                 int32_t rangeStart,
@@ -1076,6 +1247,13 @@ static const int32_t kMaxKatakanaLength = 8;
 static const int32_t kMaxKatakanaGroupLength = 20;
 static const uint32_t maxSnlp = 255;
 
+// The longest dictionary word considered, in code points.
+static const int32_t kMaxWordSize = 20;
+
+// Dictionary ranges up to this many code points are segmented using
+// stack storage only.
+static const int32_t kCjkStackRangeLength = 128;
+
 static inline uint32_t getKatakanaCost(int32_t wordLength){
     //TODO: fill array with actual values from dictionary!
     static const uint32_t katakanaCost[kMaxKatakanaLength + 1]
@@ -1239,25 +1417,26 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
                 
     // bestSnlp[i] is the snlp of the best segmentation of the first i
     // code points in the range to be matched.
-    UVector32 bestSnlp(numCodePts + 1, status);
-    bestSnlp.addElement(0, status);
-    for(int32_t i = 1; i <= numCodePts; i++) {
-        bestSnlp.addElement(kuint32max, status);
-    }
-
-
     // prev[i] is the index of the last CJK code point in the previous word in 
     // the best segmentation of the first i characters.
-    UVector32 prev(numCodePts + 1, status);
-    for(int32_t i = 0; i <= numCodePts; i++){
-        prev.addElement(-1, status);
+    // Typical ranges are short enough for the working arrays to live on the stack;
+    // longer ones fall back to the heap.
+    MaybeStackArray<uint32_t, kCjkStackRangeLength> bestSnlp(numCodePts + 1);
+    MaybeStackArray<int32_t, kCjkStackRangeLength> prev(numCodePts + 1);
+    if (bestSnlp.getCapacity() <= numCodePts || prev.getCapacity() <= numCodePts) {
+        return 0;
+    }
+    bestSnlp[0] = 0;
+    prev[0] = -1;
+    for(int32_t i = 1; i <= numCodePts; i++) {
+        bestSnlp[i] = kuint32max;
+        prev[i] = -1;
     }
 
-    const int32_t maxWordSize = 20;
-    UVector32 values(numCodePts, status);
-    values.setSize(numCodePts);
-    UVector32 lengths(numCodePts, status);
-    lengths.setSize(numCodePts);
+    // Dictionary matches at one position, with room for the
+    // default single character word that may be added after them.
+    int32_t values[kMaxWordSize + 1];
+    int32_t lengths[kMaxWordSize + 1];
 
     UText fu = UTEXT_INITIALIZER;
     utext_openUnicodeString(&fu, &inString, &status);
@@ -1270,14 +1449,16 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     int32_t ix = 0;
     bool is_prev_katakana = false;
     for (int32_t i = 0;  i < numCodePts;  ++i, ix = inString.moveIndex32(ix, 1)) {
-        if ((uint32_t)bestSnlp.elementAti(i) == kuint32max) {
+        UChar32 c = inString.char32At(ix);
+        bool is_katakana = isKatakana(c);
+        if (bestSnlp[i] == kuint32max) {
             continue;
         }
 
         int32_t count;
         utext_setNativeIndex(&fu, ix);
-        count = fDictionary->matches(&fu, maxWordSize, numCodePts,
-                             NULL, lengths.getBuffer(), values.getBuffer(), NULL);
+        count = fDictionary->matches(&fu, kMaxWordSize, kMaxWordSize,
+                             NULL, lengths, values, NULL);
                              // Note: lengths is filled with code point lengths
                              //       The NULL parameter is the ignored code unit lengths.
 
@@ -1286,18 +1467,17 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         // with the highest value possible, i.e. the least likely to occur.
         // Exclude Korean characters from this treatment, as they should be left
         // together by default.
-        if ((count == 0 || lengths.elementAti(0) != 1) &&
-                !fHangulWordSet.contains(inString.char32At(ix))) {
-            values.setElementAt(maxSnlp, count);   // 255
-            lengths.setElementAt(1, count++);
+        if ((count == 0 || lengths[0] != 1) && !fHangulWordSet.contains(c)) {
+            values[count] = maxSnlp;   // 255
+            lengths[count++] = 1;
         }
 
         for (int32_t j = 0; j < count; j++) {
-            uint32_t newSnlp = (uint32_t)bestSnlp.elementAti(i) + (uint32_t)values.elementAti(j);
-            int32_t ln_j_i = lengths.elementAti(j) + i;
-            if (newSnlp < (uint32_t)bestSnlp.elementAti(ln_j_i)) {
-                bestSnlp.setElementAt(newSnlp, ln_j_i);
-                prev.setElementAt(i, ln_j_i);
+            uint32_t newSnlp = bestSnlp[i] + (uint32_t)values[j];
+            int32_t ln_j_i = lengths[j] + i;
+            if (newSnlp < bestSnlp[ln_j_i]) {
+                bestSnlp[ln_j_i] = newSnlp;
+                prev[ln_j_i] = i;
             }
         }
 
@@ -1307,7 +1487,6 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         // characters is considered a candidate word with a default cost
         // specified in the katakanaCost table according to its length.
 
-        bool is_katakana = isKatakana(inString.char32At(ix));
         int32_t katakanaRunLength = 1;
         if (!is_prev_katakana && is_katakana) {
             int32_t j = inString.moveIndex32(ix, 1);
@@ -1318,10 +1497,10 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
                 katakanaRunLength++;
             }
             if (katakanaRunLength < kMaxKatakanaGroupLength) {
-                uint32_t newSnlp = bestSnlp.elementAti(i) + getKatakanaCost(katakanaRunLength);
-                if (newSnlp < (uint32_t)bestSnlp.elementAti(i+katakanaRunLength)) {
-                    bestSnlp.setElementAt(newSnlp, i+katakanaRunLength);
-                    prev.setElementAt(i, i+katakanaRunLength);  // prev[j] = i;
+                uint32_t newSnlp = bestSnlp[i] + getKatakanaCost(katakanaRunLength);
+                if (newSnlp < bestSnlp[i+katakanaRunLength]) {
+                    bestSnlp[i+katakanaRunLength] = newSnlp;
+                    prev[i+katakanaRunLength] = i;  // prev[j] = i;
                 }
             }
         }
@@ -1333,26 +1512,26 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     // prev[numCodePts] is guaranteed to be meaningful.
     // We'll first push in the reverse order, i.e.,
     // t_boundary[0] = numCodePts, and afterwards do a swap.
-    UVector32 t_boundary(numCodePts+1, status);
+    MaybeStackArray<int32_t, kCjkStackRangeLength> t_boundary(numCodePts + 2);
+    if (t_boundary.getCapacity() < numCodePts + 2) {
+        return 0;
+    }
 
     int32_t numBreaks = 0;
     // No segmentation found, set boundary to end of range
-    if ((uint32_t)bestSnlp.elementAti(numCodePts) == kuint32max) {
-        t_boundary.addElement(numCodePts, status);
-        numBreaks++;
+    if (bestSnlp[numCodePts] == kuint32max) {
+        t_boundary[numBreaks++] = numCodePts;
     } else {
-        for (int32_t i = numCodePts; i > 0; i = prev.elementAti(i)) {
-            t_boundary.addElement(i, status);
-            numBreaks++;
+        for (int32_t i = numCodePts; i > 0; i = prev[i]) {
+            t_boundary[numBreaks++] = i;
         }
-        U_ASSERT(prev.elementAti(t_boundary.elementAti(numBreaks - 1)) == 0);
+        U_ASSERT(prev[t_boundary[numBreaks - 1]] == 0);
     }
 
     // Add a break for the start of the dictionary range if there is not one
     // there already.
     if (foundBreaks.size() == 0 || foundBreaks.peeki() < rangeStart) {
-        t_boundary.addElement(0, status);
-        numBreaks++;
+        t_boundary[numBreaks++] = 0;
     }
 
     // Now that we're done, convert positions in t_boundary[] (indices in 
@@ -1361,7 +1540,7 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     int32_t prevCPPos = -1;
     int32_t prevUTextPos = -1;
     for (int32_t i = numBreaks-1; i >= 0; i--) {
-        int32_t cpPos = t_boundary.elementAti(i);
+        int32_t cpPos = t_boundary[i];
         U_ASSERT(cpPos > prevCPPos);
         int32_t utextPos =  inputMap.isValid() ? inputMap->elementAti(cpPos) : cpPos + rangeStart;
         U_ASSERT(utextPos >= prevUTextPos);
@@ -73,12 +73,14 @@ class DictionaryBreakEngine : public LanguageBreakEngine {
    * @param startPos The start of the run within the supplied text.
    * @param endPos The end of the run within the supplied text.
    * @param foundBreaks vector of int32_t to receive the break positions
+   * @param bestPath TRUE to divide up the run with divideUpDictionaryRangeBestPath()
    * @return The number of breaks found.
    */
   virtual int32_t findBreaks( UText *text,
                               int32_t startPos,
                               int32_t endPos,
-                              UVector32 &foundBreaks ) const;
+                              UVector32 &foundBreaks,
+                              UBool bestPath ) const;
 
  protected:
 
@@ -103,6 +105,50 @@ class DictionaryBreakEngine : public LanguageBreakEngine {
                                            int32_t rangeEnd,
                                            UVector32 &foundBreaks ) const = 0;
 
+ /**
+  * <p>Divide up a range of known dictionary characters with a best-path search,
+  * for RuleBasedBreakIterator::setDictionaryBestPath(). The default implementation
+  * calls divideUpDictionaryRange(), for engines that have no other method.</p>
+  *
+  * @param text A UText representing the text
+  * @param rangeStart The start of the range of dictionary characters
+  * @param rangeEnd The end of the range of dictionary characters
+  * @param foundBreaks Output of C array of int32_t break positions, or 0
+  * @return The number of breaks found
+  */
+  virtual int32_t divideUpDictionaryRangeBestPath( UText *text,
+                                                   int32_t rangeStart,
+                                                   int32_t rangeEnd,
+                                                   UVector32 &foundBreaks ) const;
+
+ /**
+  * <p>Divide up a range of known dictionary characters into the sequence of
+  * dictionary words and other characters that has the fewest characters outside
+  * of dictionary words, and then the fewest words. Each position is matched
+  * against the dictionary once. Runs of characters outside of dictionary words
+  * are kept together. If its working storage cannot be allocated, the range is
+  * divided up with divideUpDictionaryRange() instead.</p>
+  *
+  * @param text A UText representing the text
+  * @param rangeStart The start of the range of dictionary characters
+  * @param rangeEnd The end of the range of dictionary characters
+  * @param dictionary The dictionary of words
+  * @param markSet Characters that are never at the start of a word, such as
+  * combining marks; they are added to the end of the preceding word
+  * @param suffixSet More characters to add to the end of the preceding word, or NULL
+  * @param minWordSpan Ranges of fewer code points than this are not divided up
+  * @param foundBreaks Output of C array of int32_t break positions, or 0
+  * @return The number of breaks found
+  */
+  int32_t divideUpRangeBestPath( UText *text,
+                                 int32_t rangeStart,
+                                 int32_t rangeEnd,
+                                 const DictionaryMatcher *dictionary,
+                                 const UnicodeSet &markSet,
+                                 const UnicodeSet *suffixSet,
+                                 int32_t minWordSpan,
+                                 UVector32 &foundBreaks ) const;
+
 };
 
 /*******************************************************************
@@ -160,6 +206,20 @@ class ThaiBreakEngine : public DictionaryBreakEngine {
                                            int32_t rangeEnd,
                                            UVector32 &foundBreaks ) const;
 
+ /**
+  * <p>Divide up a range of known dictionary characters with a best-path search.</p>
+  *
+  * @param text A UText representing the text
+  * @param rangeStart The start of the range of dictionary characters
+  * @param rangeEnd The end of the range of dictionary characters
+  * @param foundBreaks Output of C array of int32_t break positions, or 0
+  * @return The number of breaks found
+  */
+  virtual int32_t divideUpDictionaryRangeBestPath( UText *text,
+                                                   int32_t rangeStart,
+                                                   int32_t rangeEnd,
+                                                   UVector32 &foundBreaks ) const;
+
 };
 
 /*******************************************************************
@@ -216,6 +276,20 @@ class LaoBreakEngine : public DictionaryBreakEngine {
                                            int32_t rangeEnd,
                                            UVector32 &foundBreaks ) const;
 
+ /**
+  * <p>Divide up a range of known dictionary characters with a best-path search.</p>
+  *
+  * @param text A UText representing the text
+  * @param rangeStart The start of the range of dictionary characters
+  * @param rangeEnd The end of the range of dictionary characters
+  * @param foundBreaks Output of C array of int32_t break positions, or 0
+  * @return The number of breaks found
+  */
+  virtual int32_t divideUpDictionaryRangeBestPath( UText *text,
+                                                   int32_t rangeStart,
+                                                   int32_t rangeEnd,
+                                                   UVector32 &foundBreaks ) const;
+
 };
 
 /******************************************************************* 
@@ -272,6 +346,20 @@ class BurmeseBreakEngine : public DictionaryBreakEngine {
                                            int32_t rangeEnd, 
                                            UVector32 &foundBreaks ) const; 
  
+ /** 
+  * <p>Divide up a range of known dictionary characters with a best-path search.</p> 
+  * 
+  * @param text A UText representing the text 
+  * @param rangeStart The start of the range of dictionary characters 
+  * @param rangeEnd The end of the range of dictionary characters 
+  * @param foundBreaks Output of C array of int32_t break positions, or 0 
+  * @return The number of breaks found 
+  */ 
+  virtual int32_t divideUpDictionaryRangeBestPath( UText *text, 
+                                                   int32_t rangeStart, 
+                                                   int32_t rangeEnd, 
+                                                   UVector32 &foundBreaks ) const; 
+ 
 }; 
  
 /******************************************************************* 
@@ -328,6 +416,20 @@ class KhmerBreakEngine : public DictionaryBreakEngine {
                                            int32_t rangeEnd, 
                                            UVector32 &foundBreaks ) const; 
  
+ /** 
+  * <p>Divide up a range of known dictionary characters with a best-path search.</p> 
+  * 
+  * @param text A UText representing the text 
+  * @param rangeStart The start of the range of dictionary characters 
+  * @param rangeEnd The end of the range of dictionary characters 
+  * @param foundBreaks Output of C array of int32_t break positions, or 0 
+  * @return The number of breaks found 
+  */ 
+  virtual int32_t divideUpDictionaryRangeBestPath( UText *text, 
+                                                   int32_t rangeStart, 
+                                                   int32_t rangeEnd, 
+                                                   UVector32 &foundBreaks ) const; 
+ 
 }; 
  
 #if !UCONFIG_NO_NORMALIZATION
@@ -207,6 +207,9 @@ RuleBasedBreakIterator::~RuleBasedBreakIterator() {
     delete fLanguageBreakEngines;
     fLanguageBreakEngines = NULL;
 
+    delete fSharedBreakEngines;
+    fSharedBreakEngines = NULL;
+
     delete fUnhandledBreakEngine;
     fUnhandledBreakEngine = NULL;
 }
@@ -226,6 +229,8 @@ RuleBasedBreakIterator::operator=(const RuleBasedBreakIterator& that) {
         delete fLanguageBreakEngines;
         fLanguageBreakEngines = NULL;   // Just rebuild for now
     }
+    delete fSharedBreakEngines;
+    fSharedBreakEngines = NULL;
     // TODO: clone fLanguageBreakEngines from "that"
     UErrorCode status = U_ZERO_ERROR;
     utext_clone(&fText, &that.fText, FALSE, TRUE, &status);
@@ -257,13 +262,18 @@ RuleBasedBreakIterator::operator=(const RuleBasedBreakIterator& that) {
     fPosition = that.fPosition;
     fRuleStatusIndex = that.fRuleStatusIndex;
     fDone = that.fDone;
+    fDictionaryBestPath = that.fDictionaryBestPath;
 
     // TODO: both the dictionary and the main cache need to be copied.
     //       Current position could be within a dictionary range. Trying to continue
     //       the iteration without the caches present would go to the rules, with
     //       the assumption that the current position is on a rule boundary.
-    fBreakCache->reset(fPosition, fRuleStatusIndex);
-    fDictionaryCache->reset();
+    if (fBreakCache != NULL) {
+        fBreakCache->reset(fPosition, fRuleStatusIndex);
+    }
+    if (fDictionaryCache != NULL) {
+        fDictionaryCache->reset();
+    }
 
     return *this;
 }
@@ -285,6 +295,9 @@ void RuleBasedBreakIterator::init(UErrorCode &status) {
     fDictionaryCharCount  = 0;
     fLanguageBreakEngines = NULL;
     fUnhandledBreakEngine = NULL;
+    fSharedBreakEngines   = NULL;
+    fUserDictionaryGeneration = 0;
+    fDictionaryBestPath   = FALSE;
     fBreakCache           = NULL;
     fDictionaryCache      = NULL;
 
@@ -298,11 +311,7 @@ void RuleBasedBreakIterator::init(UErrorCode &status) {
     }
 
     utext_openUChars(&fText, NULL, 0, &status);
-    fDictionaryCache = new DictionaryCache(this, status);
-    fBreakCache      = new BreakCache(this, status);
-    if (U_SUCCESS(status) && (fDictionaryCache == NULL || fBreakCache == NULL)) {
-        status = U_MEMORY_ALLOCATION_ERROR;
-    }
+    // fBreakCache and fDictionaryCache are created on first use.
 
 #ifdef RBBI_DEBUG
     static UBool debugInitDone = FALSE;
@@ -318,6 +327,71 @@ void RuleBasedBreakIterator::init(UErrorCode &status) {
 
 
 
+//-----------------------------------------------------------------------------
+//
+//    reset()     Empty the caches, on a change of text.
+//
+//-----------------------------------------------------------------------------
+void RuleBasedBreakIterator::reset() {
+    if (fBreakCache != NULL) {
+        fBreakCache->reset();
+    }
+    if (fDictionaryCache != NULL) {
+        fDictionaryCache->reset();
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+//
+//    ensureBreakCache(), ensureDictionaryCache()
+//
+//        Create the caches on first use. An iterator that only moves forward
+//        with first() and next(), such as a clone made to break a single
+//        string, never needs the break cache, and needs the dictionary cache
+//        only if the text has dictionary characters.
+//
+//-----------------------------------------------------------------------------
+UBool RuleBasedBreakIterator::ensureDictionaryCache(UErrorCode &status) {
+    if (fDictionaryCache != NULL) {
+        return TRUE;
+    }
+    if (U_FAILURE(status)) {
+        return FALSE;
+    }
+    fDictionaryCache = new DictionaryCache(this, status);
+    if (fDictionaryCache == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+    } else if (U_FAILURE(status)) {
+        delete fDictionaryCache;
+        fDictionaryCache = NULL;
+    }
+    return fDictionaryCache != NULL;
+}
+
+UBool RuleBasedBreakIterator::ensureBreakCache(UErrorCode &status) {
+    if (fBreakCache != NULL) {
+        return TRUE;
+    }
+    if (!ensureDictionaryCache(status)) {
+        return FALSE;
+    }
+    fBreakCache = new BreakCache(this, status);
+    if (fBreakCache == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return FALSE;
+    }
+    if (U_FAILURE(status)) {
+        delete fBreakCache;
+        fBreakCache = NULL;
+        return FALSE;
+    }
+    // The current position was reached by forward iteration, so is a boundary.
+    fBreakCache->reset(fPosition, fRuleStatusIndex);
+    return TRUE;
+}
+
+
 //-----------------------------------------------------------------------------
 //
 //    clone - Returns a newly-constructed RuleBasedBreakIterator with the same
@@ -388,8 +462,7 @@ void RuleBasedBreakIterator::setText(UText *ut, UErrorCode &status) {
     if (U_FAILURE(status)) {
         return;
     }
-    fBreakCache->reset();
-    fDictionaryCache->reset();
+    reset();
     utext_clone(&fText, ut, FALSE, TRUE, &status);
 
     // Set up a dummy CharacterIterator to be returned if anyone
@@ -443,8 +516,7 @@ RuleBasedBreakIterator::adoptText(CharacterIterator* newText) {
 
     fCharIter = newText;
     UErrorCode status = U_ZERO_ERROR;
-    fBreakCache->reset();
-    fDictionaryCache->reset();
+    reset();
     if (newText==NULL || newText->startIndex() != 0) {
         // startIndex !=0 wants to be an error, but there's no way to report it.
         // Make the iterator text be an empty string.
@@ -463,8 +535,7 @@ RuleBasedBreakIterator::adoptText(CharacterIterator* newText) {
 void
 RuleBasedBreakIterator::setText(const UnicodeString& newText) {
     UErrorCode status = U_ZERO_ERROR;
-    fBreakCache->reset();
-    fDictionaryCache->reset();
+    reset();
     utext_openConstUnicodeString(&fText, &newText, &status);
 
     // Set up a character iterator on the string.
@@ -520,6 +591,12 @@ RuleBasedBreakIterator &RuleBasedBreakIterator::refreshInputText(UText *input, U
  * @return The new iterator position, which is zero.
  */
 int32_t RuleBasedBreakIterator::first(void) {
+    if (fBreakCache == NULL) {
+        fPosition = 0;
+        fRuleStatusIndex = 0;
+        fDone = FALSE;
+        return 0;
+    }
     UErrorCode status = U_ZERO_ERROR;
     if (!fBreakCache->seek(0)) {
         fBreakCache->populateNear(0, status);
@@ -572,10 +649,53 @@ int32_t RuleBasedBreakIterator::next(int32_t n) {
  * @return The position of the first boundary after this one.
  */
 int32_t RuleBasedBreakIterator::next(void) {
+    if (fBreakCache == NULL) {
+        return nextWithoutCache();
+    }
     fBreakCache->next();
     return fDone ? UBRK_DONE : fPosition;
 }
 
+/**
+ * next() for an iterator that has only moved forward, and so has no break cache.
+ * Follows BreakCache::populateFollowing(), without saving the results.
+ */
+int32_t RuleBasedBreakIterator::nextWithoutCache() {
+    if (fDone) {
+        return UBRK_DONE;
+    }
+    int32_t fromPosition = fPosition;
+    int32_t fromRuleStatusIdx = fRuleStatusIndex;
+    int32_t pos = 0;
+    int32_t ruleStatusIdx = 0;
+
+    if (fDictionaryCache != NULL && fDictionaryCache->following(fromPosition, &pos, &ruleStatusIdx)) {
+        fPosition = pos;
+        fRuleStatusIndex = ruleStatusIdx;
+        return pos;
+    }
+
+    pos = handleNext();
+    if (pos == UBRK_DONE) {
+        fPosition = fromPosition;
+        fRuleStatusIndex = fromRuleStatusIdx;
+        fDone = TRUE;
+        return UBRK_DONE;
+    }
+
+    ruleStatusIdx = fRuleStatusIndex;
+    UErrorCode status = U_ZERO_ERROR;
+    if (fDictionaryCharCount > 0 && ensureDictionaryCache(status)) {
+        // The text segment obtained from the rules includes dictionary characters.
+        // Subdivide it, with subdivided results going into the dictionary cache.
+        fDictionaryCache->populateDictionary(fromPosition, pos, fromRuleStatusIdx, ruleStatusIdx);
+        fDictionaryCache->following(fromPosition, &pos, &ruleStatusIdx);
+    }
+    fPosition = pos;
+    fRuleStatusIndex = ruleStatusIdx;
+    return pos;
+}
+
 /**
  * Move the iterator backwards, to the boundary preceding the current one.
  *
@@ -586,6 +706,9 @@ int32_t RuleBasedBreakIterator::next(void) {
  */
 int32_t RuleBasedBreakIterator::previous(void) {
     UErrorCode status = U_ZERO_ERROR;
+    if (!ensureBreakCache(status)) {
+        return UBRK_DONE;
+    }
     fBreakCache->previous(status);
     return fDone ? UBRK_DONE : fPosition;
 }
@@ -609,6 +732,9 @@ int32_t RuleBasedBreakIterator::following(int32_t startPos) {
     startPos = (int32_t)utext_getNativeIndex(&fText);
 
     UErrorCode status = U_ZERO_ERROR;
+    if (!ensureBreakCache(status)) {
+        return UBRK_DONE;
+    }
     fBreakCache->following(startPos, status);
     return fDone ? UBRK_DONE : fPosition;
 }
@@ -631,6 +757,9 @@ int32_t RuleBasedBreakIterator::preceding(int32_t offset) {
     int32_t adjustedOffset = utext_getNativeIndex(&fText);
 
     UErrorCode status = U_ZERO_ERROR;
+    if (!ensureBreakCache(status)) {
+        return UBRK_DONE;
+    }
     fBreakCache->preceding(adjustedOffset, status);
     return fDone ? UBRK_DONE : fPosition;
 }
@@ -659,6 +788,9 @@ UBool RuleBasedBreakIterator::isBoundary(int32_t offset) {
 
     bool result = false;
     UErrorCode status = U_ZERO_ERROR;
+    if (!ensureBreakCache(status)) {
+        return FALSE;
+    }
     if (fBreakCache->seek(adjustedOffset) || fBreakCache->populateNear(adjustedOffset, status)) {
         result = (fBreakCache->current() == offset);
     }
@@ -1022,6 +1154,173 @@ int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition) {
     return result;
 }
 
+
+//-----------------------------------------------------------------------------------
+//
+//  isRuleBoundary()
+//
+//      Determine whether a position is a boundary by backing up to a safe point
+//      and running the forward rules, the same way that the break cache re-synchronizes
+//      when starting from an arbitrary position. The cache is neither used nor updated.
+//
+//-----------------------------------------------------------------------------------
+UBool RuleBasedBreakIterator::isRuleBoundary(int32_t position) {
+    int32_t backupPos = handleSafePrevious(position);
+    int32_t aBoundary = 0;
+    fPosition = 0;
+    if (backupPos > 0) {
+        // Advance to the boundary following the backup position.
+        // If that moved forwards by a single code point only, go again;
+        // the safe reverse rules identify pairs of code points that are safe.
+        // See BreakCache::populateNear().
+        fPosition = backupPos;
+        aBoundary = handleNext();
+        if (aBoundary <= backupPos + 4) {
+            utext_setNativeIndex(&fText, aBoundary);
+            if (backupPos == utext_getPreviousNativeIndex(&fText)) {
+                aBoundary = handleNext();
+            }
+        }
+    }
+    while (aBoundary != UBRK_DONE && aBoundary < position) {
+        aBoundary = handleNext();
+    }
+    return aBoundary == position;
+}
+
+
+//-------------------------------------------------------------------------------
+//
+//   getPartitions()   Split the text at verified boundaries following hard
+//                     break characters, for independent (parallel) processing.
+//
+//-------------------------------------------------------------------------------
+int32_t RuleBasedBreakIterator::getPartitions(int32_t minPartitionLength, int32_t *partitionStarts,
+                                              int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (minPartitionLength <= 0 || capacity < 0 || (partitionStarts == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    int32_t textLength = (int32_t)utext_nativeLength(&fText);
+    int32_t numPartitions = 0;
+    if (capacity > 0) {
+        partitionStarts[0] = 0;
+    }
+    ++numPartitions;
+
+    int32_t scanPos = minPartitionLength;
+    while (scanPos < textLength) {
+        // Find the position following the next hard break character at or after scanPos.
+        UTEXT_SETNATIVEINDEX(&fText, scanPos);
+        UChar32 c;
+        for (;;) {
+            c = UTEXT_NEXT32(&fText);
+            if (c == U_SENTINEL || (c >= 0xa && c <= 0xd) || c == 0x85 || c == 0x2028 || c == 0x2029) {
+                break;
+            }
+        }
+        if (c == U_SENTINEL) {
+            break;
+        }
+        if (c == 0xd && UTEXT_CURRENT32(&fText) == 0xa) {
+            UTEXT_NEXT32(&fText);
+        }
+        int32_t candidate = (int32_t)UTEXT_GETNATIVEINDEX(&fText);
+        if (candidate >= textLength) {
+            break;
+        }
+        if (isRuleBoundary(candidate)) {
+            if (numPartitions < capacity) {
+                partitionStarts[numPartitions] = candidate;
+            }
+            ++numPartitions;
+            scanPos = candidate + minPartitionLength;
+        } else {
+            scanPos = candidate;
+        }
+    }
+
+    // isRuleBoundary() bypassed the caches; bring the iterator back to a consistent state.
+    reset();
+    first();
+
+    if (numPartitions > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return numPartitions;
+}
+
+
+//-------------------------------------------------------------------------------
+//
+//   getBoundaries()   Bulk retrieval of the boundaries in a range of the text.
+//
+//-------------------------------------------------------------------------------
+int32_t RuleBasedBreakIterator::getBoundaries(int32_t start, int32_t limit, int32_t *boundaries,
+                                              int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (start < 0 || limit < start || capacity < 0 || (boundaries == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    int32_t numBoundaries = 0;
+    for (int32_t pos = following(start); pos != UBRK_DONE && pos <= limit; pos = next()) {
+        if (numBoundaries < capacity) {
+            boundaries[numBoundaries] = pos;
+        }
+        ++numBoundaries;
+    }
+    if (numBoundaries > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return numBoundaries;
+}
+
+//-------------------------------------------------------------------------------
+//
+//   registerDictionary()     Install a user dictionary for a script, shared
+//   unregisterDictionary()   by all break iterators. The registry itself lives
+//                            with the dictionary break engines, in brkeng.cpp.
+//
+//-------------------------------------------------------------------------------
+void U_EXPORT2 RuleBasedBreakIterator::registerDictionary(UScriptCode script, const char *path,
+                                                          UErrorCode &status) {
+    ICULanguageBreakFactory::registerUserDictionary(script, path, status);
+}
+
+UBool U_EXPORT2 RuleBasedBreakIterator::unregisterDictionary(UScriptCode script, UErrorCode &status) {
+    return ICULanguageBreakFactory::unregisterUserDictionary(script, status);
+}
+
+//-------------------------------------------------------------------------------
+//
+//   setDictionaryBestPath()   Choose how dictionary break engines divide up runs
+//                             of text. Boundaries already found for the text
+//                             may have come from the other method, so drop them
+//                             and start over, as for new text.
+//
+//-------------------------------------------------------------------------------
+void RuleBasedBreakIterator::setDictionaryBestPath(UBool bestPath) {
+    bestPath = (bestPath != FALSE);
+    if (bestPath == fDictionaryBestPath) {
+        return;
+    }
+    fDictionaryBestPath = bestPath;
+    reset();
+    this->first();
+}
+
+UBool RuleBasedBreakIterator::getDictionaryBestPath() const {
+    return fDictionaryBestPath;
+}
+
 //-------------------------------------------------------------------------------
 //
 //   getRuleStatus()   Return the break rule tag associated with the current
@@ -1132,6 +1431,10 @@ U_CDECL_BEGIN
 static void U_CALLCONV _deleteFactory(void *obj) {
     delete (icu::LanguageBreakFactory *) obj;
 }
+
+static void U_CALLCONV _releaseSharedBreakEngine(void *obj) {
+    ((const icu::SharedBreakEngine *) obj)->removeRef();
+}
 U_CDECL_END
 U_NAMESPACE_BEGIN
 
@@ -1190,6 +1493,21 @@ RuleBasedBreakIterator::getLanguageBreakEngine(UChar32 c) {
     const LanguageBreakEngine *lbe = NULL;
     UErrorCode status = U_ZERO_ERROR;
 
+    // If dictionaries were registered or unregistered since the engines were
+    // looked up, start over. Any engine being replaced stays alive until its
+    // SharedBreakEngine reference is released here.
+    int32_t generation = ICULanguageBreakFactory::getUserDictionaryGeneration();
+    if (generation != fUserDictionaryGeneration) {
+        if (fLanguageBreakEngines != NULL) {
+            fLanguageBreakEngines->removeAllElements();
+        }
+        delete fSharedBreakEngines;
+        fSharedBreakEngines = NULL;
+        delete fUnhandledBreakEngine;
+        fUnhandledBreakEngine = NULL;
+        fUserDictionaryGeneration = generation;
+    }
+
     if (fLanguageBreakEngines == NULL) {
         fLanguageBreakEngines = new UStack(status);
         if (fLanguageBreakEngines == NULL || U_FAILURE(status)) {
@@ -1207,8 +1525,30 @@ RuleBasedBreakIterator::getLanguageBreakEngine(UChar32 c) {
         }
     }
 
-    // No existing dictionary took the character. See if a factory wants to
-    // give us a new LanguageBreakEngine for this character.
+    // No existing dictionary took the character. User-registered dictionaries
+    // take precedence over the ones from the factories. Keep a reference to
+    // the engine for as long as it is on our stack.
+    const SharedBreakEngine *shared = ICULanguageBreakFactory::getUserEngineFor(c);
+    if (shared != NULL) {
+        if (fSharedBreakEngines == NULL) {
+            fSharedBreakEngines = new UStack(_releaseSharedBreakEngine, NULL, status);
+            if (fSharedBreakEngines == NULL || U_FAILURE(status)) {
+                delete fSharedBreakEngines;
+                fSharedBreakEngines = NULL;
+                shared->removeRef();
+                return NULL;
+            }
+        }
+        fSharedBreakEngines->push((void *)shared, status);
+        if (U_FAILURE(status)) {
+            shared->removeRef();
+            return NULL;
+        }
+        fLanguageBreakEngines->push(shared->fEngine, status);
+        return shared->fEngine;
+    }
+
+    // See if a factory wants to give us a new LanguageBreakEngine for this character.
     lbe = getLanguageBreakEngineFromFactory(c);
 
     // If we got one, use it and push it on our stack.
@@ -1246,7 +1586,9 @@ RuleBasedBreakIterator::getLanguageBreakEngine(UChar32 c) {
 }
 
 void RuleBasedBreakIterator::dumpCache() {
-    fBreakCache->dumpCache();
+    if (fBreakCache != NULL) {
+        fBreakCache->dumpCache();
+    }
 }
 
 void RuleBasedBreakIterator::dumpTables() {
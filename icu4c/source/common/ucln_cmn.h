@@ -37,6 +37,7 @@ typedef enum ECleanupCommonType {
     UCLN_COMMON_USPREP,
     UCLN_COMMON_BREAKITERATOR,
     UCLN_COMMON_RBBI,
+    UCLN_COMMON_BREAKENGINE,
     UCLN_COMMON_SERVICE,
     UCLN_COMMON_LOCALE_KEY_TYPE,
     UCLN_COMMON_LOCALE,
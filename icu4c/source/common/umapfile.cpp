@@ -136,6 +136,14 @@
             return FALSE;
         }
 
+        /* Determine the length of the file that was opened. The mapping below is created
+           with exactly this size, so that it cannot disagree with pData->length. */
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart<=0 || fileSize.QuadPart>INT32_MAX) {
+            CloseHandle(file);
+            return FALSE;
+        }
+
         /* Declare and initialize a security descriptor.
            This is required for multiuser systems on Windows 2000 SP4 and beyond */
         // TODO: UWP does not have this function and I do not think it is required?
@@ -160,9 +168,9 @@
            and mappingAttributesPtr == NULL for that case. */
 
         /* create an unnamed Windows file-mapping object for the specified file */
-        map=CreateFileMapping(file, mappingAttributesPtr, PAGE_READONLY, 0, 0, NULL);
+        map=CreateFileMapping(file, mappingAttributesPtr, PAGE_READONLY, 0, fileSize.LowPart, NULL);
 #else
-        map = CreateFileMappingFromApp(file, NULL, PAGE_READONLY, 0, NULL);
+        map = CreateFileMappingFromApp(file, NULL, PAGE_READONLY, fileSize.QuadPart, NULL);
 #endif
         CloseHandle(file);
         if(map==NULL) {
@@ -176,6 +184,7 @@
             return FALSE;
         }
         pData->map=map;
+        pData->length=(int32_t)fileSize.QuadPart;
         return TRUE;
     }
 
@@ -201,18 +210,19 @@
 
         UDataMemory_init(pData); /* Clear the output struct.        */
 
-        /* determine the length of the file */
-        if(stat(path, &mystat)!=0 || mystat.st_size<=0) {
-            return FALSE;
-        }
-        length=mystat.st_size;
-
         /* open the file */
         fd=open(path, O_RDONLY);
         if(fd==-1) {
             return FALSE;
         }
 
+        /* determine the length of the file that was opened, not of whatever the path names now */
+        if(fstat(fd, &mystat)!=0 || mystat.st_size<=0 || mystat.st_size>INT32_MAX) {
+            close(fd);
+            return FALSE;
+        }
+        length=(int)mystat.st_size;
+
         /* get a view of the mapping */
 #if U_PLATFORM != U_PF_HPUX
         data=mmap(0, length, PROT_READ, MAP_SHARED,  fd, 0);
@@ -227,6 +237,7 @@
         pData->map = (char *)data + length;
         pData->pHeader=(const DataHeader *)data;
         pData->mapAddr = data;
+        pData->length = length;
 #if U_PLATFORM == U_PF_IPHONE
         posix_madvise(data, length, POSIX_MADV_RANDOM);
 #endif
@@ -300,6 +311,7 @@
         pData->map=p;
         pData->pHeader=(const DataHeader *)p;
         pData->mapAddr=p;
+        pData->length=fileLength;
         return TRUE;
     }
 
@@ -29,6 +29,10 @@
 #include "unicode/udata.h"
 #include "putilimp.h"
 
+/*
+ * Map a file into memory. Where the implementation knows the size of what it
+ * mapped, pdm->length is set to it; otherwise it is left at -1.
+ */
 U_CFUNC UBool uprv_mapFile(UDataMemory *pdm, const char *path);
 U_CFUNC void  uprv_unmapFile(UDataMemory *pData);
 
@@ -29,6 +29,7 @@
 #include "unicode/udata.h"
 #include "unicode/parseerr.h"
 #include "unicode/schriter.h"
+#include "unicode/uscript.h"
 
 U_NAMESPACE_BEGIN
 
@@ -38,6 +39,7 @@ struct RBBIDataHeader;
 class  RBBIDataWrapper;
 class  UnhandledEngine;
 class  UStack;
+class  SharedBreakEngine;
 
 /**
  *
@@ -112,6 +114,30 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
      */
     UnhandledEngine     *fUnhandledBreakEngine;
 
+    /**
+     *
+     * If present, UStack of the SharedBreakEngine objects built from user-registered
+     * dictionaries that this iterator is using. Each holds a reference, keeping the
+     * engine alive while it is in fLanguageBreakEngines, even if its dictionary is
+     * replaced or unregistered meanwhile.
+     * @internal
+     */
+    UStack              *fSharedBreakEngines;
+
+    /**
+     * The user dictionary generation for which fLanguageBreakEngines was built.
+     * When the set of registered dictionaries changes, the cached engines are discarded.
+     * @internal
+     */
+    int32_t             fUserDictionaryGeneration;
+
+    /**
+     * TRUE if dictionary break engines divide up runs with a best-path search.
+     * See setDictionaryBestPath().
+     * @internal
+     */
+    UBool               fDictionaryBestPath;
+
     /**
      * Counter for the number of characters encountered with the "dictionary"
      *   flag set.
@@ -613,6 +639,150 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
      */
     virtual RuleBasedBreakIterator &refreshInputText(UText *input, UErrorCode &status);
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Divide the text into partitions that can be broken independently of each other,
+     * for example by clones of this break iterator running concurrently in separate threads.
+     *
+     * Partitions begin immediately following a hard break character: a mandatory line break
+     * (CR, LF, CR LF, VT, FF, NEL, LINE SEPARATOR) or a PARAGRAPH SEPARATOR. Each candidate
+     * position is verified against the break rules, by backing up to a safe position with the
+     * reverse rules and iterating forward again; only positions that are confirmed to be
+     * boundaries are used. Candidates that fail the check are skipped, so the function works
+     * with any set of break rules, though rules that do not break after hard break characters
+     * will yield a single partition.
+     *
+     * The first partition always begins at zero. Partition i extends from partitionStarts[i]
+     * up to partitionStarts[i+1], or to the end of the text for the last partition.
+     * Concatenating the results of getBoundaries() for each partition produces the same
+     * boundaries as iterating over the entire text with next().
+     *
+     * As a side effect, the iteration position is reset to the start of the text.
+     *
+     * @param minPartitionLength  The minimum length of a partition, in native units of the text.
+     *                            All partitions except the last are at least this long.
+     *                            Must be greater than zero.
+     * @param partitionStarts     An array to receive the start positions of the partitions.
+     *                            May be NULL if capacity is zero.
+     * @param capacity            The length of the partitionStarts array.
+     * @param status              Receives error codes. U_BUFFER_OVERFLOW_ERROR is set if
+     *                            the array is too small to hold all of the partitions.
+     * @return                    The number of partitions. In the event of a U_BUFFER_OVERFLOW_ERROR,
+     *                            the total number of partitions, not the number actually stored.
+     * @see getBoundaries
+     * @draft ICU 63
+     */
+    int32_t getPartitions(int32_t minPartitionLength, int32_t *partitionStarts,
+                          int32_t capacity, UErrorCode &status);
+
+    /**
+     * Get the boundaries following position start, up to and including position limit.
+     * The results are the same as the values returned by following(start) followed
+     * by repeated calls to next(), stopping at the first value beyond limit or at DONE.
+     *
+     * When start is a partition start from getPartitions(), a clone of this break iterator
+     * may be used to find the boundaries of the partition, independently of the rest of the text.
+     *
+     * As a side effect, the iteration position is left at the first boundary following limit,
+     * or at the end of the text.
+     *
+     * @param start       The position following which boundaries are collected.
+     * @param limit       The last position that may be included in the results.
+     * @param boundaries  An array to receive the boundary positions, in ascending order.
+     *                    May be NULL if capacity is zero.
+     * @param capacity    The length of the boundaries array.
+     * @param status      Receives error codes. U_BUFFER_OVERFLOW_ERROR is set if
+     *                    the array is too small to hold all of the boundaries.
+     * @return            The number of boundaries. In the event of a U_BUFFER_OVERFLOW_ERROR,
+     *                    the total number of boundaries, not the number actually stored.
+     * @see getPartitions
+     * @draft ICU 63
+     */
+    int32_t getBoundaries(int32_t start, int32_t limit, int32_t *boundaries,
+                          int32_t capacity, UErrorCode &status);
+
+    /**
+     * Register a dictionary for the dictionary-based break engine of a script, replacing
+     * the ICU dictionary for that script in all break iterators.
+     *
+     * The file must be in the format produced by the gendict tool, built with the same
+     * options as the ICU dictionary that it replaces (for example, with values for
+     * Chinese and Japanese). It is memory-mapped, not copied, and is shared by all break
+     * iterators; it remains mapped until it is no longer registered and no break iterator
+     * is using it. A file that is in use must therefore never be modified, truncated or
+     * overwritten in place, which can crash the process: write the new version to a
+     * different file, then rename it over the old path or register it instead.
+     * Only the file header is checked; the dictionary contents are trusted.
+     *
+     * Registering a dictionary for a script that already has one replaces it. This can be
+     * done while other threads are using break iterators: each break iterator picks up
+     * the new dictionary the next time it needs one, and keeps the old dictionary valid
+     * until then.
+     *
+     * Han, Hiragana and Katakana share a single dictionary; registering for any of
+     * them replaces the Chinese and Japanese dictionary.
+     *
+     * @param script  The script whose dictionary is replaced: USCRIPT_THAI, USCRIPT_LAO,
+     *                USCRIPT_MYANMAR, USCRIPT_KHMER, USCRIPT_HANGUL, USCRIPT_HAN,
+     *                USCRIPT_HIRAGANA or USCRIPT_KATAKANA.
+     * @param path    The path of the dictionary file.
+     * @param status  Receives error codes. U_ILLEGAL_ARGUMENT_ERROR is set for a script
+     *                without a dictionary-based break engine, U_FILE_ACCESS_ERROR if the
+     *                file cannot be mapped, and U_INVALID_FORMAT_ERROR if it is not a
+     *                dictionary.
+     * @see unregisterDictionary
+     * @draft ICU 63
+     */
+    static void U_EXPORT2 registerDictionary(UScriptCode script, const char *path,
+                                             UErrorCode &status);
+
+    /**
+     * Unregister the dictionary registered for a script with registerDictionary(),
+     * restoring the ICU dictionary for that script.
+     *
+     * @param script  The script whose dictionary is unregistered.
+     * @param status  Receives error codes.
+     * @return        TRUE if a dictionary was registered for the script.
+     * @see registerDictionary
+     * @draft ICU 63
+     */
+    static UBool U_EXPORT2 unregisterDictionary(UScriptCode script, UErrorCode &status);
+
+    /**
+     * Set whether runs of Thai, Lao, Khmer and Burmese text are divided into words by a
+     * best-path search, instead of by the default heuristic.
+     *
+     * The default heuristic takes the longest dictionary word that can be followed by
+     * up to two more dictionary words, then resynchronizes after text that is not in the
+     * dictionary. The best-path search looks at every dictionary word at every position of
+     * a run, and picks the segmentation that leaves the fewest characters outside of
+     * dictionary words, and then has the fewest words. It can find a different
+     * segmentation than the default; the default is kept so that existing results do
+     * not change. Chinese, Japanese and Korean text is always divided by a best-path
+     * search, and is not affected.
+     *
+     * The best-path search is slower: dividing up dictionary text takes about 2.5 to 3.5
+     * times as long as with the default heuristic.
+     *
+     * Changing the setting moves the iterator to the start of the text, as setText() does.
+     * The setting is copied with the break iterator.
+     *
+     * @param bestPath  TRUE to use the best-path search, FALSE for the default heuristic.
+     * @see getDictionaryBestPath
+     * @draft ICU 63
+     */
+    void setDictionaryBestPath(UBool bestPath);
+
+    /**
+     * Get whether runs of Thai, Lao, Khmer and Burmese text are divided into words by
+     * a best-path search.
+     *
+     * @return  TRUE if the best-path search is used.
+     * @see setDictionaryBestPath
+     * @draft ICU 63
+     */
+    UBool getDictionaryBestPath() const;
+#endif  /* U_HIDE_DRAFT_API */
 
 private:
     //=======================================================================
@@ -656,6 +826,50 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
      */
     int32_t handleNext();
 
+    /**
+     * Check whether a position is a rule-based boundary, independent of the cache.
+     * Backs up to a safe position with handleSafePrevious(), then runs the
+     * forward rules to the position.
+     * Leaves fPosition and the text index at an arbitrary position; the caller
+     * must reset the iterator afterwards.
+     *
+     * @param position the position to check. Must be greater than zero.
+     * @internal (private)
+     */
+    UBool isRuleBoundary(int32_t position);
+
+    /**
+     * Create the break cache, and the dictionary cache that it relies on, if they
+     * do not exist yet. The caches are created on first use: forward iteration
+     * with first() and next() does not need the break cache, and needs the
+     * dictionary cache only for text containing dictionary characters.
+     * A new break cache starts out holding the current position, which must be a boundary.
+     *
+     * @param status receives errors.
+     * @return TRUE if the caches are available.
+     * @internal (private)
+     */
+    UBool ensureBreakCache(UErrorCode &status);
+
+    /**
+     * Create the dictionary cache, if it does not exist yet.
+     *
+     * @param status receives errors.
+     * @return TRUE if the cache is available.
+     * @internal (private)
+     */
+    UBool ensureDictionaryCache(UErrorCode &status);
+
+    /**
+     * Implementation of next() for an iterator that has no break cache.
+     * Runs the rules directly from the current position, subdividing
+     * dictionary ranges through the dictionary cache.
+     *
+     * @return The next boundary, or UBRK_DONE at the end of the text.
+     * @internal (private)
+     */
+    int32_t nextWithoutCache();
+
 
     /**
      * This function returns the appropriate LanguageBreakEngine for a
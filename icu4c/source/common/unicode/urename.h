@@ -1166,6 +1166,8 @@
 #define unum_parseDecimal U_ICU_ENTRY_POINT_RENAME(unum_parseDecimal)
 #define unum_parseDouble U_ICU_ENTRY_POINT_RENAME(unum_parseDouble)
 #define unum_parseDoubleCurrency U_ICU_ENTRY_POINT_RENAME(unum_parseDoubleCurrency)
+#define unum_parseDoubles U_ICU_ENTRY_POINT_RENAME(unum_parseDoubles)
+#define unum_parseDoublesUTF8 U_ICU_ENTRY_POINT_RENAME(unum_parseDoublesUTF8)
 #define unum_parseInt64 U_ICU_ENTRY_POINT_RENAME(unum_parseInt64)
 #define unum_parseToUFormattable U_ICU_ENTRY_POINT_RENAME(unum_parseToUFormattable)
 #define unum_setAttribute U_ICU_ENTRY_POINT_RENAME(unum_setAttribute)
@@ -1178,7 +1180,11 @@
 #define unumf_closeResult U_ICU_ENTRY_POINT_RENAME(unumf_closeResult)
 #define unumf_formatDecimal U_ICU_ENTRY_POINT_RENAME(unumf_formatDecimal)
 #define unumf_formatDouble U_ICU_ENTRY_POINT_RENAME(unumf_formatDouble)
+#define unumf_formatDoubleToBuffer U_ICU_ENTRY_POINT_RENAME(unumf_formatDoubleToBuffer)
+#define unumf_formatDoubleToUTF8 U_ICU_ENTRY_POINT_RENAME(unumf_formatDoubleToUTF8)
 #define unumf_formatInt U_ICU_ENTRY_POINT_RENAME(unumf_formatInt)
+#define unumf_formatIntToBuffer U_ICU_ENTRY_POINT_RENAME(unumf_formatIntToBuffer)
+#define unumf_formatIntToUTF8 U_ICU_ENTRY_POINT_RENAME(unumf_formatIntToUTF8)
 #define unumf_openForSkeletonAndLocale U_ICU_ENTRY_POINT_RENAME(unumf_openForSkeletonAndLocale)
 #define unumf_openResult U_ICU_ENTRY_POINT_RENAME(unumf_openResult)
 #define unumf_resultGetAllFieldPositions U_ICU_ENTRY_POINT_RENAME(unumf_resultGetAllFieldPositions)
@@ -1397,6 +1403,7 @@
 #define uregex_appendTail U_ICU_ENTRY_POINT_RENAME(uregex_appendTail)
 #define uregex_appendTailUText U_ICU_ENTRY_POINT_RENAME(uregex_appendTailUText)
 #define uregex_clone U_ICU_ENTRY_POINT_RENAME(uregex_clone)
+#define uregex_cloneBinary U_ICU_ENTRY_POINT_RENAME(uregex_cloneBinary)
 #define uregex_close U_ICU_ENTRY_POINT_RENAME(uregex_close)
 #define uregex_end U_ICU_ENTRY_POINT_RENAME(uregex_end)
 #define uregex_end64 U_ICU_ENTRY_POINT_RENAME(uregex_end64)
@@ -1406,6 +1413,7 @@
 #define uregex_flags U_ICU_ENTRY_POINT_RENAME(uregex_flags)
 #define uregex_getFindProgressCallback U_ICU_ENTRY_POINT_RENAME(uregex_getFindProgressCallback)
 #define uregex_getMatchCallback U_ICU_ENTRY_POINT_RENAME(uregex_getMatchCallback)
+#define uregex_getMemoizeBacktracking U_ICU_ENTRY_POINT_RENAME(uregex_getMemoizeBacktracking)
 #define uregex_getStackLimit U_ICU_ENTRY_POINT_RENAME(uregex_getStackLimit)
 #define uregex_getText U_ICU_ENTRY_POINT_RENAME(uregex_getText)
 #define uregex_getTimeLimit U_ICU_ENTRY_POINT_RENAME(uregex_getTimeLimit)
@@ -1423,6 +1431,7 @@
 #define uregex_matches U_ICU_ENTRY_POINT_RENAME(uregex_matches)
 #define uregex_matches64 U_ICU_ENTRY_POINT_RENAME(uregex_matches64)
 #define uregex_open U_ICU_ENTRY_POINT_RENAME(uregex_open)
+#define uregex_openBinary U_ICU_ENTRY_POINT_RENAME(uregex_openBinary)
 #define uregex_openC U_ICU_ENTRY_POINT_RENAME(uregex_openC)
 #define uregex_openUText U_ICU_ENTRY_POINT_RENAME(uregex_openUText)
 #define uregex_pattern U_ICU_ENTRY_POINT_RENAME(uregex_pattern)
@@ -1441,6 +1450,7 @@
 #define uregex_reset64 U_ICU_ENTRY_POINT_RENAME(uregex_reset64)
 #define uregex_setFindProgressCallback U_ICU_ENTRY_POINT_RENAME(uregex_setFindProgressCallback)
 #define uregex_setMatchCallback U_ICU_ENTRY_POINT_RENAME(uregex_setMatchCallback)
+#define uregex_setMemoizeBacktracking U_ICU_ENTRY_POINT_RENAME(uregex_setMemoizeBacktracking)
 #define uregex_setRegion U_ICU_ENTRY_POINT_RENAME(uregex_setRegion)
 #define uregex_setRegion64 U_ICU_ENTRY_POINT_RENAME(uregex_setRegion64)
 #define uregex_setRegionAndStart U_ICU_ENTRY_POINT_RENAME(uregex_setRegionAndStart)
@@ -1688,6 +1698,7 @@
 #define utext_freeze U_ICU_ENTRY_POINT_RENAME(utext_freeze)
 #define utext_getNativeIndex U_ICU_ENTRY_POINT_RENAME(utext_getNativeIndex)
 #define utext_getPreviousNativeIndex U_ICU_ENTRY_POINT_RENAME(utext_getPreviousNativeIndex)
+#define utext_getUTF8Source U_ICU_ENTRY_POINT_RENAME(utext_getUTF8Source)
 #define utext_hasMetaData U_ICU_ENTRY_POINT_RENAME(utext_hasMetaData)
 #define utext_isLengthExpensive U_ICU_ENTRY_POINT_RENAME(utext_isLengthExpensive)
 #define utext_isWritable U_ICU_ENTRY_POINT_RENAME(utext_isWritable)
@@ -226,6 +226,22 @@ U_NAMESPACE_END
 U_STABLE UText * U_EXPORT2
 utext_openUTF8(UText *ut, const char *s, int64_t length, UErrorCode *status);
 
+#ifndef U_HIDE_INTERNAL_API
+/**
+ * Get the UTF-8 string that a UText opened with utext_openUTF8() reads from.
+ * Lets performance-critical code read the bytes directly, with native indexes
+ * that are byte offsets into the returned string.
+ *
+ * @param ut      the UText.
+ * @param pLength receives the length of the UTF-8 string in bytes, if the
+ *                UText reads from one. Can be NULL.
+ * @return the UTF-8 string, or NULL if the UText does not come from utext_openUTF8().
+ * @internal
+ */
+U_INTERNAL const char * U_EXPORT2
+utext_getUTF8Source(UText *ut, int64_t *pLength);
+#endif  /* U_HIDE_INTERNAL_API */
+
 
 /**
  * Open a read-only UText for UChar * string.
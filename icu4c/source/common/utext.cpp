@@ -1658,6 +1658,17 @@ utext_openUTF8(UText *ut, const char *s, int64_t length, UErrorCode *status) {
 
 }
 
+U_CAPI const char * U_EXPORT2
+utext_getUTF8Source(UText *ut, int64_t *pLength) {
+    if (ut == NULL || ut->pFuncs != &utf8Funcs) {
+        return NULL;
+    }
+    if (pLength != NULL) {
+        *pLength = utext_nativeLength(ut);
+    }
+    return (const char *)ut->context;
+}
+
 
 
 
@@ -15,6 +15,7 @@
 #include "gregoimp.h"
 #include "uvector.h"
 #include "cmemory.h"
+#include <float.h> // DBL_MAX
 
 U_NAMESPACE_BEGIN
 
@@ -546,6 +547,167 @@ BasicTimeZone::getTimeZoneRulesAfter(UDate start, InitialTimeZoneRule*& initial,
     transitionRules = NULL;
 }
 
+// Looking up the transitions around a date costs a few offset lookups, so
+// getOffsets() does it only when the next date is after this one and at most this far.
+const double BasicTimeZone::kOffsetRunLookahead = 7.0 * U_MILLIS_PER_DAY;
+
+/**
+ * Gets the range [start, limit) of dates around the given date that have the given
+ * offsets, away from any ambiguity at a transition, or an empty range.
+ */
+static void
+getOffsetRun(const BasicTimeZone& tz, UDate date, UBool local, int32_t rawOffset, int32_t dstOffset,
+             UDate& start, UDate& limit) {
+    int32_t offset = rawOffset + dstOffset;
+    UDate utc = local ? date - offset : date;
+    TimeZoneTransition prev, next;
+    start = -DBL_MAX;
+    limit = DBL_MAX;
+    if (tz.getPreviousTransition(utc, TRUE, prev)) {
+        const TimeZoneRule *to = prev.getTo();
+        if (to->getRawOffset() != rawOffset || to->getDSTSavings() != dstOffset) {
+            start = limit = 0.0;
+            return;
+        }
+        start = prev.getTime();
+        if (local) {
+            const TimeZoneRule *from = prev.getFrom();
+            start += uprv_max(offset, from->getRawOffset() + from->getDSTSavings());
+        }
+    }
+    if (tz.getNextTransition(utc, FALSE, next)) {
+        limit = next.getTime();
+        if (local) {
+            const TimeZoneRule *to = next.getTo();
+            limit += uprv_min(offset, to->getRawOffset() + to->getDSTSavings());
+        }
+    }
+    if (!(date >= start && date < limit)) {
+        start = limit = 0.0;
+    }
+}
+
+void
+BasicTimeZone::getOffsets(const UDate* dates, int32_t count, UBool local,
+                          int32_t* rawOffsets, int32_t* dstOffsets, UErrorCode& status) const {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (count < 0 || (count > 0 && (dates == NULL || rawOffsets == NULL || dstOffsets == NULL))) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    int32_t i = 0;
+    while (i < count) {
+        UDate date = dates[i];
+        int32_t rawOffset, dstOffset;
+        getOffset(date, local, rawOffset, dstOffset, status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        rawOffsets[i] = rawOffset;
+        dstOffsets[i] = dstOffset;
+        i++;
+        if (i < count && dates[i] >= date && dates[i] - date <= kOffsetRunLookahead) {
+            // Following dates between the same transitions have the same offsets
+            UDate start, limit;
+            getOffsetRun(*this, date, local, rawOffset, dstOffset, start, limit);
+            for (; i < count && dates[i] >= start && dates[i] < limit; i++) {
+                rawOffsets[i] = rawOffset;
+                dstOffsets[i] = dstOffset;
+            }
+        }
+    }
+}
+
+// getLocalFields() and getDatesFromLocalFields() look up offsets for this many dates at a time.
+static const int32_t kLocalFieldsChunk = 128;
+// The year range of getDatesFromLocalFields(), within that of MIN_MILLIS..MAX_MILLIS.
+static const int32_t kMaxLocalFieldsYear = 5000000;
+
+void
+BasicTimeZone::getLocalFields(const UDate* dates, int32_t count,
+                              int32_t* years, int32_t* months, int32_t* daysOfMonth, int32_t* millisInDay,
+                              UErrorCode& status) const {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (count < 0 || (count > 0 && dates == NULL)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    int32_t rawOffsets[kLocalFieldsChunk];
+    int32_t dstOffsets[kLocalFieldsChunk];
+    for (int32_t start = 0; start < count; start += kLocalFieldsChunk) {
+        int32_t length = uprv_min(count - start, kLocalFieldsChunk);
+        const UDate* chunk = dates + start;
+        for (int32_t i = 0; i < length; i++) {
+            if (!(chunk[i] >= MIN_MILLIS && chunk[i] <= MAX_MILLIS)) {
+                status = U_ILLEGAL_ARGUMENT_ERROR;
+                return;
+            }
+        }
+        getOffsets(chunk, length, FALSE, rawOffsets, dstOffsets, status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        for (int32_t i = 0; i < length; i++) {
+            double localMillis = chunk[i] + (rawOffsets[i] + dstOffsets[i]);
+            int32_t days = (int32_t)ClockMath::floorDivide(localMillis, (double)kOneDay);
+            int32_t year, month, dom, dow, doy;
+            GregorianCivilTime::dayToFields(days, year, month, dom, dow, doy);
+            int32_t j = start + i;
+            if (years != NULL) { years[j] = year; }
+            if (months != NULL) { months[j] = month; }
+            if (daysOfMonth != NULL) { daysOfMonth[j] = dom; }
+            if (millisInDay != NULL) { millisInDay[j] = (int32_t)(localMillis - days * kOneDay); }
+        }
+    }
+}
+
+void
+BasicTimeZone::getDatesFromLocalFields(const int32_t* years, const int32_t* months,
+                                       const int32_t* daysOfMonth, const int32_t* millisInDay, int32_t count,
+                                       UDate* dates, UErrorCode& status) const {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (count < 0 || (count > 0 && (years == NULL || months == NULL || daysOfMonth == NULL ||
+                                    millisInDay == NULL || dates == NULL))) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    int32_t rawOffsets[kLocalFieldsChunk];
+    int32_t dstOffsets[kLocalFieldsChunk];
+    for (int32_t start = 0; start < count; start += kLocalFieldsChunk) {
+        int32_t length = uprv_min(count - start, kLocalFieldsChunk);
+        UDate* chunk = dates + start;
+        for (int32_t i = 0; i < length; i++) {
+            int32_t j = start + i;
+            if (years[j] < -kMaxLocalFieldsYear || years[j] > kMaxLocalFieldsYear ||
+                    months[j] < UCAL_JANUARY || months[j] > UCAL_DECEMBER) {
+                status = U_ILLEGAL_ARGUMENT_ERROR;
+                return;
+            }
+            // The day of the month is added separately, so that large values do not overflow.
+            double day = Grego::fieldsToDay(years[j], months[j], 1) + ((double)daysOfMonth[j] - 1);
+            UDate localMillis = day * kOneDay + millisInDay[j];
+            if (!(localMillis >= MIN_MILLIS && localMillis <= MAX_MILLIS)) {
+                status = U_ILLEGAL_ARGUMENT_ERROR;
+                return;
+            }
+            chunk[i] = localMillis;
+        }
+        getOffsets(chunk, length, TRUE, rawOffsets, dstOffsets, status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        for (int32_t i = 0; i < length; i++) {
+            chunk[i] -= rawOffsets[i] + dstOffsets[i];
+        }
+    }
+}
+
 void
 BasicTimeZone::getOffsetFromLocal(UDate /*date*/, int32_t /*nonExistingTimeOpt*/, int32_t /*duplicatedTimeOpt*/,
                             int32_t& /*rawOffset*/, int32_t& /*dstOffset*/, UErrorCode& status) const {
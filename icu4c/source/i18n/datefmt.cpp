@@ -19,6 +19,8 @@
  ********************************************************************************
  */
 
+#include "utypeinfo.h"  // for 'typeid' to work
+
 #include "unicode/utypes.h"
 
 #if !UCONFIG_NO_FORMATTING
@@ -34,6 +36,7 @@
 #include "uarrsort.h"
 
 #include "cstring.h"
+#include "fphdlimp.h"
 #include "windtfmt.h"
 
 #if defined( U_DEBUG_CALSVC ) || defined (U_DEBUG_CAL)
@@ -279,6 +282,14 @@ DateFormat::format(Calendar& /* unused cal */,
 
 UnicodeString&
 DateFormat::format(UDate date, UnicodeString& appendTo, FieldPosition& fieldPosition) const {
+    if (typeid(*this) == typeid(SimpleDateFormat)) {
+        // Format without a Calendar clone, if possible
+        FieldPositionOnlyHandler handler(fieldPosition);
+        UErrorCode ec = U_ZERO_ERROR;
+        if (static_cast<const SimpleDateFormat*>(this)->formatDate(date, appendTo, handler, ec)) {
+            return appendTo;
+        }
+    }
     if (fCalendar != NULL) {
         // Use a clone of our calendar instance
         Calendar* calClone = fCalendar->clone();
@@ -299,6 +310,12 @@ DateFormat::format(UDate date, UnicodeString& appendTo, FieldPosition& fieldPosi
 UnicodeString&
 DateFormat::format(UDate date, UnicodeString& appendTo, FieldPositionIterator* posIter,
                    UErrorCode& status) const {
+    if (U_SUCCESS(status) && typeid(*this) == typeid(SimpleDateFormat)) {
+        FieldPositionIteratorHandler handler(posIter, status);
+        if (static_cast<const SimpleDateFormat*>(this)->formatDate(date, appendTo, handler, status)) {
+            return appendTo;
+        }
+    }
     if (fCalendar != NULL) {
         Calendar* calClone = fCalendar->clone();
         if (calClone != NULL) {
@@ -330,6 +347,11 @@ DateFormat::parse(const UnicodeString& text,
                   ParsePosition& pos) const
 {
     UDate d = 0; // Error return UDate is 0 (the epoch)
+    if (typeid(*this) == typeid(SimpleDateFormat) &&
+            static_cast<const SimpleDateFormat*>(this)->parseNumeric(text, pos, d)) {
+        // Parsed digits without a Calendar clone
+        return d;
+    }
     if (fCalendar != NULL) {
         Calendar* calClone = fCalendar->clone();
         if (calClone != NULL) {
@@ -14,12 +14,16 @@
 #include <stdlib.h>
 #include "unicode/errorcode.h"
 #include "unicode/decimfmt.h"
+#include "unicode/ustring.h"
+#include "unicode/utf8.h"
+#include "unicode/utf16.h"
 #include "number_decimalquantity.h"
 #include "number_types.h"
 #include "numparse_impl.h"
 #include "number_mapper.h"
 #include "number_patternstring.h"
 #include "putilimp.h"
+#include "cstring.h"
 #include "number_utils.h"
 #include "number_utypes.h"
 
@@ -592,6 +596,147 @@ CurrencyAmount* DecimalFormat::parseCurrency(const UnicodeString& text, ParsePos
     }
 }
 
+namespace {
+
+/** Parses one cell of a batch into the reused ParsedNumber; returns whether the cell parsed. */
+bool parseBatchCell(const NumberParserImpl& parser, const UnicodeString& text, ParsedNumber& result,
+                    int32_t& parseEnd, UErrorCode& status) {
+    result.clear();
+    if (!text.isEmpty()) {
+        parser.parse(text, 0, true, result, status);
+    }
+    parseEnd = result.charEnd;
+    return U_SUCCESS(status) && result.success();
+}
+
+/** Same value as populateFormattable() followed by Formattable::getDouble(). */
+double getBatchDouble(const ParsedNumber& result, parse_flags_t parseFlags) {
+    double value = result.getDouble();
+    if (value == 0 && 0 != (parseFlags & PARSE_FLAG_INTEGER_ONLY)) {
+        // populateFormattable() does not keep -0.0 in integer-only mode
+        value = 0.0;
+    }
+    return value;
+}
+
+void setBatchCellStatus(int32_t i, bool success, int32_t parseEnd, int32_t parseEnds[],
+                        UErrorCode cellStatus[]) {
+    if (parseEnds != nullptr) {
+        parseEnds[i] = parseEnd;
+    }
+    if (cellStatus != nullptr) {
+        cellStatus[i] = success ? U_ZERO_ERROR : U_PARSE_ERROR;
+    }
+}
+
+} // namespace
+
+int32_t DecimalFormat::parseDoubles(const char16_t* const texts[], const int32_t textLengths[],
+                                    int32_t count, double results[], int32_t parseEnds[],
+                                    UErrorCode cellStatus[], UErrorCode& status) const {
+    if (U_FAILURE(status)) { return 0; }
+    if (count < 0 || (count > 0 && (texts == nullptr || results == nullptr))) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const NumberParserImpl* parser = getParser(status);
+    if (U_FAILURE(status)) { return 0; }
+    parse_flags_t parseFlags = parser->getParseFlags();
+    ParsedNumber result;
+    UnicodeString text;
+    int32_t successCount = 0;
+    for (int32_t i = 0; i < count; i++) {
+        int32_t length = textLengths == nullptr ? -1 : textLengths[i];
+        // Read-only alias of the caller's string
+        text.setTo(length == -1, ConstChar16Ptr(texts[i]), length);
+        int32_t parseEnd;
+        bool success = parseBatchCell(*parser, text, result, parseEnd, status);
+        if (U_FAILURE(status)) { return successCount; }
+        results[i] = success ? getBatchDouble(result, parseFlags) : 0.0;
+        setBatchCellStatus(i, success, parseEnd, parseEnds, cellStatus);
+        successCount += success;
+    }
+    return successCount;
+}
+
+int32_t DecimalFormat::parseDoublesUTF8(const char* const texts[], const int32_t textLengths[],
+                                        int32_t count, double results[], int32_t parseEnds[],
+                                        UErrorCode cellStatus[], UErrorCode& status) const {
+    if (U_FAILURE(status)) { return 0; }
+    if (count < 0 || (count > 0 && (texts == nullptr || results == nullptr))) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const NumberParserImpl* parser = getParser(status);
+    if (U_FAILURE(status)) { return 0; }
+    parse_flags_t parseFlags = parser->getParseFlags();
+    ParsedNumber result;
+    UnicodeString text;
+    int32_t successCount = 0;
+    for (int32_t i = 0; i < count; i++) {
+        const char* s = texts[i];
+        int32_t length = textLengths == nullptr ? -1 : textLengths[i];
+        if (s == nullptr) {
+            length = 0;
+        } else if (length < 0) {
+            length = static_cast<int32_t>(uprv_strlen(s));
+        }
+        // Convert into the reused scratch string; a UTF-8 string never has more
+        // UTF-16 code units than bytes.
+        int32_t textLength = 0;
+        char16_t* buffer = text.getBuffer(length);
+        if (buffer == nullptr) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return successCount;
+        }
+        u_strFromUTF8WithSub(buffer, text.getCapacity(), &textLength, s, length, 0xfffd, nullptr, &status);
+        text.releaseBuffer(U_SUCCESS(status) ? textLength : 0);
+        int32_t parseEnd;
+        bool success = parseBatchCell(*parser, text, result, parseEnd, status);
+        if (U_FAILURE(status)) { return successCount; }
+        // Map the UTF-16 parse end back to a byte offset. Each maximal ill-formed
+        // subsequence became one U+FFFD, which is what U8_NEXT skips as well.
+        int32_t byteEnd = 0;
+        for (int32_t unitEnd = 0; unitEnd < parseEnd && byteEnd < length;) {
+            UChar32 c;
+            U8_NEXT(s, byteEnd, length, c);
+            unitEnd += c < 0 ? 1 : U16_LENGTH(c);
+        }
+        results[i] = success ? getBatchDouble(result, parseFlags) : 0.0;
+        setBatchCellStatus(i, success, byteEnd, parseEnds, cellStatus);
+        successCount += success;
+    }
+    return successCount;
+}
+
+int32_t DecimalFormat::parseNumbers(const UnicodeString texts[], int32_t count, Formattable results[],
+                                    int32_t parseEnds[], UErrorCode cellStatus[],
+                                    UErrorCode& status) const {
+    if (U_FAILURE(status)) { return 0; }
+    if (count < 0 || (count > 0 && (texts == nullptr || results == nullptr))) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const NumberParserImpl* parser = getParser(status);
+    if (U_FAILURE(status)) { return 0; }
+    parse_flags_t parseFlags = parser->getParseFlags();
+    ParsedNumber result;
+    int32_t successCount = 0;
+    for (int32_t i = 0; i < count; i++) {
+        int32_t parseEnd;
+        bool success = parseBatchCell(*parser, texts[i], result, parseEnd, status);
+        if (U_FAILURE(status)) { return successCount; }
+        if (success) {
+            result.populateFormattable(results[i], parseFlags);
+        } else {
+            results[i].setLong(0);
+        }
+        setBatchCellStatus(i, success, parseEnd, parseEnds, cellStatus);
+        successCount += success;
+    }
+    return successCount;
+}
+
 const DecimalFormatSymbols* DecimalFormat::getDecimalFormatSymbols(void) const {
     return fields->symbols.getAlias();
 }
@@ -16,6 +16,7 @@
 #if !UCONFIG_NO_FORMATTING
 
 #include "unicode/ucal.h"
+#include "unicode/gregocal.h"
 #include "uresimp.h"
 #include "cstring.h"
 #include "uassert.h"
@@ -142,6 +143,118 @@ void Grego::timeToFields(UDate time, int32_t& year, int32_t& month,
     dayToFields(day, year, month, dom, dow, doy);
 }
 
+void GregorianCivilTime::dayToFields(int32_t day, int32_t& year, int32_t& month,
+                                     int32_t& dom, int32_t& dow, int32_t& doy) {
+    // Count days from March 1 of year 0, so that the leap day is the last day
+    // of a year, in 400-year cycles of 146097 days.
+    // See Howard Hinnant, "chrono-Compatible Low-Level Date Algorithms".
+    int32_t z = day + 719468; // 1970-01-01 - 0000-03-01
+    int32_t cycle = ClockMath::floorDivide(z, (int32_t)146097);
+    int32_t dayOfCycle = z - cycle * 146097; // 0..146096
+    int32_t yearOfCycle = (dayOfCycle - dayOfCycle / 1460 + dayOfCycle / 36524 - dayOfCycle / 146096) / 365; // 0..399
+    int32_t dayOfMarchYear = dayOfCycle - (365 * yearOfCycle + yearOfCycle / 4 - yearOfCycle / 100); // 0..365
+    int32_t marchMonth = (5 * dayOfMarchYear + 2) / 153; // 0..11, 0==Mar
+    dom = dayOfMarchYear - (153 * marchMonth + 2) / 5 + 1;
+    year = cycle * 400 + yearOfCycle;
+    if (marchMonth < 10) {
+        month = marchMonth + 2;
+        doy = dayOfMarchYear + (Grego::isLeapYear(year) ? 61 : 60);
+    } else {
+        // January and February belong to the next year
+        ++year;
+        month = marchMonth - 10;
+        doy = dayOfMarchYear - 305;
+    }
+
+    // 1970-01-01 is a Thursday.
+    dow = (day + 4) % 7;
+    dow += (dow < 0) ? (UCAL_SUNDAY + 7) : UCAL_SUNDAY;
+}
+
+void GregorianCivilTime::set(UDate time, int32_t rawOffset, int32_t dstOffset,
+                             int32_t firstDayOfWeek, int32_t minimalDaysInFirstWeek) {
+    fTime = time;
+    fFirstDayOfWeek = firstDayOfWeek;
+    fMinimalDaysInFirstWeek = minimalDaysInFirstWeek;
+
+    // The same local day and milliseconds in day as Calendar::computeFields()
+    double localMillis = time + (rawOffset + dstOffset);
+    int32_t days = (int32_t)ClockMath::floorDivide(localMillis, (double)kOneDay);
+    int32_t millisInDay = (int32_t)(localMillis - (days * kOneDay));
+
+    int32_t eyear, month, dayOfMonth, dayOfWeek, dayOfYear;
+    dayToFields(days, eyear, month, dayOfMonth, dayOfWeek, dayOfYear);
+    fFields[UCAL_JULIAN_DAY] = days + kEpochStartAsJulianDay;
+    fFields[UCAL_EXTENDED_YEAR] = eyear;
+    fFields[UCAL_ERA] = (eyear < 1) ? GregorianCalendar::BC : GregorianCalendar::AD;
+    fFields[UCAL_YEAR] = (eyear < 1) ? 1 - eyear : eyear;
+    fFields[UCAL_MONTH] = month;
+    fFields[UCAL_IS_LEAP_MONTH] = 0;
+    fFields[UCAL_DAY_OF_MONTH] = dayOfMonth;
+    fFields[UCAL_DAY_OF_YEAR] = dayOfYear;
+    fFields[UCAL_DAY_OF_WEEK] = dayOfWeek;
+    int32_t dowLocal = dayOfWeek - firstDayOfWeek + 1;
+    fFields[UCAL_DOW_LOCAL] = (dowLocal < 1) ? dowLocal + 7 : dowLocal;
+
+    // Week fields as in Calendar::computeWeekFields()
+    int32_t yearOfWeekOfYear = eyear;
+    int32_t relDow = (dayOfWeek + 7 - firstDayOfWeek) % 7; // 0..6
+    int32_t relDowJan1 = (dayOfWeek - dayOfYear + 7001 - firstDayOfWeek) % 7; // 0..6
+    int32_t woy = (dayOfYear - 1 + relDowJan1) / 7; // 0..53
+    if ((7 - relDowJan1) >= minimalDaysInFirstWeek) {
+        ++woy;
+    }
+    if (woy == 0) {
+        // The last week of the previous year
+        int32_t prevDoy = dayOfYear + (Grego::isLeapYear(eyear - 1) ? 366 : 365);
+        woy = weekNumber(prevDoy, prevDoy, dayOfWeek);
+        yearOfWeekOfYear--;
+    } else {
+        int32_t lastDoy = Grego::isLeapYear(eyear) ? 366 : 365;
+        if (dayOfYear >= (lastDoy - 5)) {
+            int32_t lastRelDow = (relDow + lastDoy - dayOfYear) % 7;
+            if (lastRelDow < 0) {
+                lastRelDow += 7;
+            }
+            if (((6 - lastRelDow) >= minimalDaysInFirstWeek) &&
+                    ((dayOfYear + 7 - relDow) > lastDoy)) {
+                // The first week of the next year
+                woy = 1;
+                yearOfWeekOfYear++;
+            }
+        }
+    }
+    fFields[UCAL_WEEK_OF_YEAR] = woy;
+    fFields[UCAL_YEAR_WOY] = yearOfWeekOfYear;
+    fFields[UCAL_WEEK_OF_MONTH] = weekNumber(dayOfMonth, dayOfMonth, dayOfWeek);
+    fFields[UCAL_DAY_OF_WEEK_IN_MONTH] = (dayOfMonth - 1) / 7 + 1;
+
+    fFields[UCAL_MILLISECONDS_IN_DAY] = millisInDay;
+    fFields[UCAL_MILLISECOND] = millisInDay % 1000;
+    millisInDay /= 1000;
+    fFields[UCAL_SECOND] = millisInDay % 60;
+    millisInDay /= 60;
+    fFields[UCAL_MINUTE] = millisInDay % 60;
+    millisInDay /= 60;
+    fFields[UCAL_HOUR_OF_DAY] = millisInDay;
+    fFields[UCAL_AM_PM] = millisInDay / 12; // Assume AM == 0
+    fFields[UCAL_HOUR] = millisInDay % 12;
+    fFields[UCAL_ZONE_OFFSET] = rawOffset;
+    fFields[UCAL_DST_OFFSET] = dstOffset;
+}
+
+int32_t GregorianCivilTime::weekNumber(int32_t desiredDay, int32_t dayOfPeriod, int32_t dayOfWeek) const {
+    int32_t periodStartDayOfWeek = (dayOfWeek - fFirstDayOfWeek - dayOfPeriod + 1) % 7;
+    if (periodStartDayOfWeek < 0) {
+        periodStartDayOfWeek += 7;
+    }
+    int32_t weekNo = (desiredDay + periodStartDayOfWeek - 1) / 7;
+    if ((7 - periodStartDayOfWeek) >= fMinimalDaysInFirstWeek) {
+        ++weekNo;
+    }
+    return weekNo;
+}
+
 int32_t Grego::dayOfWeek(double day) {
     int32_t dow;
     ClockMath::floorDivide(day + UCAL_THURSDAY, 7, dow);
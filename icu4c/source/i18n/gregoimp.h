@@ -18,6 +18,7 @@
 
 #include "unicode/ures.h"
 #include "unicode/locid.h"
+#include "unicode/ucal.h"
 #include "putilimp.h"
 
 U_NAMESPACE_BEGIN
@@ -264,6 +265,63 @@ class Grego {
     static const int8_t MONTH_LENGTH[24];
 };
 
+/**
+ * The calendar fields of a point in time in the proleptic Gregorian calendar,
+ * as a value type that needs no Calendar or heap allocation. Days are converted
+ * to dates with integer arithmetic only.
+ *
+ * The fields are the same as those of a GregorianCalendar with the same zone
+ * offsets and week rules, for local dates in years after its Gregorian cutover
+ * year. Used by SimpleDateFormat to format such dates without cloning its Calendar.
+ */
+// Exported as U_I18N_API for tests
+class U_I18N_API GregorianCivilTime : public UMemory {
+ public:
+    /**
+     * Compute all fields, as Calendar::computeFields() would.
+     * @param time 1970-epoch milliseconds; must be in [MIN_MILLIS, MAX_MILLIS]
+     * @param rawOffset the raw zone offset at time
+     * @param dstOffset the DST offset at time
+     * @param firstDayOfWeek the first day of the week
+     * @param minimalDaysInFirstWeek the minimal days in the first week of a year or month
+     */
+    void set(UDate time, int32_t rawOffset, int32_t dstOffset,
+             int32_t firstDayOfWeek, int32_t minimalDaysInFirstWeek);
+
+    /**
+     * Return the value of a field; all fields are set.
+     */
+    inline int32_t get(UCalendarDateFields field) const;
+
+    /**
+     * Return the 1970-epoch milliseconds passed to set().
+     */
+    inline UDate getTime() const;
+
+    /**
+     * Convert a 1970-epoch day number to proleptic Gregorian year, month,
+     * day-of-month, day-of-week and day-of-year, like Grego::dayToFields(),
+     * using integer arithmetic only.
+     * @param day 1970-epoch day, in [MIN_JULIAN, MAX_JULIAN] - kEpochStartAsJulianDay
+     * @param year output parameter to receive year
+     * @param month output parameter to receive month (0-based, 0==Jan)
+     * @param dom output parameter to receive day-of-month (1-based)
+     * @param dow output parameter to receive day-of-week (1-based, 1==Sun)
+     * @param doy output parameter to receive day-of-year (1-based)
+     */
+    static void dayToFields(int32_t day, int32_t& year, int32_t& month,
+                            int32_t& dom, int32_t& dow, int32_t& doy);
+
+ private:
+    /** Same as Calendar::weekNumber(). */
+    int32_t weekNumber(int32_t desiredDay, int32_t dayOfPeriod, int32_t dayOfWeek) const;
+
+    UDate fTime;
+    int32_t fFirstDayOfWeek;
+    int32_t fMinimalDaysInFirstWeek;
+    int32_t fFields[UCAL_FIELD_COUNT];
+};
+
 inline double ClockMath::floorDivide(double numerator, double denominator) {
     return uprv_floor(numerator / denominator);
 }
@@ -298,6 +356,14 @@ inline int32_t Grego::millisToJulianDay(double millis) {
   return (int32_t) (kEpochStartAsJulianDay + ClockMath::floorDivide(millis, (double)kOneDay));
 }
 
+inline int32_t GregorianCivilTime::get(UCalendarDateFields field) const {
+  return fFields[field];
+}
+
+inline UDate GregorianCivilTime::getTime() const {
+  return fTime;
+}
+
 inline int32_t Grego::gregorianShift(int32_t eyear) {
   int32_t y = eyear-1;
   int32_t gregShift = ClockMath::floorDivide(y, 400) - ClockMath::floorDivide(y, 100) + 2;
@@ -12,6 +12,7 @@
 #include "fphdlimp.h"
 #include "number_utypes.h"
 #include "numparse_types.h"
+#include "unifiedcache.h"
 #include "unicode/numberformatter.h"
 #include "unicode/unumberformatter.h"
 
@@ -83,18 +84,91 @@ UFormattedNumber* UFormattedNumberData::exportForC() {
 /////////////////////////////////////
 
 
+SharedLocalizedNumberFormatter::~SharedLocalizedNumberFormatter() {}
+
+U_NAMESPACE_BEGIN
+
+template<> U_I18N_API
+const SharedLocalizedNumberFormatter* LocaleCacheKey<SharedLocalizedNumberFormatter>::createObject(
+        const void* /*creationContext*/, UErrorCode& status) const {
+    status = U_UNSUPPORTED_ERROR;
+    return nullptr;
+}
+
+/**
+ * The UnifiedCache key for the compiled formatter of a skeleton and locale.
+ */
+class NumberSkeletonCacheKey : public LocaleCacheKey<SharedLocalizedNumberFormatter> {
+  private:
+    UnicodeString fSkeleton;
+
+  public:
+    NumberSkeletonCacheKey(const UnicodeString& skeleton, const Locale& loc)
+            : LocaleCacheKey<SharedLocalizedNumberFormatter>(loc), fSkeleton(skeleton) {}
+
+    NumberSkeletonCacheKey(const NumberSkeletonCacheKey& other)
+            : LocaleCacheKey<SharedLocalizedNumberFormatter>(other), fSkeleton(other.fSkeleton) {}
+
+    virtual ~NumberSkeletonCacheKey();
+
+    virtual int32_t hashCode() const {
+        return static_cast<int32_t>(
+                37u * static_cast<uint32_t>(LocaleCacheKey<SharedLocalizedNumberFormatter>::hashCode()) +
+                static_cast<uint32_t>(fSkeleton.hashCode()));
+    }
+
+    virtual UBool operator==(const CacheKeyBase& other) const {
+        if (this == &other) {
+            return TRUE;
+        }
+        if (!LocaleCacheKey<SharedLocalizedNumberFormatter>::operator==(other)) {
+            return FALSE;
+        }
+        // We know that this and other are of same class if we get this far.
+        return static_cast<const NumberSkeletonCacheKey&>(other).fSkeleton == fSkeleton;
+    }
+
+    virtual CacheKeyBase* clone() const {
+        return new NumberSkeletonCacheKey(*this);
+    }
+
+    virtual const SharedLocalizedNumberFormatter* createObject(const void* /*unused*/,
+                                                               UErrorCode& status) const {
+        LocalizedNumberFormatter formatter = NumberFormatter::forSkeleton(fSkeleton, status).locale(fLoc);
+        formatter.compile(status);
+        if (U_FAILURE(status)) {
+            return nullptr;
+        }
+        LocalPointer<SharedLocalizedNumberFormatter> shared(
+                new SharedLocalizedNumberFormatter(std::move(formatter)), status);
+        if (U_FAILURE(status)) {
+            return nullptr;
+        }
+        SharedLocalizedNumberFormatter* result = shared.orphan();
+        result->addRef();
+        return result;
+    }
+};
+
+NumberSkeletonCacheKey::~NumberSkeletonCacheKey() {}
+
+U_NAMESPACE_END
+
+
 U_CAPI UNumberFormatter* U_EXPORT2
 unumf_openForSkeletonAndLocale(const UChar* skeleton, int32_t skeletonLen, const char* locale,
                                UErrorCode* ec) {
-    auto* impl = new UNumberFormatterData();
-    if (impl == nullptr) {
-        *ec = U_MEMORY_ALLOCATION_ERROR;
-        return nullptr;
-    }
+    if (U_FAILURE(*ec)) { return nullptr; }
+    const UnifiedCache* cache = UnifiedCache::getInstance(*ec);
+    if (U_FAILURE(*ec)) { return nullptr; }
+    LocalPointer<UNumberFormatterData> impl(new UNumberFormatterData(), *ec);
+    if (U_FAILURE(*ec)) { return nullptr; }
     // Readonly-alias constructor (first argument is whether we are NUL-terminated)
     UnicodeString skeletonString(skeletonLen == -1, skeleton, skeletonLen);
-    impl->fFormatter = NumberFormatter::forSkeleton(skeletonString, *ec).locale(locale);
-    return impl->exportForC();
+    // The handles for the same skeleton and locale share one compiled formatter.
+    cache->get(NumberSkeletonCacheKey(skeletonString, Locale(locale)), impl->fShared, *ec);
+    if (U_FAILURE(*ec)) { return nullptr; }
+    return impl.orphan()->exportForC();
 }
 
 U_CAPI UFormattedNumber* U_EXPORT2
@@ -116,7 +190,7 @@ unumf_formatInt(const UNumberFormatter* uformatter, int64_t value, UFormattedNum
 
     result->string.clear();
     result->quantity.setToLong(value);
-    formatter->fFormatter.formatImpl(result, *ec);
+    formatter->formatter().formatImpl(result, *ec);
 }
 
 U_CAPI void U_EXPORT2
@@ -128,7 +202,7 @@ unumf_formatDouble(const UNumberFormatter* uformatter, double value, UFormattedN
 
     result->string.clear();
     result->quantity.setToDouble(value);
-    formatter->fFormatter.formatImpl(result, *ec);
+    formatter->formatter().formatImpl(result, *ec);
 }
 
 U_CAPI void U_EXPORT2
@@ -141,7 +215,39 @@ unumf_formatDecimal(const UNumberFormatter* uformatter, const char* value, int32
     result->string.clear();
     result->quantity.setToDecNumber({value, valueLen}, *ec);
     if (U_FAILURE(*ec)) { return; }
-    formatter->fFormatter.formatImpl(result, *ec);
+    formatter->formatter().formatImpl(result, *ec);
+}
+
+U_CAPI int32_t U_EXPORT2
+unumf_formatIntToBuffer(const UNumberFormatter* uformatter, int64_t value, UChar* buffer,
+                        int32_t bufferCapacity, UErrorCode* ec) {
+    const UNumberFormatterData* formatter = UNumberFormatterData::validate(uformatter, *ec);
+    if (U_FAILURE(*ec)) { return 0; }
+    return formatter->formatter().formatIntToBuffer(value, buffer, bufferCapacity, *ec);
+}
+
+U_CAPI int32_t U_EXPORT2
+unumf_formatDoubleToBuffer(const UNumberFormatter* uformatter, double value, UChar* buffer,
+                           int32_t bufferCapacity, UErrorCode* ec) {
+    const UNumberFormatterData* formatter = UNumberFormatterData::validate(uformatter, *ec);
+    if (U_FAILURE(*ec)) { return 0; }
+    return formatter->formatter().formatDoubleToBuffer(value, buffer, bufferCapacity, *ec);
+}
+
+U_CAPI int32_t U_EXPORT2
+unumf_formatIntToUTF8(const UNumberFormatter* uformatter, int64_t value, char* buffer,
+                      int32_t bufferCapacity, UErrorCode* ec) {
+    const UNumberFormatterData* formatter = UNumberFormatterData::validate(uformatter, *ec);
+    if (U_FAILURE(*ec)) { return 0; }
+    return formatter->formatter().formatIntToUTF8(value, buffer, bufferCapacity, *ec);
+}
+
+U_CAPI int32_t U_EXPORT2
+unumf_formatDoubleToUTF8(const UNumberFormatter* uformatter, double value, char* buffer,
+                         int32_t bufferCapacity, UErrorCode* ec) {
+    const UNumberFormatterData* formatter = UNumberFormatterData::validate(uformatter, *ec);
+    if (U_FAILURE(*ec)) { return 0; }
+    return formatter->formatter().formatDoubleToUTF8(value, buffer, bufferCapacity, *ec);
 }
 
 U_CAPI int32_t U_EXPORT2
@@ -17,6 +17,7 @@
 #include "number_decimalquantity.h"
 #include "number_roundingutils.h"
 #include "double-conversion.h"
+#include "double-conversion-fast-dtoa.h"
 #include "charstr.h"
 #include "number_utils.h"
 #include "uassert.h"
@@ -27,6 +28,8 @@ using namespace icu::number::impl;
 
 using icu::double_conversion::DoubleToStringConverter;
 using icu::double_conversion::StringToDoubleConverter;
+using icu::double_conversion::FastDtoa;
+using icu::double_conversion::Vector;
 
 namespace {
 
@@ -67,6 +70,60 @@ static double DOUBLE_MULTIPLIERS[] = {
         1e20,
         1e21};
 
+/**
+ * Finds the shortest decimal representation of a positive double if that representation has at
+ * most 15 significant digits, which is the case for most doubles that were parsed from decimal
+ * input. Such a representation is the unique decimal with at most 15 significant digits that
+ * converts back to n, and the check below is exact because both of its operands are exact
+ * doubles.
+ *
+ * @return false if the representation has more than 15 digits or is out of the range covered by
+ *         DOUBLE_MULTIPLIERS.
+ */
+bool findShortestDecimal(double n, int64_t& digits, int32_t& exponent) {
+    uint64_t ieeeBits;
+    uprv_memcpy(&ieeeBits, &n, sizeof(n));
+    int32_t binaryExponent = static_cast<int32_t>((ieeeBits & 0x7ff0000000000000L) >> 52) - 0x3ff;
+
+    // Scale n to the range [1e14, 1e15). 0.3010... is log10(2); the estimated decimal magnitude
+    // is at most one less than the actual one.
+    int32_t shift = 14 - static_cast<int32_t>(std::floor(binaryExponent * 0.30102999566));
+    double scaled;
+    for (;;) {
+        if (shift > 21 || shift < -21) {
+            return false;
+        }
+        scaled = shift >= 0 ? n * DOUBLE_MULTIPLIERS[shift] : n / DOUBLE_MULTIPLIERS[-shift];
+        if (scaled < 1e15) {
+            break;
+        }
+        shift--;
+    }
+
+    // Round to the nearest integer, then strip trailing zeros, a few at a time when possible.
+    int64_t candidate = static_cast<int64_t>(scaled + 0.5);
+    exponent = -shift;
+    while (candidate % 10000 == 0) {
+        candidate /= 10000;
+        exponent += 4;
+    }
+    while (candidate % 10 == 0) {
+        candidate /= 10;
+        exponent++;
+    }
+    if (exponent > 21 || exponent < -21) {
+        return false;
+    }
+    double roundTrip = exponent >= 0
+            ? static_cast<double>(candidate) * DOUBLE_MULTIPLIERS[exponent]
+            : static_cast<double>(candidate) / DOUBLE_MULTIPLIERS[-exponent];
+    if (roundTrip != n) {
+        return false;
+    }
+    digits = candidate;
+    return true;
+}
+
 }  // namespace
 
 icu::IFixedDecimal::~IFixedDecimal() = default;
@@ -441,26 +498,44 @@ void DecimalQuantity::_setToDoubleFast(double n) {
 
 void DecimalQuantity::convertToAccurateDouble() {
     U_ASSERT(origDouble != 0);
+    double n = origDouble;
     int32_t delta = origDelta;
-
-    // Call the slow oracle function (Double.toString in Java, DoubleToAscii in C++).
-    char buffer[DoubleToStringConverter::kBase10MaximalLength + 1];
-    bool sign; // unused; always positive
-    int32_t length;
-    int32_t point;
-    DoubleToStringConverter::DoubleToAscii(
-        origDouble,
-        DoubleToStringConverter::DtoaMode::SHORTEST,
-        0,
-        buffer,
-        sizeof(buffer),
-        &sign,
-        &length,
-        &point
-    );
-
     setBcdToZero();
-    readDoubleConversionToBcd(buffer, length, point);
+
+    // Most doubles have a short representation that can be read straight into the BCD.
+    int64_t digits;
+    int32_t exponent;
+    if (std::numeric_limits<double>::is_iec559 && findShortestDecimal(n, digits, exponent)) {
+        readLongToBcd(digits);
+        scale = exponent;
+    } else {
+        // Generate the shortest digits with FastDtoa (Grisu3), which succeeds for about 99.5% of
+        // doubles, and call the slow oracle function (Double.toString in Java, DoubleToAscii in
+        // C++) only for the rest.
+        char buffer[DoubleToStringConverter::kBase10MaximalLength + 1];
+        int32_t length;
+        int32_t point;
+        if (!FastDtoa(
+                n,
+                icu::double_conversion::FAST_DTOA_SHORTEST,
+                0,
+                Vector<char>(buffer, sizeof(buffer)),
+                &length,
+                &point)) {
+            bool sign; // unused; always positive
+            DoubleToStringConverter::DoubleToAscii(
+                n,
+                DoubleToStringConverter::DtoaMode::SHORTEST,
+                0,
+                buffer,
+                sizeof(buffer),
+                &sign,
+                &length,
+                &point
+            );
+        }
+        readDoubleConversionToBcd(buffer, length, point);
+    }
     scale += delta;
     explicitExactDouble = true;
 }
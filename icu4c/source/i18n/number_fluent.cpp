@@ -7,6 +7,7 @@
 
 #include "uassert.h"
 #include "unicode/numberformatter.h"
+#include "unicode/ustring.h"
 #include "number_decimalquantity.h"
 #include "number_formatimpl.h"
 #include "umutex.h"
@@ -655,6 +656,79 @@ LocalizedNumberFormatter::formatDecimalQuantity(const DecimalQuantity& dq, UErro
     }
 }
 
+namespace {
+
+// Checks the arguments for a caller-provided output buffer.
+bool checkBuffer(const void* dest, int32_t destCapacity, UErrorCode& status) {
+    if (U_FAILURE(status)) { return false; }
+    if (dest == nullptr ? destCapacity != 0 : destCapacity < 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return false;
+    }
+    return true;
+}
+
+// Formats the number in data, which the caller keeps on its stack. The formatter is compiled
+// first so that the fast path, which does not allocate, is taken from the first call.
+void formatOnStack(const LocalizedNumberFormatter& formatter, UFormattedNumberData& data,
+                   UErrorCode& status) {
+    formatter.compile(status);
+    formatter.formatImpl(&data, status);
+}
+
+int32_t extractUTF16(const UFormattedNumberData& data, char16_t* dest, int32_t destCapacity,
+                     UErrorCode& status) {
+    if (U_FAILURE(status)) { return 0; }
+    return data.string.toTempUnicodeString().extract(dest, destCapacity, status);
+}
+
+int32_t extractUTF8(const UFormattedNumberData& data, char* dest, int32_t destCapacity,
+                    UErrorCode& status) {
+    if (U_FAILURE(status)) { return 0; }
+    UnicodeString result = data.string.toTempUnicodeString();
+    int32_t length = 0;
+    u_strToUTF8(dest, destCapacity, &length, result.getBuffer(), result.length(), &status);
+    return length;
+}
+
+} // namespace
+
+int32_t LocalizedNumberFormatter::formatIntToBuffer(int64_t value, char16_t* dest, int32_t destCapacity,
+                                                    UErrorCode& status) const {
+    if (!checkBuffer(dest, destCapacity, status)) { return 0; }
+    UFormattedNumberData data;
+    data.quantity.setToLong(value);
+    formatOnStack(*this, data, status);
+    return extractUTF16(data, dest, destCapacity, status);
+}
+
+int32_t LocalizedNumberFormatter::formatDoubleToBuffer(double value, char16_t* dest, int32_t destCapacity,
+                                                       UErrorCode& status) const {
+    if (!checkBuffer(dest, destCapacity, status)) { return 0; }
+    UFormattedNumberData data;
+    data.quantity.setToDouble(value);
+    formatOnStack(*this, data, status);
+    return extractUTF16(data, dest, destCapacity, status);
+}
+
+int32_t LocalizedNumberFormatter::formatIntToUTF8(int64_t value, char* dest, int32_t destCapacity,
+                                                  UErrorCode& status) const {
+    if (!checkBuffer(dest, destCapacity, status)) { return 0; }
+    UFormattedNumberData data;
+    data.quantity.setToLong(value);
+    formatOnStack(*this, data, status);
+    return extractUTF8(data, dest, destCapacity, status);
+}
+
+int32_t LocalizedNumberFormatter::formatDoubleToUTF8(double value, char* dest, int32_t destCapacity,
+                                                     UErrorCode& status) const {
+    if (!checkBuffer(dest, destCapacity, status)) { return 0; }
+    UFormattedNumberData data;
+    data.quantity.setToDouble(value);
+    formatOnStack(*this, data, status);
+    return extractUTF8(data, dest, destCapacity, status);
+}
+
 void LocalizedNumberFormatter::formatImpl(impl::UFormattedNumberData* results, UErrorCode& status) const {
     if (computeCompiled(status)) {
         fCompiled->apply(results->quantity, results->string, status);
@@ -721,6 +795,41 @@ bool LocalizedNumberFormatter::computeCompiled(UErrorCode& status) const {
     }
 }
 
+void LocalizedNumberFormatter::compile(UErrorCode& status) const {
+    if (U_FAILURE(status)) { return; }
+    if (fMacros.copyErrorTo(status)) { return; }
+    auto* callCount = reinterpret_cast<u_atomic_int32_t*>(
+            const_cast<LocalizedNumberFormatter*>(this)->fUnsafeCallCount);
+
+    // Claim the job of building the data structure as computeCompiled() does: the thread whose
+    // increment brings the count to the threshold builds it. With a threshold of zero or less,
+    // computeCompiled() never builds it nor increments the count, so the first increment claims it.
+    int32_t claim = fMacros.threshold > 0 ? fMacros.threshold : 1;
+    bool claimed = false;
+    int32_t currentCount = umtx_loadAcquire(*callCount);
+    while (0 <= currentCount && currentCount < claim) {
+        currentCount = umtx_atomic_inc(callCount);
+        claimed = currentCount == claim;
+    }
+    if (!claimed) {
+        // Already built, or being built by another thread.
+        return;
+    }
+
+    const NumberFormatterImpl* compiled = NumberFormatterImpl::fromMacros(fMacros, status);
+    if (compiled == nullptr && U_SUCCESS(status)) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+    }
+    if (U_FAILURE(status)) {
+        // Leave the count where it is, so that formatting stays on the slow path.
+        delete compiled;
+        return;
+    }
+    U_ASSERT(fCompiled == nullptr);
+    const_cast<LocalizedNumberFormatter*>(this)->fCompiled = compiled;
+    umtx_storeRelease(*callCount, INT32_MIN);
+}
+
 const impl::NumberFormatterImpl* LocalizedNumberFormatter::getCompiled() const {
     return fCompiled;
 }
@@ -11,15 +11,30 @@
 #include "number_types.h"
 #include "number_decimalquantity.h"
 #include "number_stringbuilder.h"
+#include "sharedobject.h"
 
 U_NAMESPACE_BEGIN namespace number {
 namespace impl {
 
 
+/**
+ * A compiled LocalizedNumberFormatter, shared through the UnifiedCache by all of the
+ * UNumberFormatter objects for the same skeleton and locale.
+ */
+class SharedLocalizedNumberFormatter : public SharedObject {
+  public:
+    LocalizedNumberFormatter fFormatter;
+
+    explicit SharedLocalizedNumberFormatter(LocalizedNumberFormatter&& formatter)
+            : fFormatter(std::move(formatter)) {}
+    virtual ~SharedLocalizedNumberFormatter();
+};
+
+
 /**
  * Implementation class for UNumberFormatter with a magic number for safety.
  *
- * Wraps a LocalizedNumberFormatter by value.
+ * Holds a reference to a LocalizedNumberFormatter from the UnifiedCache.
  */
 struct UNumberFormatterData : public UMemory {
     // The magic number to identify incoming objects.
@@ -28,7 +43,15 @@ struct UNumberFormatterData : public UMemory {
 
     // Data members:
     int32_t fMagic = kMagic;
-    LocalizedNumberFormatter fFormatter;
+    const SharedLocalizedNumberFormatter* fShared = nullptr;
+
+    ~UNumberFormatterData() {
+        SharedObject::clearPtr(fShared);
+    }
+
+    const LocalizedNumberFormatter& formatter() const {
+        return fShared->fFormatter;
+    }
 
     /** Convert from UNumberFormatter -> UNumberFormatterData. */
     static UNumberFormatterData* validate(UNumberFormatter* input, UErrorCode& status);
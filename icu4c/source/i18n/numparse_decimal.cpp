@@ -22,6 +22,19 @@ using namespace icu::numparse;
 using namespace icu::numparse::impl;
 
 
+namespace {
+
+bool isSimpleSeparator(const UnicodeString& separator) {
+    if (separator.length() != 1) {
+        return false;
+    }
+    char16_t c = separator.charAt(0);
+    return !U16_IS_SURROGATE(c) && !u_isdigit(c);
+}
+
+} // namespace
+
+
 DecimalMatcher::DecimalMatcher(const DecimalFormatSymbols& symbols, const Grouper& grouper,
                                parse_flags_t parseFlags) {
     if (0 != (parseFlags & PARSE_FLAG_MONETARY_SEPARATORS)) {
@@ -86,6 +99,18 @@ DecimalMatcher::DecimalMatcher(const DecimalFormatSymbols& symbols, const Groupe
     grouping1 = grouper.getPrimary();
     grouping2 = grouper.getSecondary();
 
+    // matchSimpleNumber() handles only single-unit separators that cannot be confused with digits
+    // or with each other. The decimal separator literal is tried first in match().
+    simpleNumbers = fLocalDigitStrings.isNull();
+    if (!integerOnly && isSimpleSeparator(decimalSeparator)) {
+        simpleDecimalSeparator = decimalSeparator.charAt(0);
+    }
+    if (!groupingDisabled && grouping1 >= 2 && grouping2 >= 2 &&
+            isSimpleSeparator(groupingSeparator) &&
+            (decimalSeparator.isEmpty() || groupingSeparator.charAt(0) != decimalSeparator.charAt(0))) {
+        simpleGroupingSeparator = groupingSeparator.charAt(0);
+    }
+
     // Fraction grouping parsing is disabled for now but could be enabled later.
     // See http://bugs.icu-project.org/trac/ticket/10794
     // fractionGrouping = 0 != (parseFlags & PARSE_FLAG_FRACTION_GROUPING_ENABLED);
@@ -396,6 +421,69 @@ bool DecimalMatcher::match(StringSegment& segment, ParsedNumber& result, int8_t
     return segment.length() == 0 || maybeMore;
 }
 
+bool DecimalMatcher::matchSimpleNumber(StringSegment& segment, ParsedNumber& result) const {
+    if (!simpleNumbers || result.seenNumber()) {
+        return false;
+    }
+    const UnicodeString text = segment.toTempUnicodeString();
+    const char16_t* chars = text.getBuffer();
+    int32_t length = text.length();
+
+    // Up to 18 digits always fit into an int64_t.
+    int64_t value = 0;
+    int32_t numDigits = 0;
+    // The number of digits in the current group, and after the decimal separator (-1 before it).
+    int32_t groupCount = 0;
+    int32_t fractionDigits = -1;
+    bool seenGrouping = false;
+    for (int32_t i = 0; i < length; i++) {
+        char16_t c = chars[i];
+        if (u'0' <= c && c <= u'9') {
+            if (++numDigits > 18) {
+                return false;
+            }
+            value = value * 10 + (c - u'0');
+            groupCount++;
+        } else if (fractionDigits < 0 && simpleGroupingSeparator != 0 && c == simpleGroupingSeparator) {
+            // The first group may be shorter than the secondary grouping size; the others must be
+            // full. These are the groups that match() accepts in both strict and lenient mode.
+            if (seenGrouping ? groupCount != grouping2 : (groupCount == 0 || groupCount > grouping2)) {
+                return false;
+            }
+            seenGrouping = true;
+            groupCount = 0;
+        } else if (fractionDigits < 0 && simpleDecimalSeparator != 0 && c == simpleDecimalSeparator) {
+            if (seenGrouping ? groupCount != grouping1 : groupCount == 0) {
+                return false;
+            }
+            fractionDigits = 0;
+            groupCount = 0;
+        } else {
+            return false;
+        }
+    }
+    if (fractionDigits < 0) {
+        if (seenGrouping ? groupCount != grouping1 : groupCount == 0) {
+            return false;
+        }
+    } else if (groupCount == 0) {
+        return false;
+    } else {
+        fractionDigits = groupCount;
+    }
+
+    result.quantity.clear();
+    result.quantity.bogus = false;
+    result.quantity.setToLong(value);
+    if (fractionDigits > 0) {
+        result.quantity.adjustMagnitude(-fractionDigits);
+        result.flags |= FLAG_HAS_DECIMAL_SEPARATOR;
+    }
+    segment.adjustOffset(length);
+    result.setCharsConsumed(segment);
+    return true;
+}
+
 bool DecimalMatcher::validateGroup(int32_t sepType, int32_t count, bool isPrimary) const {
     if (requireGroupingMatch) {
         if (sepType == -1) {
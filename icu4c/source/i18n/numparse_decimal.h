@@ -31,6 +31,15 @@ class DecimalMatcher : public NumberParseMatcher, public UMemory {
 
     UnicodeString toString() const override;
 
+    /**
+     * Fast path for plain numbers: if the rest of the segment consists of ASCII digits, with the
+     * locale's grouping separators between complete groups and optionally the locale's decimal
+     * separator followed by more digits, consumes all of it with the same result as match().
+     *
+     * @return false, without changing the segment or the result, for any other input.
+     */
+    bool matchSimpleNumber(StringSegment& segment, ParsedNumber& result) const;
+
   private:
     /** If true, only accept strings whose grouping sizes match the locale */
     bool requireGroupingMatch;
@@ -51,6 +60,11 @@ class DecimalMatcher : public NumberParseMatcher, public UMemory {
     UnicodeString groupingSeparator;
     UnicodeString decimalSeparator;
 
+    // The separators accepted by matchSimpleNumber(), or 0 if it does not accept any.
+    bool simpleNumbers = false;
+    char16_t simpleGroupingSeparator = 0;
+    char16_t simpleDecimalSeparator = 0;
+
     // Assumption: these sets all consist of single code points. If this assumption needs to be broken,
     // fix getLeadCodePoints() as well as matching logic. Be careful of the performance impact.
     const UnicodeSet* groupingUniSet;
@@ -231,6 +231,29 @@ void NumberParserImpl::addMatcher(NumberParseMatcher& matcher) {
 
 void NumberParserImpl::freeze() {
     fFrozen = true;
+
+    // A greedy parse gives a string that starts with a digit to the first matcher that accepts
+    // the digit. If that is the decimal matcher and it consumes the whole string, no other matcher
+    // takes part before post-processing, so parse() can call the decimal matcher's fast path
+    // directly. The same holds for a leading '-' and the minus sign matcher.
+    fSimpleNumbers = true;
+    for (char16_t digit = u'0'; digit <= u'9'; digit++) {
+        if (getFirstMatcherFor(UnicodeString(digit)) != &fLocalMatchers.decimal) {
+            fSimpleNumbers = false;
+        }
+    }
+    fSimpleNumbersMinusSign =
+            fSimpleNumbers && getFirstMatcherFor(UnicodeString(u'-')) == &fLocalMatchers.minusSign;
+}
+
+const NumberParseMatcher* NumberParserImpl::getFirstMatcherFor(const UnicodeString& lead) const {
+    StringSegment segment(lead, 0 != (fParseFlags & PARSE_FLAG_IGNORE_CASE));
+    for (int32_t i = 0; i < fNumMatchers; i++) {
+        if (fMatchers[i]->smokeTest(segment)) {
+            return fMatchers[i];
+        }
+    }
+    return nullptr;
 }
 
 parse_flags_t NumberParserImpl::getParseFlags() const {
@@ -252,7 +275,9 @@ void NumberParserImpl::parse(const UnicodeString& input, int32_t start, bool gre
     StringSegment segment(input, 0 != (fParseFlags & PARSE_FLAG_IGNORE_CASE));
     segment.adjustOffset(start);
     if (greedy) {
-        parseGreedyRecursive(segment, result, status);
+        if (!fSimpleNumbers || !parseSimpleNumber(segment, result)) {
+            parseGreedyRecursive(segment, result, status);
+        }
     } else {
         parseLongestRecursive(segment, result, status);
     }
@@ -262,6 +287,23 @@ void NumberParserImpl::parse(const UnicodeString& input, int32_t start, bool gre
     result.postProcess();
 }
 
+bool NumberParserImpl::parseSimpleNumber(StringSegment& segment, ParsedNumber& result) const {
+    int32_t initialOffset = segment.getOffset();
+    bool negative = fSimpleNumbersMinusSign && segment.getCodePoint() == u'-';
+    if (negative) {
+        segment.adjustOffset(1);
+    }
+    if (!fLocalMatchers.decimal.matchSimpleNumber(segment, result)) {
+        segment.setOffset(initialOffset);
+        return false;
+    }
+    if (negative) {
+        // As in MinusSignMatcher::accept()
+        result.flags |= FLAG_NEGATIVE;
+    }
+    return true;
+}
+
 void NumberParserImpl::parseGreedyRecursive(StringSegment& segment, ParsedNumber& result,
                                             UErrorCode& status) const {
     // Base Case
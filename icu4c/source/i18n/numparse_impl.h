@@ -68,6 +68,10 @@ class U_I18N_API NumberParserImpl : public MutableMatcherCollection, public UMem
     MaybeStackArray<const NumberParseMatcher*, 10> fMatchers;
     bool fFrozen = false;
 
+    // Whether a greedy parse can try DecimalMatcher::matchSimpleNumber() first; see freeze().
+    bool fSimpleNumbers = false;
+    bool fSimpleNumbersMinusSign = false;
+
     // WARNING: All of these matchers start in an undefined state (default-constructed).
     // You must use an assignment operator on them before using.
     struct {
@@ -95,6 +99,10 @@ class U_I18N_API NumberParserImpl : public MutableMatcherCollection, public UMem
 
     explicit NumberParserImpl(parse_flags_t parseFlags);
 
+    const NumberParseMatcher* getFirstMatcherFor(const UnicodeString& lead) const;
+
+    bool parseSimpleNumber(StringSegment& segment, ParsedNumber& result) const;
+
     void parseGreedyRecursive(StringSegment& segment, ParsedNumber& result, UErrorCode& status) const;
 
     void parseLongestRecursive(StringSegment& segment, ParsedNumber& result, UErrorCode& status) const;
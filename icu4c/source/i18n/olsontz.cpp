@@ -121,7 +121,7 @@ OlsonTimeZone::OlsonTimeZone(const UResourceBundle* top,
                              const UResourceBundle* res,
                              const UnicodeString& tzid,
                              UErrorCode& ec) :
-  BasicTimeZone(tzid), finalZone(NULL)
+  BasicTimeZone(tzid), finalZone(NULL), lastTransitionIdx(0)
 {
     clearTransitionRules();
     U_DEBUG_TZ_MSG(("OlsonTimeZone(%s)\n", ures_getKey((UResourceBundle*)res)));
@@ -266,7 +266,7 @@ OlsonTimeZone::OlsonTimeZone(const UResourceBundle* top,
  * Copy constructor
  */
 OlsonTimeZone::OlsonTimeZone(const OlsonTimeZone& other) :
-    BasicTimeZone(other), finalZone(0) {
+    BasicTimeZone(other), finalZone(0), lastTransitionIdx(0) {
     *this = other;
 }
 
@@ -295,6 +295,8 @@ OlsonTimeZone& OlsonTimeZone::operator=(const OlsonTimeZone& other) {
     finalStartYear = other.finalStartYear;
     finalStartMillis = other.finalStartMillis;
 
+    umtx_storeRelease(lastTransitionIdx, 0);
+
     clearTransitionRules();
 
     return *this;
@@ -414,6 +416,82 @@ OlsonTimeZone::getOffsetFromLocal(UDate date, int32_t nonExistingTimeOpt, int32_
 }
 
 
+void
+OlsonTimeZone::getOffsets(const UDate* dates, int32_t count, UBool local,
+                          int32_t* rawOffsets, int32_t* dstOffsets, UErrorCode& ec) const {
+    if (U_FAILURE(ec)) {
+        return;
+    }
+    if (count < 0 || (count > 0 && (dates == NULL || rawOffsets == NULL || dstOffsets == NULL))) {
+        ec = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    int16_t transCount = transitionCount();
+    UDate historicalLimit = (finalZone != NULL) ? finalStartMillis : DBL_MAX;
+    int32_t i = 0;
+    while (i < count) {
+        UDate date = dates[i];
+        if (date >= historicalLimit) {
+            // Pass the following dates in the final rule's range to the final zone
+            int32_t finalLimit = i + 1;
+            while (finalLimit < count && dates[finalLimit] >= historicalLimit) {
+                finalLimit++;
+            }
+            finalZone->getOffsets(dates + i, finalLimit - i, local, rawOffsets + i, dstOffsets + i, ec);
+            if (U_FAILURE(ec)) {
+                return;
+            }
+            i = finalLimit;
+            continue;
+        }
+
+        int32_t rawoff, dstoff;
+        getHistoricalOffset(date, local, kFormer, kLatter, rawoff, dstoff);
+        rawOffsets[i] = rawoff;
+        dstOffsets[i] = dstoff;
+        i++;
+        if (i == count || dates[i] < date || dates[i] - date > kOffsetRunLookahead) {
+            // Finding the run costs another transition lookup; skip it for scattered dates
+            continue;
+        }
+
+        // The range [start, limit) of dates between the same transitions,
+        // away from the local times that a transition makes ambiguous
+        UDate start = -DBL_MAX;
+        UDate limit = historicalLimit;
+        if (transCount > 0) {
+            double sec = uprv_floor(date / U_MILLIS_PER_SECOND);
+            if (local) {
+                sec -= (rawoff + dstoff) / U_MILLIS_PER_SECOND;
+            }
+            int16_t transIdx = findTransition(sec);
+            if (rawOffsetAt(transIdx) * U_MILLIS_PER_SECOND != rawoff ||
+                    dstOffsetAt(transIdx) * U_MILLIS_PER_SECOND != dstoff) {
+                continue;
+            }
+            if (transIdx >= 0) {
+                start = transitionTime(transIdx);
+                if (local) {
+                    start += uprv_max(zoneOffsetAt(transIdx - 1), zoneOffsetAt(transIdx)) * U_MILLIS_PER_SECOND;
+                }
+            }
+            if (transIdx + 1 < transCount) {
+                UDate next = transitionTime(transIdx + 1);
+                if (local) {
+                    next += uprv_min(zoneOffsetAt(transIdx), zoneOffsetAt(transIdx + 1)) * U_MILLIS_PER_SECOND;
+                }
+                if (next < limit) {
+                    limit = next;
+                }
+            }
+        }
+        for (; i < count && dates[i] >= start && dates[i] < limit; i++) {
+            rawOffsets[i] = rawoff;
+            dstOffsets[i] = dstoff;
+        }
+    }
+}
+
 /**
  * TimeZone API.
  */
@@ -471,6 +549,22 @@ OlsonTimeZone::transitionTimeInSeconds(int16_t transIdx) const {
 // quick zone transition checking.
 #define MAX_OFFSET_SECONDS 86400
 
+int16_t
+OlsonTimeZone::findTransition(double sec) const {
+    // Binary search for the first transition after sec
+    int16_t start = 0;
+    int16_t limit = transitionCount();
+    while (start < limit) {
+        int16_t mid = (int16_t)((start + limit) / 2);
+        if (sec >= transitionTimeInSeconds(mid)) {
+            start = mid + 1;
+        } else {
+            limit = mid;
+        }
+    }
+    return start - 1;
+}
+
 void
 OlsonTimeZone::getHistoricalOffset(UDate date, UBool local,
                                    int32_t NonExistingTimeOpt, int32_t DuplicatedTimeOpt,
@@ -488,14 +582,25 @@ OlsonTimeZone::getHistoricalOffset(UDate date, UBool local,
             // Before the first transition time
             rawoff = initialRawOffset() * U_MILLIS_PER_SECOND;
             dstoff = initialDstOffset() * U_MILLIS_PER_SECOND;
+        } else if (!local) {
+            // Most lookups are near the previous one; check its transition
+            // interval before searching all transitions.
+            int16_t transIdx = (int16_t)umtx_loadAcquire(lastTransitionIdx);
+            if (transIdx < 0 || transIdx >= transCount || !(sec >= transitionTimeInSeconds(transIdx)) ||
+                    (transIdx + 1 < transCount && sec >= transitionTimeInSeconds(transIdx + 1))) {
+                transIdx = findTransition(sec);
+                umtx_storeRelease(lastTransitionIdx, transIdx);
+            }
+            rawoff = rawOffsetAt(transIdx) * U_MILLIS_PER_SECOND;
+            dstoff = dstOffsetAt(transIdx) * U_MILLIS_PER_SECOND;
         } else {
-            // Linear search from the end is the fastest approach, since
-            // most lookups will happen at/near the end.
+            // A local time is at most MAX_OFFSET_SECONDS from its UTC time, so later
+            // transitions cannot apply. Search back from the last one that might.
             int16_t transIdx;
-            for (transIdx = transCount - 1; transIdx >= 0; transIdx--) {
+            for (transIdx = findTransition(sec + MAX_OFFSET_SECONDS); transIdx >= 0; transIdx--) {
                 int64_t transition = transitionTimeInSeconds(transIdx);
 
-                if (local && (sec >= (transition - MAX_OFFSET_SECONDS))) {
+                if (sec >= (transition - MAX_OFFSET_SECONDS)) {
                     int32_t offsetBefore = zoneOffsetAt(transIdx - 1);
                     UBool dstBefore = dstOffsetAt(transIdx - 1) != 0;
 
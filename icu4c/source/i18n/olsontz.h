@@ -190,6 +190,12 @@ class U_I18N_API OlsonTimeZone: public BasicTimeZone {
     virtual void getOffsetFromLocal(UDate date, int32_t nonExistingTimeOpt, int32_t duplicatedTimeOpt,
         int32_t& rawoff, int32_t& dstoff, UErrorCode& ec) const;
 
+    /**
+     * BasicTimeZone API.
+     */
+    virtual void getOffsets(const UDate* dates, int32_t count, UBool local,
+        int32_t* rawOffsets, int32_t* dstOffsets, UErrorCode& ec) const;
+
     /**
      * TimeZone API.  This method has no effect since objects of this
      * class are quasi-immutable (the base class allows the ID to be
@@ -299,6 +305,11 @@ class U_I18N_API OlsonTimeZone: public BasicTimeZone {
 
     int16_t transitionCount() const;
 
+    /**
+     * Returns the index of the last transition at or before sec, or -1 if there is none.
+     */
+    int16_t findTransition(double sec) const;
+
     int64_t transitionTimeInSeconds(int16_t transIdx) const;
     double transitionTime(int16_t transIdx) const;
 
@@ -382,6 +393,12 @@ class U_I18N_API OlsonTimeZone: public BasicTimeZone {
      */
     const UChar *canonicalID;
 
+    /**
+     * Index of the transition found by the last UTC lookup in getHistoricalOffset(),
+     * checked first by the next one.
+     */
+    mutable u_atomic_int32_t lastTransitionIdx;
+
     /* BasicTimeZone support */
     void clearTransitionRules(void);
     void deleteTransitionRules(void);
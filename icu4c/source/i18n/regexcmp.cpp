@@ -38,6 +38,7 @@
 #include "regexcst.h"   // Contains state table for the regex pattern parser.
                         //   generated by a Perl script.
 #include "regexcmp.h"
+#include "regexdfa.h"
 #include "regexst.h"
 #include "regextxt.h"
 
@@ -318,6 +319,11 @@ void    RegexCompile::compile(
     //
     matchStartType();
 
+    //
+    // Optimization pass 3: a literal string that all matches contain
+    //
+    requiredString();
+
     //
     // Set up fast latin-1 range sets
     //
@@ -334,6 +340,10 @@ void    RegexCompile::compile(
         fRXPat->fSets8[i].init(s);
     }
 
+    //
+    // Set up the backtracking-free match engine, if the pattern permits it.
+    //
+    fRXPat->fDFAProgram = RegexDFAProgram::createInstance(fRXPat, *fStatus);
 }
 
 
@@ -3141,6 +3151,8 @@ void   RegexCompile::matchStartType() {
         U_ASSERT(fRXPat->fInitialChars->contains(c));
         fRXPat->fStartType   = START_STRING;
         fRXPat->fInitialChar = c;
+        fRXPat->fInitialStringScan = RegexLiteralSearch::rarestUnit(
+            fRXPat->fLiteralText.getBuffer() + fRXPat->fInitialStringIdx, fRXPat->fInitialStringLen);
     } else if (fRXPat->fStartType == START_LINE) {
         // Match at start of line in Multi-Line mode.
         // Nothing to do here; everything is already set.
@@ -3166,6 +3178,137 @@ void   RegexCompile::matchStartType() {
 
 
 
+//------------------------------------------------------------------------------
+//
+//   opOperandCount    The number of extra words that follow an op in the
+//                     compiled pattern.
+//
+//------------------------------------------------------------------------------
+static int32_t opOperandCount(int32_t opType) {
+    switch (opType) {
+    case URX_STRING:
+    case URX_STRING_I:
+    case URX_JMPX:
+        return 1;
+    case URX_CTR_INIT:
+    case URX_CTR_INIT_NG:
+        return 3;
+    default:
+        return 0;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+//
+//   requiredString    Find a literal string that every match must contain.
+//                     Used to optimize find() operations: where the string does
+//                     not occur in the remaining input, no match is possible.
+//
+//                     A literal op is required unless some forward branch in the
+//                     pattern can skip over it.  A path that skipped it by looping
+//                     back would still need a forward branch to get past it again.
+//                     Patterns with look-around are not analyzed.
+//
+//------------------------------------------------------------------------------
+void   RegexCompile::requiredString() {
+    if (U_FAILURE(*fStatus)) {
+        return;
+    }
+
+    // skipped counts, for each location in the pattern, the forward branches that
+    //   jump over it.  Built as a difference vector, +1 at the start of each
+    //   skipped range and -1 after its end.
+    int32_t end = fRXPat->fCompiledPat->size();
+    UVector32  skipped(end+1, *fStatus);
+    skipped.setSize(end+1);
+    if (U_FAILURE(*fStatus)) {
+        return;
+    }
+
+    int32_t loc;
+    for (loc = 3; loc < end; loc++) {
+        int32_t op      = (int32_t)fRXPat->fCompiledPat->elementAti(loc);
+        int32_t opType  = URX_TYPE(op);
+        int32_t jmpDest = -1;
+        switch (opType) {
+        case URX_STATE_SAVE:
+        case URX_JMP:
+        case URX_JMPX:
+            jmpDest = URX_VAL(op);
+            break;
+        case URX_CTR_INIT:
+        case URX_CTR_INIT_NG:
+            // A loop with a minimum count of zero continues after its end,
+            //   at loopEndLoc+1, without running the body.
+            if (fRXPat->fCompiledPat->elementAti(loc+2) == 0) {
+                jmpDest = URX_VAL(fRXPat->fCompiledPat->elementAti(loc+1)) + 1;
+            }
+            break;
+        case URX_LA_START:
+        case URX_LB_START:
+            return;
+        default:
+            break;
+        }
+        if (jmpDest > loc+1) {
+            U_ASSERT(jmpDest <= end);
+            skipped.setElementAt(skipped.elementAti(loc+1) + 1, loc+1);
+            skipped.setElementAt(skipped.elementAti(jmpDest) - 1, jmpDest);
+        }
+        loc += opOperandCount(opType);
+    }
+    for (loc = 4; loc < end; loc++) {
+        skipped.setElementAt(skipped.elementAti(loc-1) + skipped.elementAti(loc), loc);
+    }
+
+    // Pick the longest of the required literals.
+    int32_t bestLoc = -1;
+    int32_t bestLen = 0;
+    for (loc = 3; loc < end; loc++) {
+        int32_t op     = (int32_t)fRXPat->fCompiledPat->elementAti(loc);
+        int32_t opType = URX_TYPE(op);
+        int32_t len    = 0;
+        if (opType == URX_STRING) {
+            len = URX_VAL(fRXPat->fCompiledPat->elementAti(loc+1));
+        } else if (opType == URX_ONECHAR) {
+            len = U16_LENGTH(URX_VAL(op));
+        }
+        U_ASSERT(skipped.elementAti(loc) >= 0);
+        if (skipped.elementAti(loc) == 0 && len > bestLen) {
+            bestLoc = loc;
+            bestLen = len;
+        }
+        loc += opOperandCount(opType);
+    }
+    if (bestLoc < 0) {
+        return;
+    }
+
+    // A required literal at the start of the pattern adds nothing to the search
+    //   that find() already does for the match start type.
+    int32_t op = (int32_t)fRXPat->fCompiledPat->elementAti(bestLoc);
+    if (URX_TYPE(op) == URX_STRING) {
+        if (fRXPat->fStartType == START_STRING && URX_VAL(op) == fRXPat->fInitialStringIdx) {
+            return;
+        }
+        fRXPat->fRequiredStringIdx = URX_VAL(op);
+    } else {
+        UChar32 c = URX_VAL(op);
+        if ((fRXPat->fStartType == START_CHAR || fRXPat->fStartType == START_STRING) &&
+                fRXPat->fInitialChar == c) {
+            return;
+        }
+        fRXPat->fRequiredStringIdx = fRXPat->fLiteralText.length();
+        fRXPat->fLiteralText.append(c);
+    }
+    fRXPat->fRequiredStringLen  = bestLen;
+    fRXPat->fRequiredStringScan = RegexLiteralSearch::rarestUnit(
+        fRXPat->fLiteralText.getBuffer() + fRXPat->fRequiredStringIdx, bestLen);
+}
+
+
+
 //------------------------------------------------------------------------------
 //
 //   minMatchLength    Calculate the length of the shortest string that could
@@ -0,0 +1,1152 @@
+// © 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+//
+//  file:  regexdfa.cpp
+//
+//  Backtracking-free match engine for regular expressions.  See regexdfa.h
+//
+//  The DFA states are the ordered lists of pattern positions that the backtracking engine
+//  would have pending at an input position, in the order in which it would try them.
+//  Reaching the end of the pattern cuts off everything of lower priority, which makes
+//  the match found here the same one that the backtracking engine would find,
+//  including its end position.
+//
+//  Capture groups are not tracked. When a pattern has them, the matcher runs the
+//  backtracking engine once, at the start position found here, to fill them in.
+//
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_REGULAR_EXPRESSIONS
+
+#include "unicode/regex.h"
+#include "unicode/uchar.h"
+#include "unicode/uniset.h"
+#include "unicode/utf16.h"
+#include "uarrsort.h"
+#include "uassert.h"
+#include "uhash.h"
+#include "uvectr64.h"
+#include "regexdfa.h"
+#include "regeximp.h"
+#include "regextxt.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+// Limits on the patterns handled by the DFA engine. Bigger ones are left to the
+//   backtracking engine; the time to build the program grows with the product of these.
+const int32_t kMaxInsts       = 2000;
+const int32_t kMaxSetInsts    = 0xfff0;      // A set program; state keys hold instruction
+                                             //   numbers in single UChars.
+const int32_t kMaxClasses     = 1024;
+const int32_t kMaxMembers     = 1 << 20;     // Sets * classes.
+
+// Size of each state cache, in transition table entries.
+const int32_t kMaxTransitions = 1 << 16;
+const int32_t kMaxSetTransitions = 1 << 20;  // Set programs have many more states.
+const int32_t kMinStates      = 64;
+
+// Number of cache flushes during a single scan after which the scan gives up.
+const int32_t kMaxFlushes     = 16;
+
+// Special state numbers in the transition tables.
+const int32_t kUnknownState   = -1;
+const int32_t kDeadState      = -2;
+
+// Flags, in the first code unit of a forward state key.
+const UChar   kKeySearch      = 1;     // Unanchored, no match yet: start a new attempt at each position.
+const UChar   kKeyKeepAll     = 2;     // The match must extend to the limit: a match at an
+                                       //   earlier position does not cut off other threads.
+const UChar   kKeyAllMatches  = 4;     // findAll(): keep starting new attempts after a match.
+                                       //   Thread order does not matter, and is sorted.
+
+// Per state flags.
+const int32_t kStateMatch     = 1;     // Forward: the end of the pattern has been reached.
+const int32_t kStateReadsEnd  = 2;     // Forward: a thread of higher priority than any match needs
+                                       //   more input. The backtracker would have tested the limit.
+const int32_t kStateAccept    = 1;     // Reverse: a match can begin at this position.
+
+UnicodeSet *newLineEndingSet() {
+    // Same as isLineTerminator() in rematch.cpp
+    UnicodeSet *set = new UnicodeSet(0x0a, 0x0d);
+    if (set != NULL) {
+        set->add(0x85);
+        set->add(0x2028, 0x2029);
+    }
+    return set;
+}
+
+}  // namespace
+
+
+//------------------------------------------------------------------------------
+//
+//   RegexDFAProgram
+//
+//------------------------------------------------------------------------------
+RegexDFAProgram::RegexDFAProgram(UErrorCode &status) :
+        fNumInsts(0), fMaxInsts(kMaxInsts), fStart(0), fNumPatterns(0),
+        fSets(uprv_deleteUObject, NULL, status),
+        fNumClasses(0), fBounds(status), fBoundClasses(status),
+        fRevFollowStart(status), fRevFollow(status), fRevStart(status),
+        fMatchesEmpty(FALSE) {
+    uprv_memset(fLatin1Classes, 0, sizeof(fLatin1Classes));
+}
+
+RegexDFAProgram::~RegexDFAProgram() {
+}
+
+RegexDFAProgram *RegexDFAProgram::createInstance(const RegexPattern *pattern, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    LocalPointer<RegexDFAProgram> program(new RegexDFAProgram(status), status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    LocalUHashtablePointer charSets(uhash_open(uhash_hashLong, uhash_compareLong, NULL, &status));
+    if (U_FAILURE(status) ||
+            !program->build(pattern, 0, charSets.getAlias(), status) ||
+            !program->buildClasses(status) || !program->buildReverse(status) || U_FAILURE(status)) {
+        return NULL;
+    }
+    return program.orphan();
+}
+
+
+//
+//  createSetInstance    The programs of the patterns, one after another, entered through a
+//                       chain of splits. The reverse automaton is not needed.
+//
+RegexDFAProgram *RegexDFAProgram::createSetInstance(const RegexPattern *const *patterns, int32_t count,
+                                                    UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    LocalPointer<RegexDFAProgram> program(new RegexDFAProgram(status), status);
+    LocalUHashtablePointer charSets(uhash_open(uhash_hashLong, uhash_compareLong, NULL, &status));
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    program->fMaxInsts    = kMaxSetInsts;
+    program->fNumPatterns = count;
+    UVector32 starts(status);
+    for (int32_t i = 0; i < count && U_SUCCESS(status); i++) {
+        if (patterns[i]->fDFAProgram == NULL) {
+            continue;
+        }
+        starts.addElement(program->fNumInsts, status);
+        if (!program->build(patterns[i], i, charSets.getAlias(), status)) {
+            return NULL;
+        }
+    }
+    if (U_FAILURE(status) || starts.size() == 0) {
+        return NULL;
+    }
+    int32_t next = starts.lastElementi();
+    for (int32_t i = starts.size() - 2; i >= 0; i--) {
+        next = program->addInst(kSplit, 0, starts.elementAti(i), next, status);
+    }
+    program->fStart = next;
+    if (next < 0 || U_FAILURE(status) || !program->buildClasses(status)) {
+        return NULL;
+    }
+    return program.orphan();
+}
+
+
+int32_t RegexDFAProgram::addInst(int32_t type, int32_t set, int32_t next, int32_t alt, UErrorCode &status) {
+    if (U_FAILURE(status) || fNumInsts >= fMaxInsts) {
+        return -1;
+    }
+    if (fNumInsts >= fInsts.getCapacity() &&
+            fInsts.resize(fInsts.getCapacity() * 2, fNumInsts) == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return -1;
+    }
+    Inst &inst = fInsts[fNumInsts];
+    inst.fType = type;
+    inst.fSet  = set;
+    inst.fNext = next;
+    inst.fAlt  = alt;
+    return fNumInsts++;
+}
+
+
+int32_t RegexDFAProgram::addCharSet(UChar32 c, UHashtable *charSets, UErrorCode &status) {
+    // Sets for single code points are shared by all uses of the code point.
+    int32_t set = uhash_igeti(charSets, c) - 1;
+    if (set < 0 && U_SUCCESS(status)) {
+        set = addSet(new UnicodeSet(c, c), status);
+        uhash_iputi(charSets, c, set + 1, &status);
+    }
+    return set;
+}
+
+
+int32_t RegexDFAProgram::addSet(UnicodeSet *set, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        delete set;
+        return 0;
+    }
+    if (set == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return 0;
+    }
+    set->freeze();
+    fSets.addElement(set, status);
+    if (U_FAILURE(status)) {
+        delete set;
+        return 0;
+    }
+    return fSets.size() - 1;
+}
+
+
+//
+//  build      Translate the compiled pattern, appending to the program. Instruction base + n
+//             corresponds to op n of the compiled pattern, so that jump targets carry over
+//             with the same offset. Strings and loops need more than one instruction;
+//             the extras are appended.
+//
+//             matchValue is stored in the kMatch instruction.
+//             charSets is shared by all patterns of the program; see addCharSet().
+//
+//             Returns FALSE if the pattern contains anything other than the operations
+//             handled here.
+//
+UBool RegexDFAProgram::build(const RegexPattern *pattern, int32_t matchValue, UHashtable *charSets,
+                             UErrorCode &status) {
+    const UVector64 *compiledPat = pattern->fCompiledPat;
+    int32_t patSize = compiledPat->size();
+    int32_t base = fNumInsts;
+    if (patSize > kMaxInsts || base + patSize > fMaxInsts) {
+        return FALSE;
+    }
+
+    // Check for unsupported operations before doing any real work.
+    int32_t loc;
+    for (loc = 0; loc < patSize; loc++) {
+        int32_t op = (int32_t)compiledPat->elementAti(loc);
+        switch (URX_TYPE(op)) {
+        case URX_RESERVED_OP:
+        case URX_BACKTRACK:
+        case URX_END:
+        case URX_ONECHAR:
+        case URX_STRING:
+        case URX_STRING_LEN:
+        case URX_STATE_SAVE:
+        case URX_NOP:
+        case URX_START_CAPTURE:
+        case URX_END_CAPTURE:
+        case URX_STATIC_SETREF:
+        case URX_SETREF:
+        case URX_DOTANY:
+        case URX_JMP:
+        case URX_FAIL:
+        case URX_JMP_SAV:
+        case URX_JMP_SAV_X:
+        case URX_BACKSLASH_D:
+        case URX_DOTANY_UNIX:
+        case URX_STO_INP_LOC:
+        case URX_STAT_SETREF_N:
+        case URX_LOOP_SR_I:
+        case URX_LOOP_C:
+        case URX_BACKSLASH_H:
+        case URX_BACKSLASH_V:
+            break;
+        case URX_LOOP_DOT_I:
+            if ((URX_VAL(op) & 1) != 0) {
+                // Dot-matches-all mode .* backs up over a CR/LF pair as a unit.
+                return FALSE;
+            }
+            break;
+        default:
+            return FALSE;
+        }
+    }
+
+    for (loc = 0; loc < patSize; loc++) {
+        addInst(kDead, 0, 0, 0, status);
+    }
+
+    const UChar *litText = pattern->fLiteralText.getBuffer();
+    for (loc = 0; loc < patSize && U_SUCCESS(status); loc++) {
+        int32_t op      = (int32_t)compiledPat->elementAti(loc);
+        int32_t opValue = URX_VAL(op);
+        int32_t at      = base + loc;
+        int32_t type    = kDead;
+        int32_t set     = 0;
+        int32_t next    = at + 1;
+        int32_t alt     = 0;
+        UBool   hasSet  = FALSE;
+        UnicodeSet *newSet = NULL;
+
+        switch (URX_TYPE(op)) {
+        case URX_NOP:
+        case URX_START_CAPTURE:
+        case URX_END_CAPTURE:
+        case URX_STO_INP_LOC:
+            type = kJmp;
+            break;
+
+        case URX_JMP:
+            type = kJmp;
+            next = base + opValue;
+            break;
+
+        case URX_JMP_SAV:
+        case URX_JMP_SAV_X:
+            // Loop again first; falling out of the loop is the lower priority alternative.
+            // An iteration of a JMP_SAV_X loop that consumed nothing arrives back at an
+            // instruction that the closure has already visited, and is cut off there,
+            // just as the backtracking engine's progress test cuts it off.
+            type = kSplit;
+            next = base + opValue;
+            alt  = at + 1;
+            break;
+
+        case URX_STATE_SAVE:
+            type = kSplit;
+            alt  = base + opValue;
+            break;
+
+        case URX_END:
+            type = kMatch;
+            set  = matchValue;
+            break;
+
+        case URX_ONECHAR:
+            type = kConsume;
+            set  = addCharSet(opValue, charSets, status);
+            break;
+
+        case URX_STRING:
+            {
+                // One instruction per code point, chained.
+                int32_t stringLen = URX_VAL(compiledPat->elementAti(loc+1));
+                const UChar *s = litText + opValue;
+                int32_t i = 0;
+                int32_t prev = -1;
+                while (i < stringLen && U_SUCCESS(status)) {
+                    UChar32 c;
+                    U16_NEXT(s, i, stringLen, c);
+                    int32_t inst = at;
+                    if (prev >= 0) {
+                        inst = addInst(kConsume, 0, 0, 0, status);
+                        if (inst < 0) {
+                            return FALSE;
+                        }
+                        fInsts[prev].fNext = inst;
+                    }
+                    fInsts[inst].fType = kConsume;
+                    fInsts[inst].fSet  = addCharSet(c, charSets, status);
+                    prev = inst;
+                }
+                fInsts[prev].fNext = at + 2;
+            }
+            continue;
+
+        case URX_SETREF:
+            hasSet = TRUE;
+            newSet = new UnicodeSet(*(UnicodeSet *)pattern->fSets->elementAt(opValue));
+            break;
+
+        case URX_STATIC_SETREF:
+        case URX_STAT_SETREF_N:
+            hasSet = TRUE;
+            newSet = new UnicodeSet(*pattern->fStaticSets[opValue & ~URX_NEG_SET]);
+            if (newSet != NULL &&
+                    (URX_TYPE(op) == URX_STAT_SETREF_N || (opValue & URX_NEG_SET) != 0)) {
+                newSet->complement();
+            }
+            break;
+
+        case URX_DOTANY:
+            hasSet = TRUE;
+            newSet = newLineEndingSet();
+            if (newSet != NULL) {
+                newSet->complement();
+            }
+            break;
+
+        case URX_DOTANY_UNIX:
+            hasSet = TRUE;
+            newSet = new UnicodeSet(0x0a, 0x0a);
+            if (newSet != NULL) {
+                newSet->complement();
+            }
+            break;
+
+        case URX_BACKSLASH_D:
+        case URX_BACKSLASH_H:
+            hasSet = TRUE;
+            newSet = new UnicodeSet();
+            if (newSet != NULL) {
+                if (URX_TYPE(op) == URX_BACKSLASH_D) {
+                    newSet->applyIntPropertyValue(UCHAR_GENERAL_CATEGORY_MASK, U_GC_ND_MASK, status);
+                } else {
+                    newSet->applyIntPropertyValue(UCHAR_GENERAL_CATEGORY_MASK, U_GC_ZS_MASK, status);
+                    newSet->add(9);
+                }
+                if (opValue != 0) {
+                    newSet->complement();
+                }
+            }
+            break;
+
+        case URX_BACKSLASH_V:
+            hasSet = TRUE;
+            newSet = newLineEndingSet();
+            if (newSet != NULL && opValue != 0) {
+                newSet->complement();
+            }
+            break;
+
+        case URX_LOOP_SR_I:
+        case URX_LOOP_DOT_I:
+            {
+                // A greedy [set]* or .*, followed by a URX_LOOP_C.
+                if (URX_TYPE(op) == URX_LOOP_SR_I) {
+                    newSet = new UnicodeSet(*(UnicodeSet *)pattern->fSets->elementAt(opValue));
+                } else if ((opValue & 2) != 0) {
+                    newSet = new UnicodeSet(0x0a, 0x0a);
+                    if (newSet != NULL) {
+                        newSet->complement();
+                    }
+                } else {
+                    newSet = newLineEndingSet();
+                    if (newSet != NULL) {
+                        newSet->complement();
+                    }
+                }
+                int32_t body = addInst(kConsume, addSet(newSet, status), at, 0, status);
+                if (body < 0) {
+                    return FALSE;
+                }
+                fInsts[at].fType = kSplit;
+                fInsts[at].fNext = body;
+                fInsts[at].fAlt  = at + 2;
+            }
+            continue;
+
+        default:
+            // Operands of a preceding op (never executed), or a forced failure.
+            break;
+        }
+
+        if (hasSet) {
+            type = kConsume;
+            set  = addSet(newSet, status);
+        }
+        Inst &inst = fInsts[at];
+        inst.fType = type;
+        inst.fSet  = set;
+        inst.fNext = next;
+        inst.fAlt  = alt;
+    }
+
+    return U_SUCCESS(status);
+}
+
+
+//
+//  buildClasses    Partition the code points into classes that no set distinguishes.
+//
+//                  Start from the elementary ranges delimited by the boundaries of all
+//                  ranges of all sets, with all ranges in a single class. Each set in turn
+//                  then splits every class into its members and non-members.
+//
+UBool RegexDFAProgram::buildClasses(UErrorCode &status) {
+    UVector32 bounds(status);
+    bounds.addElement(0, status);
+    int32_t numSets = fSets.size();
+    int32_t setIndex;
+    for (setIndex = 0; setIndex < numSets; setIndex++) {
+        const UnicodeSet *set = (const UnicodeSet *)fSets.elementAt(setIndex);
+        for (int32_t r = 0; r < set->getRangeCount(); r++) {
+            bounds.addElement(set->getRangeStart(r), status);
+            if (set->getRangeEnd(r) < 0x10ffff) {
+                bounds.addElement(set->getRangeEnd(r) + 1, status);
+            }
+        }
+    }
+    if (U_FAILURE(status)) {
+        return FALSE;
+    }
+    int32_t *b = bounds.getBuffer();
+    uprv_sortArray(b, bounds.size(), sizeof(int32_t), uprv_int32Comparator, NULL, FALSE, &status);
+    int32_t numBounds = 0;
+    for (int32_t i = 0; i < bounds.size(); i++) {
+        if (numBounds == 0 || b[i] != b[numBounds - 1]) {
+            b[numBounds++] = b[i];
+        }
+    }
+
+    MaybeStackArray<int32_t, 64> classes;
+    MaybeStackArray<int32_t, 64> remap;
+    if (numBounds > classes.getCapacity() && classes.resize(numBounds) == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return FALSE;
+    }
+    uprv_memset(classes.getAlias(), 0, numBounds * sizeof(int32_t));
+    fNumClasses = 1;
+    for (setIndex = 0; setIndex < numSets; setIndex++) {
+        const UnicodeSet *set = (const UnicodeSet *)fSets.elementAt(setIndex);
+        if (fNumClasses * 2 > remap.getCapacity() && remap.resize(fNumClasses * 2) == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return FALSE;
+        }
+        uprv_memset(remap.getAlias(), 0xff, fNumClasses * 2 * sizeof(int32_t));
+        int32_t numClasses = 0;
+        int32_t rangeCount = set->getRangeCount();
+        int32_t r = 0;
+        for (int32_t i = 0; i < numBounds; i++) {
+            while (r < rangeCount && set->getRangeEnd(r) < b[i]) {
+                ++r;
+            }
+            int32_t key = classes[i] * 2 + (r < rangeCount && set->getRangeStart(r) <= b[i]);
+            if (remap[key] < 0) {
+                remap[key] = numClasses++;
+            }
+            classes[i] = remap[key];
+        }
+        fNumClasses = numClasses;
+        if (fNumClasses > kMaxClasses) {
+            return FALSE;
+        }
+    }
+    if (numSets * fNumClasses > kMaxMembers) {
+        return FALSE;
+    }
+
+    // Lookup: a table for Latin-1, binary search on range starts above.
+    //   Adjacent ranges in the same class are merged.
+    int32_t i = 0;
+    for (UChar32 c = 0; c < 256; c++) {
+        while (i + 1 < numBounds && b[i + 1] <= c) {
+            ++i;
+        }
+        fLatin1Classes[c] = (uint16_t)classes[i];
+    }
+    MaybeStackArray<UChar32, 64> reps;
+    if (fNumClasses > reps.getCapacity() && reps.resize(fNumClasses) == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return FALSE;
+    }
+    uprv_memset(reps.getAlias(), 0xff, fNumClasses * sizeof(UChar32));
+    for (i = 0; i < numBounds; i++) {
+        if (fBoundClasses.size() == 0 || fBoundClasses.lastElementi() != classes[i]) {
+            fBounds.addElement(b[i], status);
+            fBoundClasses.addElement(classes[i], status);
+        }
+        if (reps[classes[i]] < 0) {
+            reps[classes[i]] = b[i];
+        }
+    }
+
+    // Set membership of each class, tested with a representative code point.
+    int32_t numMembers = numSets * fNumClasses;
+    if (numMembers > fMember.getCapacity() && fMember.resize(numMembers) == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return FALSE;
+    }
+    for (setIndex = 0; setIndex < numSets; setIndex++) {
+        const UnicodeSet *set = (const UnicodeSet *)fSets.elementAt(setIndex);
+        for (int32_t cls = 0; cls < fNumClasses; cls++) {
+            fMember[setIndex * fNumClasses + cls] = set->contains(reps[cls]);
+        }
+    }
+    return U_SUCCESS(status);
+}
+
+
+//
+//  reachable     Collect the consuming instructions reachable from inst by epsilon moves alone,
+//                in no particular order. Set match if the end of the pattern is reachable.
+//
+void RegexDFAProgram::reachable(int32_t inst, int32_t *stamp, int32_t mark, UVector32 &stack,
+                                UVector32 &dest, UBool &match, UErrorCode &status) {
+    stack.removeAllElements();
+    stack.push(inst, status);
+    while (!stack.empty() && U_SUCCESS(status)) {
+        int32_t i = stack.popi();
+        if (stamp[i] == mark) {
+            continue;
+        }
+        stamp[i] = mark;
+        const Inst &in = fInsts[i];
+        switch (in.fType) {
+        case kConsume:
+            dest.addElement(i, status);
+            break;
+        case kSplit:
+            stack.push(in.fAlt, status);
+            stack.push(in.fNext, status);
+            break;
+        case kJmp:
+            stack.push(in.fNext, status);
+            break;
+        case kMatch:
+            match = TRUE;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+
+//
+//  buildReverse    Invert the follow relation of the consuming instructions,
+//                  for the reverse automaton.
+//
+UBool RegexDFAProgram::buildReverse(UErrorCode &status) {
+    MaybeStackArray<int32_t, 64> stamp;
+    MaybeStackArray<int32_t, 64> counts;
+    if ((fNumInsts > stamp.getCapacity() && stamp.resize(fNumInsts) == NULL) ||
+            (fNumInsts + 1 > counts.getCapacity() && counts.resize(fNumInsts + 1) == NULL) ||
+            (fNumInsts > fIsFirst.getCapacity() && fIsFirst.resize(fNumInsts) == NULL)) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return FALSE;
+    }
+    uprv_memset(stamp.getAlias(), 0, fNumInsts * sizeof(int32_t));
+    uprv_memset(counts.getAlias(), 0, (fNumInsts + 1) * sizeof(int32_t));
+    uprv_memset(fIsFirst.getAlias(), 0, fNumInsts);
+    int32_t mark = 0;
+    UVector32 stack(status);
+    UVector32 follow(status);
+    UVector32 pairs(status);
+
+    reachable(fStart, stamp.getAlias(), ++mark, stack, follow, fMatchesEmpty, status);
+    int32_t i;
+    for (i = 0; i < follow.size(); i++) {
+        fIsFirst[follow.elementAti(i)] = 1;
+    }
+
+    for (int32_t from = 0; from < fNumInsts && U_SUCCESS(status); from++) {
+        if (fInsts[from].fType != kConsume) {
+            continue;
+        }
+        UBool match = FALSE;
+        follow.removeAllElements();
+        reachable(fInsts[from].fNext, stamp.getAlias(), ++mark, stack, follow, match, status);
+        if (match) {
+            fRevStart.addElement(from, status);
+        }
+        for (i = 0; i < follow.size(); i++) {
+            int32_t to = follow.elementAti(i);
+            pairs.addElement(from, status);
+            pairs.addElement(to, status);
+            counts[to]++;
+        }
+    }
+    if (U_FAILURE(status)) {
+        return FALSE;
+    }
+
+    int32_t total = 0;
+    for (i = 0; i <= fNumInsts; i++) {
+        fRevFollowStart.addElement(total, status);
+        total += counts[i];
+        counts[i] = fRevFollowStart.elementAti(i);
+    }
+    fRevFollow.setSize(total);
+    if (U_FAILURE(status) || fRevFollow.size() != total) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return FALSE;
+    }
+    int32_t *revFollow = fRevFollow.getBuffer();
+    for (i = 0; i < pairs.size(); i += 2) {
+        revFollow[counts[pairs.elementAti(i + 1)]++] = pairs.elementAti(i);
+    }
+    return TRUE;
+}
+
+
+//------------------------------------------------------------------------------
+//
+//   RegexLazyDFA::StateTable
+//
+//------------------------------------------------------------------------------
+RegexLazyDFA::StateTable::StateTable(int32_t numClasses, int32_t maxTransitions, UErrorCode &status) :
+        fMap(status), fKeys(uprv_deleteUObject, NULL, status), fTrans(status), fFlags(status),
+        fNumClasses(numClasses), fMaxStates(maxTransitions / numClasses), fFlushes(0) {
+    if (fMaxStates < kMinStates) {
+        fMaxStates = kMinStates;
+    }
+    fStarts[0] = fStarts[1] = fStarts[2] = fStarts[3] = kUnknownState;
+}
+
+RegexLazyDFA::StateTable::~StateTable() {
+}
+
+int32_t RegexLazyDFA::StateTable::intern(const UnicodeString &key, int32_t flags, UErrorCode &status) {
+    int32_t state = fMap.geti(key) - 1;
+    if (state >= 0 || U_FAILURE(status)) {
+        return state;
+    }
+    if (fFlags.size() >= fMaxStates) {
+        flush();
+    }
+    state = fFlags.size();
+    UnicodeString *ownKey = new UnicodeString(key);
+    if (ownKey == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return kDeadState;
+    }
+    fKeys.addElement(ownKey, status);
+    if (U_FAILURE(status)) {
+        delete ownKey;
+        return kDeadState;
+    }
+    fMap.puti(key, state + 1, status);
+    fFlags.addElement(flags, status);
+    int32_t *row = fTrans.reserveBlock(fNumClasses, status);
+    if (U_FAILURE(status)) {
+        return kDeadState;
+    }
+    for (int32_t i = 0; i < fNumClasses; i++) {
+        row[i] = kUnknownState;
+    }
+    return state;
+}
+
+void RegexLazyDFA::StateTable::flush() {
+    fMap.removeAll();
+    fKeys.removeAllElements();
+    fTrans.removeAllElements();
+    fFlags.removeAllElements();
+    fStarts[0] = fStarts[1] = fStarts[2] = fStarts[3] = kUnknownState;
+    ++fFlushes;
+}
+
+
+//------------------------------------------------------------------------------
+//
+//   RegexLazyDFA
+//
+//------------------------------------------------------------------------------
+RegexLazyDFA::RegexLazyDFA(const RegexDFAProgram *program, UErrorCode &status) :
+        fProgram(program),
+        fForward(program->fNumClasses,
+                 program->fNumPatterns > 0 ? kMaxSetTransitions : kMaxTransitions, status),
+        fReverse(program->fNumClasses, kMaxTransitions, status),
+        fStamp(0),
+        fWork(status),
+        fReported(status),
+        fScan(0) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (program->fNumInsts > fVisited.getCapacity() && fVisited.resize(program->fNumInsts) == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    uprv_memset(fVisited.getAlias(), 0, program->fNumInsts * sizeof(int32_t));
+}
+
+RegexLazyDFA::~RegexLazyDFA() {
+}
+
+void RegexLazyDFA::newVisit() {
+    if (fStamp == INT32_MAX) {
+        uprv_memset(fVisited.getAlias(), 0, fProgram->fNumInsts * sizeof(int32_t));
+        fStamp = 0;
+    }
+    ++fStamp;
+}
+
+
+//
+//  addClosure    Append the consuming instructions reachable from inst to a state key,
+//                in the order in which the backtracking engine would reach them.
+//                Return TRUE if the end of the pattern was reached and nothing of lower
+//                priority can matter any more.
+//
+UBool RegexLazyDFA::addClosure(int32_t inst, UBool keepAll, UnicodeString &key, UErrorCode &status) {
+    fWork.removeAllElements();
+    fWork.push(inst, status);
+    while (!fWork.empty() && U_SUCCESS(status)) {
+        int32_t i = fWork.popi();
+        if (fVisited[i] == fStamp) {
+            continue;
+        }
+        fVisited[i] = fStamp;
+        const RegexDFAProgram::Inst &in = fProgram->fInsts[i];
+        switch (in.fType) {
+        case RegexDFAProgram::kConsume:
+            key.append((UChar)i);
+            break;
+        case RegexDFAProgram::kSplit:
+            fWork.push(in.fAlt, status);
+            fWork.push(in.fNext, status);
+            break;
+        case RegexDFAProgram::kJmp:
+            fWork.push(in.fNext, status);
+            break;
+        case RegexDFAProgram::kMatch:
+            key.append((UChar)i);
+            if (!keepAll) {
+                return TRUE;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return FALSE;
+}
+
+
+//
+//  sortKey       For findAll(), the order of the threads of a state does not matter.
+//                Sorting them lets states that differ only in order share a cache entry.
+//
+void RegexLazyDFA::sortKey(UnicodeString &key) {
+    int32_t length = key.length();
+    if (length <= 2 || (key.charAt(0) & kKeyAllMatches) == 0) {
+        return;
+    }
+    UErrorCode status = U_ZERO_ERROR;
+    UChar *buffer = key.getBuffer(length);
+    uprv_sortArray(buffer + 1, length - 1, sizeof(UChar), uprv_uint16Comparator, NULL, FALSE, &status);
+    key.releaseBuffer(length);
+}
+
+
+int32_t RegexLazyDFA::internForward(const UnicodeString &key, UErrorCode &status) {
+    if (key.length() <= 1) {
+        return kDeadState;
+    }
+    int32_t flags = 0;
+    for (int32_t i = 1; i < key.length(); i++) {
+        if (fProgram->fInsts[key.charAt(i)].fType == RegexDFAProgram::kMatch) {
+            flags |= kStateMatch;
+        } else if ((flags & kStateMatch) == 0) {
+            flags |= kStateReadsEnd;
+        }
+    }
+    return fForward.intern(key, flags, status);
+}
+
+
+int32_t RegexLazyDFA::forwardStart(EMode mode, UErrorCode &status) {
+    int32_t state = fForward.fStarts[mode];
+    if (state != kUnknownState) {
+        return state;
+    }
+    UChar keyFlags = mode == kFind ? kKeySearch : (mode == kMatches ? kKeyKeepAll : 0);
+    if (mode == kFindAll) {
+        keyFlags = kKeySearch | kKeyKeepAll | kKeyAllMatches;
+    }
+    UnicodeString key(keyFlags);
+    newVisit();
+    addClosure(fProgram->fStart, (keyFlags & kKeyKeepAll) != 0, key, status);
+    sortKey(key);
+    state = internForward(key, status);
+    if (U_SUCCESS(status)) {
+        fForward.fStarts[mode] = state;
+    }
+    return state;
+}
+
+
+int32_t RegexLazyDFA::forwardNext(int32_t state, int32_t cls, UErrorCode &status) {
+    const UnicodeString &key = *(const UnicodeString *)fForward.fKeys.elementAt(state);
+    UChar keyFlags = key.charAt(0);
+    UBool keepAll = (keyFlags & kKeyKeepAll) != 0;
+    if ((fForward.fFlags.elementAti(state) & kStateMatch) != 0 && (keyFlags & kKeyAllMatches) == 0) {
+        // A match has been found. Later attempts could only find ones further to the right.
+        keyFlags &= ~kKeySearch;
+    }
+
+    UnicodeString next(keyFlags);
+    UBool cut = FALSE;
+    newVisit();
+    for (int32_t i = 1; i < key.length() && !cut; i++) {
+        int32_t inst = key.charAt(i);
+        if (fProgram->fInsts[inst].fType == RegexDFAProgram::kMatch) {
+            continue;
+        }
+        if (fProgram->accepts(inst, cls)) {
+            cut = addClosure(fProgram->fInsts[inst].fNext, keepAll, next, status);
+        }
+    }
+    if (!cut && (keyFlags & kKeySearch) != 0) {
+        // A new attempt, starting at the current position, with the lowest priority.
+        addClosure(fProgram->fStart, keepAll, next, status);
+    }
+    sortKey(next);
+
+    int32_t flushes = fForward.fFlushes;
+    int32_t result = internForward(next, status);
+    if (U_SUCCESS(status) && flushes == fForward.fFlushes) {
+        fForward.fTrans.setElementAt(result, state * fForward.fNumClasses + cls);
+    }
+    return result;
+}
+
+
+template<class Input>
+RegexLazyDFA::EResult RegexLazyDFA::forwardScan(Input &input, int64_t start, int64_t limit, EMode mode,
+                                                int64_t &matchEnd, UBool &hitEnd, UErrorCode &status) {
+    matchEnd = -1;
+    hitEnd   = FALSE;
+    int32_t flushes = fForward.fFlushes;
+    int32_t state = forwardStart(mode, status);
+    const int32_t  numClasses = fForward.fNumClasses;
+    const int32_t *trans = fForward.fTrans.getBuffer();
+    const int32_t *flags = fForward.fFlags.getBuffer();
+
+    int64_t pos = start;
+    input.setNativeIndex(start);
+    while (state >= 0) {
+        int32_t stateFlags = flags[state];
+        if ((stateFlags & kStateMatch) != 0 && (mode != kMatches || pos >= limit)) {
+            matchEnd = pos;
+        }
+        if (pos >= limit) {
+            hitEnd = (stateFlags & kStateReadsEnd) != 0;
+            break;
+        }
+        UChar32 c = input.next32();
+        int32_t cls = fProgram->classOf(c);
+        int32_t next = trans[state * numClasses + cls];
+        if (next == kUnknownState) {
+            next = forwardNext(state, cls, status);
+            if (fForward.fFlushes - flushes > kMaxFlushes) {
+                return kGaveUp;
+            }
+            trans = fForward.fTrans.getBuffer();
+            flags = fForward.fFlags.getBuffer();
+        }
+        state = next;
+        pos = input.getNativeIndex();
+    }
+    if (U_FAILURE(status)) {
+        return kGaveUp;
+    }
+    return matchEnd >= 0 ? kMatch : kNoMatch;
+}
+
+
+RegexLazyDFA::EResult RegexLazyDFA::forward(UText *text, int64_t start, int64_t limit, EMode mode,
+                                            int64_t &matchEnd, UBool &hitEnd, UErrorCode &status) {
+    int64_t length;
+    const char *utf8 = utext_getUTF8Source(text, &length);
+    if (utf8 != NULL) {
+        RegexUTF8Input input(utf8, length);
+        return forwardScan(input, start, limit, mode, matchEnd, hitEnd, status);
+    }
+    RegexUTextInput input(text);
+    return forwardScan(input, start, limit, mode, matchEnd, hitEnd, status);
+}
+
+
+//
+//  findAll       The set program runs unanchored, keeping all threads and starting a new attempt
+//                at every position. Each state whose key includes kMatch instructions
+//                reports their patterns, once per scan.
+//
+template<class Input>
+RegexLazyDFA::EResult RegexLazyDFA::findAllScan(Input &input, int64_t start, int64_t limit,
+                                                UBool *matched, int32_t &numMatched, UErrorCode &status) {
+    numMatched = 0;
+    if (fScan == INT32_MAX) {
+        fReported.removeAllElements();
+        fScan = 0;
+    }
+    ++fScan;
+    int32_t flushes = fForward.fFlushes;
+    int32_t reportedFlushes = flushes;
+    int32_t state = forwardStart(kFindAll, status);
+    const int32_t  numClasses = fForward.fNumClasses;
+    const int32_t *trans = fForward.fTrans.getBuffer();
+    const int32_t *flags = fForward.fFlags.getBuffer();
+
+    input.setNativeIndex(start);
+    int64_t pos = start;
+    while (state >= 0 && U_SUCCESS(status)) {
+        if ((flags[state] & kStateMatch) != 0) {
+            if (reportedFlushes != fForward.fFlushes) {
+                // State numbers have been reused.
+                fReported.removeAllElements();
+                reportedFlushes = fForward.fFlushes;
+            }
+            if (state >= fReported.size()) {
+                fReported.setSize(fForward.fFlags.size());
+            }
+            if (state < fReported.size() && fReported.elementAti(state) != fScan) {
+                fReported.setElementAt(fScan, state);
+                const UnicodeString &key = *(const UnicodeString *)fForward.fKeys.elementAt(state);
+                for (int32_t i = 1; i < key.length(); i++) {
+                    const RegexDFAProgram::Inst &in = fProgram->fInsts[key.charAt(i)];
+                    if (in.fType == RegexDFAProgram::kMatch && !matched[in.fSet]) {
+                        matched[in.fSet] = TRUE;
+                        ++numMatched;
+                    }
+                }
+            }
+        }
+        if (pos >= limit) {
+            break;
+        }
+        UChar32 c = input.next32();
+        int32_t cls = fProgram->classOf(c);
+        int32_t next = trans[state * numClasses + cls];
+        if (next == kUnknownState) {
+            next = forwardNext(state, cls, status);
+            if (fForward.fFlushes - flushes > kMaxFlushes) {
+                return kGaveUp;
+            }
+            trans = fForward.fTrans.getBuffer();
+            flags = fForward.fFlags.getBuffer();
+        }
+        state = next;
+        pos = input.getNativeIndex();
+    }
+    if (U_FAILURE(status)) {
+        return kGaveUp;
+    }
+    return numMatched > 0 ? kMatch : kNoMatch;
+}
+
+
+RegexLazyDFA::EResult RegexLazyDFA::findAll(UText *text, int64_t start, int64_t limit,
+                                            UBool *matched, int32_t &numMatched, UErrorCode &status) {
+    int64_t length;
+    const char *utf8 = utext_getUTF8Source(text, &length);
+    if (utf8 != NULL) {
+        RegexUTF8Input input(utf8, length);
+        return findAllScan(input, start, limit, matched, numMatched, status);
+    }
+    RegexUTextInput input(text);
+    return findAllScan(input, start, limit, matched, numMatched, status);
+}
+
+
+int32_t RegexLazyDFA::internReverse(const UnicodeString &key, UErrorCode &status) {
+    if (key.length() <= 1 && key.charAt(0) == 0) {
+        return kDeadState;
+    }
+    return fReverse.intern(key, key.charAt(0) != 0 ? kStateAccept : 0, status);
+}
+
+
+//
+//  The reverse automaton. A state is the set of instructions that may have consumed
+//  the code point preceding the current position, in increasing order, with a flag
+//  for whether a match can begin at the current position.
+//
+int32_t RegexLazyDFA::reverseStart(UErrorCode &status) {
+    int32_t state = fReverse.fStarts[0];
+    if (state != kUnknownState) {
+        return state;
+    }
+    UnicodeString key((UChar)(fProgram->fMatchesEmpty ? 1 : 0));
+    for (int32_t i = 0; i < fProgram->fRevStart.size(); i++) {
+        key.append((UChar)fProgram->fRevStart.elementAti(i));
+    }
+    state = internReverse(key, status);
+    if (U_SUCCESS(status)) {
+        fReverse.fStarts[0] = state;
+    }
+    return state;
+}
+
+
+int32_t RegexLazyDFA::reverseNext(int32_t state, int32_t cls, UErrorCode &status) {
+    const UnicodeString &key = *(const UnicodeString *)fReverse.fKeys.elementAt(state);
+    UBool accept = FALSE;
+    newVisit();
+    fWork.removeAllElements();
+    for (int32_t i = 1; i < key.length(); i++) {
+        int32_t inst = key.charAt(i);
+        if (!fProgram->accepts(inst, cls)) {
+            continue;
+        }
+        if (fProgram->fIsFirst[inst]) {
+            accept = TRUE;
+        }
+        int32_t limit = fProgram->fRevFollowStart.elementAti(inst + 1);
+        for (int32_t j = fProgram->fRevFollowStart.elementAti(inst); j < limit; j++) {
+            int32_t prev = fProgram->fRevFollow.elementAti(j);
+            if (fVisited[prev] != fStamp) {
+                fVisited[prev] = fStamp;
+                fWork.addElement(prev, status);
+            }
+        }
+    }
+    uprv_sortArray(fWork.getBuffer(), fWork.size(), sizeof(int32_t), uprv_int32Comparator, NULL, FALSE, &status);
+
+    UnicodeString next((UChar)(accept ? 1 : 0));
+    for (int32_t i = 0; i < fWork.size(); i++) {
+        next.append((UChar)fWork.elementAti(i));
+    }
+    int32_t flushes = fReverse.fFlushes;
+    int32_t result = internReverse(next, status);
+    if (U_SUCCESS(status) && flushes == fReverse.fFlushes) {
+        fReverse.fTrans.setElementAt(result, state * fReverse.fNumClasses + cls);
+    }
+    return result;
+}
+
+
+template<class Input>
+RegexLazyDFA::EResult RegexLazyDFA::reverseScan(Input &input, int64_t end, int64_t lowerBound,
+                                                int64_t &matchStart, UErrorCode &status) {
+    matchStart = -1;
+    int32_t flushes = fReverse.fFlushes;
+    int32_t state = reverseStart(status);
+    const int32_t  numClasses = fReverse.fNumClasses;
+    const int32_t *trans = fReverse.fTrans.getBuffer();
+    const int32_t *flags = fReverse.fFlags.getBuffer();
+
+    int64_t pos = end;
+    if (state >= 0 && (flags[state] & kStateAccept) != 0) {
+        matchStart = pos;
+    }
+    input.setNativeIndex(end);
+    while (state >= 0 && pos > lowerBound) {
+        UChar32 c = input.previous32();
+        int32_t cls = fProgram->classOf(c);
+        int32_t next = trans[state * numClasses + cls];
+        if (next == kUnknownState) {
+            next = reverseNext(state, cls, status);
+            if (fReverse.fFlushes - flushes > kMaxFlushes) {
+                return kGaveUp;
+            }
+            trans = fReverse.fTrans.getBuffer();
+            flags = fReverse.fFlags.getBuffer();
+        }
+        state = next;
+        pos = input.getNativeIndex();
+        if (state >= 0 && (flags[state] & kStateAccept) != 0) {
+            matchStart = pos;
+        }
+    }
+    if (U_FAILURE(status)) {
+        return kGaveUp;
+    }
+    return matchStart >= 0 ? kMatch : kNoMatch;
+}
+
+
+RegexLazyDFA::EResult RegexLazyDFA::reverse(UText *text, int64_t end, int64_t lowerBound,
+                                            int64_t &matchStart, UErrorCode &status) {
+    int64_t length;
+    const char *utf8 = utext_getUTF8Source(text, &length);
+    if (utf8 != NULL) {
+        RegexUTF8Input input(utf8, length);
+        return reverseScan(input, end, lowerBound, matchStart, status);
+    }
+    RegexUTextInput input(text);
+    return reverseScan(input, end, lowerBound, matchStart, status);
+}
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_REGULAR_EXPRESSIONS
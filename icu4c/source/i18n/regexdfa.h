@@ -0,0 +1,234 @@
+// © 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+//
+//  regexdfa.h
+//
+//  This file contains declarations for the classes RegexDFAProgram and RegexLazyDFA,
+//  which together form a backtracking-free match engine for those regular expressions
+//  that use no back references, look-around, anchors, counted loops or other constructs
+//  that depend on more than the set of pattern positions reachable at an input position.
+//
+//  RegexDFAProgram is built by the pattern compiler and is part of the (immutable,
+//  shareable) RegexPattern. RegexLazyDFA holds the DFA states, which are built on demand
+//  while matching, and belongs to a single RegexMatcher.
+//
+//  These classes are internal to the regular expression implementation.
+//  For the public Regular Expression API, see the file "unicode/regex.h"
+//
+
+#ifndef REGEXDFA_H
+#define REGEXDFA_H
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_REGULAR_EXPRESSIONS
+
+#include "unicode/uobject.h"
+#include "unicode/utext.h"
+#include "cmemory.h"
+#include "hash.h"
+#include "uvector.h"
+#include "uvectr32.h"
+
+U_NAMESPACE_BEGIN
+
+class RegexPattern;
+class UnicodeSet;
+
+//
+//  RegexDFAProgram     A compiled pattern, re-expressed as a non-deterministic automaton
+//                      whose instructions are either epsilon moves (jumps and prioritized
+//                      splits) or consume one code point from a set.
+//
+//                      Code points are partitioned into equivalence classes, such that
+//                      all members of a class are accepted by exactly the same instructions.
+//                      The DFA transition tables are indexed by these classes.
+//
+class RegexDFAProgram : public UMemory {
+public:
+    // Build the program for a compiled pattern.
+    // Returns NULL if the pattern can not be run by the DFA engine, or on errors.
+    static RegexDFAProgram *createInstance(const RegexPattern *pattern, UErrorCode &status);
+
+    // Build a single program for a set of patterns, for RegexLazyDFA::findAll().
+    // Patterns that can not be run by the DFA engine (those without a program of their own)
+    // are left out; the kMatch instruction of each included pattern holds its index.
+    // Returns NULL if no pattern can be included, or on errors.
+    static RegexDFAProgram *createSetInstance(const RegexPattern *const *patterns, int32_t count,
+                                              UErrorCode &status);
+    ~RegexDFAProgram();
+
+    enum {
+        kConsume,       // Consume one code point of fSets[fSet], then continue at fNext.
+        kSplit,         // Continue at fNext, then (lower priority) at fAlt.
+        kJmp,           // Continue at fNext.
+        kMatch,         // Successful end of the pattern. In a set program, fSet is the pattern index.
+        kDead           // Failure; also unreachable filler instructions.
+    };
+
+    struct Inst {
+        int32_t  fType;
+        int32_t  fSet;
+        int32_t  fNext;
+        int32_t  fAlt;
+    };
+
+    inline int32_t classOf(UChar32 c) const;
+
+    inline UBool accepts(int32_t inst, int32_t cls) const {
+        return fMember[fInsts[inst].fSet * fNumClasses + cls] != 0;
+    }
+
+private:
+    RegexDFAProgram(UErrorCode &status);
+    UBool   build(const RegexPattern *pattern, int32_t matchValue, UHashtable *charSets,
+                  UErrorCode &status);
+    int32_t addInst(int32_t type, int32_t set, int32_t next, int32_t alt, UErrorCode &status);
+    int32_t addSet(UnicodeSet *set, UErrorCode &status);
+    int32_t addCharSet(UChar32 c, UHashtable *charSets, UErrorCode &status);
+    UBool   buildClasses(UErrorCode &status);
+    UBool   buildReverse(UErrorCode &status);
+    void    reachable(int32_t inst, int32_t *stamp, int32_t mark, UVector32 &stack,
+                      UVector32 &dest, UBool &match, UErrorCode &status);
+
+    MaybeStackArray<Inst, 32> fInsts;
+    int32_t         fNumInsts;
+    int32_t         fMaxInsts;
+    int32_t         fStart;             // The first instruction.
+    int32_t         fNumPatterns;       // Number of patterns, for a set program; otherwise 0.
+
+    UVector         fSets;              // The UnicodeSets consumed by kConsume instructions.
+
+    int32_t         fNumClasses;        // Number of code point equivalence classes.
+    uint16_t        fLatin1Classes[256];
+    UVector32       fBounds;            // Start of each code point range above Latin-1 ...
+    UVector32       fBoundClasses;      //   ... and its class.
+    MaybeStackArray<uint8_t, 256> fMember;  // fMember[set * fNumClasses + class] != 0
+                                        //   if the class is contained in the set.
+
+    // The reversed automaton, used to find the start of a match once its end is known.
+    // It is expressed in terms of the kConsume instructions only.
+    UVector32       fRevFollowStart;    // Index into fRevFollow, per instruction; one extra entry.
+    UVector32       fRevFollow;         // Instructions that may have consumed the
+                                        //   code point preceding the one consumed by an instruction.
+    UVector32       fRevStart;          // Instructions that can consume the last code point of a match.
+    MaybeStackArray<uint8_t, 32> fIsFirst;  // Nonzero for instructions that can consume the
+                                        //   first code point of a match.
+    UBool           fMatchesEmpty;      // True if the pattern can match an empty string.
+
+    friend class RegexLazyDFA;
+};
+
+inline int32_t RegexDFAProgram::classOf(UChar32 c) const {
+    if (c < 256) {
+        return fLatin1Classes[c];
+    }
+    // Binary search for the last range starting at or before c.
+    const int32_t *bounds = fBounds.getBuffer();
+    int32_t lo = 0;
+    int32_t hi = fBounds.size();
+    while (hi - lo > 1) {
+        int32_t mid = (lo + hi) / 2;
+        if (bounds[mid] <= c) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return fBoundClasses.elementAti(lo);
+}
+
+
+//
+//  RegexLazyDFA        The deterministic automaton for a RegexDFAProgram. States and transitions
+//                      are created as the input is scanned, and cached for subsequent use.
+//                      The cache is bounded; when it fills it is flushed and rebuilt.
+//
+class RegexLazyDFA : public UMemory {
+public:
+    RegexLazyDFA(const RegexDFAProgram *program, UErrorCode &status);
+    ~RegexLazyDFA();
+
+    enum EMode {
+        kFind,          // Leftmost match, starting anywhere at or after the start position.
+        kLookingAt,     // Match beginning at the start position.
+        kMatches,       // Match of the entire range from the start to the limit.
+        kFindAll        // Every pattern of a set program with a match anywhere in the range.
+    };
+
+    enum EResult {
+        kNoMatch,
+        kMatch,
+        kGaveUp         // The state cache thrashed; use the backtracking engine instead.
+    };
+
+    //  Scan forward from start. For a match, matchEnd is set to the end of the match that
+    //  the backtracking engine would report. hitEnd is set if the backtracking engine
+    //  would have examined the input at limit.
+    EResult forward(UText *text, int64_t start, int64_t limit, EMode mode,
+                    int64_t &matchEnd, UBool &hitEnd, UErrorCode &status);
+
+    //  Scan backwards from the end of a match found by forward(), to find the
+    //  leftmost position at or after lowerBound at which the match can begin.
+    EResult reverse(UText *text, int64_t end, int64_t lowerBound,
+                    int64_t &matchStart, UErrorCode &status);
+
+    //  For a set program: scan from start to limit once, setting matched[n] to TRUE
+    //  for each pattern n that has a match within the range. Entries for patterns
+    //  without a match are left unchanged. numMatched is the number of entries set.
+    EResult findAll(UText *text, int64_t start, int64_t limit,
+                    UBool *matched, int32_t &numMatched, UErrorCode &status);
+
+private:
+    //  The scans behind forward(), reverse() and findAll(), templates on the input
+    //  accessor class, RegexUTextInput or RegexUTF8Input.
+    template<class Input>
+    EResult forwardScan(Input &input, int64_t start, int64_t limit, EMode mode,
+                        int64_t &matchEnd, UBool &hitEnd, UErrorCode &status);
+    template<class Input>
+    EResult reverseScan(Input &input, int64_t end, int64_t lowerBound,
+                        int64_t &matchStart, UErrorCode &status);
+    template<class Input>
+    EResult findAllScan(Input &input, int64_t start, int64_t limit,
+                        UBool *matched, int32_t &numMatched, UErrorCode &status);
+
+    //  One set of cached states, for either the forward or the reverse automaton.
+    struct StateTable : public UMemory {
+        StateTable(int32_t numClasses, int32_t maxTransitions, UErrorCode &status);
+        ~StateTable();
+        int32_t intern(const UnicodeString &key, int32_t flags, UErrorCode &status);
+        void    flush();
+
+        Hashtable   fMap;           // State key -> state number + 1
+        UVector     fKeys;          // UnicodeString *, the key of each state.
+        UVector32   fTrans;         // Next state, by [state * numClasses + class].
+        UVector32   fFlags;         // Per state flags.
+        int32_t     fStarts[4];     // Cached initial states, by EMode, or -1.
+        int32_t     fNumClasses;
+        int32_t     fMaxStates;
+        int32_t     fFlushes;
+    };
+
+    void    newVisit();
+    UBool   addClosure(int32_t inst, UBool keepAll, UnicodeString &key, UErrorCode &status);
+    void    sortKey(UnicodeString &key);
+    int32_t internForward(const UnicodeString &key, UErrorCode &status);
+    int32_t forwardStart(EMode mode, UErrorCode &status);
+    int32_t forwardNext(int32_t state, int32_t cls, UErrorCode &status);
+    int32_t internReverse(const UnicodeString &key, UErrorCode &status);
+    int32_t reverseStart(UErrorCode &status);
+    int32_t reverseNext(int32_t state, int32_t cls, UErrorCode &status);
+
+    const RegexDFAProgram *fProgram;
+    StateTable      fForward;
+    StateTable      fReverse;
+    MaybeStackArray<int32_t, 32> fVisited;  // Per instruction, stamp of the last closure visit.
+    int32_t         fStamp;
+    UVector32       fWork;              // Closure stack.
+    UVector32       fReported;          // findAll(): per state, the scan that reported its matches.
+    int32_t         fScan;
+};
+
+U_NAMESPACE_END
+#endif   // !UCONFIG_NO_REGULAR_EXPRESSIONS
+#endif   // REGEXDFA_H
@@ -15,25 +15,29 @@
 #if !UCONFIG_NO_REGULAR_EXPRESSIONS
 #include "regeximp.h"
 #include "unicode/utf16.h"
+#include "cmemory.h"
 
 U_NAMESPACE_BEGIN
 
-CaseFoldingUTextIterator::CaseFoldingUTextIterator(UText &text) :
-   fUText(text), fFoldChars(NULL), fFoldLength(0) {
+CaseFoldingUCharIterator::CaseFoldingUCharIterator(const UChar *chars, int64_t start, int64_t limit) :
+   fChars(chars), fIndex(start), fLimit(limit), fFoldChars(NULL), fFoldLength(0) {
 }
 
-CaseFoldingUTextIterator::~CaseFoldingUTextIterator() {}
 
-UChar32 CaseFoldingUTextIterator::next() {
+CaseFoldingUCharIterator::~CaseFoldingUCharIterator() {}
+
+
+UChar32 CaseFoldingUCharIterator::next() {
     UChar32  foldedC;
     UChar32  originalC;
     if (fFoldChars == NULL) {
         // We are not in a string folding of an earlier character.
         // Start handling the next char from the input UText.
-        originalC = UTEXT_NEXT32(&fUText);
-        if (originalC == U_SENTINEL) {
-            return originalC;
+        if (fIndex >= fLimit) {
+            return U_SENTINEL;
         }
+        U16_NEXT(fChars, fIndex, fLimit, originalC);
+
         fFoldLength = ucase_toFullFolding(originalC, &fFoldChars, U_FOLD_CASE_DEFAULT);
         if (fFoldLength >= UCASE_MAX_STRING_LENGTH || fFoldLength < 0) {
             // input code point folds to a single code point, possibly itself.
@@ -57,63 +61,236 @@ UChar32 CaseFoldingUTextIterator::next() {
 }
     
 
-UBool CaseFoldingUTextIterator::inExpansion() {
+UBool CaseFoldingUCharIterator::inExpansion() {
     return fFoldChars != NULL;
 }
 
+int64_t CaseFoldingUCharIterator::getIndex() {
+    return fIndex;
+}
 
 
-CaseFoldingUCharIterator::CaseFoldingUCharIterator(const UChar *chars, int64_t start, int64_t limit) :
-   fChars(chars), fIndex(start), fLimit(limit), fFoldChars(NULL), fFoldLength(0) {
-}
+//
+//  RegexLiteralSearch
+//
+//  Text is scanned with memchr(), which C libraries implement with wide loads or
+//  SIMD instructions, for one byte of the code unit being searched for; the other
+//  byte and the rest of the string are then checked at each candidate position.
+//
 
+namespace {
 
-CaseFoldingUCharIterator::~CaseFoldingUCharIterator() {}
+// A rough measure of how common a code unit is in typical text; larger is more common.
+int32_t unitFrequency(UChar c) {
+    // Lower case letters in order of decreasing frequency in English text.
+    static const char kLetters[] = "etaoinshrdlcumwfgypbvkjxqz";
+    if (c >= 0x61 && c <= 0x7a) {
+        for (int32_t i = 0; kLetters[i] != 0; i++) {
+            if ((UChar)kLetters[i] == c) {
+                return 100 - i;
+            }
+        }
+    }
+    if (c == 0x20 || c == 0x0a || c == 0x2c || c == 0x2e) {     // space \n , .
+        return 100;
+    }
+    if ((c >= 0x41 && c <= 0x5a) || (c >= 0x30 && c <= 0x39)) {    // A-Z 0-9
+        return 60;
+    }
+    if (c < 0x80) {
+        return 30;
+    }
+    if (U16_IS_SURROGATE(c)) {
+        return 20;
+    }
+    // Other scripts: common in the text that uses them. A zero low byte is searched
+    //   for by its high byte, which is often shared by many other characters.
+    return (c & 0xff) == 0 ? 80 : 50;
+}
 
+}  // namespace
 
-UChar32 CaseFoldingUCharIterator::next() {
-    UChar32  foldedC;
-    UChar32  originalC;
-    if (fFoldChars == NULL) {
-        // We are not in a string folding of an earlier character.
-        // Start handling the next char from the input UText.
-        if (fIndex >= fLimit) {
-            return U_SENTINEL;
+int32_t RegexLiteralSearch::rarestUnit(const UChar *s, int32_t length) {
+    int32_t rarest = 0;
+    for (int32_t i = 1; i < length; i++) {
+        if (unitFrequency(s[i]) < unitFrequency(s[rarest])) {
+            rarest = i;
         }
-        U16_NEXT(fChars, fIndex, fLimit, originalC);
+    }
+    return rarest;
+}
 
-        fFoldLength = ucase_toFullFolding(originalC, &fFoldChars, U_FOLD_CASE_DEFAULT);
-        if (fFoldLength >= UCASE_MAX_STRING_LENGTH || fFoldLength < 0) {
-            // input code point folds to a single code point, possibly itself.
-            // See comment in ucase.h for explanation of return values from ucase_toFullFoldings.
-            if (fFoldLength < 0) {
-                fFoldLength = ~fFoldLength;
+int32_t RegexLiteralSearch::findUnit(const UChar *text, int32_t start, int32_t limit, UChar c) {
+    if (start >= limit) {
+        return -1;
+    }
+    // Search for the low byte of c, unless it is zero, which is common in most text.
+    uint8_t b = (uint8_t)c;
+    int32_t byteIndex = U_IS_BIG_ENDIAN ? 1 : 0;
+    if (b == 0) {
+        b = (uint8_t)(c >> 8);
+        byteIndex ^= 1;
+    }
+    const uint8_t *bytes = (const uint8_t *)text;
+    const uint8_t *p = bytes + 2 * (size_t)start + byteIndex;
+    const uint8_t *end = bytes + 2 * (size_t)limit;
+    while (p < end) {
+        p = (const uint8_t *)uprv_memchr(p, b, end - p);
+        if (p == NULL) {
+            break;
+        }
+        size_t offset = p - bytes;
+        if ((int32_t)(offset & 1) == byteIndex) {
+            int32_t i = (int32_t)(offset >> 1);
+            if (text[i] == c) {
+                return i;
             }
-            foldedC = (UChar32)fFoldLength;
-            fFoldChars = NULL;
-            return foldedC;
+            p += 2;
+        } else {
+            // The other byte of a code unit.
+            ++p;
         }
-        // String foldings fall through here.
-        fFoldIndex = 0;
     }
+    return -1;
+}
 
-    U16_NEXT(fFoldChars, fFoldIndex, fFoldLength, foldedC);
-    if (fFoldIndex >= fFoldLength) {
-        fFoldChars = NULL;
+int32_t RegexLiteralSearch::find(const UChar *text, int32_t start, int32_t limit,
+                                 const UChar *s, int32_t length, int32_t scan) {
+    UChar c = s[scan];
+    int32_t last = limit - length + scan;     // The last possible index of c.
+    for (int32_t i = start + scan; i <= last; i++) {
+        i = findUnit(text, i, last + 1, c);
+        if (i < 0) {
+            break;
+        }
+        int32_t candidate = i - scan;
+        if (uprv_memcmp(text + candidate, s, length * U_SIZEOF_UCHAR) == 0) {
+            return candidate;
+        }
     }
-    return foldedC;
+    return -1;
 }
-    
 
-UBool CaseFoldingUCharIterator::inExpansion() {
-    return fFoldChars != NULL;
+RegexMemo::RegexMemo(const int64_t *pat, int32_t patLength, UErrorCode &status) :
+        fNumSlots(0), fBits(NULL), fBitsCapacity(0), fDirty(NULL), fDirtyCount(0), fDirtyCapacity(0),
+        fStart(0), fLimit(-1), fToEnd(FALSE), fValid(FALSE) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (patLength > fSlots.getCapacity() && fSlots.resize(patLength) == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < patLength; i++) {
+        fSlots[i] = -1;
+    }
+    // The joins are the destinations of jumps and state saves, and the continuations of
+    //   the optimized loops.  The URX_FAIL at the bottom of the backtrack stack is not one.
+    int32_t numSlots = 0;
+    for (int32_t i = 0; i < patLength; i++) {
+        int32_t op = (int32_t)pat[i];
+        int32_t opValue = URX_VAL(op);
+        int32_t joins[2] = { -1, -1 };
+        switch (URX_TYPE(op)) {
+        case URX_STATE_SAVE:
+        case URX_JMP:
+            joins[0] = opValue;
+            break;
+        case URX_JMP_SAV:
+            joins[0] = opValue;
+            joins[1] = i + 1;
+            break;
+        case URX_LOOP_C:
+            joins[0] = i + 1;
+            break;
+        case URX_BACKREF:
+        case URX_BACKREF_I:
+        case URX_CTR_INIT:
+        case URX_CTR_INIT_NG:
+        case URX_CTR_LOOP:
+        case URX_CTR_LOOP_NG:
+        case URX_STO_SP:
+        case URX_LD_SP:
+        case URX_STO_INP_LOC:
+        case URX_JMPX:
+        case URX_JMP_SAV_X:
+        case URX_LA_START:
+        case URX_LA_END:
+        case URX_LB_START:
+        case URX_LB_CONT:
+        case URX_LB_END:
+        case URX_LBN_CONT:
+        case URX_LBN_END:
+            // The outcome of a match from these depends on more than the input position.
+            return;
+        default:
+            break;
+        }
+        for (int32_t j = 0; j < 2; j++) {
+            int32_t join = joins[j];
+            if (join >= 0 && join < patLength && fSlots[join] < 0 && URX_TYPE(pat[join]) != URX_FAIL) {
+                fSlots[join] = numSlots++;
+            }
+        }
+    }
+    fNumSlots = numSlots;
 }
 
-int64_t CaseFoldingUCharIterator::getIndex() {
-    return fIndex;
+
+RegexMemo::~RegexMemo() {
+    uprv_free(fBits);
+    uprv_free(fDirty);
 }
 
 
+UBool RegexMemo::begin(int64_t start, int64_t limit, UBool toEnd, int32_t maxBytes, UErrorCode &status) {
+    if (U_FAILURE(status) || fNumSlots == 0) {
+        return FALSE;
+    }
+    if (fValid && start == fStart && limit == fLimit && toEnd == fToEnd) {
+        return TRUE;
+    }
+    clear();
+    fValid = FALSE;
+    int64_t numWords = ((limit - start + 1) * fNumSlots + 31) / 32;
+    if ((maxBytes > 0 && numWords * 4 > maxBytes) || numWords > INT32_MAX / 4) {
+        return FALSE;
+    }
+    if (numWords > fBitsCapacity) {
+        uprv_free(fBits);
+        uprv_free(fDirty);
+        fBitsCapacity = 0;
+        fDirtyCapacity = 0;
+        int32_t dirtyCapacity = (int32_t)(numWords / 32) + 16;
+        fBits = (uint32_t *)uprv_malloc(numWords * 4);
+        fDirty = (int32_t *)uprv_malloc(dirtyCapacity * 4);
+        if (fBits == NULL || fDirty == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return FALSE;
+        }
+        uprv_memset(fBits, 0, numWords * 4);
+        fBitsCapacity = (int32_t)numWords;
+        fDirtyCapacity = dirtyCapacity;
+    }
+    fStart = start;
+    fLimit = limit;
+    fToEnd = toEnd;
+    fValid = TRUE;
+    return TRUE;
+}
+
+
+void RegexMemo::clear() {
+    if (fDirtyCount > fDirtyCapacity) {
+        uprv_memset(fBits, 0, fBitsCapacity * 4);
+    } else {
+        for (int32_t i = 0; i < fDirtyCount; i++) {
+            fBits[fDirty[i]] = 0;
+        }
+    }
+    fDirtyCount = 0;
+}
+
 U_NAMESPACE_END
 
 #endif
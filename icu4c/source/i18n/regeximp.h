@@ -18,6 +18,7 @@
 #include "unicode/uobject.h"
 #include "unicode/uniset.h"
 #include "unicode/utext.h"
+#include "unicode/utf16.h"
 
 #include "cmemory.h"
 #include "ucase.h"
@@ -357,27 +358,53 @@ inline void Regex8BitSet::operator = (const Regex8BitSet &s) {
 }
 
 
-//  Case folded UText Iterator helper class.
-//  Wraps a UText, provides a case-folded enumeration over its contents.
+//  Case folded Iterator over the input of the backtracking match engine.
 //  Used in implementing case insensitive matching constructs.
-//  Implementation in rematch.cpp
 
-class CaseFoldingUTextIterator: public UMemory {
+template<class Input>
+class CaseFoldingInputIterator: public UMemory {
       public:
-        CaseFoldingUTextIterator(UText &text);
-        ~CaseFoldingUTextIterator();
+        CaseFoldingInputIterator(Input &input) :
+            fInput(input), fFoldChars(NULL), fFoldLength(0), fFoldIndex(0) {}
+
+        UChar32 next() {          // Next case folded character
+            UChar32  foldedC;
+            if (fFoldChars == NULL) {
+                // We are not in a string folding of an earlier character.
+                // Start handling the next char from the input.
+                UChar32 originalC = fInput.next32();
+                if (originalC == U_SENTINEL) {
+                    return originalC;
+                }
+                fFoldLength = ucase_toFullFolding(originalC, &fFoldChars, U_FOLD_CASE_DEFAULT);
+                if (fFoldLength >= UCASE_MAX_STRING_LENGTH || fFoldLength < 0) {
+                    // input code point folds to a single code point, possibly itself.
+                    if (fFoldLength < 0) {
+                        fFoldLength = ~fFoldLength;
+                    }
+                    foldedC = (UChar32)fFoldLength;
+                    fFoldChars = NULL;
+                    return foldedC;
+                }
+                // String foldings fall through here.
+                fFoldIndex = 0;
+            }
+            U16_NEXT(fFoldChars, fFoldIndex, fFoldLength, foldedC);
+            if (fFoldIndex >= fFoldLength) {
+                fFoldChars = NULL;
+            }
+            return foldedC;
+        }
 
-        UChar32 next();           // Next case folded character
+        UBool   inExpansion() {   // True if last char returned from next() and the
+            return fFoldChars != NULL;  //  next to be returned both originated from a string
+        }                               //  folding of the same code point from the input.
 
-        UBool   inExpansion();    // True if last char returned from next() and the
-                                  //  next to be returned both originated from a string
-                                  //  folding of the same code point from the orignal UText.
       private:
-        UText             &fUText;
+        Input             &fInput;
         const  UChar      *fFoldChars;
         int32_t            fFoldLength;
         int32_t            fFoldIndex;
-
 };
 
 
@@ -409,6 +436,99 @@ class CaseFoldingUCharIterator: public UMemory {
 
 };
 
+//  Literal string search in UTF-16 text.
+//  Used by find() to skip over text that can not contain a match.
+//  Implementation in regeximp.cpp
+
+class RegexLiteralSearch {
+      public:
+        // The index of the code unit of s that is least likely to occur in text.
+        //   Searching for it first leaves the fewest candidate positions to check.
+        static int32_t rarestUnit(const UChar *s, int32_t length);
+
+        // The index of the first occurrence of c in text[start, limit), or -1.
+        static int32_t findUnit(const UChar *text, int32_t start, int32_t limit, UChar c);
+
+        // The index of the first occurrence of s in text[start, limit), or -1.
+        //   scan is the index within s of the code unit to search for first,
+        //   normally the one returned by rarestUnit().
+        static int32_t find(const UChar *text, int32_t start, int32_t limit,
+                            const UChar *s, int32_t length, int32_t scan);
+};
+
+//  Memo of the states from which the backtracking match engine has already tried to
+//  match, for RegexMatcher::setMemoizeBacktracking().
+//  A state is a location in the compiled pattern where paths through the pattern
+//  join, together with an input position.  Once the engine has tried to match from a
+//  state, arriving there again by another path can only repeat the same failure,
+//  so that path is abandoned at once.  This holds only for patterns in which the
+//  outcome depends on nothing but the state: no back references, look-around,
+//  atomic groups, counted loops or loops over expressions that can match the empty
+//  string.  For other patterns the memo is not usable.
+//  Implementation in regeximp.cpp
+
+class RegexMemo : public UMemory {
+  public:
+    RegexMemo(const int64_t *pat, int32_t patLength, UErrorCode &status);
+    ~RegexMemo();
+
+    UBool isUsable() const { return fNumSlots > 0; }
+
+    // Prepares for a match within input positions [start, limit].  The states recorded
+    //   by earlier matches are kept unless one of the parameters differs.
+    //   Returns FALSE, and the memo must not be used for the match, if the pattern
+    //   is not usable, or if maxBytes is not zero and the table would be larger.
+    UBool begin(int64_t start, int64_t limit, UBool toEnd, int32_t maxBytes, UErrorCode &status);
+
+    // Forgets all states.  Must be called when a match succeeds, since its path did
+    //   not try everything from the states that it passed through, and when the
+    //   input or the kind of match operation may have changed.
+    void clear();
+
+    // Returns TRUE if matching was already tried from the state,
+    //   otherwise records it and returns FALSE.
+    inline UBool visit(int64_t patIdx, int64_t inputIdx);
+
+  private:
+    RegexMemo(const RegexMemo &other); // forbid copying of this class
+    RegexMemo &operator=(const RegexMemo &other); // forbid copying of this class
+
+    MaybeStackArray<int32_t, 64> fSlots;   // For each pattern location, its bit in a row of
+                                           //   the table, or -1 if paths do not join there.
+    int32_t     fNumSlots;
+    uint32_t   *fBits;                     // The table, a row of fNumSlots bits per input position.
+    int32_t     fBitsCapacity;             //   In words.
+    int32_t    *fDirty;                    // The words of fBits that are not zero, so that
+    int32_t     fDirtyCount;               //   clear() need not touch the others.  If there are
+    int32_t     fDirtyCapacity;            //   too many, clear() zeroes the whole table.
+    int64_t     fStart;
+    int64_t     fLimit;
+    UBool       fToEnd;
+    UBool       fValid;                    // False if the table is not set up for any match.
+};
+
+inline UBool RegexMemo::visit(int64_t patIdx, int64_t inputIdx) {
+    int32_t slot = fSlots[(int32_t)patIdx];
+    if (slot < 0 || inputIdx < fStart || inputIdx > fLimit) {
+        return FALSE;
+    }
+    int64_t bit = (inputIdx - fStart) * fNumSlots + slot;
+    int32_t wordIndex = (int32_t)(bit >> 5);
+    uint32_t mask = (uint32_t)1 << (bit & 31);
+    uint32_t word = fBits[wordIndex];
+    if ((word & mask) != 0) {
+        return TRUE;
+    }
+    if (word == 0) {
+        if (fDirtyCount < fDirtyCapacity) {
+            fDirty[fDirtyCount] = wordIndex;
+        }
+        ++fDirtyCount;
+    }
+    fBits[wordIndex] = word | mask;
+    return FALSE;
+}
+
 U_NAMESPACE_END
 #endif
 
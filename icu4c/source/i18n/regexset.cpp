@@ -0,0 +1,257 @@
+// © 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+//
+//  file:  regexset.cpp
+//
+//  Contains the implementation of class RegexSet, which matches a collection of
+//  regular expressions against an input together.
+//
+//  The patterns that the DFA engine can run are combined into one RegexDFAProgram,
+//  and a single RegexLazyDFA scan reports all of them that match.  Each of the
+//  other patterns is run by its own RegexMatcher.
+//
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_REGULAR_EXPRESSIONS
+
+#include "unicode/regex.h"
+#include "unicode/utext.h"
+#include "cmemory.h"
+#include "uassert.h"
+#include "uvector.h"
+#include "regexdfa.h"
+
+U_NAMESPACE_BEGIN
+
+//--------------------------------------------------------------------------
+//
+//    Constructor, Destructor
+//
+//--------------------------------------------------------------------------
+RegexSet::RegexSet(UErrorCode &status) :
+        fPatterns(NULL), fMatchers(NULL), fProgram(NULL), fDFA(NULL), fProgramIsCurrent(FALSE) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    fPatterns = new UVector(uprv_deleteUObject, NULL, status);
+    fMatchers = new UVector(uprv_deleteUObject, NULL, status);
+    if ((fPatterns == NULL || fMatchers == NULL) && U_SUCCESS(status)) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+    }
+}
+
+
+RegexSet::~RegexSet() {
+    delete fDFA;
+    delete fProgram;
+    delete fMatchers;
+    delete fPatterns;
+}
+
+
+//--------------------------------------------------------------------------
+//
+//    add
+//
+//--------------------------------------------------------------------------
+int32_t RegexSet::add(const UnicodeString &regex, uint32_t flags, UParseError &pe, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return -1;
+    }
+    if (fPatterns == NULL || fMatchers == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return -1;
+    }
+    LocalPointer<RegexPattern> pattern(RegexPattern::compile(regex, flags, pe, status), status);
+    if (U_FAILURE(status)) {
+        return -1;
+    }
+    fPatterns->addElement(pattern.getAlias(), status);
+    if (U_FAILURE(status)) {
+        return -1;
+    }
+    pattern.orphan();
+    fMatchers->addElement((void *)NULL, status);
+    if (U_FAILURE(status)) {
+        delete (RegexPattern *)fPatterns->orphanElementAt(fPatterns->size() - 1);
+        return -1;
+    }
+    fProgramIsCurrent = FALSE;
+    return fPatterns->size() - 1;
+}
+
+
+int32_t RegexSet::add(const UnicodeString &regex, uint32_t flags, UErrorCode &status) {
+    UParseError pe;
+    return add(regex, flags, pe, status);
+}
+
+
+int32_t RegexSet::size() const {
+    return fPatterns != NULL ? fPatterns->size() : 0;
+}
+
+
+const RegexPattern *RegexSet::getPattern(int32_t index) const {
+    if (index < 0 || index >= size()) {
+        return NULL;
+    }
+    return (const RegexPattern *)fPatterns->elementAt(index);
+}
+
+
+//--------------------------------------------------------------------------
+//
+//    buildProgram     Combine the patterns that the DFA engine can run.
+//                     If they exceed the limits of the DFA engine, there is no
+//                     program, and all of the patterns are run separately.
+//
+//--------------------------------------------------------------------------
+void RegexSet::buildProgram(UErrorCode &status) {
+    delete fDFA;
+    fDFA = NULL;
+    delete fProgram;
+    fProgram = NULL;
+    if (U_FAILURE(status)) {
+        return;
+    }
+    int32_t count = size();
+    MaybeStackArray<const RegexPattern *, 32> patterns;
+    if (count > patterns.getCapacity() && patterns.resize(count) == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < count; i++) {
+        patterns[i] = getPattern(i);
+    }
+    fProgram = RegexDFAProgram::createSetInstance(patterns.getAlias(), count, status);
+    if (fProgram != NULL) {
+        fDFA = new RegexLazyDFA(fProgram, status);
+        if (fDFA == NULL && U_SUCCESS(status)) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+        }
+    }
+    if (U_FAILURE(status)) {
+        delete fDFA;
+        fDFA = NULL;
+        delete fProgram;
+        fProgram = NULL;
+        return;
+    }
+    fProgramIsCurrent = TRUE;
+}
+
+
+RegexMatcher *RegexSet::getMatcher(int32_t index, UErrorCode &status) {
+    RegexMatcher *matcher = (RegexMatcher *)fMatchers->elementAt(index);
+    if (matcher == NULL && U_SUCCESS(status)) {
+        matcher = getPattern(index)->matcher(status);
+        if (U_FAILURE(status)) {
+            delete matcher;
+            return NULL;
+        }
+        fMatchers->setElementAt(matcher, index);
+    }
+    return matcher;
+}
+
+
+//--------------------------------------------------------------------------
+//
+//    findAll
+//
+//--------------------------------------------------------------------------
+int32_t RegexSet::findAll(const UnicodeString &input, int32_t *dest, int32_t destCapacity,
+                          UErrorCode &status) {
+    UText inputText = UTEXT_INITIALIZER;
+    utext_openConstUnicodeString(&inputText, &input, &status);
+    int32_t count = findAll(&inputText, dest, NULL, NULL, destCapacity, status);
+    utext_close(&inputText);
+    return count;
+}
+
+
+int32_t RegexSet::findAll(UText *input, int32_t *dest, int64_t *starts, int64_t *ends,
+                          int32_t destCapacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (input == NULL || destCapacity < 0 || (destCapacity > 0 && dest == NULL)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if (fPatterns == NULL || fMatchers == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return 0;
+    }
+    if (!fProgramIsCurrent) {
+        buildProgram(status);
+        if (U_FAILURE(status)) {
+            return 0;
+        }
+    }
+
+    int32_t count = size();
+    MaybeStackArray<UBool, 64> matched;
+    if (count > matched.getCapacity() && matched.resize(count) == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return 0;
+    }
+    uprv_memset(matched.getAlias(), 0, count * sizeof(UBool));
+
+    // One scan for all of the patterns in the combined program.
+    // If the scan gives up, the patterns that it did not report are run separately.
+    UBool scanned = FALSE;
+    if (fDFA != NULL) {
+        int32_t numMatched;
+        RegexLazyDFA::EResult result = fDFA->findAll(input, 0, utext_nativeLength(input),
+                                                     matched.getAlias(), numMatched, status);
+        if (U_FAILURE(status)) {
+            return 0;
+        }
+        scanned = result != RegexLazyDFA::kGaveUp;
+    }
+
+    UBool wantPositions = starts != NULL || ends != NULL;
+    int32_t numFound = 0;
+    for (int32_t i = 0; i < count && U_SUCCESS(status); i++) {
+        UBool inProgram = scanned && getPattern(i)->fDFAProgram != NULL;
+        UBool store = numFound < destCapacity;
+        if ((!matched[i] && !inProgram) || (matched[i] && wantPositions && store)) {
+            RegexMatcher *matcher = getMatcher(i, status);
+            if (U_FAILURE(status)) {
+                break;
+            }
+            matcher->reset(input);
+            matched[i] = matcher->find(status);
+            if (matched[i] && store) {
+                if (starts != NULL) {
+                    starts[numFound] = matcher->start64(status);
+                }
+                if (ends != NULL) {
+                    ends[numFound] = matcher->end64(status);
+                }
+            }
+        }
+        if (matched[i]) {
+            if (store) {
+                dest[numFound] = i;
+            }
+            ++numFound;
+        }
+    }
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (numFound > destCapacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return numFound;
+}
+
+UOBJECT_DEFINE_RTTI_IMPLEMENTATION(RegexSet)
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_REGULAR_EXPRESSIONS
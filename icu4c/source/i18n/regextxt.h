@@ -19,6 +19,7 @@
 
 #include "unicode/utypes.h"
 #include "unicode/utext.h"
+#include "unicode/utf8.h"
 
 U_NAMESPACE_BEGIN
 
@@ -34,6 +35,83 @@ U_NAMESPACE_BEGIN
 #  define UTEXT_FULL_TEXT_IN_CHUNK(ut,len) ((0==((ut)->chunkNativeStart))&&((len)==((ut)->chunkNativeLimit))&&((len)==((ut)->nativeIndexingLimit)))
 #endif
 
+//  Input accessors for the match engines, which are templates on the accessor class.
+//  Both provide the subset of the UText inline macros that the engines use, with
+//  native indexes.
+
+//  Reads any UText.
+class RegexUTextInput {
+      public:
+        RegexUTextInput(UText *text) : fText(text) {}
+
+        inline void     setNativeIndex(int64_t index) { UTEXT_SETNATIVEINDEX(fText, index); }
+        inline int64_t  getNativeIndex() const        { return UTEXT_GETNATIVEINDEX(fText); }
+        inline UChar32  next32()                      { return UTEXT_NEXT32(fText); }
+        inline UChar32  previous32()                  { return UTEXT_PREVIOUS32(fText); }
+        inline UChar32  current32()                   { return UTEXT_CURRENT32(fText); }
+        inline UBool    usesU16() const               { return UTEXT_USES_U16(fText); }
+
+      private:
+        UText      *fText;
+};
+
+//  Reads a UTF-8 string directly, for a UText from utext_openUTF8().
+//  Native indexes are byte offsets, and ill-formed sequences read as U+FFFD,
+//  the same as with the UText.
+class RegexUTF8Input {
+      public:
+        RegexUTF8Input(const char *s, int64_t length) :
+            fText((const uint8_t *)s), fLength((int32_t)length), fIndex(0) {}
+
+        inline void setNativeIndex(int64_t index) {
+            if (index <= 0) {
+                fIndex = 0;
+            } else if (index >= fLength) {
+                fIndex = fLength;
+            } else {
+                fIndex = (int32_t)index;
+                U8_SET_CP_START(fText, 0, fIndex);
+            }
+        }
+        inline int64_t getNativeIndex() const {
+            return fIndex;
+        }
+        inline UChar32 next32() {
+            if (fIndex >= fLength) {
+                return U_SENTINEL;
+            }
+            UChar32 c;
+            U8_NEXT_OR_FFFD(fText, fIndex, fLength, c);
+            return c;
+        }
+        inline UChar32 previous32() {
+            if (fIndex <= 0) {
+                return U_SENTINEL;
+            }
+            UChar32 c;
+            U8_PREV_OR_FFFD(fText, 0, fIndex, c);
+            return c;
+        }
+        inline UChar32 current32() {
+            if (fIndex >= fLength) {
+                return U_SENTINEL;
+            }
+            int32_t i = fIndex;
+            UChar32 c;
+            U8_NEXT_OR_FFFD(fText, i, fLength, c);
+            return c;
+        }
+        inline UBool usesU16() const {
+            return FALSE;
+        }
+
+      private:
+        const uint8_t  *fText;
+        int32_t         fLength;
+        int32_t         fIndex;
+};
+
+
 struct URegexUTextUnescapeCharContext {
     UText *text;
     int32_t lastOffset;
@@ -29,6 +29,7 @@
 #include "uvector.h"
 #include "uvectr32.h"
 #include "uvectr64.h"
+#include "regexdfa.h"
 #include "regeximp.h"
 #include "regexst.h"
 #include "regextxt.h"
@@ -178,6 +179,8 @@ RegexMatcher::~RegexMatcher() {
     #if UCONFIG_NO_BREAK_ITERATION==0
     delete fWordBreakItr;
     #endif
+    delete fDFA;
+    delete fMemo;
 }
 
 //
@@ -214,6 +217,7 @@ void RegexMatcher::init(UErrorCode &status) {
     fTime              = 0;
     fTickCounter       = 0;
     fStackLimit        = DEFAULT_BACKTRACK_STACK_CAPACITY;
+    fStackReserve      = 0;
     fCallbackFn        = NULL;
     fCallbackContext   = NULL;
     fFindProgressCallbackFn      = NULL;
@@ -222,6 +226,10 @@ void RegexMatcher::init(UErrorCode &status) {
     fDeferredStatus    = status;
     fData              = fSmallData;
     fWordBreakItr      = NULL;
+    fDFA               = NULL;
+    fUseDFA            = TRUE;
+    fMemo              = NULL;
+    fRequiredStringPos = -1;
 
     fStack             = NULL;
     fInputText         = NULL;
@@ -634,6 +642,11 @@ UBool RegexMatcher::find(UErrorCode &status) {
         status = fDeferredStatus;
         return FALSE;
     }
+    if (fMemo != NULL) {
+        // The match attempts at successive positions share the memo, since each
+        //   tries everything from the states that it records before it fails.
+        fMemo->clear();
+    }
 
     if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         return findUsingChunk(status);
@@ -689,6 +702,30 @@ UBool RegexMatcher::find(UErrorCode &status) {
         testStartLimit = fActiveLimit - (fPattern->fMinMatchLen > 0 ? 1 : 0);
     }
 
+    if (findUsingDFA(startPos, status)) {
+        return U_SUCCESS(status) && fMatch;
+    }
+
+    const char *utf8 = utext_getUTF8Source(fInputText, NULL);
+    if (utf8 != NULL) {
+        RegexUTF8Input input(utf8, fInputLength);
+        return findUsingInput(input, startPos, testStartLimit, status);
+    }
+    RegexUTextInput input(fInputText);
+    return findUsingInput(input, startPos, testStartLimit, status);
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   findUsingInput() -- the part of find() that tries matches at successive
+//                       positions, reading the input through a RegexUTextInput
+//                       or a RegexUTF8Input.
+//
+//--------------------------------------------------------------------------------
+template<class Input>
+UBool RegexMatcher::findUsingInput(Input &input, int64_t startPos, int64_t testStartLimit,
+                                   UErrorCode &status) {
     UChar32  c;
     U_ASSERT(startPos >= 0);
 
@@ -697,7 +734,7 @@ UBool RegexMatcher::find(UErrorCode &status) {
         // No optimization was found.
         //  Try a match at each input position.
         for (;;) {
-            MatchAt(startPos, FALSE, status);
+            MatchInputAt(input, startPos, FALSE, status);
             if (U_FAILURE(status)) {
                 return FALSE;
             }
@@ -708,9 +745,9 @@ UBool RegexMatcher::find(UErrorCode &status) {
                 fHitEnd = TRUE;
                 return FALSE;
             }
-            UTEXT_SETNATIVEINDEX(fInputText, startPos);
-            (void)UTEXT_NEXT32(fInputText);
-            startPos = UTEXT_GETNATIVEINDEX(fInputText);
+            input.setNativeIndex(startPos);
+            (void)input.next32();
+            startPos = input.getNativeIndex();
             // Note that it's perfectly OK for a pattern to have a zero-length
             //   match at the end of a string, so we must make sure that the loop
             //   runs with startPos == testStartLimit the last time through.
@@ -726,7 +763,7 @@ UBool RegexMatcher::find(UErrorCode &status) {
             fMatch = FALSE;
             return FALSE;
         }
-        MatchAt(startPos, FALSE, status);
+        MatchInputAt(input, startPos, FALSE, status);
         if (U_FAILURE(status)) {
             return FALSE;
         }
@@ -737,24 +774,24 @@ UBool RegexMatcher::find(UErrorCode &status) {
         {
             // Match may start on any char from a pre-computed set.
             U_ASSERT(fPattern->fMinMatchLen > 0);
-            UTEXT_SETNATIVEINDEX(fInputText, startPos);
+            input.setNativeIndex(startPos);
             for (;;) {
                 int64_t pos = startPos;
-                c = UTEXT_NEXT32(fInputText);
-                startPos = UTEXT_GETNATIVEINDEX(fInputText);
+                c = input.next32();
+                startPos = input.getNativeIndex();
                 // c will be -1 (U_SENTINEL) at end of text, in which case we
                 // skip this next block (so we don't have a negative array index)
                 // and handle end of text in the following block.
                 if (c >= 0 && ((c<256 && fPattern->fInitialChars8->contains(c)) ||
                               (c>=256 && fPattern->fInitialChars->contains(c)))) {
-                    MatchAt(pos, FALSE, status);
+                    MatchInputAt(input, pos, FALSE, status);
                     if (U_FAILURE(status)) {
                         return FALSE;
                     }
                     if (fMatch) {
                         return TRUE;
                     }
-                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                    input.setNativeIndex(pos);
                 }
                 if (startPos > testStartLimit) {
                     fMatch = FALSE;
@@ -773,20 +810,20 @@ UBool RegexMatcher::find(UErrorCode &status) {
             // Match starts on exactly one char.
             U_ASSERT(fPattern->fMinMatchLen > 0);
             UChar32 theChar = fPattern->fInitialChar;
-            UTEXT_SETNATIVEINDEX(fInputText, startPos);
+            input.setNativeIndex(startPos);
             for (;;) {
                 int64_t pos = startPos;
-                c = UTEXT_NEXT32(fInputText);
-                startPos = UTEXT_GETNATIVEINDEX(fInputText);
+                c = input.next32();
+                startPos = input.getNativeIndex();
                 if (c == theChar) {
-                    MatchAt(pos, FALSE, status);
+                    MatchInputAt(input, pos, FALSE, status);
                     if (U_FAILURE(status)) {
                         return FALSE;
                     }
                     if (fMatch) {
                         return TRUE;
                     }
-                    UTEXT_SETNATIVEINDEX(fInputText, startPos);
+                    input.setNativeIndex(startPos);
                 }
                 if (startPos > testStartLimit) {
                     fMatch = FALSE;
@@ -803,41 +840,41 @@ UBool RegexMatcher::find(UErrorCode &status) {
         {
             UChar32  c;
             if (startPos == fAnchorStart) {
-                MatchAt(startPos, FALSE, status);
+                MatchInputAt(input, startPos, FALSE, status);
                 if (U_FAILURE(status)) {
                     return FALSE;
                 }
                 if (fMatch) {
                     return TRUE;
                 }
-                UTEXT_SETNATIVEINDEX(fInputText, startPos);
-                c = UTEXT_NEXT32(fInputText);
-                startPos = UTEXT_GETNATIVEINDEX(fInputText);
+                input.setNativeIndex(startPos);
+                c = input.next32();
+                startPos = input.getNativeIndex();
             } else {
-                UTEXT_SETNATIVEINDEX(fInputText, startPos);
-                c = UTEXT_PREVIOUS32(fInputText);
-                UTEXT_SETNATIVEINDEX(fInputText, startPos);
+                input.setNativeIndex(startPos);
+                c = input.previous32();
+                input.setNativeIndex(startPos);
             }
 
             if (fPattern->fFlags & UREGEX_UNIX_LINES) {
                 for (;;) {
                     if (c == 0x0a) {
-                            MatchAt(startPos, FALSE, status);
+                            MatchInputAt(input, startPos, FALSE, status);
                             if (U_FAILURE(status)) {
                                 return FALSE;
                             }
                             if (fMatch) {
                                 return TRUE;
                             }
-                            UTEXT_SETNATIVEINDEX(fInputText, startPos);
+                            input.setNativeIndex(startPos);
                     }
                     if (startPos >= testStartLimit) {
                         fMatch = FALSE;
                         fHitEnd = TRUE;
                         return FALSE;
                     }
-                    c = UTEXT_NEXT32(fInputText);
-                    startPos = UTEXT_GETNATIVEINDEX(fInputText);
+                    c = input.next32();
+                    startPos = input.getNativeIndex();
                     // Note that it's perfectly OK for a pattern to have a zero-length
                     //   match at the end of a string, so we must make sure that the loop
                     //   runs with startPos == testStartLimit the last time through.
@@ -847,26 +884,26 @@ UBool RegexMatcher::find(UErrorCode &status) {
             } else {
                 for (;;) {
                     if (isLineTerminator(c)) {
-                        if (c == 0x0d && startPos < fActiveLimit && UTEXT_CURRENT32(fInputText) == 0x0a) {
-                            (void)UTEXT_NEXT32(fInputText);
-                            startPos = UTEXT_GETNATIVEINDEX(fInputText);
+                        if (c == 0x0d && startPos < fActiveLimit && input.current32() == 0x0a) {
+                            (void)input.next32();
+                            startPos = input.getNativeIndex();
                         }
-                        MatchAt(startPos, FALSE, status);
+                        MatchInputAt(input, startPos, FALSE, status);
                         if (U_FAILURE(status)) {
                             return FALSE;
                         }
                         if (fMatch) {
                             return TRUE;
                         }
-                        UTEXT_SETNATIVEINDEX(fInputText, startPos);
+                        input.setNativeIndex(startPos);
                     }
                     if (startPos >= testStartLimit) {
                         fMatch = FALSE;
                         fHitEnd = TRUE;
                         return FALSE;
                     }
-                    c = UTEXT_NEXT32(fInputText);
-                    startPos = UTEXT_GETNATIVEINDEX(fInputText);
+                    c = input.next32();
+                    startPos = input.getNativeIndex();
                     // Note that it's perfectly OK for a pattern to have a zero-length
                     //   match at the end of a string, so we must make sure that the loop
                     //   runs with startPos == testStartLimit the last time through.
@@ -960,12 +997,16 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
     //          Be aware of possible overflows if making changes here.
     //   Note:  a match can begin at inputBuf + testLen; it is an inclusive limit.
     int32_t testLen  = (int32_t)(fActiveLimit - fPattern->fMinMatchLen);
-    if (startPos > testLen) {
+    if (startPos > testLen || !skipToLiteralInChunk(startPos, testLen)) {
         fMatch = FALSE;
         fHitEnd = TRUE;
         return FALSE;
     }
 
+    if (findUsingDFA(startPos, status)) {
+        return U_SUCCESS(status) && fMatch;
+    }
+
     UChar32  c;
     U_ASSERT(startPos >= 0);
 
@@ -1043,6 +1084,11 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
         U_ASSERT(fPattern->fMinMatchLen > 0);
         UChar32 theChar = fPattern->fInitialChar;
         for (;;) {
+            if (!skipToLiteralInChunk(startPos, testLen)) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
             int32_t pos = startPos;
             U16_NEXT(inputBuf, startPos, fActiveLimit, c);  // like c = inputBuf[startPos++];
             if (c == theChar) {
@@ -1143,6 +1189,240 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
 
 
 
+//--------------------------------------------------------------------------------
+//
+//   skipToLiteralInChunk()   Advance startPos over input that can not begin a match,
+//                            using a fast search for the literal text that the
+//                            pattern requires: its initial string or character,
+//                            and a string that occurs somewhere in every match.
+//
+//                            Returns FALSE if no match is possible at or after startPos.
+//                            Time limits and callbacks are defined in terms of the
+//                            match attempts at each position, so they turn off the skipping.
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::skipToLiteralInChunk(int32_t &startPos, int32_t testLen) {
+    if (fTimeLimit > 0 || fCallbackFn != NULL || fFindProgressCallbackFn != NULL) {
+        return TRUE;
+    }
+    const UChar *inputBuf = fInputText->chunkContents;
+    const UChar *literals = fPattern->fLiteralText.getBuffer();
+
+    if (fPattern->fRequiredStringLen > 0 && fRequiredStringPos < startPos) {
+        int32_t pos = RegexLiteralSearch::find(inputBuf, startPos, (int32_t)fActiveLimit,
+                                               literals + fPattern->fRequiredStringIdx,
+                                               fPattern->fRequiredStringLen,
+                                               fPattern->fRequiredStringScan);
+        fRequiredStringPos = pos >= 0 ? pos : INT64_MAX;
+    }
+    if (fRequiredStringPos == INT64_MAX) {
+        return FALSE;
+    }
+
+    // The start type treats back references as matching nothing, so only the first
+    //   character of the initial string is certain if the pattern has any.
+    //   A string that starts with a trail surrogate could be found within a
+    //   surrogate pair, where the match loop does not look.
+    int32_t pos = startPos;
+    UChar32 c = fPattern->fInitialChar;
+    const UChar *initialString = literals + fPattern->fInitialStringIdx;
+    if (fPattern->fStartType == START_STRING && !fPattern->fNeedsAltInput &&
+            !U16_IS_TRAIL(initialString[0])) {
+        pos = RegexLiteralSearch::find(inputBuf, startPos, (int32_t)fActiveLimit,
+                                       initialString, fPattern->fInitialStringLen,
+                                       fPattern->fInitialStringScan);
+    } else if ((fPattern->fStartType == START_CHAR || fPattern->fStartType == START_STRING) &&
+               c <= 0xffff && !U_IS_SURROGATE(c)) {
+        pos = RegexLiteralSearch::findUnit(inputBuf, startPos, testLen+1, (UChar)c);
+    }
+    if (pos < 0 || pos > testLen) {
+        return FALSE;
+    }
+    startPos = pos;
+    return TRUE;
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   canUseDFA()   Check whether the DFA match engine can be used for the current
+//                 operation, and create it if it does not yet exist.
+//                 Time limits and callbacks are defined in terms of the backtracking
+//                 engine's progress, so they turn off the DFA.
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::canUseDFA(UErrorCode &status) {
+    if (U_FAILURE(status) || !fUseDFA || fPattern->fDFAProgram == NULL ||
+            fTimeLimit > 0 || fCallbackFn != NULL || fFindProgressCallbackFn != NULL) {
+        return FALSE;
+    }
+    if (fDFA == NULL) {
+        fDFA = new RegexLazyDFA(fPattern->fDFAProgram, status);
+        if (fDFA == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+        }
+        if (U_FAILURE(status)) {
+            delete fDFA;
+            fDFA = NULL;
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   findUsingDFA()   find(), with the DFA match engine.
+//                    A forward scan locates the end of the leftmost match, and a reverse
+//                    scan from there its start. If the pattern has capture groups,
+//                    the backtracking engine then runs once, at the start of the match.
+//
+//                    Returns FALSE if the DFA can not be used, and find() must
+//                    continue with the backtracking engine.
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::findUsingDFA(int64_t startPos, UErrorCode &status) {
+    if (!canUseDFA(status)) {
+        return FALSE;
+    }
+    if (!skipToStartChar(startPos)) {
+        fMatch = FALSE;
+        fHitEnd = TRUE;
+        return TRUE;
+    }
+    int64_t matchEnd;
+    UBool   hitEnd;
+    RegexLazyDFA::EResult result =
+        fDFA->forward(fInputText, startPos, fActiveLimit, RegexLazyDFA::kFind, matchEnd, hitEnd, status);
+    if (result == RegexLazyDFA::kGaveUp) {
+        return U_FAILURE(status);
+    }
+    if (result == RegexLazyDFA::kNoMatch) {
+        fMatch = FALSE;
+        fHitEnd = TRUE;
+        return TRUE;
+    }
+
+    int64_t matchStart;
+    result = fDFA->reverse(fInputText, matchEnd, startPos, matchStart, status);
+    if (result != RegexLazyDFA::kMatch) {
+        U_ASSERT(result == RegexLazyDFA::kGaveUp);
+        return U_FAILURE(status);
+    }
+    if (hitEnd) {
+        fHitEnd = TRUE;
+    }
+    if (fPattern->fGroupMap->size() > 0) {
+        if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+            MatchChunkAt((int32_t)matchStart, FALSE, status);
+        } else {
+            MatchAt(matchStart, FALSE, status);
+        }
+        U_ASSERT(U_FAILURE(status) || (fMatch && fMatchEnd == matchEnd));
+        return TRUE;
+    }
+    fMatch        = TRUE;
+    fLastMatchEnd = fMatchEnd;
+    fMatchStart   = matchStart;
+    fMatchEnd     = matchEnd;
+    return TRUE;
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   skipToStartChar()   For findUsingDFA(), advance startPos to the first character
+//                       that the pattern's start set or initial character allows,
+//                       as the backtracking engine's find loops do, rather than have
+//                       the DFA step through all of the input before it.
+//
+//                       Returns FALSE if there is no such character before the end
+//                       of the active region.
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::skipToStartChar(int64_t &startPos) {
+    int32_t startType = fPattern->fStartType;
+    if (startType != START_SET && startType != START_CHAR && startType != START_STRING) {
+        return TRUE;
+    }
+    UChar32 theChar = fPattern->fInitialChar;
+    UChar32 c;
+    if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+        const UChar *inputBuf = fInputText->chunkContents;
+        int32_t limit = (int32_t)fActiveLimit;
+        for (int32_t pos = (int32_t)startPos; pos < limit;) {
+            int32_t charStart = pos;
+            U16_NEXT(inputBuf, pos, limit, c);
+            if (startType == START_SET ?
+                    ((c<256 && fPattern->fInitialChars8->contains(c)) ||
+                     (c>=256 && fPattern->fInitialChars->contains(c))) :
+                    c == theChar) {
+                startPos = charStart;
+                return TRUE;
+            }
+        }
+        return FALSE;
+    }
+    UTEXT_SETNATIVEINDEX(fInputText, startPos);
+    for (;;) {
+        int64_t charStart = UTEXT_GETNATIVEINDEX(fInputText);
+        if (charStart >= fActiveLimit) {
+            return FALSE;
+        }
+        c = UTEXT_NEXT32(fInputText);
+        if (c < 0) {
+            return FALSE;
+        }
+        if (startType == START_SET ?
+                ((c<256 && fPattern->fInitialChars8->contains(c)) ||
+                 (c>=256 && fPattern->fInitialChars->contains(c))) :
+                c == theChar) {
+            startPos = charStart;
+            return TRUE;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   matchUsingDFA()   matches() or lookingAt(), with the DFA match engine.
+//                     Returns FALSE if the backtracking engine must be used: if the
+//                     DFA can not be used at all, or to fill in the capture groups
+//                     of a successful match.
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::matchUsingDFA(int64_t startIdx, UBool toEnd, UErrorCode &status) {
+    if (!canUseDFA(status)) {
+        return FALSE;
+    }
+    int64_t matchEnd;
+    UBool   hitEnd;
+    RegexLazyDFA::EResult result =
+        fDFA->forward(fInputText, startIdx, fActiveLimit,
+                      toEnd ? RegexLazyDFA::kMatches : RegexLazyDFA::kLookingAt,
+                      matchEnd, hitEnd, status);
+    if (result == RegexLazyDFA::kGaveUp) {
+        return U_FAILURE(status);
+    }
+    if (result == RegexLazyDFA::kNoMatch) {
+        fMatch = FALSE;
+        fHitEnd = fHitEnd || hitEnd;
+        return TRUE;
+    }
+    if (fPattern->fGroupMap->size() > 0) {
+        return FALSE;
+    }
+    fMatch        = TRUE;
+    fHitEnd       = fHitEnd || hitEnd;
+    fLastMatchEnd = fMatchEnd;
+    fMatchStart   = startIdx;
+    fMatchEnd     = matchEnd;
+    return TRUE;
+}
+
+
 //--------------------------------------------------------------------------------
 //
 //  group()
@@ -1469,6 +1749,12 @@ UBool RegexMatcher::lookingAt(UErrorCode &status) {
     else {
         resetPreserveRegion();
     }
+    if (matchUsingDFA(fActiveStart, FALSE, status)) {
+        return fMatch;
+    }
+    if (fMemo != NULL) {
+        fMemo->clear();
+    }
     if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)fActiveStart, FALSE, status);
     } else {
@@ -1507,6 +1793,12 @@ UBool RegexMatcher::lookingAt(int64_t start, UErrorCode &status) {
         return FALSE;
     }
 
+    if (matchUsingDFA(nativeStart, FALSE, status)) {
+        return fMatch;
+    }
+    if (fMemo != NULL) {
+        fMemo->clear();
+    }
     if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)nativeStart, FALSE, status);
     } else {
@@ -1541,6 +1833,12 @@ UBool RegexMatcher::matches(UErrorCode &status) {
         resetPreserveRegion();
     }
 
+    if (matchUsingDFA(fActiveStart, TRUE, status)) {
+        return fMatch;
+    }
+    if (fMemo != NULL) {
+        fMemo->clear();
+    }
     if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)fActiveStart, TRUE, status);
     } else {
@@ -1579,6 +1877,12 @@ UBool RegexMatcher::matches(int64_t start, UErrorCode &status) {
         return FALSE;
     }
 
+    if (matchUsingDFA(nativeStart, TRUE, status)) {
+        return fMatch;
+    }
+    if (fMemo != NULL) {
+        fMemo->clear();
+    }
     if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)nativeStart, TRUE, status);
     } else {
@@ -1834,6 +2138,7 @@ void RegexMatcher::resetPreserveRegion() {
     fRequireEnd     = FALSE;
     fTime           = 0;
     fTickCounter    = TIMER_INITIAL_VALUE;
+    fRequiredStringPos = -1;
     //resetStack(); // more expensive than it looks...
 }
 
@@ -1935,6 +2240,7 @@ RegexMatcher &RegexMatcher::refreshInputText(UText *input, UErrorCode &status) {
         return *this;
     }
     utext_setNativeIndex(fInputText, pos);
+    fRequiredStringPos = -1;
 
     if (fAltInputText != NULL) {
         pos = utext_getNativeIndex(fAltInputText);
@@ -1959,6 +2265,16 @@ void RegexMatcher::setTrace(UBool state) {
 }
 
 
+//--------------------------------------------------------------------------------
+//
+//    setUseDFA
+//
+//--------------------------------------------------------------------------------
+void RegexMatcher::setUseDFA(UBool useDFA) {
+    fUseDFA = useDFA;
+}
+
+
 
 /**
   *  UText, replace entire contents of the destination UText with a substring of the source UText.
@@ -2401,6 +2717,10 @@ void RegexMatcher::setStackLimit(int32_t limit, UErrorCode &status) {
         fStack->setMaxCapacity(adjustedLimit);
     }
     fStackLimit = limit;
+    if (fStackReserve > 0) {
+        // The new limit may have trimmed the reserved storage.
+        setStackReserve(fStackReserve, status);
+    }
 }
 
 
@@ -2414,6 +2734,117 @@ int32_t RegexMatcher::getStackLimit() const {
 }
 
 
+//--------------------------------------------------------------------------------
+//
+//     setMemoizeBacktracking
+//
+//--------------------------------------------------------------------------------
+void RegexMatcher::setMemoizeBacktracking(UBool memoize, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (U_FAILURE(fDeferredStatus)) {
+        status = fDeferredStatus;
+        return;
+    }
+    if (!memoize) {
+        delete fMemo;
+        fMemo = NULL;
+    } else if (fMemo == NULL) {
+        LocalPointer<RegexMemo> memo(new RegexMemo(fPattern->fCompiledPat->getBuffer(),
+                                                   fPattern->fCompiledPat->size(), status), status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        fMemo = memo.orphan();
+    }
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//     getMemoizeBacktracking
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::getMemoizeBacktracking() const {
+    return fMemo != NULL;
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//     setStackReserve
+//
+//--------------------------------------------------------------------------------
+void RegexMatcher::setStackReserve(int32_t reserve, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (U_FAILURE(fDeferredStatus)) {
+        status = fDeferredStatus;
+        return;
+    }
+    if (reserve < 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+
+    // Growing the stack moves it, which would lose the final stack frame of a
+    //   current match.
+    reset();
+
+    // The stack limit is applied in the units used by setStackLimit().
+    int32_t capacity = reserve / sizeof(int64_t);
+    if (fStackLimit > 0) {
+        int32_t maxCapacity = fStackLimit / sizeof(int32_t);
+        if (maxCapacity < fPattern->fFrameSize) {
+            maxCapacity = fPattern->fFrameSize;
+        }
+        if (capacity > maxCapacity) {
+            capacity = maxCapacity;
+        }
+    }
+    fStack->ensureCapacity(capacity, status);
+    fStackReserve = reserve;
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//     getStackReserve
+//
+//--------------------------------------------------------------------------------
+int32_t RegexMatcher::getStackReserve() const {
+    return fStackReserve;
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//     restoreDefaults
+//
+//--------------------------------------------------------------------------------
+void RegexMatcher::restoreDefaults() {
+    reset(RegexStaticSets::gStaticSets->fEmptyText);
+    fTransparentBounds = FALSE;
+    fAnchoringBounds   = TRUE;
+    fTimeLimit         = 0;
+    fCallbackFn        = NULL;
+    fCallbackContext   = NULL;
+    fFindProgressCallbackFn      = NULL;
+    fFindProgressCallbackContext = NULL;
+    fTraceDebug        = FALSE;
+    fUseDFA            = TRUE;
+    delete fMemo;
+    fMemo              = NULL;
+    fStackReserve      = 0;     // Storage already reserved is kept, like other stack storage.
+    if (fStackLimit != DEFAULT_BACKTRACK_STACK_CAPACITY) {
+        UErrorCode status = U_ZERO_ERROR;
+        setStackLimit(DEFAULT_BACKTRACK_STACK_CAPACITY, status);
+    }
+}
+
+
 //--------------------------------------------------------------------------------
 //
 //     setMatchCallback
@@ -2533,12 +2964,12 @@ UBool RegexMatcher::isWordBoundary(int64_t pos) {
     UBool isBoundary = FALSE;
     UBool cIsWord    = FALSE;
 
+    UTEXT_SETNATIVEINDEX(fInputText, pos);
     if (pos >= fLookLimit) {
         fHitEnd = TRUE;
     } else {
         // Determine whether char c at current position is a member of the word set of chars.
         // If we're off the end of the string, behave as though we're not at a word char.
-        UTEXT_SETNATIVEINDEX(fInputText, pos);
         UChar32  c = UTEXT_CURRENT32(fInputText);
         if (u_hasBinaryProperty(c, UCHAR_GRAPHEME_EXTEND) || u_charType(c) == U_FORMAT_CHAR) {
             // Current char is a combining one.  Not a boundary.
@@ -2742,13 +3173,34 @@ UnicodeString StringFromUText(UText *ut) {
 
 //--------------------------------------------------------------------------------
 //
-//   MatchAt      This is the actual matching engine.
+//   MatchAt      Run the matching engine, reading UTF-8 input directly
+//                  when it comes from utext_openUTF8().
 //
+//--------------------------------------------------------------------------------
+void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
+    const char *utf8 = utext_getUTF8Source(fInputText, NULL);
+    if (utf8 != NULL) {
+        RegexUTF8Input input(utf8, fInputLength);
+        MatchInputAt(input, startIdx, toEnd, status);
+    } else {
+        RegexUTextInput input(fInputText);
+        MatchInputAt(input, startIdx, toEnd, status);
+    }
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   MatchInputAt   This is the actual matching engine.
+//
+//                  input:       accessor for the input text, a RegexUTextInput
+//                               or a RegexUTF8Input.
 //                  startIdx:    begin matching a this index.
 //                  toEnd:       if true, match must extend to end of the input region
 //
 //--------------------------------------------------------------------------------
-void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
+template<class Input>
+void RegexMatcher::MatchInputAt(Input &input, int64_t startIdx, UBool toEnd, UErrorCode &status) {
     UBool       isMatch  = FALSE;      // True if the we have a match.
 
     int64_t     backSearchIndex = U_INT64_MAX; // used after greedy single-character matches for searching backwards
@@ -2765,6 +3217,11 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
     }
 #endif
 
+    //  The memo of states that have been tried, if memoization applies to this match.
+    RegexMemo *memo = NULL;
+    if (fMemo != NULL && fMemo->begin(fActiveStart, fActiveLimit, toEnd, fStackLimit, status)) {
+        memo = fMemo;
+    }
     if (U_FAILURE(status)) {
         return;
     }
@@ -2797,14 +3254,19 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
     //  One iteration of the loop per pattern operation performed.
     //
     for (;;) {
+        if (memo != NULL && memo->visit(fp->fPatIdx, fp->fInputIdx)) {
+            // Matching from here has been tried already, and failed.
+            fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+            continue;
+        }
         op      = (int32_t)pat[fp->fPatIdx];
         opType  = URX_TYPE(op);
         opValue = URX_VAL(op);
 #ifdef REGEX_RUN_DEBUG
         if (fTraceDebug) {
-            UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
+            input.setNativeIndex(fp->fInputIdx);
             printf("inputIdx=%ld   inputChar=%x   sp=%3ld   activeLimit=%ld  ", fp->fInputIdx,
-                UTEXT_CURRENT32(fInputText), (int64_t *)fp-fStack->getBuffer(), fActiveLimit);
+                input.current32(), (int64_t *)fp-fStack->getBuffer(), fActiveLimit);
             fPattern->dumpOp(fp->fPatIdx);
         }
 #endif
@@ -2827,10 +3289,10 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
 
         case URX_ONECHAR:
             if (fp->fInputIdx < fActiveLimit) {
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
-                UChar32 c = UTEXT_NEXT32(fInputText);
+                input.setNativeIndex(fp->fInputIdx);
+                UChar32 c = input.next32();
                 if (c == opValue) {
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                    fp->fInputIdx = input.getNativeIndex();
                     break;
                 }
             } else {
@@ -2856,17 +3318,17 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
 
                 const UChar *patternString = litText+stringStartIdx;
                 int32_t patternStringIndex = 0;
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
+                input.setNativeIndex(fp->fInputIdx);
                 UChar32 inputChar;
                 UChar32 patternChar;
                 UBool success = TRUE;
                 while (patternStringIndex < stringLen) {
-                    if (UTEXT_GETNATIVEINDEX(fInputText) >= fActiveLimit) {
+                    if (input.getNativeIndex() >= fActiveLimit) {
                         success = FALSE;
                         fHitEnd = TRUE;
                         break;
                     }
-                    inputChar = UTEXT_NEXT32(fInputText);
+                    inputChar = input.next32();
                     U16_NEXT(patternString, patternStringIndex, stringLen, patternChar);
                     if (patternChar != inputChar) {
                         success = FALSE;
@@ -2875,7 +3337,7 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                 }
 
                 if (success) {
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                    fp->fInputIdx = input.getNativeIndex();
                 } else {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                 }
@@ -2929,15 +3391,15 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     break;
                 }
 
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
+                input.setNativeIndex(fp->fInputIdx);
 
                 // If we are positioned just before a new-line that is located at the
                 //   end of input, succeed.
-                UChar32 c = UTEXT_NEXT32(fInputText);
-                if (UTEXT_GETNATIVEINDEX(fInputText) >= fAnchorLimit) {
+                UChar32 c = input.next32();
+                if (input.getNativeIndex() >= fAnchorLimit) {
                     if (isLineTerminator(c)) {
                         // If not in the middle of a CR/LF sequence
-                        if ( !(c==0x0a && fp->fInputIdx>fAnchorStart && ((void)UTEXT_PREVIOUS32(fInputText), UTEXT_PREVIOUS32(fInputText))==0x0d)) {
+                        if ( !(c==0x0a && fp->fInputIdx>fAnchorStart && ((void)input.previous32(), input.previous32())==0x0d)) {
                             // At new-line at end of input. Success
                             fHitEnd = TRUE;
                             fRequireEnd = TRUE;
@@ -2946,8 +3408,8 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                         }
                     }
                 } else {
-                    UChar32 nextC = UTEXT_NEXT32(fInputText);
-                    if (c == 0x0d && nextC == 0x0a && UTEXT_GETNATIVEINDEX(fInputText) >= fAnchorLimit) {
+                    UChar32 nextC = input.next32();
+                    if (c == 0x0d && nextC == 0x0a && input.getNativeIndex() >= fAnchorLimit) {
                         fHitEnd = TRUE;
                         fRequireEnd = TRUE;
                         break;                         // At CR/LF at end of input.  Success
@@ -2966,10 +3428,10 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                 fRequireEnd = TRUE;
                 break;
             } else {
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
-                UChar32 c = UTEXT_NEXT32(fInputText);
+                input.setNativeIndex(fp->fInputIdx);
+                UChar32 c = input.next32();
                 // Either at the last character of input, or off the end.
-                if (c == 0x0a && UTEXT_GETNATIVEINDEX(fInputText) == fAnchorLimit) {
+                if (c == 0x0a && input.getNativeIndex() == fAnchorLimit) {
                     fHitEnd = TRUE;
                     fRequireEnd = TRUE;
                     break;
@@ -2991,13 +3453,13 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                  }
                  // If we are positioned just before a new-line, succeed.
                  // It makes no difference where the new-line is within the input.
-                 UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
-                 UChar32 c = UTEXT_CURRENT32(fInputText);
+                 input.setNativeIndex(fp->fInputIdx);
+                 UChar32 c = input.current32();
                  if (isLineTerminator(c)) {
                      // At a line end, except for the odd chance of  being in the middle of a CR/LF sequence
                      //  In multi-line mode, hitting a new-line just before the end of input does not
                      //   set the hitEnd or requireEnd flags
-                     if ( !(c==0x0a && fp->fInputIdx>fAnchorStart && UTEXT_PREVIOUS32(fInputText)==0x0d)) {
+                     if ( !(c==0x0a && fp->fInputIdx>fAnchorStart && input.previous32()==0x0d)) {
                         break;
                      }
                  }
@@ -3017,8 +3479,8 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                  }
                  // If we are not positioned just before a new-line, the test fails; backtrack out.
                  // It makes no difference where the new-line is within the input.
-                 UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
-                 if (UTEXT_CURRENT32(fInputText) != 0x0a) {
+                 input.setNativeIndex(fp->fInputIdx);
+                 if (input.current32() != 0x0a) {
                      fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                  }
              }
@@ -3040,8 +3502,8 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                }
                // Check whether character just before the current pos is a new-line
                //   unless we are at the end of input
-               UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
-               UChar32  c = UTEXT_PREVIOUS32(fInputText);
+               input.setNativeIndex(fp->fInputIdx);
+               UChar32  c = input.previous32();
                if ((fp->fInputIdx < fAnchorLimit) && isLineTerminator(c)) {
                    //  It's a new-line.  ^ is true.  Success.
                    //  TODO:  what should be done with positions between a CR and LF?
@@ -3062,8 +3524,8 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                }
                // Check whether character just before the current pos is a new-line
                U_ASSERT(fp->fInputIdx <= fAnchorLimit);
-               UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
-               UChar32  c = UTEXT_PREVIOUS32(fInputText);
+               input.setNativeIndex(fp->fInputIdx);
+               UChar32  c = input.previous32();
                if (c != 0x0a) {
                    // Not at the start of a line.  Back-track out.
                    fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -3101,14 +3563,14 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     break;
                 }
 
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
+                input.setNativeIndex(fp->fInputIdx);
 
-                UChar32 c = UTEXT_NEXT32(fInputText);
+                UChar32 c = input.next32();
                 int8_t ctype = u_charType(c);     // TODO:  make a unicode set for this.  Will be faster.
                 UBool success = (ctype == U_DECIMAL_DIGIT_NUMBER);
                 success ^= (UBool)(opValue != 0);        // flip sense for \D
                 if (success) {
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                    fp->fInputIdx = input.getNativeIndex();
                 } else {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                 }
@@ -3130,13 +3592,13 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                     break;
                 }
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
-                UChar32 c = UTEXT_NEXT32(fInputText);
+                input.setNativeIndex(fp->fInputIdx);
+                UChar32 c = input.next32();
                 int8_t ctype = u_charType(c);
                 UBool success = (ctype == U_SPACE_SEPARATOR || c == 9);  // SPACE_SEPARATOR || TAB
                 success ^= (UBool)(opValue != 0);        // flip sense for \H
                 if (success) {
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                    fp->fInputIdx = input.getNativeIndex();
                 } else {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                 }
@@ -3151,13 +3613,13 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                     break;
                 }
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
-                UChar32 c = UTEXT_NEXT32(fInputText);
+                input.setNativeIndex(fp->fInputIdx);
+                UChar32 c = input.next32();
                 if (isLineTerminator(c)) {
-                    if (c == 0x0d && utext_current32(fInputText) == 0x0a) {
-                        utext_next32(fInputText);
+                    if (c == 0x0d && input.current32() == 0x0a) {
+                        input.next32();
                     }
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                    fp->fInputIdx = input.getNativeIndex();
                 } else {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                 }
@@ -3172,12 +3634,12 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                     break;
                 }
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
-                UChar32 c = UTEXT_NEXT32(fInputText);
+                input.setNativeIndex(fp->fInputIdx);
+                UChar32 c = input.next32();
                 UBool success = isLineTerminator(c);
                 success ^= (UBool)(opValue != 0);        // flip sense for \V
                 if (success) {
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                    fp->fInputIdx = input.getNativeIndex();
                 } else {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                 }
@@ -3198,13 +3660,13 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     break;
                 }
 
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
+                input.setNativeIndex(fp->fInputIdx);
 
                 // Examine (and consume) the current char.
                 //   Dispatch into a little state machine, based on the char.
                 UChar32  c;
-                c = UTEXT_NEXT32(fInputText);
-                fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                c = input.next32();
+                fp->fInputIdx = input.getNativeIndex();
                 UnicodeSet **sets = fPattern->fStaticSets;
                 if (sets[URX_GC_NORMAL]->contains(c))  goto GC_Extend;
                 if (sets[URX_GC_CONTROL]->contains(c)) goto GC_Control;
@@ -3219,33 +3681,33 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
 
 GC_L:
                 if (fp->fInputIdx >= fActiveLimit)         goto GC_Done;
-                c = UTEXT_NEXT32(fInputText);
-                fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                c = input.next32();
+                fp->fInputIdx = input.getNativeIndex();
                 if (sets[URX_GC_L]->contains(c))       goto GC_L;
                 if (sets[URX_GC_LV]->contains(c))      goto GC_V;
                 if (sets[URX_GC_LVT]->contains(c))     goto GC_T;
                 if (sets[URX_GC_V]->contains(c))       goto GC_V;
-                (void)UTEXT_PREVIOUS32(fInputText);
-                fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                (void)input.previous32();
+                fp->fInputIdx = input.getNativeIndex();
                 goto GC_Extend;
 
 GC_V:
                 if (fp->fInputIdx >= fActiveLimit)         goto GC_Done;
-                c = UTEXT_NEXT32(fInputText);
-                fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                c = input.next32();
+                fp->fInputIdx = input.getNativeIndex();
                 if (sets[URX_GC_V]->contains(c))       goto GC_V;
                 if (sets[URX_GC_T]->contains(c))       goto GC_T;
-                (void)UTEXT_PREVIOUS32(fInputText);
-                fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                (void)input.previous32();
+                fp->fInputIdx = input.getNativeIndex();
                 goto GC_Extend;
 
 GC_T:
                 if (fp->fInputIdx >= fActiveLimit)         goto GC_Done;
-                c = UTEXT_NEXT32(fInputText);
-                fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                c = input.next32();
+                fp->fInputIdx = input.getNativeIndex();
                 if (sets[URX_GC_T]->contains(c))       goto GC_T;
-                (void)UTEXT_PREVIOUS32(fInputText);
-                fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                (void)input.previous32();
+                fp->fInputIdx = input.getNativeIndex();
                 goto GC_Extend;
 
 GC_Extend:
@@ -3254,21 +3716,21 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     if (fp->fInputIdx >= fActiveLimit) {
                         break;
                     }
-                    c = UTEXT_CURRENT32(fInputText);
+                    c = input.current32();
                     if (sets[URX_GC_EXTEND]->contains(c) == FALSE) {
                         break;
                     }
-                    (void)UTEXT_NEXT32(fInputText);
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                    (void)input.next32();
+                    fp->fInputIdx = input.getNativeIndex();
                 }
                 goto GC_Done;
 
 GC_Control:
                 // Most control chars stand alone (don't combine with combining chars),
                 //   except for that CR/LF sequence is a single grapheme cluster.
-                if (c == 0x0d && fp->fInputIdx < fActiveLimit && UTEXT_CURRENT32(fInputText) == 0x0a) {
-                    c = UTEXT_NEXT32(fInputText);
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                if (c == 0x0d && fp->fInputIdx < fActiveLimit && input.current32() == 0x0a) {
+                    c = input.next32();
+                    fp->fInputIdx = input.getNativeIndex();
                 }
 
 GC_Done:
@@ -3309,8 +3771,8 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                 opValue &= ~URX_NEG_SET;
                 U_ASSERT(opValue > 0 && opValue < URX_LAST_SET);
 
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
-                UChar32 c = UTEXT_NEXT32(fInputText);
+                input.setNativeIndex(fp->fInputIdx);
+                UChar32 c = input.next32();
                 if (c < 256) {
                     Regex8BitSet *s8 = &fPattern->fStaticSets8[opValue];
                     if (s8->contains(c)) {
@@ -3323,7 +3785,7 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     }
                 }
                 if (success) {
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                    fp->fInputIdx = input.getNativeIndex();
                 } else {
                     // the character wasn't in the set.
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -3344,19 +3806,19 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
 
                 U_ASSERT(opValue > 0 && opValue < URX_LAST_SET);
 
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
+                input.setNativeIndex(fp->fInputIdx);
 
-                UChar32 c = UTEXT_NEXT32(fInputText);
+                UChar32 c = input.next32();
                 if (c < 256) {
                     Regex8BitSet *s8 = &fPattern->fStaticSets8[opValue];
                     if (s8->contains(c) == FALSE) {
-                        fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                        fp->fInputIdx = input.getNativeIndex();
                         break;
                     }
                 } else {
                     const UnicodeSet *s = fPattern->fStaticSets[opValue];
                     if (s->contains(c) == FALSE) {
-                        fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                        fp->fInputIdx = input.getNativeIndex();
                         break;
                     }
                 }
@@ -3372,22 +3834,22 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                 fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                 break;
             } else {
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
+                input.setNativeIndex(fp->fInputIdx);
 
                 // There is input left.  Pick up one char and test it for set membership.
-                UChar32 c = UTEXT_NEXT32(fInputText);
+                UChar32 c = input.next32();
                 U_ASSERT(opValue > 0 && opValue < sets->size());
                 if (c<256) {
                     Regex8BitSet *s8 = &fPattern->fSets8[opValue];
                     if (s8->contains(c)) {
-                        fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                        fp->fInputIdx = input.getNativeIndex();
                         break;
                     }
                 } else {
                     UnicodeSet *s = (UnicodeSet *)sets->elementAt(opValue);
                     if (s->contains(c)) {
                         // The character is in the set.  A Match.
-                        fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                        fp->fInputIdx = input.getNativeIndex();
                         break;
                     }
                 }
@@ -3408,16 +3870,16 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     break;
                 }
 
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
+                input.setNativeIndex(fp->fInputIdx);
 
                 // There is input left.  Advance over one char, unless we've hit end-of-line
-                UChar32 c = UTEXT_NEXT32(fInputText);
+                UChar32 c = input.next32();
                 if (isLineTerminator(c)) {
                     // End of line in normal mode.   . does not match.
                         fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                     break;
                 }
-                fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                fp->fInputIdx = input.getNativeIndex();
             }
             break;
 
@@ -3432,19 +3894,19 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     break;
                 }
 
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
+                input.setNativeIndex(fp->fInputIdx);
 
                 // There is input left.  Advance over one char, except if we are
                 //   at a cr/lf, advance over both of them.
                 UChar32 c;
-                c = UTEXT_NEXT32(fInputText);
-                fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                c = input.next32();
+                fp->fInputIdx = input.getNativeIndex();
                 if (c==0x0d && fp->fInputIdx < fActiveLimit) {
                     // In the case of a CR/LF, we need to advance over both.
-                    UChar32 nextc = UTEXT_CURRENT32(fInputText);
+                    UChar32 nextc = input.current32();
                     if (nextc == 0x0a) {
-                        (void)UTEXT_NEXT32(fInputText);
-                        fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                        (void)input.next32();
+                        fp->fInputIdx = input.getNativeIndex();
                     }
                 }
             }
@@ -3462,15 +3924,15 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     break;
                 }
 
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
+                input.setNativeIndex(fp->fInputIdx);
 
                 // There is input left.  Advance over one char, unless we've hit end-of-line
-                UChar32 c = UTEXT_NEXT32(fInputText);
+                UChar32 c = input.next32();
                 if (c == 0x0a) {
                     // End of line in normal mode.   '.' does not match the \n
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                 } else {
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                    fp->fInputIdx = input.getNativeIndex();
                 }
             }
             break;
@@ -3692,7 +4154,7 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     break;
                 }
                 UTEXT_SETNATIVEINDEX(fAltInputText, groupStartIdx);
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
+                input.setNativeIndex(fp->fInputIdx);
 
                 //   Note: if the capture group match was of an empty string the backref
                 //         match succeeds.  Verified by testing:  Perl matches succeed
@@ -3704,13 +4166,13 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                         success = TRUE;
                         break;
                     }
-                    if (utext_getNativeIndex(fInputText) >= fActiveLimit) {
+                    if (input.getNativeIndex() >= fActiveLimit) {
                         success = FALSE;
                         fHitEnd = TRUE;
                         break;
                     }
                     UChar32 captureGroupChar = utext_next32(fAltInputText);
-                    UChar32 inputChar = utext_next32(fInputText);
+                    UChar32 inputChar = input.next32();
                     if (inputChar != captureGroupChar) {
                         success = FALSE;
                         break;
@@ -3718,7 +4180,7 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                 }
 
                 if (success) {
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                    fp->fInputIdx = input.getNativeIndex();
                 } else {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                 }
@@ -3739,9 +4201,10 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     break;
                 }
                 utext_setNativeIndex(fAltInputText, groupStartIdx);
-                utext_setNativeIndex(fInputText, fp->fInputIdx);
-                CaseFoldingUTextIterator captureGroupItr(*fAltInputText);
-                CaseFoldingUTextIterator inputItr(*fInputText);
+                input.setNativeIndex(fp->fInputIdx);
+                RegexUTextInput captureGroup(fAltInputText);
+                CaseFoldingInputIterator<RegexUTextInput> captureGroupItr(captureGroup);
+                CaseFoldingInputIterator<Input> inputItr(input);
 
                 //   Note: if the capture group match was of an empty string the backref
                 //         match succeeds.  Verified by testing:  Perl matches succeed
@@ -3753,7 +4216,7 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                         success = TRUE;
                         break;
                     }
-                    if (!inputItr.inExpansion() && utext_getNativeIndex(fInputText) >= fActiveLimit) {
+                    if (!inputItr.inExpansion() && input.getNativeIndex() >= fActiveLimit) {
                         success = FALSE;
                         fHitEnd = TRUE;
                         break;
@@ -3774,7 +4237,7 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                 }
 
                 if (success) {
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                    fp->fInputIdx = input.getNativeIndex();
                 } else {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                 }
@@ -3851,11 +4314,11 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
             // Input text is not, but case folding the input can not reduce two or more code
             // points to one.
             if (fp->fInputIdx < fActiveLimit) {
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
+                input.setNativeIndex(fp->fInputIdx);
 
-                UChar32 c = UTEXT_NEXT32(fInputText);
+                UChar32 c = input.next32();
                 if (u_foldCase(c, U_FOLD_CASE_DEFAULT) == opValue) {
-                    fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                    fp->fInputIdx = input.getNativeIndex();
                     break;
                 }
             } else {
@@ -3887,10 +4350,10 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     UChar32   cText;
                     UBool     success = TRUE;
 
-                    UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
-                    CaseFoldingUTextIterator inputIterator(*fInputText);
+                    input.setNativeIndex(fp->fInputIdx);
+                    CaseFoldingInputIterator<Input> inputIterator(input);
                     while (patternStringIdx < patternStringLen) {
-                        if (!inputIterator.inExpansion() && UTEXT_GETNATIVEINDEX(fInputText) >= fActiveLimit) {
+                        if (!inputIterator.inExpansion() && input.getNativeIndex() >= fActiveLimit) {
                             success = FALSE;
                             fHitEnd = TRUE;
                             break;
@@ -3907,7 +4370,7 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     }
 
                     if (success) {
-                        fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                        fp->fInputIdx = input.getNativeIndex();
                     } else {
                         fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                     }
@@ -3942,7 +4405,7 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                 //   of this op in the pattern.
                 int32_t minML = (int32_t)pat[fp->fPatIdx++];
                 int32_t maxML = (int32_t)pat[fp->fPatIdx++];
-                if (!UTEXT_USES_U16(fInputText)) {
+                if (!input.usesU16()) {
                     // utf-8 fix to maximum match length. The pattern compiler assumes utf-16.
                     // The max length need not be exact; it just needs to be >= actual maximum.
                     maxML *= 3;
@@ -3958,8 +4421,8 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     lbStartIdx = fp->fInputIdx - minML;
                     if (lbStartIdx > 0) {
                         // move index to a code point boudary, if it's not on one already.
-                        UTEXT_SETNATIVEINDEX(fInputText, lbStartIdx);
-                        lbStartIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                        input.setNativeIndex(lbStartIdx);
+                        lbStartIdx = input.getNativeIndex();
                     }
                 } else {
                     // 2nd through nth time through the loop.
@@ -3967,9 +4430,9 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     if (lbStartIdx == 0) {
                         (lbStartIdx)--;
                     } else {
-                        UTEXT_SETNATIVEINDEX(fInputText, lbStartIdx);
-                        (void)UTEXT_PREVIOUS32(fInputText);
-                        lbStartIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                        input.setNativeIndex(lbStartIdx);
+                        (void)input.previous32();
+                        lbStartIdx = input.getNativeIndex();
                     }
                 }
 
@@ -4025,7 +4488,7 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                 // Fetch the extra parameters of this op.
                 int32_t minML       = (int32_t)pat[fp->fPatIdx++];
                 int32_t maxML       = (int32_t)pat[fp->fPatIdx++];
-                if (!UTEXT_USES_U16(fInputText)) {
+                if (!input.usesU16()) {
                     // utf-8 fix to maximum match length. The pattern compiler assumes utf-16.
                     // The max length need not be exact; it just needs to be >= actual maximum.
                     maxML *= 3;
@@ -4044,8 +4507,8 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     lbStartIdx = fp->fInputIdx - minML;
                     if (lbStartIdx > 0) {
                         // move index to a code point boudary, if it's not on one already.
-                        UTEXT_SETNATIVEINDEX(fInputText, lbStartIdx);
-                        lbStartIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                        input.setNativeIndex(lbStartIdx);
+                        lbStartIdx = input.getNativeIndex();
                     }
                 } else {
                     // 2nd through nth time through the loop.
@@ -4053,9 +4516,9 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     if (lbStartIdx == 0) {
                         (lbStartIdx)--;
                     } else {
-                        UTEXT_SETNATIVEINDEX(fInputText, lbStartIdx);
-                        (void)UTEXT_PREVIOUS32(fInputText);
-                        lbStartIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                        input.setNativeIndex(lbStartIdx);
+                        (void)input.previous32();
+                        lbStartIdx = input.getNativeIndex();
                     }
                 }
 
@@ -4130,13 +4593,13 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                 // Loop through input, until either the input is exhausted or
                 //   we reach a character that is not a member of the set.
                 int64_t ix = fp->fInputIdx;
-                UTEXT_SETNATIVEINDEX(fInputText, ix);
+                input.setNativeIndex(ix);
                 for (;;) {
                     if (ix >= fActiveLimit) {
                         fHitEnd = TRUE;
                         break;
                     }
-                    UChar32 c = UTEXT_NEXT32(fInputText);
+                    UChar32 c = input.next32();
                     if (c<256) {
                         if (s8->contains(c) == FALSE) {
                             break;
@@ -4146,7 +4609,7 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                             break;
                         }
                     }
-                    ix = UTEXT_GETNATIVEINDEX(fInputText);
+                    ix = input.getNativeIndex();
                 }
 
                 // If there were no matching characters, skip over the loop altogether.
@@ -4191,13 +4654,13 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     // NOT DOT ALL mode.  Line endings do not match '.'
                     // Scan forward until a line ending or end of input.
                     ix = fp->fInputIdx;
-                    UTEXT_SETNATIVEINDEX(fInputText, ix);
+                    input.setNativeIndex(ix);
                     for (;;) {
                         if (ix >= fActiveLimit) {
                             fHitEnd = TRUE;
                             break;
                         }
-                        UChar32 c = UTEXT_NEXT32(fInputText);
+                        UChar32 c = input.next32();
                         if ((c & 0x7f) <= 0x29) {          // Fast filter of non-new-line-s
                             if ((c == 0x0a) ||             //  0x0a is newline in both modes.
                                (((opValue & 2) == 0) &&    // IF not UNIX_LINES mode
@@ -4206,7 +4669,7 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                                 break;
                             }
                         }
-                        ix = UTEXT_GETNATIVEINDEX(fInputText);
+                        ix = input.getNativeIndex();
                     }
                 }
 
@@ -4253,18 +4716,18 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                 //   (We're going backwards because this loop emulates stack unwinding, not
                 //    the initial scan forward.)
                 U_ASSERT(fp->fInputIdx > 0);
-                UTEXT_SETNATIVEINDEX(fInputText, fp->fInputIdx);
-                UChar32 prevC = UTEXT_PREVIOUS32(fInputText);
-                fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                input.setNativeIndex(fp->fInputIdx);
+                UChar32 prevC = input.previous32();
+                fp->fInputIdx = input.getNativeIndex();
 
-                UChar32 twoPrevC = UTEXT_PREVIOUS32(fInputText);
+                UChar32 twoPrevC = input.previous32();
                 if (prevC == 0x0a &&
                     fp->fInputIdx > backSearchIndex &&
                     twoPrevC == 0x0d) {
                     int32_t prevOp = (int32_t)pat[fp->fPatIdx-2];
                     if (URX_TYPE(prevOp) == URX_LOOP_DOT_I) {
                         // .*, stepping back over CRLF pair.
-                        fp->fInputIdx = UTEXT_GETNATIVEINDEX(fInputText);
+                        fp->fInputIdx = input.getNativeIndex();
                     }
                 }
 
@@ -4293,6 +4756,10 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
         fLastMatchEnd = fMatchEnd;
         fMatchStart   = startIdx;
         fMatchEnd     = fp->fInputIdx;
+        if (memo != NULL) {
+            // The states on the path of the match were not all tried to the end.
+            memo->clear();
+        }
     }
 
 #ifdef REGEX_RUN_DEBUG
@@ -4341,6 +4808,11 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
     }
 #endif
 
+    //  The memo of states that have been tried, if memoization applies to this match.
+    RegexMemo *memo = NULL;
+    if (fMemo != NULL && fMemo->begin(fActiveStart, fActiveLimit, toEnd, fStackLimit, status)) {
+        memo = fMemo;
+    }
     if (U_FAILURE(status)) {
         return;
     }
@@ -4375,6 +4847,11 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
     //  One iteration of the loop per pattern operation performed.
     //
     for (;;) {
+        if (memo != NULL && memo->visit(fp->fPatIdx, fp->fInputIdx)) {
+            // Matching from here has been tried already, and failed.
+            fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+            continue;
+        }
         op      = (int32_t)pat[fp->fPatIdx];
         opType  = URX_TYPE(op);
         opValue = URX_VAL(op);
@@ -5793,6 +6270,10 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
         fLastMatchEnd = fMatchEnd;
         fMatchStart   = startIdx;
         fMatchEnd     = fp->fInputIdx;
+        if (memo != NULL) {
+            // The states on the path of the match were not all tried to the end.
+            memo->clear();
+        }
     }
 
 #ifdef REGEX_RUN_DEBUG
@@ -17,6 +17,7 @@
 #include "unicode/regex.h"
 #include "unicode/uclean.h"
 #include "cmemory.h"
+#include "mutex.h"
 #include "cstr.h"
 #include "uassert.h"
 #include "uhash.h"
@@ -24,6 +25,7 @@
 #include "uvectr32.h"
 #include "uvectr64.h"
 #include "regexcmp.h"
+#include "regexdfa.h"
 #include "regeximp.h"
 #include "regexst.h"
 
@@ -107,6 +109,10 @@ RegexPattern &RegexPattern::operator = (const RegexPattern &other) {
     fInitialChar      = other.fInitialChar;
     *fInitialChars8   = *other.fInitialChars8;
     fNeedsAltInput    = other.fNeedsAltInput;
+    fInitialStringScan  = other.fInitialStringScan;
+    fRequiredStringIdx  = other.fRequiredStringIdx;
+    fRequiredStringLen  = other.fRequiredStringLen;
+    fRequiredStringScan = other.fRequiredStringScan;
 
     //  Copy the pattern.  It's just values, nothing deep to copy.
     fCompiledPat->assign(*other.fCompiledPat, fDeferredStatus);
@@ -152,6 +158,11 @@ RegexPattern &RegexPattern::operator = (const RegexPattern &other) {
             uhash_puti(fNamedCaptureMap, key, val, &fDeferredStatus);
         }
     }
+
+    // The DFA program is immutable, but owned; make a new one.
+    if (other.fDFAProgram != NULL) {
+        fDFAProgram = RegexDFAProgram::createInstance(this, fDeferredStatus);
+    }
     return *this;
 }
 
@@ -182,7 +193,13 @@ void RegexPattern::init() {
     fInitialChar      = 0;
     fInitialChars8    = NULL;
     fNeedsAltInput    = FALSE;
+    fInitialStringScan  = 0;
+    fRequiredStringIdx  = 0;
+    fRequiredStringLen  = 0;
+    fRequiredStringScan = 0;
     fNamedCaptureMap  = NULL;
+    fDFAProgram       = NULL;
+    fMatcherPool      = NULL;
 
     fPattern          = NULL; // will be set later
     fPatternString    = NULL; // may be set later
@@ -248,6 +265,10 @@ void RegexPattern::zap() {
     }
     uhash_close(fNamedCaptureMap);
     fNamedCaptureMap = NULL;
+    delete fDFAProgram;
+    fDFAProgram = NULL;
+    delete fMatcherPool;
+    fMatcherPool = NULL;
 }
 
 
@@ -450,6 +471,636 @@ RegexPattern::compile(UText                *regex,
 }
 
 
+//---------------------------------------------------------------------
+//
+//   cloneBinary, createFromBinary
+//
+//     The binary form of a compiled pattern starts with an array of
+//     int32_t indexes, followed by the pattern's tables. Each table
+//     starts at a multiple of 8 bytes, at the offset given by its index.
+//     Values are in the byte order of the platform that wrote them;
+//     data from a platform with the other byte order does not match the
+//     signature. The compiled code is specific to an ICU major version.
+//
+//---------------------------------------------------------------------
+namespace {
+
+enum {
+    IX_SIGNATURE,
+    IX_FORMAT_VERSION,
+    IX_ICU_VERSION,
+    IX_TOTAL_LENGTH,
+
+    IX_FLAGS,
+    IX_MIN_MATCH_LEN,
+    IX_FRAME_SIZE,
+    IX_DATA_SIZE,
+    IX_START_TYPE,
+    IX_INITIAL_STRING_IDX,
+    IX_INITIAL_STRING_LEN,
+    IX_INITIAL_STRING_SCAN,
+    IX_INITIAL_CHAR,
+    IX_NEEDS_ALT_INPUT,
+    IX_REQUIRED_STRING_IDX,
+    IX_REQUIRED_STRING_LEN,
+    IX_REQUIRED_STRING_SCAN,
+
+    IX_PATTERN_OFFSET,          // UChar[IX_PATTERN_LENGTH], the pattern string.
+    IX_PATTERN_LENGTH,
+    IX_LITERAL_OFFSET,          // UChar[IX_LITERAL_LENGTH], fLiteralText.
+    IX_LITERAL_LENGTH,
+    IX_COMPILED_OFFSET,         // int64_t[IX_COMPILED_LENGTH], fCompiledPat.
+    IX_COMPILED_LENGTH,
+    IX_GROUP_MAP_OFFSET,        // int32_t[IX_GROUP_MAP_LENGTH], fGroupMap.
+    IX_GROUP_MAP_LENGTH,
+    IX_INITIAL_CHARS_OFFSET,    // int32_t length, then fInitialChars from UnicodeSet::serialize().
+    IX_SETS_OFFSET,             // For each of fSets after slot zero: as for fInitialChars,
+    IX_NUM_SETS,                //   each starting at a multiple of 4 bytes.
+    IX_NAMES_OFFSET,            // For each named capture group: int32_t group number,
+    IX_NUM_NAMES,               //   int32_t name length, UChar name[], at multiples of 4 bytes.
+
+    IX_COUNT
+};
+
+const int32_t kBinarySignature = 0x52784270;    // "RxBp"
+const int32_t kBinaryFormatVersion = 1;
+
+// Appends to a buffer, or only counts the length once the buffer is too small.
+class BinaryWriter : public UMemory {
+public:
+    BinaryWriter(uint8_t *dest, int32_t capacity) : fDest(dest), fCapacity(capacity), fLength(0) {}
+
+    void append(const void *p, int32_t length) {
+        if (length > 0 && fLength <= fCapacity - length) {
+            uprv_memcpy(fDest + fLength, p, length);
+        }
+        fLength += length;
+    }
+    void appendInt32(int32_t value) {
+        append(&value, 4);
+    }
+    void pad(int32_t alignment) {
+        static const uint8_t zeros[8] = { 0 };
+        append(zeros, (alignment - (fLength & (alignment - 1))) & (alignment - 1));
+    }
+    void appendSet(const UnicodeSet &set, UErrorCode &status) {
+        MaybeStackArray<uint16_t, 256> data;
+        int32_t length = set.serialize(data.getAlias(), data.getCapacity(), status);
+        if (status == U_BUFFER_OVERFLOW_ERROR) {
+            status = U_ZERO_ERROR;
+            if (data.resize(length) == NULL) {
+                status = U_MEMORY_ALLOCATION_ERROR;
+                return;
+            }
+            length = set.serialize(data.getAlias(), length, status);
+        }
+        if (U_FAILURE(status)) {
+            return;
+        }
+        appendInt32(length);
+        append(data.getAlias(), length * 2);
+        pad(4);
+    }
+    int32_t length() const { return fLength; }
+    UBool   fits() const   { return fLength <= fCapacity; }
+
+private:
+    uint8_t  *fDest;
+    int32_t   fCapacity;
+    int32_t   fLength;
+};
+
+// Reads the tables, checking that each lies within the data.
+class BinaryReader : public UMemory {
+public:
+    BinaryReader(const uint8_t *bin, int32_t length) : fBin(bin), fLength(length), fPos(0) {}
+
+    UBool seek(int32_t offset) {
+        if (offset < 0 || offset > fLength) {
+            return FALSE;
+        }
+        fPos = offset;
+        return TRUE;
+    }
+    UBool read(void *p, int32_t length) {
+        if (length < 0 || length > fLength - fPos) {
+            return FALSE;
+        }
+        uprv_memcpy(p, fBin + fPos, length);
+        fPos += length;
+        return TRUE;
+    }
+    UBool readInt32(int32_t &value) {
+        return read(&value, 4);
+    }
+    UBool skipTo4() {
+        return seek((fPos + 3) & ~3);
+    }
+    UnicodeSet *readSet(UErrorCode &status) {
+        int32_t length;
+        MaybeStackArray<uint16_t, 256> data;
+        if (!readInt32(length) || length <= 0 || length > (fLength - fPos) / 2) {
+            status = U_INVALID_FORMAT_ERROR;
+            return NULL;
+        }
+        if (length > data.getCapacity() && data.resize(length) == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return NULL;
+        }
+        read(data.getAlias(), length * 2);
+        skipTo4();
+        // The UnicodeSet constructor trusts the lengths in the serialized form.
+        int32_t headerLength = (data[0] & 0x8000) != 0 ? 2 : 1;
+        int32_t listLength = data[0] & 0x7fff;
+        int32_t bmpLength = headerLength == 1 ? listLength : (length > 1 ? data[1] : -1);
+        if (length != headerLength + listLength || bmpLength < 0 || bmpLength > listLength ||
+                ((listLength - bmpLength) & 1) != 0) {
+            status = U_INVALID_FORMAT_ERROR;
+            return NULL;
+        }
+        UnicodeSet *set = new UnicodeSet(data.getAlias(), length, UnicodeSet::kSerialized, status);
+        if (set == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+        } else if (U_FAILURE(status)) {
+            delete set;
+            set = NULL;
+        }
+        return set;
+    }
+
+private:
+    const uint8_t *fBin;
+    int32_t        fLength;
+    int32_t        fPos;
+};
+
+}  // namespace
+
+
+int32_t RegexPattern::cloneBinary(uint8_t *dest, int32_t destCapacity, UErrorCode &status) const {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (U_FAILURE(fDeferredStatus)) {
+        status = fDeferredStatus;
+        return 0;
+    }
+    if (destCapacity < 0 || (dest == NULL && destCapacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    int32_t indexes[IX_COUNT];
+    uprv_memset(indexes, 0, sizeof(indexes));
+    indexes[IX_SIGNATURE]           = kBinarySignature;
+    indexes[IX_FORMAT_VERSION]      = kBinaryFormatVersion;
+    indexes[IX_ICU_VERSION]         = U_ICU_VERSION_MAJOR_NUM;
+    indexes[IX_FLAGS]               = (int32_t)fFlags;
+    indexes[IX_MIN_MATCH_LEN]       = fMinMatchLen;
+    indexes[IX_FRAME_SIZE]          = fFrameSize;
+    indexes[IX_DATA_SIZE]           = fDataSize;
+    indexes[IX_START_TYPE]          = fStartType;
+    indexes[IX_INITIAL_STRING_IDX]  = fInitialStringIdx;
+    indexes[IX_INITIAL_STRING_LEN]  = fInitialStringLen;
+    indexes[IX_INITIAL_STRING_SCAN] = fInitialStringScan;
+    indexes[IX_INITIAL_CHAR]        = fInitialChar;
+    indexes[IX_NEEDS_ALT_INPUT]     = fNeedsAltInput;
+    indexes[IX_REQUIRED_STRING_IDX] = fRequiredStringIdx;
+    indexes[IX_REQUIRED_STRING_LEN] = fRequiredStringLen;
+    indexes[IX_REQUIRED_STRING_SCAN] = fRequiredStringScan;
+
+    BinaryWriter writer(dest, destCapacity);
+    writer.append(indexes, sizeof(indexes));
+
+    UnicodeString patternString;
+    if (fPatternString != NULL) {
+        patternString.fastCopyFrom(*fPatternString);
+    } else {
+        patternString = pattern();
+    }
+    writer.pad(8);
+    indexes[IX_PATTERN_OFFSET] = writer.length();
+    indexes[IX_PATTERN_LENGTH] = patternString.length();
+    writer.append(patternString.getBuffer(), patternString.length() * 2);
+
+    writer.pad(8);
+    indexes[IX_LITERAL_OFFSET] = writer.length();
+    indexes[IX_LITERAL_LENGTH] = fLiteralText.length();
+    writer.append(fLiteralText.getBuffer(), fLiteralText.length() * 2);
+
+    writer.pad(8);
+    indexes[IX_COMPILED_OFFSET] = writer.length();
+    indexes[IX_COMPILED_LENGTH] = fCompiledPat->size();
+    writer.append(fCompiledPat->getBuffer(), fCompiledPat->size() * 8);
+
+    writer.pad(8);
+    indexes[IX_GROUP_MAP_OFFSET] = writer.length();
+    indexes[IX_GROUP_MAP_LENGTH] = fGroupMap->size();
+    writer.append(fGroupMap->getBuffer(), fGroupMap->size() * 4);
+
+    writer.pad(8);
+    indexes[IX_INITIAL_CHARS_OFFSET] = writer.length();
+    writer.appendSet(*fInitialChars, status);
+
+    writer.pad(8);
+    indexes[IX_SETS_OFFSET] = writer.length();
+    indexes[IX_NUM_SETS] = fSets->size();
+    for (int32_t i = 1; i < fSets->size() && U_SUCCESS(status); i++) {
+        writer.appendSet(*(const UnicodeSet *)fSets->elementAt(i), status);
+    }
+
+    writer.pad(8);
+    indexes[IX_NAMES_OFFSET] = writer.length();
+    indexes[IX_NUM_NAMES] = uhash_count(fNamedCaptureMap);
+    int32_t hashPos = UHASH_FIRST;
+    while (const UHashElement *hashEl = uhash_nextElement(fNamedCaptureMap, &hashPos)) {
+        const UnicodeString *name = (const UnicodeString *)hashEl->key.pointer;
+        writer.appendInt32(hashEl->value.integer);
+        writer.appendInt32(name->length());
+        writer.append(name->getBuffer(), name->length() * 2);
+        writer.pad(4);
+    }
+    writer.pad(8);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+
+    indexes[IX_TOTAL_LENGTH] = writer.length();
+    if (!writer.fits()) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    } else {
+        uprv_memcpy(dest, indexes, sizeof(indexes));
+    }
+    return writer.length();
+}
+
+
+//
+//   validateBinary   Check that the compiled code is well formed, and refers only to
+//                    data that exists: literal strings, sets, static data, stack frame
+//                    variables and pattern locations.  The matching engine trusts
+//                    these, as it does code from the pattern compiler.
+//
+UBool RegexPattern::validateBinary() const {
+    int32_t numSets = fSets->size();
+    int32_t patLength = fCompiledPat->size();
+    int32_t literalLength = fLiteralText.length();
+    int32_t frameLimit = fFrameSize - RESTACKFRAME_HDRCOUNT;
+    if (fInitialStringIdx < 0 || fInitialStringLen < 0 ||
+            fInitialStringLen > literalLength - fInitialStringIdx ||
+            fRequiredStringIdx < 0 || fRequiredStringLen < 0 ||
+            fRequiredStringLen > literalLength - fRequiredStringIdx ||
+            fInitialStringScan < 0 || (fInitialStringScan >= fInitialStringLen && fInitialStringScan > 0) ||
+            fRequiredStringScan < 0 || (fRequiredStringScan >= fRequiredStringLen && fRequiredStringScan > 0) ||
+            (fStartType == START_STRING && fInitialStringLen == 0) ||
+            fStartType < START_NO_INFO || fStartType > START_STRING ||
+            fInitialChar < 0 || fInitialChar > 0x10ffff || fMinMatchLen < 0 ||
+            // The compiler allocates at most a few data and frame slots per op.
+            frameLimit < 0 || frameLimit > 3 * patLength || fDataSize < 0 || fDataSize > 4 * patLength ||
+            patLength < 2 ||
+            URX_TYPE(fCompiledPat->elementAti(patLength - 1)) != URX_END) {
+        return FALSE;
+    }
+    // The compiled code is held in 64 bit elements, but all of its values are 32 bit.
+    for (int32_t i = 0; i < patLength; i++) {
+        int64_t value = fCompiledPat->elementAti(i);
+        if (value != (int32_t)value) {
+            return FALSE;
+        }
+    }
+    for (int32_t i = 0; i < patLength; i++) {
+        int32_t op = (int32_t)fCompiledPat->elementAti(i);
+        int32_t opType = URX_TYPE(op);
+        int32_t opValue = URX_VAL(op);
+        // Most ops refer to one kind of data, and some have extra operands.
+        int32_t patLimit = -1;      // For pattern locations, the limit of opValue.
+        int32_t dataCount = 0;      // For static data locations, the number of slots used.
+        int32_t frameCount = 0;     // For stack frame locations, the number of slots used.
+        int32_t numOperands = 0;
+        switch (opType) {
+        case URX_SETREF:
+        case URX_LOOP_SR_I:
+            if (opValue <= 0 || opValue >= numSets) {
+                return FALSE;
+            }
+            break;
+        case URX_STATIC_SETREF:
+        case URX_STAT_SETREF_N:
+            if ((opValue & ~URX_NEG_SET) >= URX_LAST_SET) {
+                return FALSE;
+            }
+            break;
+        case URX_STRING:
+        case URX_STRING_I:
+            {
+                int32_t lenOp = (int32_t)fCompiledPat->elementAti(i + 1);
+                if (URX_TYPE(lenOp) != URX_STRING_LEN || URX_VAL(lenOp) > literalLength - opValue) {
+                    return FALSE;
+                }
+                numOperands = 1;
+            }
+            break;
+        case URX_STATE_SAVE:
+        case URX_JMP:
+        case URX_JMP_SAV:
+            patLimit = patLength;
+            break;
+        case URX_JMP_SAV_X:
+            // The destination follows the URX_STO_INP_LOC for the loop.
+            if (opValue <= 0 || opValue >= patLength ||
+                    URX_TYPE(fCompiledPat->elementAti(opValue - 1)) != URX_STO_INP_LOC) {
+                return FALSE;
+            }
+            break;
+        case URX_JMPX:
+            {
+                int32_t frameLoc = URX_VAL(fCompiledPat->elementAti(i + 1));
+                if (frameLoc >= frameLimit) {
+                    return FALSE;
+                }
+                patLimit = patLength;
+                numOperands = 1;
+            }
+            break;
+        case URX_CTR_INIT:
+        case URX_CTR_INIT_NG:
+            {
+                // Operands: the loc of the matching URX_CTR_LOOP, and the minimum and maximum counts.
+                if (i + 4 >= patLength) {
+                    return FALSE;
+                }
+                int32_t loopOp = (int32_t)fCompiledPat->elementAti(i + 1);
+                int32_t loopLoc = URX_VAL(loopOp);
+                int32_t minCount = (int32_t)fCompiledPat->elementAti(i + 2);
+                int32_t maxCount = (int32_t)fCompiledPat->elementAti(i + 3);
+                int32_t expectedLoopType = opType == URX_CTR_INIT ? URX_CTR_LOOP : URX_CTR_LOOP_NG;
+                if (URX_TYPE(loopOp) != URX_RELOC_OPRND || loopLoc <= i + 3 || loopLoc >= patLength ||
+                        (int32_t)URX_TYPE(fCompiledPat->elementAti(loopLoc)) != expectedLoopType ||
+                        URX_VAL(fCompiledPat->elementAti(loopLoc)) != i ||
+                        minCount < 0 || (maxCount < minCount && maxCount != -1)) {
+                    return FALSE;
+                }
+                frameCount = maxCount == -1 ? 2 : 1;
+                numOperands = 3;
+            }
+            break;
+        case URX_CTR_LOOP:
+        case URX_CTR_LOOP_NG:
+            {
+                int32_t initType = URX_TYPE(fCompiledPat->elementAti(opValue));
+                if (opValue >= i || initType != (opType == URX_CTR_LOOP ? URX_CTR_INIT : URX_CTR_INIT_NG)) {
+                    return FALSE;
+                }
+            }
+            break;
+        case URX_START_CAPTURE:
+        case URX_END_CAPTURE:
+            frameCount = 3;
+            break;
+        case URX_BACKREF:
+        case URX_BACKREF_I:
+            frameCount = 2;
+            break;
+        case URX_STO_INP_LOC:
+        case URX_LOOP_C:
+            frameCount = 1;
+            break;
+        case URX_STO_SP:
+        case URX_LD_SP:
+            dataCount = 1;
+            break;
+        case URX_LA_START:
+        case URX_LA_END:
+            dataCount = 2;
+            break;
+        case URX_LB_START:
+        case URX_LB_END:
+        case URX_LBN_END:
+            dataCount = 4;
+            break;
+        case URX_LB_CONT:
+        case URX_LBN_CONT:
+            {
+                // Operands: the minimum and maximum lengths of a match of the look-behind,
+                //   and for URX_LBN_CONT the loc following the look-behind block.
+                numOperands = opType == URX_LB_CONT ? 2 : 3;
+                if (i + numOperands + 1 >= patLength) {
+                    return FALSE;
+                }
+                int32_t minML = (int32_t)fCompiledPat->elementAti(i + 1);
+                int32_t maxML = (int32_t)fCompiledPat->elementAti(i + 2);
+                if (minML < 0 || maxML < minML || maxML > 0x00ffffff) {
+                    return FALSE;
+                }
+                if (opType == URX_LBN_CONT) {
+                    int32_t contOp = (int32_t)fCompiledPat->elementAti(i + 3);
+                    if (URX_TYPE(contOp) != URX_RELOC_OPRND || URX_VAL(contOp) >= patLength) {
+                        return FALSE;
+                    }
+                }
+                dataCount = 4;
+            }
+            break;
+        case URX_LOOP_DOT_I:
+            break;
+        case URX_RELOC_OPRND:
+        case URX_STRING_LEN:
+            // Only as the operand of another op.
+            return FALSE;
+        default:
+            if (opType > URX_BACKSLASH_V) {
+                return FALSE;
+            }
+            break;
+        }
+        if ((patLimit >= 0 && opValue >= patLimit) ||
+                (dataCount > 0 && opValue > fDataSize - dataCount) ||
+                (frameCount > 0 && opValue > frameLimit - frameCount)) {
+            return FALSE;
+        }
+        if ((opType == URX_LOOP_SR_I || opType == URX_LOOP_DOT_I) &&
+                URX_TYPE(fCompiledPat->elementAti(i + 1)) != URX_LOOP_C) {
+            return FALSE;
+        }
+        i += numOperands;
+    }
+    for (int32_t i = 0; i < fGroupMap->size(); i++) {
+        int32_t loc = fGroupMap->elementAti(i);
+        if (loc < 0 || loc > frameLimit - 3) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
+RegexPattern * U_EXPORT2
+RegexPattern::createFromBinary(const uint8_t *bin, int32_t length, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    if (bin == NULL || length < 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    int32_t indexes[IX_COUNT];
+    if (length < (int32_t)sizeof(indexes)) {
+        status = U_INVALID_FORMAT_ERROR;
+        return NULL;
+    }
+    uprv_memcpy(indexes, bin, sizeof(indexes));
+    if (indexes[IX_SIGNATURE] != kBinarySignature ||
+            indexes[IX_FORMAT_VERSION] != kBinaryFormatVersion ||
+            indexes[IX_ICU_VERSION] != U_ICU_VERSION_MAJOR_NUM ||
+            indexes[IX_TOTAL_LENGTH] < (int32_t)sizeof(indexes) || indexes[IX_TOTAL_LENGTH] > length) {
+        status = U_INVALID_FORMAT_ERROR;
+        return NULL;
+    }
+    RegexStaticSets::initGlobals(&status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    LocalPointer<RegexPattern> pat(new RegexPattern, status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    if (U_FAILURE(pat->fDeferredStatus)) {
+        status = pat->fDeferredStatus;
+        return NULL;
+    }
+
+    pat->fFlags              = (uint32_t)indexes[IX_FLAGS];
+    pat->fMinMatchLen        = indexes[IX_MIN_MATCH_LEN];
+    pat->fFrameSize          = indexes[IX_FRAME_SIZE];
+    pat->fDataSize           = indexes[IX_DATA_SIZE];
+    pat->fStartType          = indexes[IX_START_TYPE];
+    pat->fInitialStringIdx   = indexes[IX_INITIAL_STRING_IDX];
+    pat->fInitialStringLen   = indexes[IX_INITIAL_STRING_LEN];
+    pat->fInitialStringScan  = indexes[IX_INITIAL_STRING_SCAN];
+    pat->fInitialChar        = indexes[IX_INITIAL_CHAR];
+    pat->fNeedsAltInput      = (UBool)(indexes[IX_NEEDS_ALT_INPUT] != 0);
+    pat->fRequiredStringIdx  = indexes[IX_REQUIRED_STRING_IDX];
+    pat->fRequiredStringLen  = indexes[IX_REQUIRED_STRING_LEN];
+    pat->fRequiredStringScan = indexes[IX_REQUIRED_STRING_SCAN];
+    pat->fStaticSets         = RegexStaticSets::gStaticSets->fPropSets;
+    pat->fStaticSets8        = RegexStaticSets::gStaticSets->fPropSets8;
+
+    BinaryReader reader(bin, indexes[IX_TOTAL_LENGTH]);
+    int32_t patternLength = indexes[IX_PATTERN_LENGTH];
+    int32_t literalLength = indexes[IX_LITERAL_LENGTH];
+    int32_t compiledLength = indexes[IX_COMPILED_LENGTH];
+    int32_t groupMapLength = indexes[IX_GROUP_MAP_LENGTH];
+    if (patternLength < 0 || literalLength < 0 || compiledLength < 0 || groupMapLength < 0 ||
+            patternLength > indexes[IX_TOTAL_LENGTH] / 2 || literalLength > indexes[IX_TOTAL_LENGTH] / 2 ||
+            compiledLength > indexes[IX_TOTAL_LENGTH] / 8 || groupMapLength > indexes[IX_TOTAL_LENGTH] / 4) {
+        status = U_INVALID_FORMAT_ERROR;
+        return NULL;
+    }
+
+    pat->fPatternString = new UnicodeString();
+    if (pat->fPatternString == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    UChar *patternBuffer = pat->fPatternString->getBuffer(patternLength);
+    UChar *literalBuffer = pat->fLiteralText.getBuffer(literalLength);
+    pat->fCompiledPat->setSize(compiledLength);
+    pat->fGroupMap->setSize(groupMapLength);
+    if (patternBuffer == NULL || literalBuffer == NULL ||
+            pat->fCompiledPat->size() != compiledLength || pat->fGroupMap->size() != groupMapLength) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    UBool ok =
+        reader.seek(indexes[IX_PATTERN_OFFSET]) && reader.read(patternBuffer, patternLength * 2) &&
+        reader.seek(indexes[IX_LITERAL_OFFSET]) && reader.read(literalBuffer, literalLength * 2) &&
+        reader.seek(indexes[IX_COMPILED_OFFSET]) &&
+            reader.read(pat->fCompiledPat->getBuffer(), compiledLength * 8) &&
+        reader.seek(indexes[IX_GROUP_MAP_OFFSET]) &&
+            reader.read(pat->fGroupMap->getBuffer(), groupMapLength * 4);
+    pat->fPatternString->releaseBuffer(ok ? patternLength : 0);
+    pat->fLiteralText.releaseBuffer(ok ? literalLength : 0);
+    if (!ok || !reader.seek(indexes[IX_INITIAL_CHARS_OFFSET])) {
+        status = U_INVALID_FORMAT_ERROR;
+        return NULL;
+    }
+    pat->fPattern = utext_openConstUnicodeString(NULL, pat->fPatternString, &status);
+
+    // The initial characters, and the sets. Slot zero of fSets is reserved.
+    LocalPointer<UnicodeSet> set(reader.readSet(status));
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    *pat->fInitialChars = *set;
+    pat->fInitialChars8->init(pat->fInitialChars);
+
+    int32_t numSets = indexes[IX_NUM_SETS];
+    if (numSets < 1 || numSets > indexes[IX_TOTAL_LENGTH] / 4 || !reader.seek(indexes[IX_SETS_OFFSET])) {
+        status = U_INVALID_FORMAT_ERROR;
+        return NULL;
+    }
+    pat->fSets8 = new Regex8BitSet[numSets];
+    if (pat->fSets8 == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    for (int32_t i = 1; i < numSets; i++) {
+        set.adoptInstead(reader.readSet(status));
+        if (U_FAILURE(status)) {
+            return NULL;
+        }
+        pat->fSets8[i].init(set.getAlias());
+        pat->fSets->addElement(set.orphan(), status);
+        if (U_FAILURE(status)) {
+            return NULL;
+        }
+    }
+
+    int32_t numNames = indexes[IX_NUM_NAMES];
+    if (numNames < 0 || !reader.seek(indexes[IX_NAMES_OFFSET])) {
+        status = U_INVALID_FORMAT_ERROR;
+        return NULL;
+    }
+    for (int32_t i = 0; i < numNames; i++) {
+        int32_t number, nameLength;
+        if (!reader.readInt32(number) || !reader.readInt32(nameLength) ||
+                nameLength <= 0 || nameLength > indexes[IX_TOTAL_LENGTH] / 2) {
+            status = U_INVALID_FORMAT_ERROR;
+            return NULL;
+        }
+        LocalPointer<UnicodeString> name(new UnicodeString(), status);
+        if (U_FAILURE(status)) {
+            return NULL;
+        }
+        UChar *nameBuffer = name->getBuffer(nameLength);
+        if (nameBuffer == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return NULL;
+        }
+        ok = reader.read(nameBuffer, nameLength * 2) && reader.skipTo4();
+        name->releaseBuffer(ok ? nameLength : 0);
+        if (!ok || number <= 0 || number > groupMapLength) {
+            status = U_INVALID_FORMAT_ERROR;
+            return NULL;
+        }
+        uhash_puti(pat->fNamedCaptureMap, name.orphan(), number, &status);
+        if (U_FAILURE(status)) {
+            return NULL;
+        }
+    }
+
+    if (!pat->validateBinary()) {
+        status = U_INVALID_FORMAT_ERROR;
+        return NULL;
+    }
+    pat->fDFAProgram = RegexDFAProgram::createInstance(pat.getAlias(), status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return pat.orphan();
+}
+
+
 //---------------------------------------------------------------------
 //
 //   flags
@@ -501,6 +1152,71 @@ RegexMatcher *RegexPattern::matcher(UErrorCode &status)  const {
 }
 
 
+//---------------------------------------------------------------------
+//
+//   acquireMatcher, releaseMatcher     The pool of matchers for reuse.
+//
+//         One mutex serves the pools of all patterns; it is held only
+//         to move a matcher into or out of a pool.
+//
+//---------------------------------------------------------------------
+static UMutex gMatcherPoolMutex = U_MUTEX_INITIALIZER;
+
+// The largest number of idle matchers kept by one pattern.
+static const int32_t MAX_POOLED_MATCHERS = 16;
+
+RegexMatcher *RegexPattern::acquireMatcher(UErrorCode &status) const {
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    if (U_FAILURE(fDeferredStatus)) {
+        status = fDeferredStatus;
+        return NULL;
+    }
+    {
+        Mutex lock(&gMatcherPoolMutex);
+        if (fMatcherPool != NULL && !fMatcherPool->isEmpty()) {
+            // The most recently released matcher, whose storage is most likely to be in cache.
+            return (RegexMatcher *)fMatcherPool->orphanElementAt(fMatcherPool->size() - 1);
+        }
+    }
+    return matcher(status);
+}
+
+
+void RegexPattern::releaseMatcher(RegexMatcher *matcher) const {
+    if (matcher == NULL) {
+        return;
+    }
+    if (matcher->fPattern != this || matcher->fPatternOwned != NULL ||
+            U_FAILURE(matcher->fDeferredStatus)) {
+        delete matcher;
+        return;
+    }
+    matcher->restoreDefaults();
+    {
+        Mutex lock(&gMatcherPoolMutex);
+        UErrorCode status = U_ZERO_ERROR;
+        if (fMatcherPool == NULL) {
+            fMatcherPool = new UVector(uprv_deleteUObject, NULL, status);
+            if (fMatcherPool == NULL) {
+                status = U_MEMORY_ALLOCATION_ERROR;
+            } else if (U_FAILURE(status)) {
+                delete fMatcherPool;
+                fMatcherPool = NULL;
+            }
+        }
+        if (U_SUCCESS(status) && fMatcherPool->size() < MAX_POOLED_MATCHERS) {
+            fMatcherPool->addElement(matcher, status);
+            if (U_SUCCESS(status)) {
+                return;
+            }
+        }
+    }
+    delete matcher;
+}
+
+
 
 //---------------------------------------------------------------------
 //
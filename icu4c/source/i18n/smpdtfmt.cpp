@@ -28,6 +28,8 @@
 
 #define ZID_KEY_MAX 128
 
+#include "utypeinfo.h"  // for 'typeid' to work
+
 #include "unicode/utypes.h"
 
 #if !UCONFIG_NO_FORMATTING
@@ -73,6 +75,7 @@
 #include "cstr.h"
 #include "dayperiodrules.h"
 #include "tznames_impl.h"   // ZONE_NAME_U16_MAX
+#include "gregoimp.h"
 #include "number_utypes.h"
 
 #if defined( U_DEBUG_CALSVC ) || defined (U_DEBUG_CAL)
@@ -173,6 +176,9 @@ static const UChar SUPPRESS_NEGATIVE_PREFIX[] = {0xAB00, 0};
  */
 static const UChar QUOTE = 0x27; // Single quote
 
+// In fCompiledPattern, code units below this start literal text, the others start a field.
+static const UChar COMPILED_FIELD = 0x8000;
+
 /*
  * The field range check bias for each UDateFormatField.
  * The bias is added to the minimum and maximum values
@@ -326,6 +332,7 @@ SimpleDateFormat::~SimpleDateFormat()
         delete fTimeZoneFormat;
     }
     freeFastNumberFormatters();
+    initFieldCache(FALSE);
 
 #if !UCONFIG_NO_BREAK_ITERATION
     delete fCapitalizationBrkIter;
@@ -580,8 +587,10 @@ SimpleDateFormat& SimpleDateFormat::operator=(const SimpleDateFormat& other)
     fHaveDefaultCentury          = other.fHaveDefaultCentury;
 
     fPattern = other.fPattern;
+    fCompiledPattern = other.fCompiledPattern;
     fHasMinute = other.fHasMinute;
     fHasSecond = other.fHasSecond;
+    fNumericFieldsOnly = other.fNumericFieldsOnly;
 
     // TimeZoneFormat in ICU4C only depends on a locale for now
     if (fLocale != other.fLocale) {
@@ -614,6 +623,10 @@ SimpleDateFormat& SimpleDateFormat::operator=(const SimpleDateFormat& other)
     UErrorCode localStatus = U_ZERO_ERROR;
     freeFastNumberFormatters();
     initFastNumberFormatters(localStatus);
+    // A fresh cache, not a copy: other.fFieldCache may be in use by another thread.
+    initFieldCache(FALSE);
+    UErrorCode attributeStatus = U_ZERO_ERROR;
+    initFieldCache(getBooleanAttribute(UDAT_FORMAT_CACHE_FIELDS, attributeStatus));
 
     return *this;
 }
@@ -934,7 +947,7 @@ SimpleDateFormat::format(Calendar& cal, UnicodeString& appendTo, FieldPosition&
 {
   UErrorCode status = U_ZERO_ERROR;
   FieldPositionOnlyHandler handler(pos);
-  return _format(cal, appendTo, handler, status);
+  return _format(cal, NULL, appendTo, handler, status);
 }
 
 //----------------------------------------------------------------------
@@ -944,13 +957,13 @@ SimpleDateFormat::format(Calendar& cal, UnicodeString& appendTo,
                          FieldPositionIterator* posIter, UErrorCode& status) const
 {
   FieldPositionIteratorHandler handler(posIter, status);
-  return _format(cal, appendTo, handler, status);
+  return _format(cal, NULL, appendTo, handler, status);
 }
 
 //----------------------------------------------------------------------
 
 UnicodeString&
-SimpleDateFormat::_format(Calendar& cal, UnicodeString& appendTo,
+SimpleDateFormat::_format(Calendar& cal, const GregorianCivilTime* civil, UnicodeString& appendTo,
                             FieldPositionHandler& handler, UErrorCode& status) const
 {
     if ( U_FAILURE(status) ) {
@@ -974,54 +987,402 @@ SimpleDateFormat::_format(Calendar& cal, UnicodeString& appendTo,
         }
     }
 
-    UBool inQuote = FALSE;
-    UChar prevCh = 0;
-    int32_t count = 0;
     int32_t fieldNum = 0;
     UDisplayContext capitalizationContext = getContext(UDISPCTX_TYPE_CAPITALIZATION, status);
 
-    // loop through the pattern string character by character
-    for (int32_t i = 0; i < fPattern.length() && U_SUCCESS(status); ++i) {
-        UChar ch = fPattern[i];
-
-        // Use subFormat() to format a repeated pattern character
-        // when a different pattern or non-pattern character is seen
-        if (ch != prevCh && count > 0) {
-            subFormat(appendTo, prevCh, count, capitalizationContext, fieldNum++, handler, *workCal, status);
-            count = 0;
+    // Walk the pattern as compiled by parsePattern():
+    // append literal text, and use subFormat() for each pattern field
+    const UChar* compiled = fCompiledPattern.getBuffer();
+    int32_t compiledLength = fCompiledPattern.length();
+    for (int32_t i = 0; i < compiledLength && U_SUCCESS(status);) {
+        UChar item = compiled[i++];
+        if (item < COMPILED_FIELD) {
+            appendTo.append(compiled + i, item);
+            i += item;
+        } else {
+            int32_t count = ((item & 0x7fff) << 16) | compiled[i];
+            UChar ch = compiled[i + 1];
+            i += 2;
+            subFormat(appendTo, ch, count, capitalizationContext, fieldNum++, handler, *workCal, civil, status);
         }
-        if (ch == QUOTE) {
-            // Consecutive single quotes are a single quote literal,
-            // either outside of quotes or between quotes
-            if ((i+1) < fPattern.length() && fPattern[i+1] == QUOTE) {
-                appendTo += (UChar)QUOTE;
-                ++i;
+    }
+
+    if (calClone != NULL) {
+        delete calClone;
+    }
+
+    return appendTo;
+}
+
+//----------------------------------------------------------------------
+
+/**
+ * Returns a field value for subFormat(): from the civil time if there is one,
+ * otherwise from the calendar.
+ */
+static inline int32_t getField(Calendar& cal, const GregorianCivilTime* civil,
+                               UCalendarDateFields field, UErrorCode& status) {
+    return (civil != NULL) ? civil->get(field) : cal.get(field, status);
+}
+
+/**
+ * Dates outside of +-kMaxCivilMillis are never formatted from a GregorianCivilTime
+ * or the field cache, so that they need not know where Calendar starts pinning
+ * dates to its range.
+ */
+static const double kMaxCivilMillis = 1.0e16;
+
+UBool
+SimpleDateFormat::formatDate(UDate date, UnicodeString& appendTo,
+                             FieldPositionHandler& handler, UErrorCode& status) const
+{
+    if (U_FAILURE(status)) {
+        return FALSE;
+    }
+    if (getBooleanAttribute(UDAT_FORMAT_CACHE_FIELDS, status) &&
+            formatCached(date, appendTo, handler, status)) {
+        return TRUE;
+    }
+    GregorianCivilTime civil;
+    if (!getCivilTime(date, civil)) {
+        return FALSE;
+    }
+    _format(*fCalendar, &civil, appendTo, handler, status);
+    return TRUE;
+}
+
+UBool
+SimpleDateFormat::getCivilTime(UDate date, GregorianCivilTime& civil) const
+{
+    if (fCalendar == NULL || typeid(*fCalendar) != typeid(GregorianCalendar) ||
+            !(uprv_fabs(date) < kMaxCivilMillis)) {
+        return FALSE;
+    }
+    UErrorCode status = U_ZERO_ERROR;
+    int32_t rawOffset, dstOffset;
+    fCalendar->getTimeZone().getOffset(date, FALSE, rawOffset, dstOffset, status);
+    if (U_FAILURE(status)) {
+        return FALSE;
+    }
+    civil.set(date, rawOffset, dstOffset,
+              fCalendar->getFirstDayOfWeek(), fCalendar->getMinimalDaysInFirstWeek());
+    // GregorianCalendar uses the Julian calendar before the cutover,
+    // and the cutover year is shorter, which changes week numbers in the next year.
+    // Stay at least a year after the cutover day.
+    double cutoverDay = ClockMath::floorDivide(
+        static_cast<const GregorianCalendar*>(fCalendar)->getGregorianChange(), (double)kOneDay);
+    return civil.get(UCAL_JULIAN_DAY) - kEpochStartAsJulianDay >= cutoverDay + 366;
+}
+
+/**
+ * The local day, and the formatted text of its date fields, kept for
+ * UDAT_FORMAT_CACHE_FIELDS by SimpleDateFormat::formatCached().
+ */
+class SimpleDateFormatFieldCache : public UMemory {
+public:
+    SimpleDateFormatFieldCache() : fBusy(0) {}
+
+    /** Empties the cache, so that the next date refills it. */
+    void clear() {
+        fUnsupported = FALSE;
+        fStart = fLimit = 0;
+        fText.remove();
+    }
+
+    /** Nonzero while a thread uses the cache; other threads then format normally. */
+    u_atomic_int32_t fBusy;
+    /** The pattern or the time zone cannot be formatted from the cache. */
+    UBool fUnsupported = FALSE;
+    /** The UTC range between zone transitions of the cached dates; empty until filled. */
+    UDate fStart = 0;
+    UDate fLimit = 0;
+    /** The zone offset (raw + DST), local day number and am/pm (-1 for no 'a' field) of the cached dates. */
+    int32_t fOffset = 0;
+    int32_t fDays = 0;
+    int32_t fAmPm = -1;
+    /** The values of the 'k' and 'h' fields for hour 0. */
+    int32_t fHourOfDay1Zero = 24;
+    int32_t fHour1Zero = 12;
+    /**
+     * The formatted text of the date fields, and for each pattern field its limit in fText,
+     * or -1 for a time-of-day field that is formatted for each date.
+     */
+    UnicodeString fText;
+    MaybeStackArray<int32_t, 16> fFieldLimits;
+};
+
+/** How a pattern field is formatted from the field cache. */
+enum CachedFieldKind {
+    /** Constant for a local day and zone offset: formatted when the cache is filled. */
+    kCachedFieldDate,
+    /** Computed for each date from its milliseconds in day. */
+    kCachedFieldTimeOfDay,
+    /** Changes within a day in ways the cache does not track. */
+    kCachedFieldUnsupported
+};
+
+static CachedFieldKind getCachedFieldKind(UDateFormatField patternCharIndex) {
+    switch (patternCharIndex) {
+    case UDAT_HOUR_OF_DAY1_FIELD:
+    case UDAT_HOUR_OF_DAY0_FIELD:
+    case UDAT_MINUTE_FIELD:
+    case UDAT_SECOND_FIELD:
+    case UDAT_FRACTIONAL_SECOND_FIELD:
+    case UDAT_HOUR1_FIELD:
+    case UDAT_HOUR0_FIELD:
+    case UDAT_MILLISECONDS_IN_DAY_FIELD:
+        return kCachedFieldTimeOfDay;
+    // Day periods depend on the hour and minute;
+    // specific and generic zone names can change with the metazone, without an offset transition.
+    case UDAT_AM_PM_MIDNIGHT_NOON_FIELD:
+    case UDAT_FLEXIBLE_DAY_PERIOD_FIELD:
+    case UDAT_TIMEZONE_FIELD:
+    case UDAT_TIMEZONE_GENERIC_FIELD:
+        return kCachedFieldUnsupported;
+    default:
+        // UDAT_AM_PM_FIELD is cached per half day.
+        return kCachedFieldDate;
+    }
+}
+
+/**
+ * Returns TRUE if the date is in the local day (and half day) and the zone offset range
+ * of the field cache, and sets millisInDay the same way as Calendar::computeFields().
+ */
+static UBool getCachedMillisInDay(const SimpleDateFormatFieldCache& cache, UDate date, int32_t& millisInDay) {
+    if (!(cache.fStart <= date && date < cache.fLimit)) {
+        return FALSE;
+    }
+    double localMillis = date + cache.fOffset;
+    int32_t days = (int32_t)ClockMath::floorDivide(localMillis, (double)kOneDay);
+    millisInDay = (int32_t)(localMillis - (days * kOneDay));
+    return days == cache.fDays &&
+        (cache.fAmPm < 0 || millisInDay / (12 * U_MILLIS_PER_HOUR) == cache.fAmPm);
+}
+
+UBool
+SimpleDateFormat::formatCached(UDate date, UnicodeString& appendTo,
+                               FieldPositionHandler& handler, UErrorCode& status) const
+{
+    if (U_FAILURE(status) || fCalendar == NULL) {
+        return FALSE;
+    }
+    // fFieldCache is only set by non-const functions, when the attribute is set.
+    if (fFieldCache == NULL) {
+        return FALSE;
+    }
+    SimpleDateFormatFieldCache& cache = *fFieldCache;
+    if (umtx_atomic_inc(&cache.fBusy) != 1) {
+        umtx_atomic_dec(&cache.fBusy);
+        return FALSE;
+    }
+
+    int32_t millisInDay = 0;
+    UErrorCode fillStatus = U_ZERO_ERROR;
+    UBool cached = !cache.fUnsupported &&
+        (getCachedMillisInDay(cache, date, millisInDay) ||
+            (fillFieldCache(cache, date, fillStatus) && getCachedMillisInDay(cache, date, millisInDay)));
+
+    if (cached) {
+        const UChar* compiled = fCompiledPattern.getBuffer();
+        int32_t compiledLength = fCompiledPattern.length();
+        const UChar* text = cache.fText.getBuffer();
+        int32_t textStart = 0;
+        int32_t fieldNum = 0;
+        for (int32_t i = 0; i < compiledLength;) {
+            UChar item = compiled[i++];
+            if (item < COMPILED_FIELD) {
+                appendTo.append(compiled + i, item);
+                i += item;
+                continue;
+            }
+            int32_t count = ((item & 0x7fff) << 16) | compiled[i];
+            UDateFormatField patternCharIndex = DateFormatSymbols::getPatternCharIndex(compiled[i + 1]);
+            i += 2;
+            int32_t beginOffset = appendTo.length();
+            int32_t limit = cache.fFieldLimits[fieldNum++];
+            if (limit >= 0) {
+                appendTo.append(text + textStart, limit - textStart);
+                textStart = limit;
+                if (patternCharIndex == UDAT_FIELD_COUNT) {
+                    continue;  // ignored pattern character 'l'
+                }
             } else {
-                inQuote = ! inQuote;
+                // Time-of-day fields, as in subFormat()
+                const NumberFormat* currentNumberFormat = getNumberFormatByIndex(patternCharIndex);
+                int32_t hour = millisInDay / U_MILLIS_PER_HOUR;
+                int32_t value;
+                switch (patternCharIndex) {
+                case UDAT_HOUR_OF_DAY1_FIELD:
+                    value = (hour == 0) ? cache.fHourOfDay1Zero : hour;
+                    break;
+                case UDAT_HOUR_OF_DAY0_FIELD:
+                    value = hour;
+                    break;
+                case UDAT_HOUR1_FIELD:
+                    value = (hour % 12 == 0) ? cache.fHour1Zero : hour % 12;
+                    break;
+                case UDAT_HOUR0_FIELD:
+                    value = hour % 12;
+                    break;
+                case UDAT_MINUTE_FIELD:
+                    value = (millisInDay / U_MILLIS_PER_MINUTE) % 60;
+                    break;
+                case UDAT_SECOND_FIELD:
+                    value = (millisInDay / U_MILLIS_PER_SECOND) % 60;
+                    break;
+                case UDAT_FRACTIONAL_SECOND_FIELD:
+                    value = millisInDay % 1000;
+                    break;
+                default:  // UDAT_MILLISECONDS_IN_DAY_FIELD
+                    value = millisInDay;
+                    break;
+                }
+                if (patternCharIndex == UDAT_FRACTIONAL_SECOND_FIELD) {
+                    // Fractional seconds left-justify
+                    if (count == 1) {
+                        value /= 100;
+                    } else if (count == 2) {
+                        value /= 10;
+                    }
+                    zeroPaddingNumber(currentNumberFormat, appendTo, value, (count > 3) ? 3 : count, 10);
+                    if (count > 3) {
+                        zeroPaddingNumber(currentNumberFormat, appendTo, 0, count - 3, 10);
+                    }
+                } else {
+                    zeroPaddingNumber(currentNumberFormat, appendTo, value, count, 10);
+                }
             }
+            handler.addAttribute(fgPatternIndexToDateFormatField[patternCharIndex], beginOffset, appendTo.length());
         }
-        else if (!inQuote && isSyntaxChar(ch)) {
-            // ch is a date-time pattern character to be interpreted
-            // by subFormat(); count the number of times it is repeated
-            prevCh = ch;
-            ++count;
+    }
+
+    umtx_atomic_dec(&cache.fBusy);
+    return cached;
+}
+
+UBool
+SimpleDateFormat::fillFieldCache(SimpleDateFormatFieldCache& cache, UDate date, UErrorCode& status) const
+{
+    cache.fStart = cache.fLimit = 0;
+    if (!(uprv_fabs(date) < kMaxCivilMillis)) {
+        return FALSE;
+    }
+
+    const UChar* compiled = fCompiledPattern.getBuffer();
+    int32_t compiledLength = fCompiledPattern.length();
+    int32_t fieldCount = 0;
+    UBool hasAmPm = FALSE;
+    for (int32_t i = 0; i < compiledLength;) {
+        UChar item = compiled[i++];
+        if (item < COMPILED_FIELD) {
+            i += item;
+            continue;
+        }
+        UDateFormatField patternCharIndex = DateFormatSymbols::getPatternCharIndex(compiled[i + 1]);
+        i += 2;
+        if (getCachedFieldKind(patternCharIndex) == kCachedFieldUnsupported) {
+            cache.fUnsupported = TRUE;
+            return FALSE;
         }
-        else {
-            // Append quoted characters and unquoted non-pattern characters
-            appendTo += ch;
+        hasAmPm |= (patternCharIndex == UDAT_AM_PM_FIELD);
+        ++fieldCount;
+    }
+    const BasicTimeZone* btz = dynamic_cast<const BasicTimeZone*>(&fCalendar->getTimeZone());
+    if (btz == NULL) {
+        cache.fUnsupported = TRUE;
+        return FALSE;
+    }
+    if (fieldCount > cache.fFieldLimits.getCapacity() &&
+            cache.fFieldLimits.resize(fieldCount) == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return FALSE;
+    }
+
+    GregorianCivilTime civilTime;
+    const GregorianCivilTime* civil = NULL;
+    Calendar* cal = fCalendar;
+    LocalPointer<Calendar> calClone;
+    if (getCivilTime(date, civilTime)) {
+        civil = &civilTime;
+    } else {
+        calClone.adoptInsteadAndCheckErrorCode(fCalendar->clone(), status);
+        if (U_FAILURE(status)) {
+            return FALSE;
         }
+        calClone->setTime(date, status);
+        cal = calClone.getAlias();
+    }
+    int32_t offset = getField(*cal, civil, UCAL_ZONE_OFFSET, status) +
+        getField(*cal, civil, UCAL_DST_OFFSET, status);
+    UDisplayContext capitalizationContext = getContext(UDISPCTX_TYPE_CAPITALIZATION, status);
+    if (U_FAILURE(status)) {
+        return FALSE;
     }
 
-    // Format the last item in the pattern, if any
-    if (count > 0) {
-        subFormat(appendTo, prevCh, count, capitalizationContext, fieldNum++, handler, *workCal, status);
+    // Format the date fields; subFormat() does not use the time-of-day fields for them.
+    FieldPosition pos(FieldPosition::DONT_CARE);
+    FieldPositionOnlyHandler handler(pos);
+    cache.fText.remove();
+    int32_t fieldNum = 0;
+    for (int32_t i = 0; i < compiledLength && U_SUCCESS(status);) {
+        UChar item = compiled[i++];
+        if (item < COMPILED_FIELD) {
+            i += item;
+            continue;
+        }
+        int32_t count = ((item & 0x7fff) << 16) | compiled[i];
+        UChar ch = compiled[i + 1];
+        i += 2;
+        if (getCachedFieldKind(DateFormatSymbols::getPatternCharIndex(ch)) == kCachedFieldTimeOfDay) {
+            cache.fFieldLimits[fieldNum] = -1;
+        } else {
+            subFormat(cache.fText, ch, count, capitalizationContext, fieldNum, handler, *cal, civil, status);
+            cache.fFieldLimits[fieldNum] = cache.fText.length();
+        }
+        ++fieldNum;
+    }
+    if (U_FAILURE(status)) {
+        return FALSE;
     }
 
-    if (calClone != NULL) {
-        delete calClone;
+    // The dates between the zone transitions around this one have the same offset.
+    UDate start = -kMaxCivilMillis;
+    UDate limit = kMaxCivilMillis;
+    TimeZoneTransition transition;
+    if (btz->getPreviousTransition(date, TRUE, transition) && transition.getTime() > start) {
+        start = transition.getTime();
+    }
+    if (btz->getNextTransition(date, FALSE, transition) && transition.getTime() < limit) {
+        limit = transition.getTime();
+    }
+    double localMillis = date + offset;
+    cache.fOffset = offset;
+    cache.fDays = (int32_t)ClockMath::floorDivide(localMillis, (double)kOneDay);
+    cache.fAmPm = hasAmPm ? getField(*cal, civil, UCAL_AM_PM, status) : -1;
+    cache.fHourOfDay1Zero = cal->getMaximum(UCAL_HOUR_OF_DAY) + 1;
+    cache.fHour1Zero = cal->getLeastMaximum(UCAL_HOUR) + 1;
+    if (U_FAILURE(status)) {
+        return FALSE;
+    }
+    cache.fStart = start;
+    cache.fLimit = limit;
+    return TRUE;
+}
+
+void SimpleDateFormat::initFieldCache(UBool enabled) {
+    if (!enabled) {
+        delete fFieldCache;
+        fFieldCache = NULL;
+    } else if (fFieldCache == NULL) {
+        fFieldCache = new SimpleDateFormatFieldCache();
     }
+}
 
-    return appendTo;
+void SimpleDateFormat::clearFieldCache() {
+    if (fFieldCache != NULL) {
+        fFieldCache->clear();
+    }
 }
 
 //----------------------------------------------------------------------
@@ -1217,6 +1578,42 @@ createFastFormatter(const DecimalFormat* df, int32_t minInt, int32_t maxInt) {
                     .integerWidth(number::IntegerWidth::zeroFillTo(minInt).truncateAt(maxInt)));
 }
 
+/**
+ * Appends value as decimal digits from zero, padded to minDigits and keeping only
+ * the last maxDigits digits, like a fast formatter with those integer widths.
+ * Requires value >= 0 and minDigits <= maxDigits <= 10.
+ */
+static void
+appendFastDigits(UnicodeString& appendTo, UChar zero, int32_t value, int32_t minDigits, int32_t maxDigits) {
+    UChar digits[10];
+    int32_t start = UPRV_LENGTHOF(digits);
+    int32_t limit = UPRV_LENGTHOF(digits) - maxDigits;
+    do {
+        digits[--start] = (UChar)(zero + value % 10);
+        value /= 10;
+    } while (value > 0 && start > limit);
+    while (start > UPRV_LENGTHOF(digits) - minDigits) {
+        digits[--start] = zero;
+    }
+    appendTo.append(digits + start, UPRV_LENGTHOF(digits) - start);
+}
+
+/** Returns TRUE if the fast formatter writes the value exactly as appendFastDigits() does. */
+static UBool
+formatsFastDigits(const number::LocalizedNumberFormatter* formatter, UChar zero,
+                  int32_t value, int32_t minDigits, int32_t maxDigits) {
+    if (formatter == nullptr) {
+        return FALSE;
+    }
+    number::impl::UFormattedNumberData result;
+    result.quantity.setToInt(value);
+    UErrorCode localStatus = U_ZERO_ERROR;
+    formatter->formatImpl(&result, localStatus);
+    UnicodeString expected;
+    appendFastDigits(expected, zero, value, minDigits, maxDigits);
+    return U_SUCCESS(localStatus) && result.string.toTempUnicodeString() == expected;
+}
+
 void SimpleDateFormat::initFastNumberFormatters(UErrorCode& status) {
     if (U_FAILURE(status)) {
         return;
@@ -1230,6 +1627,18 @@ void SimpleDateFormat::initFastNumberFormatters(UErrorCode& status) {
     fFastNumberFormatters[SMPDTFMT_NF_3x10] = createFastFormatter(df, 3, 10);
     fFastNumberFormatters[SMPDTFMT_NF_4x10] = createFastFormatter(df, 4, 10);
     fFastNumberFormatters[SMPDTFMT_NF_2x2] = createFastFormatter(df, 2, 2);
+
+    // Most date number formats write plain digits (no affixes, grouping or multiplier),
+    // and then zeroPaddingNumber() need not go through the formatters at all.
+    // The formatters differ only in their integer widths, so checking two of them suffices.
+    UChar zero = df->getDecimalFormatSymbols()->getConstSymbol(DecimalFormatSymbols::kZeroDigitSymbol).charAt(0);
+    if (u_charDigitValue(zero) == 0 && zero <= 0xfff6 &&
+            formatsFastDigits(fFastNumberFormatters[SMPDTFMT_NF_1x10], zero, 0, 1, 10) &&
+            formatsFastDigits(fFastNumberFormatters[SMPDTFMT_NF_1x10], zero, 123456789, 1, 10) &&
+            formatsFastDigits(fFastNumberFormatters[SMPDTFMT_NF_1x10], zero, 987654321, 1, 10) &&
+            formatsFastDigits(fFastNumberFormatters[SMPDTFMT_NF_2x2], zero, 2018, 2, 2)) {
+        fFastZeroDigit = zero;
+    }
 }
 
 void SimpleDateFormat::freeFastNumberFormatters() {
@@ -1243,6 +1652,7 @@ void SimpleDateFormat::freeFastNumberFormatters() {
     fFastNumberFormatters[SMPDTFMT_NF_3x10] = nullptr;
     fFastNumberFormatters[SMPDTFMT_NF_4x10] = nullptr;
     fFastNumberFormatters[SMPDTFMT_NF_2x2] = nullptr;
+    fFastZeroDigit = 0;
 }
 
 
@@ -1395,6 +1805,7 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
                             int32_t fieldNum,
                             FieldPositionHandler& handler,
                             Calendar& cal,
+                            const GregorianCivilTime* civil,
                             UErrorCode& status) const
 {
     if (U_FAILURE(status)) {
@@ -1410,9 +1821,6 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
     const NumberFormat *currentNumberFormat;
     DateFormatSymbols::ECapitalizationContextUsageType capContextUsageType = DateFormatSymbols::kCapContextUsageOther;
 
-    UBool isHebrewCalendar = (uprv_strcmp(cal.getType(),"hebrew") == 0);
-    UBool isChineseCalendar = (uprv_strcmp(cal.getType(),"chinese") == 0 || uprv_strcmp(cal.getType(),"dangi") == 0);
-
     // if the pattern character is unrecognized, signal an error and dump out
     if (patternCharIndex == UDAT_FIELD_COUNT)
     {
@@ -1426,7 +1834,12 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
     int32_t value = 0;
     // Don't get value unless it is useful
     if (field < UCAL_FIELD_COUNT) {
-        value = (patternCharIndex != UDAT_RELATED_YEAR_FIELD)? cal.get(field, status): cal.getRelatedYear(status);
+        if (civil != NULL) {
+            // Gregorian: the related year is the extended year
+            value = civil->get((patternCharIndex != UDAT_RELATED_YEAR_FIELD)? field: UCAL_EXTENDED_YEAR);
+        } else {
+            value = (patternCharIndex != UDAT_RELATED_YEAR_FIELD)? cal.get(field, status): cal.getRelatedYear(status);
+        }
     }
     if (U_FAILURE(status)) {
         return;
@@ -1437,14 +1850,12 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
         status = U_INTERNAL_PROGRAM_ERROR;
         return;
     }
-    UnicodeString hebr("hebr", 4, US_INV);
-
     switch (patternCharIndex) {
 
     // for any "G" symbol, write out the appropriate era string
     // "GGGG" is wide era name, "GGGGG" is narrow era name, anything else is abbreviated name
     case UDAT_ERA_FIELD:
-        if (isChineseCalendar) {
+        if (uprv_strcmp(cal.getType(),"chinese") == 0 || uprv_strcmp(cal.getType(),"dangi") == 0) {
             zeroPaddingNumber(currentNumberFormat,appendTo, value, 1, 9); // as in ICU4J
         } else {
             if (count == 5) {
@@ -1479,7 +1890,8 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
 //AD 12345 12345     45   12345    12345     12345
     case UDAT_YEAR_FIELD:
     case UDAT_YEAR_WOY_FIELD:
-        if (fDateOverride.compare(hebr)==0 && value>HEBREW_CAL_CUR_MILLENIUM_START_YEAR && value<HEBREW_CAL_CUR_MILLENIUM_END_YEAR) {
+        if (!fDateOverride.isBogus() && fDateOverride.compare(UnicodeString("hebr", 4, US_INV))==0 &&
+                value>HEBREW_CAL_CUR_MILLENIUM_START_YEAR && value<HEBREW_CAL_CUR_MILLENIUM_END_YEAR) {
             value-=HEBREW_CAL_CUR_MILLENIUM_START_YEAR;
         }
         if(count == 2)
@@ -1494,7 +1906,7 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
     // for "MMMMM"/"LLLLL", use the narrow form
     case UDAT_MONTH_FIELD:
     case UDAT_STANDALONE_MONTH_FIELD:
-        if ( isHebrewCalendar ) {
+        if (uprv_strcmp(cal.getType(),"hebrew") == 0) {
            HebrewCalendar *hc = (HebrewCalendar*)&cal;
            if (hc->isLeapYear(hc->get(UCAL_YEAR,status)) && value == 6 && count >= 3 )
                value = 13; // Show alternate form for Adar II in leap years in Hebrew calendar.
@@ -1503,7 +1915,7 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
         }
         {
             int32_t isLeapMonth = (fSymbols->fLeapMonthPatterns != NULL && fSymbols->fLeapMonthPatternsCount >= DateFormatSymbols::kMonthPatternsCount)?
-                        cal.get(UCAL_IS_LEAP_MONTH, status): 0;
+                        getField(cal, civil, UCAL_IS_LEAP_MONTH, status): 0;
             // should consolidate the next section by using arrays of pointers & counts for the right symbols...
             if (count == 5) {
                 if (patternCharIndex == UDAT_MONTH_FIELD) {
@@ -1579,7 +1991,7 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
         }
         // fall through to EEEEE-EEE handling, but for that we don't want local day-of-week,
         // we want standard day-of-week, so first fix value to work for EEEEE-EEE.
-        value = cal.get(UCAL_DAY_OF_WEEK, status);
+        value = getField(cal, civil, UCAL_DAY_OF_WEEK, status);
         if (U_FAILURE(status)) {
             return;
         }
@@ -1616,7 +2028,7 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
         }
         // fall through to alpha DOW handling, but for that we don't want local day-of-week,
         // we want standard day-of-week, so first fix value.
-        value = cal.get(UCAL_DAY_OF_WEEK, status);
+        value = getField(cal, civil, UCAL_DAY_OF_WEEK, status);
         if (U_FAILURE(status)) {
             return;
         }
@@ -1679,7 +2091,7 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
             UChar zsbuf[ZONE_NAME_U16_MAX];
             UnicodeString zoneString(zsbuf, 0, UPRV_LENGTHOF(zsbuf));
             const TimeZone& tz = cal.getTimeZone();
-            UDate date = cal.getTime(status);
+            UDate date = (civil != NULL) ? civil->getTime() : cal.getTime(status);
             const TimeZoneFormat *tzfmt = tzFormat(status);
             if (U_SUCCESS(status)) {
                 if (patternCharIndex == UDAT_TIMEZONE_FIELD) {
@@ -1810,7 +2222,7 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
     case UDAT_AM_PM_MIDNIGHT_NOON_FIELD:
     {
         const UnicodeString *toAppend = NULL;
-        int32_t hour = cal.get(UCAL_HOUR_OF_DAY, status);
+        int32_t hour = getField(cal, civil, UCAL_HOUR_OF_DAY, status);
 
         // Note: "midnight" can be ambiguous as to whether it refers to beginning of day or end of day.
         // For ICU 57 output of "midnight" is temporarily suppressed.
@@ -1819,12 +2231,12 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
         // Time, as displayed, must be exactly noon or midnight.
         // This means minutes and seconds, if present, must be zero.
         if ((/*hour == 0 ||*/ hour == 12) &&
-                (!fHasMinute || cal.get(UCAL_MINUTE, status) == 0) &&
-                (!fHasSecond || cal.get(UCAL_SECOND, status) == 0)) {
+                (!fHasMinute || getField(cal, civil, UCAL_MINUTE, status) == 0) &&
+                (!fHasSecond || getField(cal, civil, UCAL_SECOND, status) == 0)) {
             // Stealing am/pm value to use as our array index.
             // It works out: am/midnight are both 0, pm/noon are both 1,
             // 12 am is 12 midnight, and 12 pm is 12 noon.
-            int32_t value = cal.get(UCAL_AM_PM, status);
+            int32_t value = getField(cal, civil, UCAL_AM_PM, status);
 
             if (count <= 3) {
                 toAppend = &fSymbols->fAbbreviatedDayPeriods[value];
@@ -1841,7 +2253,7 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
         if (toAppend == NULL || toAppend->isBogus()) {
             // Reformat with identical arguments except ch, now changed to 'a'.
             subFormat(appendTo, 0x61, count, capitalizationContext, fieldNum,
-                      handler, cal, status);
+                      handler, cal, civil, status);
         } else {
             appendTo += *toAppend;
         }
@@ -1862,19 +2274,19 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
             // Data doesn't exist for the locale we're looking for.
             // Falling back to am/pm.
             subFormat(appendTo, 0x61, count, capitalizationContext, fieldNum,
-                      handler, cal, status);
+                      handler, cal, civil, status);
             break;
         }
 
         // Get current display time.
-        int32_t hour = cal.get(UCAL_HOUR_OF_DAY, status);
+        int32_t hour = getField(cal, civil, UCAL_HOUR_OF_DAY, status);
         int32_t minute = 0;
         if (fHasMinute) {
-            minute = cal.get(UCAL_MINUTE, status);
+            minute = getField(cal, civil, UCAL_MINUTE, status);
         }
         int32_t second = 0;
         if (fHasSecond) {
-            second = cal.get(UCAL_SECOND, status);
+            second = getField(cal, civil, UCAL_SECOND, status);
         }
 
         // Determine day period.
@@ -1933,7 +2345,7 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
             periodType == DayPeriodRules::DAYPERIOD_PM ||
             toAppend->isBogus()) {
             subFormat(appendTo, 0x61, count, capitalizationContext, fieldNum,
-                      handler, cal, status);
+                      handler, cal, civil, status);
         }
         else {
             appendTo += *toAppend;
@@ -1995,6 +2407,7 @@ void SimpleDateFormat::adoptNumberFormat(NumberFormat *formatToAdopt) {
     UErrorCode localStatus = U_ZERO_ERROR;
     freeFastNumberFormatters();
     initFastNumberFormatters(localStatus);
+    clearFieldCache();
 }
 
 void SimpleDateFormat::adoptNumberFormat(const UnicodeString& fields, NumberFormat *formatToAdopt, UErrorCode &status){
@@ -2032,6 +2445,7 @@ void SimpleDateFormat::adoptNumberFormat(const UnicodeString& fields, NumberForm
                 newFormat, fSharedNumberFormatters[patternCharIndex]);
     }
     newFormat->deleteIfZeroRefCount();
+    clearFieldCache();
 }
 
 const NumberFormat *
@@ -2070,6 +2484,11 @@ SimpleDateFormat::zeroPaddingNumber(
             }
         }
     }
+    if (fastFormatter != nullptr && fFastZeroDigit != 0 && value >= 0) {
+        // Fastest path: plain digits, see initFastNumberFormatters()
+        appendFastDigits(appendTo, fFastZeroDigit, value, minDigits, maxDigits);
+        return;
+    }
     if (fastFormatter != nullptr) {
         // Can use fast path
         number::impl::UFormattedNumberData result;
@@ -2145,6 +2564,167 @@ SimpleDateFormat::isAfterNonNumericField(const UnicodeString &pattern, int32_t p
     return !DateFormatSymbols::isNumericField(f, patternOffset - i);
 }
 
+UBool
+SimpleDateFormat::parseNumeric(const UnicodeString& text, ParsePosition& parsePos, UDate& date) const
+{
+    int32_t start = parsePos.getIndex();
+    if (!fNumericFieldsOnly || start < 0 || fFastZeroDigit != 0x30 ||
+            fSharedNumberFormatters != NULL || fSymbols->fLeapMonthPatterns != NULL ||
+            fCalendar == NULL || typeid(*fCalendar) != typeid(GregorianCalendar)) {
+        return FALSE;
+    }
+    // Calendar::computeZoneOffset() uses only these zones as BasicTimeZones
+    const TimeZone& tz = fCalendar->getTimeZone();
+    if (dynamic_cast<const OlsonTimeZone *>(&tz) == NULL
+        && dynamic_cast<const SimpleTimeZone *>(&tz) == NULL
+        && dynamic_cast<const RuleBasedTimeZone *>(&tz) == NULL
+        && dynamic_cast<const VTimeZone *>(&tz) == NULL) {
+        return FALSE;
+    }
+    const BasicTimeZone& btz = static_cast<const BasicTimeZone&>(tz);
+
+    // Fields that are not in the pattern keep the values of a cleared Calendar
+    int32_t year = kEpochYear, month = 0, dayOfMonth = 1;
+    int32_t hour = 0, minute = 0, second = 0, millis = 0;
+
+    const UChar* chars = text.getBuffer();
+    int32_t length = text.length();
+    int32_t pos = start;
+    const UChar* compiled = fCompiledPattern.getBuffer();
+    int32_t compiledLength = fCompiledPattern.length();
+    UBool afterField = FALSE;
+    for (int32_t i = 0; i < compiledLength;) {
+        UChar item = compiled[i++];
+        if (item < COMPILED_FIELD) {
+            // Literal text must match exactly; parse() handles whitespace and partial matches
+            if (length - pos < item || u_memcmp(chars + pos, compiled + i, item) != 0) {
+                return FALSE;
+            }
+            pos += item;
+            i += item;
+            afterField = FALSE;
+            continue;
+        }
+        int32_t count = compiled[i];  // at most 9
+        UChar ch = compiled[i + 1];
+        i += 2;
+        if (length - pos < count) {
+            return FALSE;
+        }
+        int32_t value = 0;
+        for (int32_t limit = pos + count; pos < limit; ++pos) {
+            UChar c = chars[pos];
+            if (c < 0x30 || 0x39 < c) {
+                return FALSE;
+            }
+            value = value * 10 + (c - 0x30);
+        }
+        // parse() takes count digits for each field in a run of abutting fields,
+        // and the whole number for other fields. Leave longer numbers, and any
+        // that might continue with an exponent, to the NumberFormat.
+        UBool abutting = afterField || (i < compiledLength && compiled[i] >= COMPILED_FIELD);
+        afterField = TRUE;
+        if (!abutting && pos < length) {
+            UChar c = chars[pos];
+            if ((0x30 <= c && c <= 0x39) || c == 0x45 || c == 0x65 || c >= 0x80) {  // E e
+                return FALSE;
+            }
+        }
+        // Values out of range are errors or wrap around in the Calendar
+        switch (ch) {
+        case 0x79:  // 'y', within kMaxCivilMillis
+            if (value > 300000) {
+                return FALSE;
+            }
+            year = value;
+            break;
+        case 0x4D:  // 'M'
+            if (value < 1 || value > 12) {
+                return FALSE;
+            }
+            month = value - 1;
+            break;
+        case 0x64:  // 'd', checked below
+            dayOfMonth = value;
+            break;
+        case 0x48:  // 'H'
+            if (value > 23) {
+                return FALSE;
+            }
+            hour = value;
+            break;
+        case 0x6B:  // 'k'
+            if (value > 24) {
+                return FALSE;
+            }
+            hour = (value == 24) ? 0 : value;
+            break;
+        case 0x6D:  // 'm'
+            if (value > 59) {
+                return FALSE;
+            }
+            minute = value;
+            break;
+        case 0x73:  // 's'
+            if (value > 59) {
+                return FALSE;
+            }
+            second = value;
+            break;
+        default:  // 'S'
+            // Fractional seconds left-justify
+            for (int32_t digits = count; digits < 3; ++digits) {
+                value *= 10;
+            }
+            for (int32_t digits = count; digits > 3; --digits) {
+                value /= 10;
+            }
+            millis = value;
+            break;
+        }
+    }
+    if (dayOfMonth < 1 || dayOfMonth > Grego::monthLength(year, month)) {
+        return FALSE;
+    }
+
+    // Stay a year after the Gregorian cutover, as in getCivilTime()
+    double day = Grego::fieldsToDay(year, month, dayOfMonth);
+    double cutoverDay = ClockMath::floorDivide(
+        static_cast<const GregorianCalendar*>(fCalendar)->getGregorianChange(), (double)kOneDay);
+    if (day < cutoverDay + 366) {
+        return FALSE;
+    }
+    UDate wall = day * kOneDay + (((hour * 60 + minute) * 60 + second) * 1000 + millis);
+    if (!(uprv_fabs(wall) < kMaxCivilMillis)) {
+        return FALSE;
+    }
+
+    // Resolve the wall time like Calendar::computeTime()
+    UErrorCode status = U_ZERO_ERROR;
+    UCalendarWallTimeOption skippedWallTime = fCalendar->getSkippedWallTimeOption();
+    int32_t duplicatedTimeOpt = (fCalendar->getRepeatedWallTimeOption() == UCAL_WALLTIME_FIRST) ?
+        BasicTimeZone::kFormer : BasicTimeZone::kLatter;
+    int32_t nonExistingTimeOpt = (skippedWallTime == UCAL_WALLTIME_FIRST) ?
+        BasicTimeZone::kLatter : BasicTimeZone::kFormer;
+    int32_t rawOffset, dstOffset;
+    btz.getOffsetFromLocal(wall, nonExistingTimeOpt, duplicatedTimeOpt, rawOffset, dstOffset, status);
+    UDate time = wall - (rawOffset + dstOffset);
+    if (!fCalendar->isLenient() || skippedWallTime == UCAL_WALLTIME_NEXT_VALID) {
+        // A skipped wall time is an error, or is moved to the transition
+        int32_t raw, dst;
+        btz.getOffset(time, FALSE, raw, dst, status);
+        if (raw + dst != rawOffset + dstOffset) {
+            return FALSE;
+        }
+    }
+    if (U_FAILURE(status)) {
+        return FALSE;
+    }
+    parsePos.setIndex(pos);
+    date = time;
+    return TRUE;
+}
+
 void
 SimpleDateFormat::parse(const UnicodeString& text, Calendar& cal, ParsePosition& parsePos) const
 {
@@ -3883,6 +4463,7 @@ SimpleDateFormat::applyLocalizedPattern(const UnicodeString& pattern,
     translatePattern(pattern, fPattern,
                      fSymbols->fLocalPatternChars,
                      UnicodeString(DateFormatSymbols::getPatternUChars()), status);
+    parsePattern();
 }
 
 //----------------------------------------------------------------------
@@ -3900,6 +4481,7 @@ SimpleDateFormat::adoptDateFormatSymbols(DateFormatSymbols* newFormatSymbols)
 {
     delete fSymbols;
     fSymbols = newFormatSymbols;
+    clearFieldCache();
 }
 
 //----------------------------------------------------------------------
@@ -3908,6 +4490,7 @@ SimpleDateFormat::setDateFormatSymbols(const DateFormatSymbols& newFormatSymbols
 {
     delete fSymbols;
     fSymbols = new DateFormatSymbols(newFormatSymbols);
+    clearFieldCache();
 }
 
 //----------------------------------------------------------------------
@@ -3928,6 +4511,7 @@ SimpleDateFormat::adoptTimeZoneFormat(TimeZoneFormat* timeZoneFormatToAdopt)
 {
     delete fTimeZoneFormat;
     fTimeZoneFormat = timeZoneFormatToAdopt;
+    clearFieldCache();
 }
 
 //----------------------------------------------------------------------
@@ -3936,6 +4520,7 @@ SimpleDateFormat::setTimeZoneFormat(const TimeZoneFormat& newTimeZoneFormat)
 {
     delete fTimeZoneFormat;
     fTimeZoneFormat = new TimeZoneFormat(newTimeZoneFormat);
+    clearFieldCache();
 }
 
 //----------------------------------------------------------------------
@@ -3955,11 +4540,44 @@ void SimpleDateFormat::adoptCalendar(Calendar* calendarToAdopt)
   delete fSymbols;
   fSymbols = newSymbols;
   initializeDefaultCentury();  // we need a new century (possibly)
+  clearFieldCache();
 }
 
+//----------------------------------------------------------------------
+
+void SimpleDateFormat::adoptTimeZone(TimeZone* zoneToAdopt)
+{
+    DateFormat::adoptTimeZone(zoneToAdopt);
+    clearFieldCache();
+}
 
 //----------------------------------------------------------------------
 
+void SimpleDateFormat::setTimeZone(const TimeZone& zone)
+{
+    DateFormat::setTimeZone(zone);
+    clearFieldCache();
+}
+
+
+//----------------------------------------------------------------------
+
+
+// override the DateFormat implementation in order to
+// create or delete fFieldCache
+DateFormat&
+SimpleDateFormat::setBooleanAttribute(UDateFormatBooleanAttribute attr,
+                                      UBool newValue,
+                                      UErrorCode &status)
+{
+    DateFormat::setBooleanAttribute(attr, newValue, status);
+    if (attr == UDAT_FORMAT_CACHE_FIELDS && U_SUCCESS(status)) {
+        initFieldCache(newValue);
+    }
+    return *this;
+}
+
+//----------------------------------------------------------------------
 
 // override the DateFormat implementation in order to
 // lazily initialize fCapitalizationBrkIter
@@ -3967,6 +4585,7 @@ void
 SimpleDateFormat::setContext(UDisplayContext value, UErrorCode& status)
 {
     DateFormat::setContext(value, status);
+    clearFieldCache();
 #if !UCONFIG_NO_BREAK_ITERATION
     if (U_SUCCESS(status)) {
         if ( fCapitalizationBrkIter == NULL && (value==UDISPCTX_CAPITALIZATION_FOR_BEGINNING_OF_SENTENCE ||
@@ -4204,9 +4823,52 @@ SimpleDateFormat::tzFormat(UErrorCode &status) const {
     return fTimeZoneFormat;
 }
 
+/**
+ * Appends one code unit of literal text to a compiled pattern,
+ * starting a new literal item if the previous item is not a literal or is full.
+ */
+static void
+appendCompiledLiteral(UnicodeString& compiled, int32_t& literalStart, UChar ch) {
+    if (literalStart < 0 || compiled[literalStart] == COMPILED_FIELD - 1) {
+        literalStart = compiled.length();
+        compiled.append((UChar)0);
+    }
+    compiled.append(ch);
+    compiled.setCharAt(literalStart, compiled[literalStart] + 1);
+}
+
+/**
+ * Returns TRUE if SimpleDateFormat::parseNumeric() supports the pattern field.
+ * Years of 1 or 2 letters are excluded because two-digit years are adjusted
+ * to the default century.
+ */
+static UBool
+isNumericParseField(UChar ch, int32_t count) {
+    if (count > 9) {
+        return FALSE;
+    }
+    switch (ch) {
+    case 0x79:  // 'y'
+        return count >= 3;
+    case 0x4D:  // 'M'
+        return count <= 2;
+    case 0x64:  // 'd'
+    case 0x48:  // 'H'
+    case 0x6B:  // 'k'
+    case 0x6D:  // 'm'
+    case 0x73:  // 's'
+    case 0x53:  // 'S'
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
 void SimpleDateFormat::parsePattern() {
+    clearFieldCache();
     fHasMinute = FALSE;
     fHasSecond = FALSE;
+    fCompiledPattern.remove();
 
     int len = fPattern.length();
     UBool inQuote = FALSE;
@@ -4224,6 +4886,61 @@ void SimpleDateFormat::parsePattern() {
             }
         }
     }
+
+    // Split the pattern the way format() used to when scanning it for each call:
+    // a run of one unquoted pattern character is a field, everything else is literal.
+    inQuote = FALSE;
+    UChar prevCh = 0;
+    int32_t count = 0;
+    int32_t literalStart = -1;
+    for (int32_t i = 0; i < len; ++i) {
+        UChar ch = fPattern[i];
+        if (ch != prevCh && count > 0) {
+            fCompiledPattern.append((UChar)(COMPILED_FIELD | (count >> 16)))
+                    .append((UChar)count).append(prevCh);
+            literalStart = -1;
+            count = 0;
+        }
+        if (ch == QUOTE) {
+            // Consecutive single quotes are a single quote literal,
+            // either outside of quotes or between quotes
+            if ((i+1) < len && fPattern[i+1] == QUOTE) {
+                appendCompiledLiteral(fCompiledPattern, literalStart, QUOTE);
+                ++i;
+            } else {
+                inQuote = ! inQuote;
+            }
+        }
+        else if (!inQuote && isSyntaxChar(ch)) {
+            prevCh = ch;
+            ++count;
+        }
+        else {
+            appendCompiledLiteral(fCompiledPattern, literalStart, ch);
+        }
+    }
+    if (count > 0) {
+        fCompiledPattern.append((UChar)(COMPILED_FIELD | (count >> 16)))
+                .append((UChar)count).append(prevCh);
+    }
+
+    fNumericFieldsOnly = FALSE;
+    const UChar* compiled = fCompiledPattern.getBuffer();
+    int32_t compiledLength = fCompiledPattern.length();
+    for (int32_t i = 0; i < compiledLength;) {
+        UChar item = compiled[i++];
+        if (item < COMPILED_FIELD) {
+            i += item;
+            continue;
+        }
+        count = ((item & 0x7fff) << 16) | compiled[i];
+        UChar ch = compiled[i + 1];
+        i += 2;
+        fNumericFieldsOnly = isNumericParseField(ch, count);
+        if (!fNumericFieldsOnly) {
+            break;
+        }
+    }
 }
 
 U_NAMESPACE_END
@@ -134,6 +134,29 @@ static icu::UInitOnce gSystemZonesInitOnce = U_INITONCE_INITIALIZER;
 static icu::UInitOnce gCanonicalZonesInitOnce = U_INITONCE_INITIALIZER;
 static icu::UInitOnce gCanonicalLocationZonesInitOnce = U_INITONCE_INITIALIZER;
 
+// Regions of the zones, indexed like the zoneinfo64 Names
+static const UChar** ZONE_REGIONS = NULL;
+static int32_t LEN_ZONE_REGIONS = 0;
+static icu::UInitOnce gZoneRegionsInitOnce = U_INITONCE_INITIALIZER;
+
+// Immutable OlsonTimeZone prototypes for system zone IDs, indexed like the
+// zoneinfo64 Names; createTimeZone() returns clones of them.
+// Each prototype is created once, under gZonePrototypeLock, and published
+// by setting its ready flag, so that lookups need no lock.
+U_NAMESPACE_BEGIN
+struct ZonePrototype : public UMemory {
+    ZonePrototype() : ready(0), zone(NULL) {}
+    ~ZonePrototype() { delete zone; }
+
+    u_atomic_int32_t ready;
+    OlsonTimeZone *zone;
+};
+U_NAMESPACE_END
+static icu::ZonePrototype* ZONE_PROTOTYPES = NULL;
+static int32_t LEN_ZONE_PROTOTYPES = 0;
+static icu::UInitOnce gZonePrototypesInitOnce = U_INITONCE_INITIALIZER;
+static UMutex gZonePrototypeLock = U_MUTEX_INITIALIZER;
+
 U_CDECL_BEGIN
 static UBool U_CALLCONV timeZone_cleanup(void)
 {
@@ -166,6 +189,16 @@ static UBool U_CALLCONV timeZone_cleanup(void)
     MAP_CANONICAL_SYSTEM_LOCATION_ZONES = 0;
     gCanonicalLocationZonesInitOnce.reset();
 
+    LEN_ZONE_REGIONS = 0;
+    uprv_free(ZONE_REGIONS);
+    ZONE_REGIONS = NULL;
+    gZoneRegionsInitOnce.reset();
+
+    LEN_ZONE_PROTOTYPES = 0;
+    delete[] ZONE_PROTOTYPES;
+    ZONE_PROTOTYPES = NULL;
+    gZonePrototypesInitOnce.reset();
+
     return TRUE;
 }
 U_CDECL_END
@@ -376,8 +409,26 @@ TimeZone::operator==(const TimeZone& that) const
 // -------------------------------------
 
 namespace {
+
+void U_CALLCONV initZonePrototypes(UErrorCode &ec) {
+    ucln_i18n_registerCleanup(UCLN_I18N_TIMEZONE, timeZone_cleanup);
+    UResourceBundle *res = ures_openDirect(0, kZONEINFO, &ec);
+    res = ures_getByKey(res, kNAMES, res, &ec); // dereference Names section
+    int32_t size = ures_getSize(res);
+    ures_close(res);
+    if (U_FAILURE(ec)) {
+        return;
+    }
+    ZONE_PROTOTYPES = new ZonePrototype[size];
+    if (ZONE_PROTOTYPES == NULL) {
+        ec = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    LEN_ZONE_PROTOTYPES = size;
+}
+
 TimeZone*
-createSystemTimeZone(const UnicodeString& id, UErrorCode& ec) {
+createOlsonTimeZone(const UnicodeString& id, UErrorCode& ec) {
     if (U_FAILURE(ec)) {
         return NULL;
     }
@@ -390,6 +441,7 @@ createSystemTimeZone(const UnicodeString& id, UErrorCode& ec) {
     if (U_SUCCESS(ec)) {
         z = new OlsonTimeZone(top, &res, id, ec);
         if (z == NULL) {
+          ec = U_MEMORY_ALLOCATION_ERROR;
           U_DEBUG_TZ_MSG(("cstz: olson time zone failed to initialize - err %s\n", u_errorName(ec)));
         }
     }
@@ -403,6 +455,49 @@ createSystemTimeZone(const UnicodeString& id, UErrorCode& ec) {
     return z;
 }
 
+/**
+ * Returns a new OlsonTimeZone for a system zone ID, as a clone of the
+ * shared prototype for that ID. The prototype is never modified, so that
+ * each clone can be changed independently.
+ */
+TimeZone*
+createSystemTimeZone(const UnicodeString& id, UErrorCode& ec) {
+    if (U_FAILURE(ec)) {
+        return NULL;
+    }
+    int32_t index = ZoneMeta::findTimeZoneIDIndex(id);
+    if (index < 0) {
+        ec = U_MISSING_RESOURCE_ERROR;
+        return NULL;
+    }
+    umtx_initOnce(gZonePrototypesInitOnce, &initZonePrototypes, ec);
+    if (U_FAILURE(ec) || index >= LEN_ZONE_PROTOTYPES) {
+        // Fall back to loading the zone for this instance only
+        ec = U_ZERO_ERROR;
+        return createOlsonTimeZone(id, ec);
+    }
+    ZonePrototype &prototype = ZONE_PROTOTYPES[index];
+    if (umtx_loadAcquire(prototype.ready) == 0) {
+        Mutex lock(&gZonePrototypeLock);
+        if (umtx_loadAcquire(prototype.ready) == 0) {
+            prototype.zone = (OlsonTimeZone*)createOlsonTimeZone(id, ec);
+            if (prototype.zone == NULL) {
+                // Leave the prototype unset, so that a later call tries again.
+                if (U_SUCCESS(ec)) {
+                    ec = U_MEMORY_ALLOCATION_ERROR;
+                }
+                return NULL;
+            }
+            umtx_storeRelease(prototype.ready, 1);
+        }
+    }
+    TimeZone *z = prototype.zone->clone();
+    if (z == NULL) {
+        ec = U_MEMORY_ALLOCATION_ERROR;
+    }
+    return z;
+}
+
 /**
  * Lookup the given name in our system zone table.  If found,
  * instantiate a new zone of that name and return it.  If not
@@ -590,6 +685,46 @@ TimeZone::setDefault(const TimeZone& zone)
 //----------------------------------------------------------------------
 
 
+static void U_CALLCONV initZoneRegions(UErrorCode& ec) {
+    ucln_i18n_registerCleanup(UCLN_I18N_TIMEZONE, timeZone_cleanup);
+
+    UResourceBundle *res = ures_openDirect(0, kZONEINFO, &ec);
+    res = ures_getByKey(res, kREGIONS, res, &ec); // dereference Regions section
+    if (U_SUCCESS(ec)) {
+        int32_t size = ures_getSize(res);
+        const UChar **regions = (const UChar **)uprv_malloc(size * sizeof(const UChar *));
+        if (regions == NULL) {
+            ec = U_MEMORY_ALLOCATION_ERROR;
+        } else {
+            for (int32_t i = 0; i < size && U_SUCCESS(ec); i++) {
+                regions[i] = ures_getStringByIndex(res, i, NULL, &ec);
+            }
+            if (U_SUCCESS(ec)) {
+                ZONE_REGIONS = regions;
+                LEN_ZONE_REGIONS = size;
+            } else {
+                uprv_free(regions);
+            }
+        }
+    }
+    ures_close(res);
+}
+
+/**
+ * Returns the region of the zone at the given index in the zoneinfo64 Names.
+ */
+static const UChar* getRegionAt(int32_t zidx, UErrorCode& ec) {
+    umtx_initOnce(gZoneRegionsInitOnce, &initZoneRegions, ec);
+    if (U_FAILURE(ec)) {
+        return NULL;
+    }
+    if (zidx < 0 || zidx >= LEN_ZONE_REGIONS) {
+        ec = U_MISSING_RESOURCE_ERROR;
+        return NULL;
+    }
+    return ZONE_REGIONS[zidx];
+}
+
 static void U_CALLCONV initMap(USystemTimeZoneType type, UErrorCode& ec) {
     ucln_i18n_registerCleanup(UCLN_I18N_TIMEZONE, timeZone_cleanup);
 
@@ -623,7 +758,7 @@ static void U_CALLCONV initMap(USystemTimeZoneType type, UErrorCode& ec) {
                     }
                 }
                 if (type == UCAL_ZONE_TYPE_CANONICAL_LOCATION) {
-                    const UChar *region = TimeZone::getRegion(id, ec);
+                    const UChar *region = getRegionAt(i, ec);
                     if (U_FAILURE(ec)) {
                         break;
                     }
@@ -822,17 +957,19 @@ class TZEnumeration : public StringEnumeration {
             res = ures_getByKey(res, kNAMES, res, &ec); // dereference Zones section
             for (int32_t i = 0; i < baseLen; i++) {
                 int32_t zidx = baseMap[i];
-                UnicodeString id = ures_getUnicodeStringByIndex(res, zidx, &ec);
-                if (U_FAILURE(ec)) {
-                    break;
-                }
                 if (region != NULL) {
                     // Filter by region
-                    char tzregion[4]; // max 3 letters + null term
-                    TimeZone::getRegion(id, tzregion, sizeof(tzregion), ec);
+                    const UChar *uregion = getRegionAt(zidx, ec);
                     if (U_FAILURE(ec)) {
                         break;
                     }
+                    char tzregion[4]; // max 3 letters + null term
+                    int32_t regionLen = u_strlen(uregion);
+                    if (regionLen >= UPRV_LENGTHOF(tzregion)) {
+                        continue;
+                    }
+                    // A region code is represented by invariant characters
+                    u_UCharsToChars(uregion, tzregion, regionLen + 1);
                     if (uprv_stricmp(tzregion, region) != 0) {
                         // region does not match
                         continue;
@@ -841,6 +978,10 @@ class TZEnumeration : public StringEnumeration {
                 if (rawOffset != NULL) {
                     // Filter by raw offset
                     // Note: This is VERY inefficient
+                    UnicodeString id = ures_getUnicodeStringByIndex(res, zidx, &ec);
+                    if (U_FAILURE(ec)) {
+                        break;
+                    }
                     TimeZone *z = createSystemTimeZone(id, ec);
                     if (U_FAILURE(ec)) {
                         break;
@@ -1112,23 +1253,11 @@ TimeZone::getRegion(const UnicodeString& id, UErrorCode& status) {
     if (U_FAILURE(status)) {
         return NULL;
     }
-    const UChar *result = NULL;
-    UResourceBundle *rb = ures_openDirect(NULL, kZONEINFO, &status);
-
-    // resolve zone index by name
-    UResourceBundle *res = ures_getByKey(rb, kNAMES, NULL, &status);
-    int32_t idx = findInStringArray(res, id, status);
-
-    // get region mapping
-    ures_getByKey(rb, kREGIONS, res, &status);
-    const UChar *tmp = ures_getStringByIndex(res, idx, NULL, &status);
-    if (U_SUCCESS(status)) {
-        result = tmp;
+    // resolve zone index by name, and get its region
+    const UChar *result = getRegionAt(ZoneMeta::findTimeZoneIDIndex(id), status);
+    if (U_FAILURE(status)) {
+        result = NULL;
     }
-
-    ures_close(res);
-    ures_close(rb);
-
     return result;
 }
 
@@ -173,7 +173,7 @@ TextTrieMapSearchResultHandler::~TextTrieMapSearchResultHandler(){
 // ---------------------------------------------------
 TextTrieMap::TextTrieMap(UBool ignoreCase, UObjectDeleter *valueDeleter)
 : fIgnoreCase(ignoreCase), fNodes(NULL), fNodesCapacity(0), fNodesCount(0), 
-  fLazyContents(NULL), fIsEmpty(TRUE), fValueDeleter(valueDeleter) {
+  fLazyContents(NULL), fHasLazyContents(0), fIsEmpty(TRUE), fValueDeleter(valueDeleter) {
 }
 
 TextTrieMap::~TextTrieMap() {
@@ -240,6 +240,7 @@ TextTrieMap::put(const UChar *key, void *value, UErrorCode &status) {
     }
 
     fLazyContents->addElement(value, status);
+    umtx_storeRelease(fHasLazyContents, 1);
 }
 
 void
@@ -375,17 +376,15 @@ void TextTrieMap::buildTrie(UErrorCode &status) {
         delete fLazyContents;
         fLazyContents = NULL; 
     }
+    umtx_storeRelease(fHasLazyContents, 0);
 }
 
 void
 TextTrieMap::search(const UnicodeString &text, int32_t start,
                   TextTrieMapSearchResultHandler *handler, UErrorCode &status) const {
-    {
-        // TODO: if locking the mutex for each check proves to be a performance problem,
-        //       add a flag of type atomic_int32_t to class TextTrieMap, and use only
-        //       the ICU atomic safe functions for assigning and testing.
-        //       Don't test the pointer fLazyContents.
-        //       Don't do unless it's really required.
+    // Lock only while the trie still needs to be built;
+    // don't test the pointer fLazyContents without the lock.
+    if (umtx_loadAcquire(fHasLazyContents) != 0) {
         Mutex lock(&TextTrieMutex);
         if (fLazyContents != NULL) {
             TextTrieMap *nonConstThis = const_cast<TextTrieMap *>(this);
@@ -1018,7 +1017,7 @@ TimeZoneNamesImpl::TimeZoneNamesImpl(const Locale& locale, UErrorCode& status)
   fZoneStrings(NULL),
   fTZNamesMap(NULL),
   fMZNamesMap(NULL),
-  fNamesTrieFullyLoaded(FALSE),
+  fNamesTrieFullyLoaded(0),
   fNamesFullyLoaded(FALSE),
   fNamesTrie(TRUE, deleteZNameInfo) {
     initialize(locale, status);
@@ -1351,15 +1350,19 @@ TimeZoneNamesImpl::find(const UnicodeString& text, int32_t start, uint32_t types
     TimeZoneNames::MatchInfoCollection* matches;
     TimeZoneNamesImpl* nonConstThis = const_cast<TimeZoneNamesImpl*>(this);
 
+    // Once all names are in the trie, it is frozen and can be searched without locking.
+    if (umtx_loadAcquire(fNamesTrieFullyLoaded) != 0) {
+        return doFind(handler, text, start, status);
+    }
+
     // Synchronize so that data is not loaded multiple times.
-    // TODO: Consider more fine-grained synchronization.
     {
         Mutex lock(&gDataMutex);
 
         // First try of lookup.
         matches = doFind(handler, text, start, status);
         if (U_FAILURE(status)) { return NULL; }
-        if (matches != NULL) {
+        if (matches != NULL || fNamesTrieFullyLoaded != 0) {
             return matches;
         }
 
@@ -1380,9 +1383,11 @@ TimeZoneNamesImpl::find(const UnicodeString& text, int32_t start, uint32_t types
         // Load everything now.
         nonConstThis->internalLoadAllDisplayNames(status);
         nonConstThis->addAllNamesIntoTrie(status);
-        nonConstThis->fNamesTrieFullyLoaded = TRUE;
         if (U_FAILURE(status)) { return NULL; }
 
+        // No more names will be added; publish the trie as frozen.
+        umtx_storeRelease(nonConstThis->fNamesTrieFullyLoaded, 1);
+
         // Third try: we must return this one.
         return doFind(handler, text, start, status);
     }
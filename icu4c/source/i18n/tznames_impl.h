@@ -129,6 +129,8 @@ class TextTrieMapSearchResultHandler : public UMemory {
 /**
  * TextTrieMap is a trie implementation for supporting
  * fast prefix match for the string key.
+ * Callers must synchronize put() with search(); concurrent searches
+ * need no lock once the trie has been built.
  */
 class U_I18N_API TextTrieMap : public UMemory {
 public:
@@ -148,6 +150,7 @@ class U_I18N_API TextTrieMap : public UMemory {
     int32_t         fNodesCount;
 
     UVector         *fLazyContents;
+    mutable u_atomic_int32_t fHasLazyContents;  // nonzero if fLazyContents are not in fNodes yet
     UBool           fIsEmpty;
     UObjectDeleter  *fValueDeleter;
 
@@ -208,7 +211,9 @@ class TimeZoneNamesImpl : public TimeZoneNames {
     UHashtable* fTZNamesMap;
     UHashtable* fMZNamesMap;
 
-    UBool fNamesTrieFullyLoaded;
+    // Set once all names are in fNamesTrie; the trie is not modified after that,
+    // so find() can search it without locking.
+    mutable u_atomic_int32_t fNamesTrieFullyLoaded;
     UBool fNamesFullyLoaded;
     TextTrieMap fNamesTrie;
 
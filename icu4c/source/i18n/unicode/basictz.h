@@ -142,6 +142,76 @@ class U_I18N_API BasicTimeZone: public TimeZone {
     virtual void getSimpleRulesNear(UDate date, InitialTimeZoneRule*& initial,
         AnnualTimeZoneRule*& std, AnnualTimeZoneRule*& dst, UErrorCode& status) const;
 
+    /* Cannot use #ifndef U_HIDE_DRAFT_API for the following draft method since it is virtual. */
+    /**
+     * Gets the raw and daylight savings offsets for each of an array of dates.
+     * The results are the same as calling
+     * getOffset(UDate date, UBool local, int32_t& rawOffset, int32_t& dstOffset, UErrorCode& ec)
+     * for each date, but this is faster when the dates are sorted, or otherwise
+     * close to each other: dates between the same two time zone transitions
+     * share one lookup.
+     * For a UTC date, the local wall time is date + rawOffsets[i] + dstOffsets[i];
+     * for a local wall time, the UTC date is date - rawOffsets[i] - dstOffsets[i].
+     *
+     * @param dates The dates, in milliseconds since 1970-01-01T00:00 UTC, or in local
+     *        wall time milliseconds if local is TRUE.
+     * @param count The number of dates.
+     * @param local If TRUE, the dates are local wall times; otherwise they are in UTC.
+     * @param rawOffsets Output array of count raw offsets, in milliseconds.
+     * @param dstOffsets Output array of count daylight savings offsets, in milliseconds.
+     * @param status Output param to filled in with a success or an error.
+     * @draft ICU 63
+     */
+    virtual void getOffsets(const UDate* dates, int32_t count, UBool local,
+        int32_t* rawOffsets, int32_t* dstOffsets, UErrorCode& status) const;
+
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Gets the local wall time fields, in the proleptic Gregorian calendar, for each
+     * of an array of UTC dates. The offsets are looked up with getOffsets(), so this is
+     * fastest for sorted or nearby dates.
+     * The fields are the same as those of a GregorianCalendar in this zone for dates
+     * after its Gregorian cutover. Any of the output arrays may be NULL.
+     *
+     * @param dates The dates, in milliseconds since 1970-01-01T00:00 UTC.
+     * @param count The number of dates.
+     * @param years Output array of count extended years (0 for 1 BC), or NULL.
+     * @param months Output array of count months, 0-based (0 for January), or NULL.
+     * @param daysOfMonth Output array of count days of the month, 1-based, or NULL.
+     * @param millisInDay Output array of count milliseconds in the local day, or NULL.
+     * @param status Output param to filled in with a success or an error.
+     *        U_ILLEGAL_ARGUMENT_ERROR if a date is outside the range of a Calendar.
+     * @draft ICU 63
+     */
+    void getLocalFields(const UDate* dates, int32_t count,
+        int32_t* years, int32_t* months, int32_t* daysOfMonth, int32_t* millisInDay,
+        UErrorCode& status) const;
+
+    /**
+     * Gets the UTC date for each of an array of local wall times given as proleptic
+     * Gregorian fields; the inverse of getLocalFields().
+     * Days of the month and milliseconds in day outside of their usual ranges carry
+     * into the neighboring days, as in a lenient Calendar. A wall time that a
+     * transition skips or repeats gets the offsets from
+     * getOffset(UDate date, UBool local, int32_t& rawOffset, int32_t& dstOffset, UErrorCode& ec)
+     * with local=TRUE.
+     *
+     * @param years Array of count extended years, from -5000000 to 5000000.
+     * @param months Array of count months, 0-based (0 for January).
+     * @param daysOfMonth Array of count days of the month, 1-based.
+     * @param millisInDay Array of count milliseconds in the local day.
+     * @param count The number of dates.
+     * @param dates Output array of count dates, in milliseconds since 1970-01-01T00:00 UTC.
+     * @param status Output param to filled in with a success or an error.
+     *        U_ILLEGAL_ARGUMENT_ERROR if a month or year is out of range,
+     *        or a date is outside the range of a Calendar.
+     * @draft ICU 63
+     */
+    void getDatesFromLocalFields(const int32_t* years, const int32_t* months,
+        const int32_t* daysOfMonth, const int32_t* millisInDay, int32_t count,
+        UDate* dates, UErrorCode& status) const;
+#endif  /* U_HIDE_DRAFT_API */
+
 
 #ifndef U_HIDE_INTERNAL_API
     /**
@@ -174,6 +244,13 @@ class U_I18N_API BasicTimeZone: public TimeZone {
         kStdDstMask = kDaylight,
         kFormerLatterMask = kLatter
     };
+
+    /**
+     * The batch getOffsets() looks for a run of dates with the same offsets only when
+     * the next date is after the current one and at most this many milliseconds later.
+     * @internal
+     */
+    static const double kOffsetRunLookahead;
 #endif  /* U_HIDE_INTERNAL_API */
 
     /**
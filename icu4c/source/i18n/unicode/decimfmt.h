@@ -1165,6 +1165,81 @@ class U_I18N_API DecimalFormat : public NumberFormat {
      */
     CurrencyAmount* parseCurrency(const UnicodeString& text, ParsePosition& pos) const U_OVERRIDE;
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Parses a column of strings into doubles, as if by calling parse() on each string
+     * starting at index 0 and converting the result with Formattable::getDouble().
+     *
+     * Unlike a loop over parse(), the parser, its scratch state, and the string wrapping
+     * each cell are set up only once for the whole column. The strings are read in place;
+     * they are not copied.
+     *
+     * This method is const and does not modify this DecimalFormat, so a large column can be
+     * split into ranges that are parsed concurrently on several threads.
+     *
+     * @param texts        Array of count UTF-16 strings.
+     * @param textLengths  Array of count string lengths, in UTF-16 code units. A length of -1
+     *                     means that the string is NUL-terminated. If NULL, all strings are
+     *                     NUL-terminated.
+     * @param count        Number of strings to parse.
+     * @param results      Array of count doubles to receive the parsed values.
+     *                     A string that fails to parse produces 0.
+     * @param parseEnds    If not NULL, array of count indexes: for a string that parses, the
+     *                     index after the last parsed character; for a string that fails,
+     *                     the index at which the error was detected.
+     * @param cellStatus   If not NULL, array of count error codes: U_ZERO_ERROR for a string
+     *                     that parses, and U_PARSE_ERROR for one that fails, including an
+     *                     empty string.
+     * @param status       Set if an error occurs that is not tied to a single string,
+     *                     such as an illegal argument or a memory allocation failure.
+     * @return             The number of strings that parsed successfully.
+     * @draft ICU 63
+     */
+    int32_t parseDoubles(const char16_t* const texts[], const int32_t textLengths[], int32_t count,
+                         double results[], int32_t parseEnds[], UErrorCode cellStatus[],
+                         UErrorCode& status) const;
+
+    /**
+     * Parses a column of UTF-8 strings into doubles; otherwise the same as parseDoubles().
+     * Ill-formed UTF-8 is treated as U+FFFD, which never parses as part of a number.
+     *
+     * @param texts        Array of count UTF-8 strings.
+     * @param textLengths  Array of count string lengths, in bytes. A length of -1 means that
+     *                     the string is NUL-terminated. If NULL, all strings are NUL-terminated.
+     * @param count        Number of strings to parse.
+     * @param results      Array of count doubles to receive the parsed values.
+     *                     A string that fails to parse produces 0.
+     * @param parseEnds    If not NULL, array of count byte offsets: for a string that parses,
+     *                     the offset after the last parsed character; for a string that fails,
+     *                     the offset at which the error was detected.
+     * @param cellStatus   If not NULL, array of count error codes, as in parseDoubles().
+     * @param status       Set if an error occurs that is not tied to a single string.
+     * @return             The number of strings that parsed successfully.
+     * @draft ICU 63
+     */
+    int32_t parseDoublesUTF8(const char* const texts[], const int32_t textLengths[], int32_t count,
+                             double results[], int32_t parseEnds[], UErrorCode cellStatus[],
+                             UErrorCode& status) const;
+
+    /**
+     * Parses a column of strings into Formattables, as if by calling parse() on each string
+     * starting at index 0. Use this instead of parseDoubles() when the full precision of the
+     * parsed numbers is needed, for example through Formattable::getDecimalNumber().
+     *
+     * @param texts        Array of count strings.
+     * @param count        Number of strings to parse.
+     * @param results      Array of count Formattables to receive the parsed values.
+     *                     A string that fails to parse produces the long value 0.
+     * @param parseEnds    If not NULL, array of count indexes, as in parseDoubles().
+     * @param cellStatus   If not NULL, array of count error codes, as in parseDoubles().
+     * @param status       Set if an error occurs that is not tied to a single string.
+     * @return             The number of strings that parsed successfully.
+     * @draft ICU 63
+     */
+    int32_t parseNumbers(const UnicodeString texts[], int32_t count, Formattable results[],
+                         int32_t parseEnds[], UErrorCode cellStatus[], UErrorCode& status) const;
+#endif  /* U_HIDE_DRAFT_API */
+
     /**
      * Returns the decimal format symbols, which is generally not changed
      * by the programmer or user.
@@ -2247,6 +2247,97 @@ class U_I18N_API LocalizedNumberFormatter
      */
     FormattedNumber formatDecimal(StringPiece value, UErrorCode& status) const;
 
+    /**
+     * Build the internal data structures for formatting now. Normally they are built after the
+     * formatter has been used a few times, and the first calls take a slower path; after compile(),
+     * every call takes the fast path. This is useful for a formatter that is set up once and then
+     * used many times, or shared by many short-lived tasks.
+     *
+     * compile() may be called concurrently with formatting, and from more than one thread.
+     * It does nothing if the data structures have already been built, or if another thread is
+     * building them. A copy of a LocalizedNumberFormatter is not compiled; a moved one stays compiled.
+     *
+     * @param status
+     *            Set if an error occurred in the setter chain or while building the data structures.
+     * @draft ICU 63
+     */
+    void compile(UErrorCode& status) const;
+
+    /**
+     * Format the given integer number into a caller-provided buffer, using the settings specified in the
+     * NumberFormatter fluent setting chain.
+     *
+     * Unlike formatInt(), which returns a FormattedNumber, this function keeps its working storage on the
+     * stack. For numbers of up to 15 digits, counting displayed fraction digits, it performs no heap
+     * allocation once the formatter has been compiled. The first call compiles the formatter as compile() does.
+     *
+     * The result is NUL-terminated if there is room. If the buffer is too small, U_BUFFER_OVERFLOW_ERROR is
+     * set and the full length is returned; pass a NULL buffer and zero capacity to preflight.
+     *
+     * @param value
+     *            The number to format.
+     * @param dest
+     *            The destination buffer. May be NULL if destCapacity is zero.
+     * @param destCapacity
+     *            The number of char16_t units available at dest.
+     * @param status
+     *            Set to an ErrorCode if one occurred in the setter chain or during formatting.
+     * @return The length of the formatted number, in char16_t units.
+     * @draft ICU 63
+     */
+    int32_t formatIntToBuffer(int64_t value, char16_t* dest, int32_t destCapacity, UErrorCode& status) const;
+
+    /**
+     * Format the given float or double into a caller-provided buffer, using the settings specified in the
+     * NumberFormatter fluent setting chain. See formatIntToBuffer().
+     *
+     * @param value
+     *            The number to format.
+     * @param dest
+     *            The destination buffer. May be NULL if destCapacity is zero.
+     * @param destCapacity
+     *            The number of char16_t units available at dest.
+     * @param status
+     *            Set to an ErrorCode if one occurred in the setter chain or during formatting.
+     * @return The length of the formatted number, in char16_t units.
+     * @draft ICU 63
+     */
+    int32_t formatDoubleToBuffer(double value, char16_t* dest, int32_t destCapacity, UErrorCode& status) const;
+
+    /**
+     * Format the given integer number into a caller-provided buffer, as UTF-8.
+     * See formatIntToBuffer().
+     *
+     * @param value
+     *            The number to format.
+     * @param dest
+     *            The destination buffer. May be NULL if destCapacity is zero.
+     * @param destCapacity
+     *            The number of bytes available at dest.
+     * @param status
+     *            Set to an ErrorCode if one occurred in the setter chain or during formatting.
+     * @return The length of the formatted number, in bytes.
+     * @draft ICU 63
+     */
+    int32_t formatIntToUTF8(int64_t value, char* dest, int32_t destCapacity, UErrorCode& status) const;
+
+    /**
+     * Format the given float or double into a caller-provided buffer, as UTF-8.
+     * See formatIntToBuffer().
+     *
+     * @param value
+     *            The number to format.
+     * @param dest
+     *            The destination buffer. May be NULL if destCapacity is zero.
+     * @param destCapacity
+     *            The number of bytes available at dest.
+     * @param status
+     *            Set to an ErrorCode if one occurred in the setter chain or during formatting.
+     * @return The length of the formatted number, in bytes.
+     * @draft ICU 63
+     */
+    int32_t formatDoubleToUTF8(double value, char* dest, int32_t destCapacity, UErrorCode& status) const;
+
 #ifndef U_HIDE_INTERNAL_API
 
     /** Internal method.
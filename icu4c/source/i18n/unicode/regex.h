@@ -63,8 +63,12 @@ U_NAMESPACE_BEGIN
 
 struct Regex8BitSet;
 class  RegexCImpl;
+class  RegexDFAProgram;
+class  RegexLazyDFA;
 class  RegexMatcher;
+class  RegexMemo;
 class  RegexPattern;
+class  RegexSet;
 struct REStackFrame;
 class  RuleBasedBreakIterator;
 class  UnicodeSet;
@@ -320,6 +324,47 @@ class U_I18N_API RegexPattern U_FINAL : public UObject {
         uint32_t             flags,
         UErrorCode           &status);
 
+#ifndef U_HIDE_DRAFT_API
+   /**
+    * Writes the compiled form of this pattern to a flat buffer, from which
+    * createFromBinary() can recreate the pattern without compiling it again.
+    * An application with many patterns can compile them once, store the binary
+    * forms in a file, and load or memory-map that file at startup.
+    *
+    * The binary form is specific to the ICU major version and to the byte order
+    * of the platform; createFromBinary() rejects data from any other.
+    * Its tables are aligned for access if dest is aligned on 8 bytes.
+    *
+    * @param dest         Buffer for the binary form. Can be NULL if destCapacity==0.
+    * @param destCapacity Capacity of dest in bytes.
+    * @param status       Set to U_BUFFER_OVERFLOW_ERROR if the binary form does not fit.
+    * @return the length of the binary form in bytes, even if it does not fit.
+    *
+    * @draft ICU 63
+    */
+    int32_t cloneBinary(uint8_t *dest, int32_t destCapacity, UErrorCode &status) const;
+
+   /**
+    * Creates a pattern from the binary form written by cloneBinary(), without
+    * parsing the pattern string. The pattern does not alias the binary data,
+    * which can be released afterwards.
+    *
+    * The header and tables are checked, and the compiled code is checked for
+    * references to tables, strings and locations that do not exist. The code
+    * is not otherwise verified, so the data should come only from a trusted source.
+    *
+    * @param bin     The binary form of a pattern.
+    * @param length  The length of bin in bytes, at least the length returned by cloneBinary().
+    * @param status  Set to U_INVALID_FORMAT_ERROR if bin is not the binary form of a
+    *                pattern from this version of ICU on a platform with the same byte order.
+    * @return the pattern, to be deleted by the caller.
+    *
+    * @draft ICU 63
+    */
+    static RegexPattern * U_EXPORT2 createFromBinary(const uint8_t *bin, int32_t length,
+        UErrorCode           &status);
+#endif  /* U_HIDE_DRAFT_API */
+
    /**
     * Get the match mode flags that were used when compiling this pattern.
     * @return  the match mode flags
@@ -378,6 +423,42 @@ class U_I18N_API RegexPattern U_FINAL : public UObject {
     */
     virtual RegexMatcher *matcher(UErrorCode  &status) const;
 
+    /* Cannot use #ifndef U_HIDE_DRAFT_API for the following draft methods since they are virtual. */
+   /**
+    * Gets a RegexMatcher for this pattern from a pool of matchers that are not in use,
+    * or creates one if the pool is empty.  The matcher has no input; set it with
+    * RegexMatcher::reset() before use.
+    * <p>
+    * A RegexMatcher must not be used by more than one thread at a time, but a
+    * RegexPattern may be shared.  acquireMatcher() and releaseMatcher() may be called
+    * on the same pattern from any number of threads concurrently, giving each
+    * operation a matcher without the cost of creating and deleting one, and with
+    * the storage that the matcher allocated during earlier matches.
+    * <p>
+    * Return the matcher with releaseMatcher() rather than deleting it.
+    * The pattern must not be deleted while any matcher acquired from it is in use.
+    *
+    * @param status   A reference to a UErrorCode to receive any errors.
+    * @return      A RegexMatcher for this pattern, owned by the caller until it is released.
+    * @draft ICU 63
+    */
+    virtual RegexMatcher *acquireMatcher(UErrorCode &status) const;
+
+   /**
+    * Returns a matcher to this pattern's pool, for reuse by a later acquireMatcher().
+    * The matcher is reset to no input, and its settings, such as the time limit and
+    * callbacks, are restored to those of a new matcher.  Storage that it has
+    * allocated is kept.
+    * <p>
+    * A matcher that was not created from this pattern, or that arrives when the
+    * pool is full, is deleted.
+    *
+    * @param matcher  The matcher, from acquireMatcher() or matcher().  May be NULL.
+    *                 The caller must not use it again.
+    * @draft ICU 63
+    */
+    virtual void releaseMatcher(RegexMatcher *matcher) const;
+
 
    /**
     * Test whether a string matches a regular expression.  This convenience function
@@ -625,12 +706,25 @@ class U_I18N_API RegexPattern U_FINAL : public UObject {
     UChar32         fInitialChar;
     Regex8BitSet   *fInitialChars8;
     UBool           fNeedsAltInput;
+    int32_t         fInitialStringScan;    // Index within the initial string of the code unit
+                                           //   that find() searches for first.
+
+    int32_t         fRequiredStringIdx;    // A literal string that every match contains,
+    int32_t         fRequiredStringLen;    //   in fLiteralText.  Length 0 if there is none.
+    int32_t         fRequiredStringScan;   // Index within it of the code unit to search for first.
 
     UHashtable     *fNamedCaptureMap;  // Map from capture group names to numbers.
 
+    RegexDFAProgram *fDFAProgram;  // The pattern in a form for the DFA match engine,
+                                   //   NULL if the pattern needs the backtracking engine.
+
+    mutable UVector *fMatcherPool; // Matchers returned by releaseMatcher(), created on first use.
+
     friend class RegexCompile;
     friend class RegexMatcher;
     friend class RegexCImpl;
+    friend class RegexDFAProgram;
+    friend class RegexSet;
 
     //
     //  Implementation Methods
@@ -639,6 +733,7 @@ class U_I18N_API RegexPattern U_FINAL : public UObject {
     void        zap();             // Common cleanup
 
     void        dumpOp(int32_t index) const;
+    UBool       validateBinary() const;    // Check a pattern from createFromBinary().
 
   public:
 #ifndef U_HIDE_INTERNAL_API
@@ -1668,6 +1763,78 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
     */
     virtual int32_t  getStackLimit() const;
 
+    /* Cannot use #ifndef U_HIDE_DRAFT_API for the following draft methods since they are virtual. */
+  /**
+    *  Enable or disable memoization in the backtracking match engine.
+    *  <p>
+    *  Patterns with nested or adjacent repetitions, like <code>(a+)+b</code>, can
+    *  take exponential time to fail to match, because the backtracking engine tries
+    *  every way of dividing the input among the repetitions.  With memoization, the
+    *  engine records each place in the pattern where paths through it join, together
+    *  with the input position, from which it has tried to match.  When another path
+    *  arrives at the same place and position, the engine abandons it at once, since it
+    *  could only repeat the same failure.  A match operation then takes time
+    *  proportional to the length of the pattern times the length of the input region.
+    *  <p>
+    *  Memoization applies only to patterns without back references, look-around
+    *  assertions, atomic groups, possessive or counted <code>{min,max}</code> quantifiers,
+    *  or repetitions of expressions that can match an empty string.  Other patterns
+    *  are matched as without it.  Patterns that the matcher can run with its
+    *  DFA engine are not affected either.
+    *  <p>
+    *  The memo takes one bit per join in the pattern per position in the input region.
+    *  Its size is limited like that of the backtrack stack, by setStackLimit();
+    *  a match operation for which it would be larger is run without memoization.
+    *  <p>
+    *  Memoization does not change the results of any match operation.
+    *  It is disabled by default.
+    *
+    *  @param memoize  TRUE to enable memoization, FALSE to disable it.
+    *  @param status   A reference to a UErrorCode to receive any errors.
+    *  @draft ICU 63
+    */
+    virtual void setMemoizeBacktracking(UBool memoize, UErrorCode &status);
+
+  /**
+    *  Tell whether memoization in the backtracking match engine is enabled.
+    *  See setMemoizeBacktracking().
+    *
+    *  @return TRUE if memoization is enabled.
+    *  @draft ICU 63
+    */
+    virtual UBool getMemoizeBacktracking() const;
+
+  /**
+    *  Set aside heap storage for the match backtracking stack, so that match
+    *  operations needing no more than this do not allocate it as they run.
+    *  The matcher is also reset, discarding any results from previous matches.
+    *  <p>
+    *  The backtrack stack grows as needed, and keeps its storage from one match
+    *  operation to the next.  Reserving it up front makes the amount of memory a
+    *  matcher holds predictable, and means that find(), matches() and lookingAt()
+    *  perform no heap allocation after a reset(), as long as the stack they use stays
+    *  within the reserve, memoization is not enabled, and the DFA match engine, which
+    *  allocates its states as it first reaches them, is disabled with setUseDFA()
+    *  or has already seen the input's states.
+    *  <p>
+    *  The reserve is limited by the stack limit set with setStackLimit().
+    *  Reducing the reserve does not release storage already allocated.
+    *
+    *  @param reserve  The size, in bytes, of the backtrack stack storage to allocate.
+    *                  Must be greater than or equal to zero.  The default is zero.
+    *  @param status   A reference to a UErrorCode to receive any errors.
+    *  @draft ICU 63
+    */
+    virtual void setStackReserve(int32_t reserve, UErrorCode &status);
+
+  /**
+    *  Get the size of the backtrack stack reserve set with setStackReserve().
+    *
+    *  @return  the reserve, in bytes.
+    *  @draft ICU 63
+    */
+    virtual int32_t getStackReserve() const;
+
 
   /**
     * Set a callback function for use with this Matcher.
@@ -1766,6 +1933,8 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
     RegexMatcher &operator =(const RegexMatcher &rhs);
     void init(UErrorCode &status);                      // Common initialization
     void init2(UText *t, UErrorCode &e);  // Common initialization, part 2.
+    void restoreDefaults();               // Reset to no input and the settings of a new
+                                          //   matcher, for RegexPattern::releaseMatcher().
 
     friend class RegexPattern;
     friend class RegexCImpl;
@@ -1773,14 +1942,28 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
 #ifndef U_HIDE_INTERNAL_API
     /** @internal  */
     void resetPreserveRegion();  // Reset matcher state, but preserve any region.
+
+    /**
+     * Patterns without back references, look-around assertions, anchors or other
+     * constructs that need backtracking are normally matched with a DFA, which is
+     * immune to the exponential run times that some such patterns can cause.
+     * Disabling it forces the use of the backtracking engine, for testing and
+     * performance comparisons. The results are the same either way.
+     * @internal
+     */
+    void setUseDFA(UBool useDFA);
 #endif  /* U_HIDE_INTERNAL_API */
 private:
 
     //
     //  MatchAt   This is the internal interface to the match engine itself.
     //            Match status comes back in matcher member variables.
+    //            MatchInputAt is the engine, a template on the input accessor
+    //            class; see regeximp.h.
     //
     void                 MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status);
+    template<class Input>
+    void                 MatchInputAt(Input &input, int64_t startIdx, UBool toEnd, UErrorCode &status);
     inline void          backTrack(int64_t &inputIdx, int32_t &patIdx);
     UBool                isWordBoundary(int64_t pos);         // perform Perl-like  \b test
     UBool                isUWordBoundary(int64_t pos);        // perform RBBI based \b test
@@ -1793,8 +1976,19 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
     
     int64_t              appendGroup(int32_t groupNum, UText *dest, UErrorCode &status) const;
     
+    template<class Input>
+    UBool                findUsingInput(Input &input, int64_t startPos, int64_t testStartLimit,
+                                        UErrorCode &status);
     UBool                findUsingChunk(UErrorCode &status);
+    UBool                skipToLiteralInChunk(int32_t &startPos, int32_t testLen);
     void                 MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &status);
+
+    // The DFA match engine. These return TRUE if the DFA produced the result, FALSE if the
+    //   backtracking engine must be used.
+    UBool                canUseDFA(UErrorCode &status);
+    UBool                findUsingDFA(int64_t startPos, UErrorCode &status);
+    UBool                skipToStartChar(int64_t &startPos);
+    UBool                matchUsingDFA(int64_t startIdx, UBool toEnd, UErrorCode &status);
     UBool                isChunkWordBoundary(int32_t pos);
 
     const RegexPattern  *fPattern;
@@ -1860,6 +2054,8 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
 
     int32_t             fStackLimit;       // Maximum memory size to use for the backtrack
                                            //   stack, in bytes.  Zero for unlimited.
+    int32_t             fStackReserve;     // Backtrack stack storage to allocate up front,
+                                           //   in bytes.  See setStackReserve().
 
     URegexMatchCallback *fCallbackFn;       // Pointer to match progress callback funct.
                                            //   NULL if there is no callback.
@@ -1878,7 +2074,165 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
                                            //   reported, or that permanently disables this matcher.
 
     RuleBasedBreakIterator  *fWordBreakItr;
+
+    RegexLazyDFA        *fDFA;             // DFA match engine state, created on first use.
+    UBool                fUseDFA;          // False to always use the backtracking engine.
+
+    RegexMemo           *fMemo;            // Memo for the backtracking engine, or NULL
+                                           //   if memoization is not enabled.
+
+    int64_t              fRequiredStringPos;  // Position of the first occurrence of the pattern's
+                                              //   required string at or after the start of the
+                                              //   most recent find(), INT64_MAX if there is none,
+                                              //   or -1 if not yet searched for.
+};
+
+#ifndef U_HIDE_DRAFT_API
+/**
+  * Class <code>RegexSet</code> matches a collection of regular expressions against an
+  * input text together, and reports which of them match.
+  *
+  * <p>Patterns that need no backtracking are combined into a single automaton, which
+  * finds all of them that match in one pass over the input, so that the time
+  * taken depends little on the number of such patterns. Each of the other patterns
+  * (for example those with back references, look-around assertions or anchors) is
+  * searched for separately, as RegexMatcher::find() would. The results are the same
+  * either way: a pattern is reported if RegexMatcher::find() would find a match for it
+  * anywhere in the input.</p>
+  *
+  * <p>A RegexSet keeps matching state and caches between calls, which makes it
+  * cheap to use it repeatedly, but it must not be used by more than one thread at a
+  * time. Threads should each use their own RegexSet.</p>
+  *
+  * <p>Class RegexSet is not intended to be subclassed.</p>
+  *
+  * @draft ICU 63
+  */
+class U_I18N_API RegexSet U_FINAL : public UObject {
+public:
+    /**
+     * Construct an empty RegexSet. Patterns are added with add().
+     *
+     * @param status  A reference to a UErrorCode to receive any errors.
+     * @draft ICU 63
+     */
+    RegexSet(UErrorCode &status);
+
+    /**
+     * Destructor.
+     * @draft ICU 63
+     */
+    virtual ~RegexSet();
+
+    /**
+     * Compile a regular expression and add it to the set.
+     *
+     * @param regex   The regular expression to be compiled.
+     * @param flags   The <code>URegexpFlag</code> match mode flags to be used,
+     *                as for RegexPattern::compile().
+     * @param pe      Receives the position (line and column numbers) of any syntax
+     *                error within the regular expression.
+     * @param status  A reference to a UErrorCode to receive any errors.
+     * @return        The index of the pattern within the set, which identifies it in the
+     *                results of findAll(); or -1 if the pattern could not be added.
+     * @draft ICU 63
+     */
+    int32_t add(const UnicodeString &regex, uint32_t flags, UParseError &pe, UErrorCode &status);
+
+    /**
+     * Compile a regular expression and add it to the set.
+     *
+     * @param regex   The regular expression to be compiled.
+     * @param flags   The <code>URegexpFlag</code> match mode flags to be used.
+     * @param status  A reference to a UErrorCode to receive any errors.
+     * @return        The index of the pattern within the set, or -1 if it could not be added.
+     * @draft ICU 63
+     */
+    int32_t add(const UnicodeString &regex, uint32_t flags, UErrorCode &status);
+
+    /**
+     * Get the number of patterns in the set.
+     * @return  The number of patterns.
+     * @draft ICU 63
+     */
+    int32_t size() const;
+
+    /**
+     * Get one of the patterns of the set.
+     *
+     * @param index  The index of the pattern, as returned by add().
+     * @return       The pattern, owned by the set, or NULL if the index is out of range.
+     * @draft ICU 63
+     */
+    const RegexPattern *getPattern(int32_t index) const;
+
+    /**
+     * Find all of the patterns that match anywhere in the input.
+     *
+     * @param input        The input text.
+     * @param dest         Receives the indexes of the matching patterns, in increasing order.
+     *                     May be NULL if destCapacity is 0.
+     * @param destCapacity The capacity of dest.
+     * @param status       A reference to a UErrorCode to receive any errors.
+     *                     U_BUFFER_OVERFLOW_ERROR is set if more than destCapacity
+     *                     patterns match; the first destCapacity are stored.
+     * @return             The number of patterns that match.
+     * @draft ICU 63
+     */
+    int32_t findAll(const UnicodeString &input, int32_t *dest, int32_t destCapacity,
+                    UErrorCode &status);
+
+    /**
+     * Find all of the patterns that match anywhere in the input, and optionally where.
+     * The position reported for a pattern is that of the first match that
+     * RegexMatcher::find() would return. Positions are only computed for the patterns
+     * that match, and only if they are requested.
+     *
+     * @param input        The input text. It need not remain valid after the call.
+     * @param dest         Receives the indexes of the matching patterns, in increasing order.
+     *                     May be NULL if destCapacity is 0.
+     * @param starts       If not NULL, receives the native start index of the first match
+     *                     of each pattern stored in dest.
+     * @param ends         If not NULL, receives the native end index of the first match
+     *                     of each pattern stored in dest.
+     * @param destCapacity The capacity of dest, and of starts and ends if they are not NULL.
+     * @param status       A reference to a UErrorCode to receive any errors.
+     *                     U_BUFFER_OVERFLOW_ERROR is set if more than destCapacity
+     *                     patterns match; the first destCapacity are stored.
+     * @return             The number of patterns that match.
+     * @draft ICU 63
+     */
+    int32_t findAll(UText *input, int32_t *dest, int64_t *starts, int64_t *ends,
+                    int32_t destCapacity, UErrorCode &status);
+
+    /**
+     * ICU "poor man's RTTI", returns a UClassID for the actual class.
+     *
+     * @draft ICU 63
+     */
+    virtual UClassID getDynamicClassID() const;
+
+    /**
+     * ICU "poor man's RTTI", returns a UClassID for this class.
+     *
+     * @draft ICU 63
+     */
+    static UClassID U_EXPORT2 getStaticClassID();
+
+private:
+    RegexSet(const RegexSet &other);    // Not implemented.
+    RegexSet &operator =(const RegexSet &other);
+    void          buildProgram(UErrorCode &status);
+    RegexMatcher *getMatcher(int32_t index, UErrorCode &status);
+
+    UVector          *fPatterns;        // The RegexPatterns of the set, owned.
+    UVector          *fMatchers;        // A RegexMatcher for each pattern, created when first needed.
+    RegexDFAProgram  *fProgram;         // The combined program of the patterns that the DFA
+                                        //   engine can run, or NULL if there are none.
+    RegexLazyDFA     *fDFA;
+    UBool             fProgramIsCurrent;    // False after a pattern is added.
 };
+#endif  /* U_HIDE_DRAFT_API */
 
 U_NAMESPACE_END
 #endif  // UCONFIG_NO_REGULAR_EXPRESSIONS
@@ -49,6 +49,8 @@ class FieldPositionHandler;
 class TimeZoneFormat;
 class SharedNumberFormat;
 class SimpleDateFormatMutableNFs;
+class SimpleDateFormatFieldCache;
+class GregorianCivilTime;
 
 namespace number {
 class LocalizedNumberFormatter;
@@ -1107,6 +1109,39 @@ class U_I18N_API SimpleDateFormat: public DateFormat {
      */
     virtual void adoptCalendar(Calendar* calendarToAdopt);
 
+    /**
+     * Sets the time zone for the calendar of this DateFormat object. The caller
+     * no longer owns the TimeZone object and should not delete it after this call.
+     * Overrides the base class method to also discard fields cached for
+     * UDAT_FORMAT_CACHE_FIELDS.
+     * @param zoneToAdopt the TimeZone to be adopted.
+     * @stable ICU 2.0
+     */
+    virtual void adoptTimeZone(TimeZone* zoneToAdopt);
+
+    /**
+     * Sets the time zone for the calendar of this DateFormat object.
+     * Overrides the base class method to also discard fields cached for
+     * UDAT_FORMAT_CACHE_FIELDS.
+     * @param zone the new time zone.
+     * @stable ICU 2.0
+     */
+    virtual void setTimeZone(const TimeZone& zone);
+
+    /**
+     * Sets a boolean attribute on this DateFormat.
+     * Overrides the base class method to create or delete the fields cached for
+     * UDAT_FORMAT_CACHE_FIELDS.
+     * @param attr the attribute to set
+     * @param newvalue new value
+     * @param status the error type
+     * @return *this - for chaining
+     * @stable ICU 53
+     */
+    virtual DateFormat& U_EXPORT2 setBooleanAttribute(UDateFormatBooleanAttribute attr,
+                                                      UBool newvalue,
+                                                      UErrorCode &status);
+
     /* Cannot use #ifndef U_HIDE_INTERNAL_API for the following methods since they are virtual */
     /**
      * Sets the TimeZoneFormat to be used by this date/time formatter.
@@ -1246,8 +1281,59 @@ class U_I18N_API SimpleDateFormat: public DateFormat {
 
     /**
      * Hook called by format(... FieldPosition& ...) and format(...FieldPositionIterator&...)
+     * @param civil if not NULL, the fields to format, and cal is fCalendar
      */
-    UnicodeString& _format(Calendar& cal, UnicodeString& appendTo, FieldPositionHandler& handler, UErrorCode& status) const;
+    UnicodeString& _format(Calendar& cal, const GregorianCivilTime* civil, UnicodeString& appendTo,
+                           FieldPositionHandler& handler, UErrorCode& status) const;
+
+    /**
+     * Called by DateFormat::format(UDate, ...) to format a date without cloning
+     * fCalendar: from the field cache if UDAT_FORMAT_CACHE_FIELDS is set,
+     * otherwise from a GregorianCivilTime if getCivilTime() can compute one.
+     * @return FALSE if nothing was appended, and the date must be formatted with a Calendar
+     */
+    UBool formatDate(UDate date, UnicodeString& appendTo, FieldPositionHandler& handler, UErrorCode& status) const;
+
+    /**
+     * Computes the fields of fCalendar for the date, if it is a plain GregorianCalendar
+     * and the date is after its Gregorian cutover year.
+     * @return FALSE if the date must be formatted with a Calendar
+     */
+    UBool getCivilTime(UDate date, GregorianCivilTime& civil) const;
+
+    /**
+     * Called by DateFormat::parse(text, pos) to parse a pattern of fixed-width
+     * numeric fields (see fNumericFieldsOnly) without cloning fCalendar: scans the
+     * digits directly, and computes the date the way a cleared GregorianCalendar would.
+     * @return FALSE if pos was not changed, and the text must be parsed with a Calendar
+     */
+    UBool parseNumeric(const UnicodeString& text, ParsePosition& pos, UDate& date) const;
+
+    /**
+     * Formats the date from the fields cached for an earlier date in the same
+     * local day and offset, refilling the cache when the date is outside of it.
+     * @return FALSE if nothing was appended, and the date must be formatted normally:
+     *         the pattern or time zone is not supported, or another thread is using the cache.
+     */
+    UBool formatCached(UDate date, UnicodeString& appendTo, FieldPositionHandler& handler, UErrorCode& status) const;
+
+    /**
+     * Sets up fFieldCache for the local day or half day that contains the date.
+     * @return FALSE if the cache cannot be used for the date.
+     */
+    UBool fillFieldCache(SimpleDateFormatFieldCache& cache, UDate date, UErrorCode& status) const;
+
+    /**
+     * Creates fFieldCache if enabled and it does not exist yet, or deletes it if not enabled.
+     * Only called from non-const functions, so that formatCached() can read fFieldCache
+     * without synchronization.
+     */
+    void initFieldCache(UBool enabled);
+
+    /**
+     * Empties fFieldCache; called whenever anything changes that formatting depends on.
+     */
+    void clearFieldCache();
 
     /**
      * Called by format() to format a single field.
@@ -1262,6 +1348,7 @@ class U_I18N_API SimpleDateFormat: public DateFormat {
      * @param fieldNum  Zero-based numbering of current field within the overall format.
      * @param handler   Records information about field positions.
      * @param cal       Calendar to use
+     * @param civil     If not NULL, the field values to use instead of those of cal
      * @param status    Receives a status code, which will be U_ZERO_ERROR if the operation
      *                  succeeds.
      */
@@ -1272,6 +1359,7 @@ class U_I18N_API SimpleDateFormat: public DateFormat {
                    int32_t fieldNum,
                    FieldPositionHandler& handler,
                    Calendar& cal,
+                   const GregorianCivilTime* civil,
                    UErrorCode& status) const; // in case of illegal argument
 
     /**
@@ -1558,6 +1646,14 @@ class U_I18N_API SimpleDateFormat: public DateFormat {
      */
     UnicodeString       fPattern;
 
+    /**
+     * fPattern split into literal text and pattern fields by parsePattern(), so that
+     * format() need not re-scan the pattern. Each item starts with one code unit:
+     * a literal of n<0x8000 code units is n followed by the text; a field is
+     * 0x8000|(count>>16), the low 16 bits of count, and the pattern character.
+     */
+    UnicodeString       fCompiledPattern;
+
     /**
      * The numbering system override for dates.
      */
@@ -1599,7 +1695,13 @@ class U_I18N_API SimpleDateFormat: public DateFormat {
     UBool                fHasSecond;
 
     /**
-     * Sets fHasMinutes and fHasSeconds.
+     * TRUE if the pattern has only numeric fields that parseNumeric() supports:
+     * y (3 or more), M (1 or 2), d, H, k, m, s and S, each with at most 9 letters.
+     */
+    UBool                fNumericFieldsOnly = FALSE;
+
+    /**
+     * Sets fHasMinutes, fHasSeconds, fCompiledPattern and fNumericFieldsOnly.
      */
     void                 parsePattern();
 
@@ -1638,9 +1740,22 @@ class U_I18N_API SimpleDateFormat: public DateFormat {
      */
     const number::LocalizedNumberFormatter* fFastNumberFormatters[SMPDTFMT_NF_COUNT] = {};
 
+    /**
+     * The zero digit, if the fast number formatters write non-negative integers as
+     * plain decimal digits from U+0030 or another BMP zero; 0 otherwise.
+     * Set by initFastNumberFormatters().
+     */
+    UChar fFastZeroDigit = 0;
+
     UBool fHaveDefaultCentury;
 
     BreakIterator* fCapitalizationBrkIter;
+
+    /**
+     * Fields and text of the last local day formatted with UDAT_FORMAT_CACHE_FIELDS.
+     * Exists exactly while that attribute is set.
+     */
+    SimpleDateFormatFieldCache* fFieldCache = nullptr;
 };
 
 inline UDate
@@ -899,6 +899,17 @@ typedef enum UDateFormatBooleanAttribute {
      * @stable ICU 56
      */
     UDAT_PARSE_MULTIPLE_PATTERNS_FOR_MATCH = 3,
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * indicates that a SimpleDateFormat may keep the fields and text it formatted for the
+     * last date, and reuse them for later dates in the same local day (or half day, if the
+     * pattern has an am/pm field) and the same time zone offset, recomputing only the
+     * time-of-day fields. Speeds up formatting runs of nearby dates, such as log timestamps.
+     * Off by default; ignored when formatting a Calendar, and by other DateFormat types.
+     * @draft ICU 63
+     */
+    UDAT_FORMAT_CACHE_FIELDS = 4,
+#endif  /* U_HIDE_DRAFT_API */
 
     /* Do not conditionalize the following with #ifndef U_HIDE_DEPRECATED_API,
      * it is needed for layout of DateFormat object. */
@@ -906,7 +917,7 @@ typedef enum UDateFormatBooleanAttribute {
      * One more than the highest normal UDateFormatBooleanAttribute value.
      * @deprecated ICU 58 The numeric value may change over time, see ICU ticket #12420.
      */
-    UDAT_BOOLEAN_ATTRIBUTE_COUNT = 4
+    UDAT_BOOLEAN_ATTRIBUTE_COUNT = 5
 } UDateFormatBooleanAttribute;
 
 /**
@@ -858,6 +858,74 @@ unum_parseDoubleCurrency(const UNumberFormat* fmt,
                          UChar* currency,
                          UErrorCode* status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Parse a column of strings into doubles using a UNumberFormat, with the same result for
+ * each string as unum_parseDouble() starting at offset 0.
+ * The per-format parse setup is done once for the whole column rather than once per string,
+ * and the strings are read in place.
+ * The UNumberFormat is not modified, so a large column can be split into ranges that are
+ * parsed concurrently on several threads with the same UNumberFormat.
+ * Note: parsing is not supported for styles UNUM_DECIMAL_COMPACT_SHORT
+ * and UNUM_DECIMAL_COMPACT_LONG.
+ * @param fmt The formatter to use.
+ * @param texts Array of count strings to parse.
+ * @param textLengths Array of count string lengths, where -1 means null-terminated;
+ *                    or NULL if all strings are null-terminated.
+ * @param count The number of strings.
+ * @param results Array of count doubles to receive the parsed values.
+ *                A string that fails to parse produces 0.
+ * @param parseEnds If not NULL, array of count offsets to receive, for each string, the offset
+ *                  at which parsing ended, or the offset of the error if parsing failed.
+ * @param cellStatus If not NULL, array of count error codes to receive U_ZERO_ERROR for each
+ *                   string that parsed and U_PARSE_ERROR for each string that did not,
+ *                   including an empty string.
+ * @param status A pointer to an UErrorCode to receive any errors that are not tied to
+ *               a single string.
+ * @return The number of strings that parsed successfully.
+ * @see unum_parseDouble
+ * @see unum_parseDoublesUTF8
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+unum_parseDoubles(const UNumberFormat* fmt,
+                  const UChar* const texts[],
+                  const int32_t textLengths[],
+                  int32_t count,
+                  double results[],
+                  int32_t parseEnds[],
+                  UErrorCode cellStatus[],
+                  UErrorCode* status);
+
+/**
+ * Parse a column of UTF-8 strings into doubles using a UNumberFormat.
+ * Otherwise the same as unum_parseDoubles(); textLengths and parseEnds count bytes,
+ * and ill-formed UTF-8 never parses as part of a number.
+ * @param fmt The formatter to use.
+ * @param texts Array of count UTF-8 strings to parse.
+ * @param textLengths Array of count string lengths in bytes, where -1 means null-terminated;
+ *                    or NULL if all strings are null-terminated.
+ * @param count The number of strings.
+ * @param results Array of count doubles to receive the parsed values.
+ * @param parseEnds If not NULL, array of count byte offsets at which parsing ended or failed.
+ * @param cellStatus If not NULL, array of count error codes, as for unum_parseDoubles().
+ * @param status A pointer to an UErrorCode to receive any errors that are not tied to
+ *               a single string.
+ * @return The number of strings that parsed successfully.
+ * @see unum_parseDoubles
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+unum_parseDoublesUTF8(const UNumberFormat* fmt,
+                      const char* const texts[],
+                      const int32_t textLengths[],
+                      int32_t count,
+                      double results[],
+                      int32_t parseEnds[],
+                      UErrorCode cellStatus[],
+                      UErrorCode* status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Parse a UChar string into a UFormattable.
  * Example code:
@@ -426,6 +426,10 @@ typedef struct UFormattedNumber UFormattedNumber;
  *
  * Objects of type UNumberFormatter returned by this method are threadsafe.
  *
+ * The formatters for a skeleton and locale are compiled once and shared, through a cache, by the
+ * UNumberFormatter objects opened for the same skeleton string and locale ID; opening one after the
+ * first is inexpensive, and it formats at full speed from its first use.
+ *
  * For more details on skeleton strings, see the documentation in numberformatter.h. For more details on
  * the usage of this API, see the documentation at the top of unumberformatter.h.
  *
@@ -520,6 +524,86 @@ unumf_formatDecimal(const UNumberFormatter* uformatter, const char* value, int32
                     UFormattedNumber* uresult, UErrorCode* ec);
 
 
+/**
+ * Uses a UNumberFormatter to format an integer directly into a buffer, without a UFormattedNumber.
+ * The formatting is done with storage on the stack; for numbers of up to 15 digits, counting
+ * displayed fraction digits, no heap memory is allocated.
+ *
+ * The result is NUL-terminated if there is room. If the buffer is too small, U_BUFFER_OVERFLOW_ERROR
+ * is set and the full length is returned; pass NULL and a capacity of zero to preflight.
+ *
+ * NOTE: This is a C-compatible API; C++ users should build against numberformatter.h instead.
+ *
+ * @param uformatter A formatter object created by unumf_openForSkeletonAndLocale or similar.
+ * @param value The number to be formatted.
+ * @param buffer The buffer to receive the formatted number. May be NULL if bufferCapacity is zero.
+ * @param bufferCapacity The number of UChars available in the buffer.
+ * @param ec Set if an error occurs.
+ * @return The length of the formatted number, in UChars.
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+unumf_formatIntToBuffer(const UNumberFormatter* uformatter, int64_t value, UChar* buffer,
+                        int32_t bufferCapacity, UErrorCode* ec);
+
+
+/**
+ * Uses a UNumberFormatter to format a double directly into a buffer, without a UFormattedNumber.
+ * See unumf_formatIntToBuffer.
+ *
+ * NOTE: This is a C-compatible API; C++ users should build against numberformatter.h instead.
+ *
+ * @param uformatter A formatter object created by unumf_openForSkeletonAndLocale or similar.
+ * @param value The number to be formatted.
+ * @param buffer The buffer to receive the formatted number. May be NULL if bufferCapacity is zero.
+ * @param bufferCapacity The number of UChars available in the buffer.
+ * @param ec Set if an error occurs.
+ * @return The length of the formatted number, in UChars.
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+unumf_formatDoubleToBuffer(const UNumberFormatter* uformatter, double value, UChar* buffer,
+                           int32_t bufferCapacity, UErrorCode* ec);
+
+
+/**
+ * Uses a UNumberFormatter to format an integer directly into a buffer as UTF-8.
+ * See unumf_formatIntToBuffer.
+ *
+ * NOTE: This is a C-compatible API; C++ users should build against numberformatter.h instead.
+ *
+ * @param uformatter A formatter object created by unumf_openForSkeletonAndLocale or similar.
+ * @param value The number to be formatted.
+ * @param buffer The buffer to receive the formatted number. May be NULL if bufferCapacity is zero.
+ * @param bufferCapacity The number of bytes available in the buffer.
+ * @param ec Set if an error occurs.
+ * @return The length of the formatted number, in bytes.
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+unumf_formatIntToUTF8(const UNumberFormatter* uformatter, int64_t value, char* buffer,
+                      int32_t bufferCapacity, UErrorCode* ec);
+
+
+/**
+ * Uses a UNumberFormatter to format a double directly into a buffer as UTF-8.
+ * See unumf_formatIntToBuffer.
+ *
+ * NOTE: This is a C-compatible API; C++ users should build against numberformatter.h instead.
+ *
+ * @param uformatter A formatter object created by unumf_openForSkeletonAndLocale or similar.
+ * @param value The number to be formatted.
+ * @param buffer The buffer to receive the formatted number. May be NULL if bufferCapacity is zero.
+ * @param bufferCapacity The number of bytes available in the buffer.
+ * @param ec Set if an error occurs.
+ * @return The length of the formatted number, in bytes.
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+unumf_formatDoubleToUTF8(const UNumberFormatter* uformatter, double value, char* buffer,
+                         int32_t bufferCapacity, UErrorCode* ec);
+
+
 /**
  * Extracts the result number string out of a UFormattedNumber to a UChar buffer if possible.
  * If bufferCapacity is greater than the required length, a terminating NUL is written.
@@ -250,6 +250,46 @@ U_NAMESPACE_END
 U_STABLE URegularExpression * U_EXPORT2 
 uregex_clone(const URegularExpression *regexp, UErrorCode *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Write the compiled form of a regular expression to a flat buffer, from which
+ * uregex_openBinary() can open the regular expression without compiling it again.
+ * The binary form is specific to the ICU major version and to the byte order
+ * of the platform.
+ *
+ * @param regexp       The compiled regular expression.
+ * @param dest         Buffer for the binary form. Can be NULL if destCapacity==0.
+ * @param destCapacity Capacity of dest in bytes.
+ * @param status       Receives errors detected by this function;
+ *                     U_BUFFER_OVERFLOW_ERROR if the binary form does not fit.
+ * @return the length of the binary form in bytes, even if it does not fit.
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+uregex_cloneBinary(const URegularExpression *regexp,
+                   uint8_t                  *dest,
+                   int32_t                   destCapacity,
+                   UErrorCode               *status);
+
+/**
+ * Open a regular expression from the binary form written by uregex_cloneBinary(),
+ * without parsing the pattern. The regular expression does not alias the
+ * binary data.
+ *
+ * @param bin     The binary form of a regular expression.
+ * @param length  The length of bin in bytes.
+ * @param status  Receives errors detected by this function; U_INVALID_FORMAT_ERROR
+ *                if bin is not the binary form of a regular expression from this
+ *                version of ICU on a platform with the same byte order.
+ * @return        The URegularExpression object.
+ * @draft ICU 63
+ */
+U_DRAFT URegularExpression * U_EXPORT2
+uregex_openBinary(const uint8_t *bin,
+                  int32_t        length,
+                  UErrorCode    *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  *  Returns a pointer to the source form of the pattern for this regular expression.
  *  This function will work even if the pattern was originally specified as a UText.
@@ -1476,6 +1516,38 @@ U_STABLE int32_t U_EXPORT2
 uregex_getStackLimit(const URegularExpression      *regexp,
                            UErrorCode              *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Enable or disable memoization in the backtracking match engine, which bounds
+ * the time for a match operation to be proportional to the length of the pattern
+ * times the length of the input region, for patterns without back references,
+ * look-around assertions, atomic groups, possessive or counted quantifiers, or
+ * repetitions of expressions that can match an empty string.
+ * It does not change the results of any match operation.
+ * See RegexMatcher::setMemoizeBacktracking().
+ *
+ * @param   regexp      The compiled regular expression.
+ * @param   memoize     TRUE to enable memoization, FALSE to disable it.
+ * @param   status      A reference to a UErrorCode to receive any errors.
+ *
+ * @draft ICU 63
+ */
+U_DRAFT void U_EXPORT2
+uregex_setMemoizeBacktracking(URegularExpression      *regexp,
+                              UBool                    memoize,
+                              UErrorCode              *status);
+
+/**
+ * Tell whether memoization in the backtracking match engine is enabled.
+ *
+ * @return  TRUE if memoization is enabled.
+ * @draft ICU 63
+ */
+U_DRAFT UBool U_EXPORT2
+uregex_getMemoizeBacktracking(const URegularExpression      *regexp,
+                                    UErrorCode              *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 
 /**
  * Function pointer for a regular expression matching callback function.
@@ -24,6 +24,8 @@
 #include "unicode/rbnf.h"
 #include "unicode/compactdecimalformat.h"
 #include "unicode/ustring.h"
+#include "unicode/utf8.h"
+#include "unicode/utf16.h"
 #include "unicode/fmtable.h"
 #include "unicode/dcfmtsym.h"
 #include "unicode/curramt.h"
@@ -491,6 +493,144 @@ unum_parseDoubleCurrency(const UNumberFormat* fmt,
     return doubleVal;
 }
 
+// Batch parsing for the formats that cannot use DecimalFormat::parseDoubles(),
+// such as RuleBasedNumberFormat: one NumberFormat::parse() call per string.
+static UBool
+parseDoublesCell(const NumberFormat& nf,
+                 const UnicodeString& src,
+                 double& result,
+                 int32_t& parseEnd,
+                 UErrorCode* status)
+{
+    Formattable res;
+    ParsePosition pp;
+    if (!src.isEmpty()) {
+        nf.parse(src, res, pp);
+    }
+    if (pp.getErrorIndex() != -1 || pp.getIndex() == 0) {
+        result = 0.0;
+        parseEnd = pp.getErrorIndex() > 0 ? pp.getErrorIndex() : 0;
+        return FALSE;
+    }
+    result = res.getDouble(*status);
+    parseEnd = pp.getIndex();
+    return TRUE;
+}
+
+static void
+setDoublesCellStatus(int32_t i,
+                     UBool success,
+                     int32_t parseEnd,
+                     int32_t parseEnds[],
+                     UErrorCode cellStatus[])
+{
+    if (parseEnds != NULL) {
+        parseEnds[i] = parseEnd;
+    }
+    if (cellStatus != NULL) {
+        cellStatus[i] = success ? U_ZERO_ERROR : U_PARSE_ERROR;
+    }
+}
+
+// CompactDecimalFormat is a DecimalFormat but does not support parsing.
+static const DecimalFormat*
+getBatchParser(const UNumberFormat* fmt)
+{
+    const NumberFormat* nf = reinterpret_cast<const NumberFormat*>(fmt);
+    if (dynamic_cast<const CompactDecimalFormat*>(nf) != NULL) {
+        return NULL;
+    }
+    return dynamic_cast<const DecimalFormat*>(nf);
+}
+
+U_CAPI int32_t U_EXPORT2
+unum_parseDoubles(const UNumberFormat* fmt,
+                  const UChar* const texts[],
+                  const int32_t textLengths[],
+                  int32_t count,
+                  double results[],
+                  int32_t parseEnds[],
+                  UErrorCode cellStatus[],
+                  UErrorCode* status)
+{
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    const DecimalFormat* df = getBatchParser(fmt);
+    if (df != NULL) {
+        return df->parseDoubles(texts, textLengths, count, results, parseEnds, cellStatus, *status);
+    }
+    if (count < 0 || (count > 0 && (texts == NULL || results == NULL))) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const NumberFormat* nf = reinterpret_cast<const NumberFormat*>(fmt);
+    int32_t successCount = 0;
+    for (int32_t i = 0; i < count; i++) {
+        int32_t length = textLengths == NULL ? -1 : textLengths[i];
+        const UnicodeString src((UBool)(length == -1), texts[i], length);
+        int32_t parseEnd;
+        UBool success = parseDoublesCell(*nf, src, results[i], parseEnd, status);
+        if (U_FAILURE(*status)) {
+            return successCount;
+        }
+        setDoublesCellStatus(i, success, parseEnd, parseEnds, cellStatus);
+        successCount += success;
+    }
+    return successCount;
+}
+
+U_CAPI int32_t U_EXPORT2
+unum_parseDoublesUTF8(const UNumberFormat* fmt,
+                      const char* const texts[],
+                      const int32_t textLengths[],
+                      int32_t count,
+                      double results[],
+                      int32_t parseEnds[],
+                      UErrorCode cellStatus[],
+                      UErrorCode* status)
+{
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    const DecimalFormat* df = getBatchParser(fmt);
+    if (df != NULL) {
+        return df->parseDoublesUTF8(texts, textLengths, count, results, parseEnds, cellStatus, *status);
+    }
+    if (count < 0 || (count > 0 && (texts == NULL || results == NULL))) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const NumberFormat* nf = reinterpret_cast<const NumberFormat*>(fmt);
+    int32_t successCount = 0;
+    for (int32_t i = 0; i < count; i++) {
+        const char* s = texts[i];
+        int32_t length = textLengths == NULL ? -1 : textLengths[i];
+        if (s == NULL) {
+            length = 0;
+        } else if (length < 0) {
+            length = (int32_t)uprv_strlen(s);
+        }
+        UnicodeString src = UnicodeString::fromUTF8(StringPiece(s, length));
+        int32_t parseEnd;
+        UBool success = parseDoublesCell(*nf, src, results[i], parseEnd, status);
+        if (U_FAILURE(*status)) {
+            return successCount;
+        }
+        // Map the UTF-16 index back to a byte offset; fromUTF8() turns each
+        // ill-formed sequence into one U+FFFD, just as U8_NEXT() skips it.
+        int32_t byteEnd = 0;
+        for (int32_t unitEnd = 0; unitEnd < parseEnd && byteEnd < length;) {
+            UChar32 c;
+            U8_NEXT(s, byteEnd, length, c);
+            unitEnd += c < 0 ? 1 : U16_LENGTH(c);
+        }
+        setDoublesCellStatus(i, success, byteEnd, parseEnds, cellStatus);
+        successCount += success;
+    }
+    return successCount;
+}
+
 U_CAPI const char* U_EXPORT2
 unum_getAvailable(int32_t index)
 {
@@ -312,6 +312,69 @@ uregex_clone(const URegularExpression *source2, UErrorCode *status)  {
 }
 
 
+//----------------------------------------------------------------------------------------
+//
+//    uregex_cloneBinary
+//
+//----------------------------------------------------------------------------------------
+U_CAPI int32_t U_EXPORT2
+uregex_cloneBinary(const URegularExpression *regexp2,
+                   uint8_t                  *dest,
+                   int32_t                   destCapacity,
+                   UErrorCode               *status) {
+    RegularExpression *regexp = (RegularExpression*)regexp2;
+    if (validateRE(regexp, FALSE, status) == FALSE) {
+        return 0;
+    }
+    return regexp->fPat->cloneBinary(dest, destCapacity, *status);
+}
+
+
+//----------------------------------------------------------------------------------------
+//
+//    uregex_openBinary
+//
+//----------------------------------------------------------------------------------------
+U_CAPI URegularExpression * U_EXPORT2
+uregex_openBinary(const uint8_t *bin,
+                  int32_t        length,
+                  UErrorCode    *status) {
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    LocalPointer<RegexPattern> pat(RegexPattern::createFromBinary(bin, length, *status));
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    UnicodeString patString = pat->pattern();
+    int32_t patLength = patString.length();
+
+    RegularExpression  *re     = new RegularExpression;
+    u_atomic_int32_t   *refC   = (u_atomic_int32_t *)uprv_malloc(sizeof(int32_t));
+    UChar              *patBuf = (UChar *)uprv_malloc(sizeof(UChar)*(patLength+1));
+    if (re == NULL || refC == NULL || patBuf == NULL) {
+        *status = U_MEMORY_ALLOCATION_ERROR;
+        delete re;
+        uprv_free((void *)refC);
+        uprv_free(patBuf);
+        return NULL;
+    }
+    re->fPatRefCount = refC;
+    *re->fPatRefCount = 1;
+    re->fPatString    = patBuf;
+    re->fPatStringLen = patLength;
+    patString.extract(patBuf, patLength+1, *status);
+    re->fPat = pat.orphan();
+
+    re->fMatcher = re->fPat->matcher(*status);
+    if (U_FAILURE(*status)) {
+        delete re;
+        return NULL;
+    }
+    return (URegularExpression*)re;
+}
+
+
 
 
 //------------------------------------------------------------------------------
@@ -1074,6 +1137,39 @@ uregex_getStackLimit(const  URegularExpression   *regexp2,
 }
 
 
+//------------------------------------------------------------------------------
+//
+//    uregex_setMemoizeBacktracking
+//
+//------------------------------------------------------------------------------
+U_CAPI void U_EXPORT2
+uregex_setMemoizeBacktracking(URegularExpression  *regexp2,
+                              UBool                memoize,
+                              UErrorCode          *status) {
+    RegularExpression *regexp = (RegularExpression*)regexp2;
+    if (validateRE(regexp, FALSE, status)) {
+        regexp->fMatcher->setMemoizeBacktracking(memoize, *status);
+    }
+}
+
+
+//------------------------------------------------------------------------------
+//
+//    uregex_getMemoizeBacktracking
+//
+//------------------------------------------------------------------------------
+U_CAPI UBool U_EXPORT2
+uregex_getMemoizeBacktracking(const  URegularExpression   *regexp2,
+                                     UErrorCode           *status) {
+    UBool retVal = FALSE;
+    RegularExpression *regexp = (RegularExpression*)regexp2;
+    if (validateRE(regexp, FALSE, status)) {
+        retVal = regexp->fMatcher->getMemoizeBacktracking();
+    }
+    return retVal;
+}
+
+
 //------------------------------------------------------------------------------
 //
 //    uregex_setMatchCallback
@@ -32,11 +32,36 @@
 
 static UMutex gZoneMetaLock = U_MUTEX_INITIALIZER;
 
-// CLDR Canonical ID mapping table
+U_NAMESPACE_BEGIN
+
+/**
+ * Lookup results for one system zone ID. Each value is set once, under gZoneMetaLock,
+ * and then published by setting its ready flag, so that readers need no lock.
+ */
+struct SystemZoneEntry : public UMemory {
+    SystemZoneEntry() : canonicalIDReady(0), canonicalID(NULL), mappingsReady(0), mappings(NULL) {}
+    ~SystemZoneEntry() { delete mappings; }
+
+    u_atomic_int32_t canonicalIDReady;
+    const UChar *canonicalID;       // from a resource bundle
+    u_atomic_int32_t mappingsReady;
+    const UVector *mappings;        // owned, NULL if the zone has no metazones
+};
+
+U_NAMESPACE_END
+
+// System zone IDs from the tz database (zoneinfo64 Names), in code unit order,
+// and their lookup results
+static const UChar **gSystemZoneIDs = NULL;
+static icu::SystemZoneEntry *gSystemZoneEntries = NULL;
+static int32_t gSystemZoneCount = 0;
+static icu::UInitOnce gSystemZonesInitOnce = U_INITONCE_INITIALIZER;
+
+// CLDR Canonical ID mapping table, for IDs that are not system zone IDs
 static UHashtable *gCanonicalIDCache = NULL;
 static icu::UInitOnce gCanonicalIDCacheInitOnce = U_INITONCE_INITIALIZER;
 
-// Metazone mapping table
+// Metazone mapping table, for IDs that are not system zone IDs
 static UHashtable *gOlsonToMeta = NULL;
 static icu::UInitOnce gOlsonToMetaInitOnce = U_INITONCE_INITIALIZER;
 
@@ -57,6 +82,13 @@ U_CDECL_BEGIN
  */
 static UBool U_CALLCONV zoneMeta_cleanup(void)
 {
+    uprv_free(gSystemZoneIDs);
+    gSystemZoneIDs = NULL;
+    delete[] gSystemZoneEntries;
+    gSystemZoneEntries = NULL;
+    gSystemZoneCount = 0;
+    gSystemZonesInitOnce.reset();
+
     if (gCanonicalIDCache != NULL) {
         uhash_close(gCanonicalIDCache);
         gCanonicalIDCache = NULL;
@@ -133,6 +165,9 @@ static const char gPrimaryZonesTag[]    = "primaryZones";
 
 static const char gWorldTag[]           = "001";
 
+static const char gZoneinfo64[]         = "zoneinfo64";
+static const char gNamesTag[]           = "Names";
+
 static const UChar gWorld[] = {0x30, 0x30, 0x31, 0x00}; // "001"
 
 static const UChar gDefaultFrom[] = {0x31, 0x39, 0x37, 0x30, 0x2D, 0x30, 0x31, 0x2D, 0x30, 0x31,
@@ -219,6 +254,37 @@ parseDate (const UChar *text, UErrorCode &status) {
     return 0;
 }
 
+static void U_CALLCONV initSystemZones(UErrorCode &status) {
+    ucln_i18n_registerCleanup(UCLN_I18N_ZONEMETA, zoneMeta_cleanup);
+    LocalUResourceBundlePointer names(ures_openDirect(NULL, gZoneinfo64, &status));
+    ures_getByKey(names.getAlias(), gNamesTag, names.getAlias(), &status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    int32_t count = ures_getSize(names.getAlias());
+    gSystemZoneIDs = (const UChar **)uprv_malloc(count * sizeof(const UChar *));
+    gSystemZoneEntries = new SystemZoneEntry[count];
+    if (gSystemZoneIDs == NULL || gSystemZoneEntries == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < count && U_SUCCESS(status); i++) {
+        gSystemZoneIDs[i] = ures_getStringByIndex(names.getAlias(), i, NULL, &status);
+    }
+    if (U_SUCCESS(status)) {
+        gSystemZoneCount = count;
+    }
+}
+
+/**
+ * Returns the SystemZoneEntry for the ID, or NULL if it is not a system zone ID.
+ */
+static SystemZoneEntry*
+findSystemZoneEntry(const UnicodeString& tzid) {
+    int32_t index = ZoneMeta::findTimeZoneIDIndex(tzid);
+    return (index >= 0) ? &gSystemZoneEntries[index] : NULL;
+}
+
 static void U_CALLCONV initCanonicalIDCache(UErrorCode &status) {
     gCanonicalIDCache = uhash_open(uhash_hashUChars, uhash_compareUChars, NULL, &status);
     if (gCanonicalIDCache == NULL) {
@@ -262,15 +328,22 @@ ZoneMeta::getCanonicalCLDRID(const UnicodeString &tzid, UErrorCode& status) {
         return NULL;
     }
 
-    // Check if it was already cached
-    umtx_lock(&gZoneMetaLock);
-    {
-        canonicalID = (const UChar *)uhash_get(gCanonicalIDCache, utzid);
-    }
-    umtx_unlock(&gZoneMetaLock);
+    // Check if it was already resolved: without locking for system zone IDs
+    SystemZoneEntry *entry = findSystemZoneEntry(tzid);
+    if (entry != NULL) {
+        if (umtx_loadAcquire(entry->canonicalIDReady) != 0) {
+            return entry->canonicalID;
+        }
+    } else {
+        umtx_lock(&gZoneMetaLock);
+        {
+            canonicalID = (const UChar *)uhash_get(gCanonicalIDCache, utzid);
+        }
+        umtx_unlock(&gZoneMetaLock);
 
-    if (canonicalID != NULL) {
-        return canonicalID;
+        if (canonicalID != NULL) {
+            return canonicalID;
+        }
     }
 
     // If not, resolve CLDR canonical ID with resource data
@@ -350,21 +423,36 @@ ZoneMeta::getCanonicalCLDRID(const UnicodeString &tzid, UErrorCode& status) {
         // Put the resolved canonical ID to the cache
         umtx_lock(&gZoneMetaLock);
         {
-            const UChar* idInCache = (const UChar *)uhash_get(gCanonicalIDCache, utzid);
-            if (idInCache == NULL) {
-                const UChar* key = ZoneMeta::findTimeZoneID(tzid);
-                U_ASSERT(key != NULL);
-                if (key != NULL) {
-                    idInCache = (const UChar *)uhash_put(gCanonicalIDCache, (void *)key, (void *)canonicalID, &status);
-                    U_ASSERT(idInCache == NULL);
+            if (entry != NULL) {
+                if (umtx_loadAcquire(entry->canonicalIDReady) == 0) {
+                    entry->canonicalID = canonicalID;
+                    umtx_storeRelease(entry->canonicalIDReady, 1);
+                }
+            } else {
+                const UChar* idInCache = (const UChar *)uhash_get(gCanonicalIDCache, utzid);
+                if (idInCache == NULL) {
+                    const UChar* key = ZoneMeta::findTimeZoneID(tzid);
+                    U_ASSERT(key != NULL);
+                    if (key != NULL) {
+                        idInCache = (const UChar *)uhash_put(gCanonicalIDCache, (void *)key, (void *)canonicalID, &status);
+                        U_ASSERT(idInCache == NULL);
+                    }
                 }
             }
             if (U_SUCCESS(status) && isInputCanonical) {
                 // Also put canonical ID itself into the cache if not exist
-                const UChar *canonicalInCache = (const UChar*)uhash_get(gCanonicalIDCache, canonicalID);
-                if (canonicalInCache == NULL) {
-                    canonicalInCache = (const UChar *)uhash_put(gCanonicalIDCache, (void *)canonicalID, (void *)canonicalID, &status);
-                    U_ASSERT(canonicalInCache == NULL);
+                SystemZoneEntry *canonicalEntry = findSystemZoneEntry(UnicodeString(TRUE, canonicalID, -1));
+                if (canonicalEntry != NULL) {
+                    if (umtx_loadAcquire(canonicalEntry->canonicalIDReady) == 0) {
+                        canonicalEntry->canonicalID = canonicalID;
+                        umtx_storeRelease(canonicalEntry->canonicalIDReady, 1);
+                    }
+                } else {
+                    const UChar *canonicalInCache = (const UChar*)uhash_get(gCanonicalIDCache, canonicalID);
+                    if (canonicalInCache == NULL) {
+                        canonicalInCache = (const UChar *)uhash_put(gCanonicalIDCache, (void *)canonicalID, (void *)canonicalID, &status);
+                        U_ASSERT(canonicalInCache == NULL);
+                    }
                 }
             }
         }
@@ -564,6 +652,24 @@ ZoneMeta::getMetazoneMappings(const UnicodeString &tzid) {
         return NULL;
     }
 
+    // System zone IDs keep their mappings without a lock, and remember when there are none
+    SystemZoneEntry *entry = findSystemZoneEntry(tzid);
+    if (entry != NULL) {
+        if (umtx_loadAcquire(entry->mappingsReady) == 0) {
+            UVector *mappings = createMetazoneMappings(tzid);
+            umtx_lock(&gZoneMetaLock);
+            if (umtx_loadAcquire(entry->mappingsReady) == 0) {
+                entry->mappings = mappings;
+                umtx_storeRelease(entry->mappingsReady, 1);
+            } else {
+                // another thread already set them
+                delete mappings;
+            }
+            umtx_unlock(&gZoneMetaLock);
+        }
+        return entry->mappings;
+    }
+
     umtx_initOnce(gOlsonToMetaInitOnce, &olsonToMetaInit, status);
     if (U_FAILURE(status)) {
         return NULL;
@@ -838,7 +944,49 @@ ZoneMeta::findMetaZoneID(const UnicodeString& mzid) {
 
 const UChar*
 ZoneMeta::findTimeZoneID(const UnicodeString& tzid) {
-    return TimeZone::findID(tzid);
+    int32_t index = findTimeZoneIDIndex(tzid);
+    return (index >= 0) ? gSystemZoneIDs[index] : NULL;
+}
+
+int32_t
+ZoneMeta::findTimeZoneIDIndex(const UnicodeString& tzid) {
+    UErrorCode status = U_ZERO_ERROR;
+    umtx_initOnce(gSystemZonesInitOnce, &initSystemZones, status);
+    if (U_FAILURE(status)) {
+        return -1;
+    }
+    // Binary search, in the code unit order of the zoneinfo64 Names
+    const UChar *id = tzid.getBuffer();
+    int32_t idLength = tzid.length();
+    if (id == NULL) {
+        return -1;
+    }
+    int32_t start = 0;
+    int32_t limit = gSystemZoneCount;
+    while (start < limit) {
+        int32_t mid = (start + limit) / 2;
+        const UChar *name = gSystemZoneIDs[mid];
+        int32_t i = 0;
+        while (i < idLength && name[i] != 0 && id[i] == name[i]) {
+            i++;
+        }
+        int32_t result;
+        if (i == idLength) {
+            result = (name[i] == 0) ? 0 : -1;
+        } else if (name[i] == 0) {
+            result = 1;
+        } else {
+            result = (int32_t)id[i] - (int32_t)name[i];
+        }
+        if (result == 0) {
+            return mid;
+        } else if (result < 0) {
+            limit = mid;
+        } else {
+            start = mid + 1;
+        }
+    }
+    return -1;
 }
 
 
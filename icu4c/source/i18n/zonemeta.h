@@ -83,6 +83,13 @@ class U_I18N_API ZoneMeta {
      */
     static const UChar* U_EXPORT2 findTimeZoneID(const UnicodeString& tzid);
 
+    /**
+     * Returns the index of the given tzid in the list of zone IDs in the tz database
+     * (zoneinfo64 Names), or -1 if the given tzid is not in the tz database.
+     * The list is loaded once; lookups do not lock.
+     */
+    static int32_t U_EXPORT2 findTimeZoneIDIndex(const UnicodeString& tzid);
+
     /**
      * Returns the pointer to the persistent meta zone ID string, or NULL if the given mzid is not available.
      * This method is useful when you maintain persistent meta zone IDs without duplication.
@@ -66,6 +66,7 @@ static void TestParseCurrPatternWithDecStyle(void);
 static void TestFormatForFields(void);
 static void TestRBNFRounding(void);
 static void Test12052_NullPointer(void);
+static void TestParseDoubles(void);
 
 #define TESTCASE(x) addTest(root, &x, "tsformat/cnumtst/" #x)
 
@@ -99,6 +100,7 @@ void addNumForTest(TestNode** root)
     TESTCASE(TestParseCurrPatternWithDecStyle);
     TESTCASE(TestFormatForFields);
     TESTCASE(Test12052_NullPointer);
+    TESTCASE(TestParseDoubles);
 }
 
 /* test Parse int 64 */
@@ -3079,4 +3081,64 @@ static void Test12052_NullPointer() {
     unum_close(theFormatter);
 }
 
+static void TestParseDoubles(void) {
+    static const UChar* const texts[] = { u"1,234.5", u"-12", u"", u"abc", u"7 days" };
+    static const char* const utf8Texts[] = { "1,234.5", "-12", "", "abc", "7 days" };
+    static const double expected[] = { 1234.5, -12, 0, 0, 7 };
+    static const int32_t expectedEnds[] = { 7, 3, 0, 0, 1 };
+    static const UErrorCode expectedStatus[] = {
+        U_ZERO_ERROR, U_ZERO_ERROR, U_PARSE_ERROR, U_PARSE_ERROR, U_ZERO_ERROR };
+    static const UChar* const spelloutTexts[] = { u"forty-two", u"", u"zebra" };
+    static const int32_t count = UPRV_LENGTHOF(texts);
+    double results[UPRV_LENGTHOF(texts)];
+    int32_t parseEnds[UPRV_LENGTHOF(texts)];
+    UErrorCode cellStatus[UPRV_LENGTHOF(texts)];
+    int32_t i, successCount;
+    UErrorCode status = U_ZERO_ERROR;
+    UNumberFormat* fmt = unum_open(UNUM_DECIMAL, NULL, 0, "en_US", NULL, &status);
+    if (U_FAILURE(status)) {
+        log_data_err("unum_open(UNUM_DECIMAL) failed - %s\n", u_errorName(status));
+        return;
+    }
+
+    successCount = unum_parseDoubles(fmt, texts, NULL, count, results, parseEnds, cellStatus, &status);
+    assertSuccess("unum_parseDoubles", &status);
+    assertIntEquals("unum_parseDoubles success count", 3, successCount);
+    for (i = 0; i < count; i++) {
+        assertTrue("unum_parseDoubles value", expected[i] == results[i]);
+        assertIntEquals("unum_parseDoubles end", expectedEnds[i], parseEnds[i]);
+        assertIntEquals("unum_parseDoubles status", expectedStatus[i], cellStatus[i]);
+    }
+
+    successCount = unum_parseDoublesUTF8(fmt, utf8Texts, NULL, count, results, parseEnds, cellStatus, &status);
+    assertSuccess("unum_parseDoublesUTF8", &status);
+    assertIntEquals("unum_parseDoublesUTF8 success count", 3, successCount);
+    for (i = 0; i < count; i++) {
+        assertTrue("unum_parseDoublesUTF8 value", expected[i] == results[i]);
+        assertIntEquals("unum_parseDoublesUTF8 end", expectedEnds[i], parseEnds[i]);
+        assertIntEquals("unum_parseDoublesUTF8 status", expectedStatus[i], cellStatus[i]);
+    }
+
+    unum_parseDoubles(fmt, texts, NULL, -1, results, NULL, NULL, &status);
+    assertIntEquals("unum_parseDoubles negative count", U_ILLEGAL_ARGUMENT_ERROR, status);
+    unum_close(fmt);
+
+    // Formats other than DecimalFormat parse one string at a time
+    status = U_ZERO_ERROR;
+    fmt = unum_open(UNUM_SPELLOUT, NULL, 0, "en_US", NULL, &status);
+    if (U_FAILURE(status)) {
+        log_data_err("unum_open(UNUM_SPELLOUT) failed - %s\n", u_errorName(status));
+        return;
+    }
+    successCount = unum_parseDoubles(fmt, spelloutTexts, NULL, UPRV_LENGTHOF(spelloutTexts),
+                                     results, parseEnds, cellStatus, &status);
+    assertSuccess("unum_parseDoubles spellout", &status);
+    assertIntEquals("unum_parseDoubles spellout success count", 1, successCount);
+    assertTrue("unum_parseDoubles spellout value", 42 == results[0]);
+    assertIntEquals("unum_parseDoubles spellout end", 9, parseEnds[0]);
+    assertIntEquals("unum_parseDoubles spellout empty", U_PARSE_ERROR, cellStatus[1]);
+    assertIntEquals("unum_parseDoubles spellout failure", U_PARSE_ERROR, cellStatus[2]);
+    unum_close(fmt);
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
@@ -163,6 +163,7 @@ static void TestUTextAPI(void);
 static void TestRefreshInput(void);
 static void TestBug8421(void);
 static void TestBug10815(void);
+static void TestBinaryForm(void);
 
 void addURegexTest(TestNode** root);
 
@@ -174,6 +175,7 @@ void addURegexTest(TestNode** root)
     addTest(root, &TestRefreshInput, "regex/TestRefreshInput");
     addTest(root, &TestBug8421,   "regex/TestBug8421");
     addTest(root, &TestBug10815,   "regex/TestBug10815");
+    addTest(root, &TestBinaryForm, "regex/TestBinaryForm");
 }
 
 /*
@@ -1312,6 +1314,20 @@ static void TestRegexCAPI(void) {
      status = U_ZERO_ERROR;
      TEST_ASSERT(uregex_getStackLimit(re, &status) == 40000);
      TEST_TEARDOWN;
+
+     /*
+      * set/get memoized backtracking
+      */
+     TEST_SETUP("(a+)+b", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", 0);
+     TEST_ASSERT(uregex_getMemoizeBacktracking(re, &status) == FALSE);
+     uregex_setMemoizeBacktracking(re, TRUE, &status);
+     TEST_ASSERT(uregex_getMemoizeBacktracking(re, &status) == TRUE);
+     uregex_setTimeLimit(re, 1000, &status);
+     TEST_ASSERT(uregex_matches(re, 0, &status) == FALSE);
+     TEST_ASSERT_SUCCESS(status);
+     uregex_setMemoizeBacktracking(re, FALSE, &status);
+     TEST_ASSERT(uregex_getMemoizeBacktracking(re, &status) == FALSE);
+     TEST_TEARDOWN;
      
      
      /*
@@ -2306,5 +2322,53 @@ static void TestBug10815() {
     uregex_close(re);
 }
 
+static void TestBinaryForm(void) {
+    /* uregex_cloneBinary() and uregex_openBinary() */
+    URegularExpression *re;
+    URegularExpression *re2;
+    UErrorCode status = U_ZERO_ERROR;
+    UChar    text[100];
+    UChar    pattern[100];
+    const UChar *pat2;
+    int32_t  pat2Length;
+    uint8_t  bin[2000];
+    int32_t  length;
+
+    re = uregex_openC("(?<word>[a-z]+)(\\d+)", UREGEX_CASE_INSENSITIVE, 0, &status);
+    TEST_ASSERT_SUCCESS(status);
+
+    length = uregex_cloneBinary(re, NULL, 0, &status);
+    TEST_ASSERT(status == U_BUFFER_OVERFLOW_ERROR);
+    TEST_ASSERT(length > 0 && length <= UPRV_LENGTHOF(bin));
+    status = U_ZERO_ERROR;
+    TEST_ASSERT(uregex_cloneBinary(re, bin, UPRV_LENGTHOF(bin), &status) == length);
+    TEST_ASSERT_SUCCESS(status);
+    uregex_close(re);
+
+    re2 = uregex_openBinary(bin, length - 1, &status);
+    TEST_ASSERT(status == U_INVALID_FORMAT_ERROR);
+    TEST_ASSERT(re2 == NULL);
+    status = U_ZERO_ERROR;
+
+    re2 = uregex_openBinary(bin, length, &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(uregex_flags(re2, &status) == UREGEX_CASE_INSENSITIVE);
+    u_uastrncpy(pattern, "(?<word>[a-z]+)(\\d+)", UPRV_LENGTHOF(pattern));
+    pat2 = uregex_pattern(re2, &pat2Length, &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(pat2Length == u_strlen(pattern) && u_strcmp(pat2, pattern) == 0);
+    TEST_ASSERT(uregex_groupNumberFromCName(re2, "word", -1, &status) == 1);
+
+    u_uastrncpy(text, "--- Abc123 xyz ---", UPRV_LENGTHOF(text));
+    uregex_setText(re2, text, -1, &status);
+    TEST_ASSERT(uregex_findNext(re2, &status));
+    TEST_ASSERT(uregex_start(re2, 0, &status) == 4);
+    TEST_ASSERT(uregex_end(re2, 1, &status) == 7);
+    TEST_ASSERT(uregex_end(re2, 2, &status) == 10);
+    TEST_ASSERT(!uregex_findNext(re2, &status));
+    TEST_ASSERT_SUCCESS(status);
+    uregex_close(re2);
+}
+
     
 #endif   /*  !UCONFIG_NO_REGULAR_EXPRESSIONS */
@@ -21,12 +21,18 @@ static void TestSkeletonFormatToFields(void);
 
 static void TestExampleCode(void);
 
+static void TestSharedFormatters(void);
+
+static void TestFormatToBuffer(void);
+
 void addUNumberFormatterTest(TestNode** root);
 
 void addUNumberFormatterTest(TestNode** root) {
     addTest(root, &TestSkeletonFormatToString, "unumberformatter/TestSkeletonFormatToString");
     addTest(root, &TestSkeletonFormatToFields, "unumberformatter/TestSkeletonFormatToFields");
     addTest(root, &TestExampleCode, "unumberformatter/TestExampleCode");
+    addTest(root, &TestSharedFormatters, "unumberformatter/TestSharedFormatters");
+    addTest(root, &TestFormatToBuffer, "unumberformatter/TestFormatToBuffer");
 }
 
 
@@ -187,4 +193,97 @@ static void TestExampleCode() {
 }
 
 
+static void TestSharedFormatters() {
+    // Formatters for the same skeleton and locale share their data;
+    // each must work independently of the others.
+    UErrorCode ec = U_ZERO_ERROR;
+    UNumberFormatter* uformatter1 = unumf_openForSkeletonAndLocale(u"percent", -1, "en", &ec);
+    UNumberFormatter* uformatter2 = unumf_openForSkeletonAndLocale(u"percent", -1, "en", &ec);
+    UNumberFormatter* uformatter3 = unumf_openForSkeletonAndLocale(u"percent", -1, "de", &ec);
+    UFormattedNumber* uresult = unumf_openResult(&ec);
+    UChar buffer[CAPACITY];
+    assertSuccessCheck("Should create formatters", &ec, TRUE);
+
+    unumf_close(uformatter1);
+    unumf_formatDouble(uformatter2, 1234.5, uresult, &ec);
+    unumf_resultToString(uresult, buffer, CAPACITY, &ec);
+    assertSuccess("Should format", &ec);
+    assertUEquals("Should format after another formatter is closed", u"1,234.5%", buffer);
+
+    unumf_formatDouble(uformatter3, 1234.5, uresult, &ec);
+    unumf_resultToString(uresult, buffer, CAPACITY, &ec);
+    assertSuccess("Should format", &ec);
+    assertUEquals("Should use its own locale", u"1.234,5\u00A0%", buffer);
+
+    // The skeleton length is part of the key.
+    uformatter1 = unumf_openForSkeletonAndLocale(u"percent precision-integer", 7, "en", &ec);
+    unumf_formatDouble(uformatter1, 1234.5, uresult, &ec);
+    unumf_resultToString(uresult, buffer, CAPACITY, &ec);
+    assertSuccess("Should format", &ec);
+    assertUEquals("Should use the skeleton prefix", u"1,234.5%", buffer);
+    unumf_close(uformatter1);
+
+    // Errors are reported each time.
+    for (int32_t i = 0; i < 2; i++) {
+        ec = U_ZERO_ERROR;
+        uformatter1 = unumf_openForSkeletonAndLocale(u"percent precision-bogus", -1, "en", &ec);
+        assertTrue("Should report a skeleton error", ec == U_NUMBER_SKELETON_SYNTAX_ERROR);
+        assertTrue("Should not return a formatter", uformatter1 == NULL);
+    }
+
+    unumf_close(uformatter2);
+    unumf_close(uformatter3);
+    unumf_closeResult(uresult);
+}
+
+
+static void TestFormatToBuffer() {
+    UErrorCode ec = U_ZERO_ERROR;
+    UNumberFormatter* uformatter = unumf_openForSkeletonAndLocale(u"percent", -1, "de", &ec);
+    UChar buffer[CAPACITY];
+    char buffer8[CAPACITY];
+    int32_t length;
+    assertSuccessCheck("Should create formatter", &ec, TRUE);
+
+    length = unumf_formatDoubleToBuffer(uformatter, 1234.5, buffer, CAPACITY, &ec);
+    assertSuccess("Should format a double", &ec);
+    assertUEquals("Should format a double", u"1.234,5\u00A0%", buffer);
+    assertIntEquals("Double length", 9, length);
+
+    length = unumf_formatIntToBuffer(uformatter, -42, buffer, CAPACITY, &ec);
+    assertSuccess("Should format an integer", &ec);
+    assertUEquals("Should format an integer", u"-42\u00A0%", buffer);
+    assertIntEquals("Integer length", 5, length);
+
+    length = unumf_formatDoubleToUTF8(uformatter, 1234.5, buffer8, CAPACITY, &ec);
+    assertSuccess("Should format a double to UTF-8", &ec);
+    assertEquals("Should format a double to UTF-8", "1.234,5\xC2\xA0%", buffer8);
+    assertIntEquals("Double UTF-8 length", 10, length);
+
+    length = unumf_formatIntToUTF8(uformatter, -42, buffer8, CAPACITY, &ec);
+    assertSuccess("Should format an integer to UTF-8", &ec);
+    assertEquals("Should format an integer to UTF-8", "-42\xC2\xA0%", buffer8);
+    assertIntEquals("Integer UTF-8 length", 6, length);
+
+    // Preflighting
+    length = unumf_formatDoubleToBuffer(uformatter, 1234.5, NULL, 0, &ec);
+    assertTrue("Preflighting", ec == U_BUFFER_OVERFLOW_ERROR);
+    assertIntEquals("Preflighted length", 9, length);
+    ec = U_ZERO_ERROR;
+    length = unumf_formatIntToUTF8(uformatter, 1234, buffer8, 2, &ec);
+    assertTrue("UTF-8 overflow", ec == U_BUFFER_OVERFLOW_ERROR);
+    assertIntEquals("UTF-8 overflow length", 8, length);
+    ec = U_ZERO_ERROR;
+
+    // Bad arguments
+    unumf_formatIntToBuffer(uformatter, 1, NULL, 5, &ec);
+    assertTrue("NULL buffer", ec == U_ILLEGAL_ARGUMENT_ERROR);
+    ec = U_ZERO_ERROR;
+    unumf_formatIntToBuffer(NULL, 1, buffer, CAPACITY, &ec);
+    assertTrue("NULL formatter", ec == U_ILLEGAL_ARGUMENT_ERROR);
+
+    unumf_close(uformatter);
+}
+
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
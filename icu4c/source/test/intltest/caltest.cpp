@@ -22,6 +22,7 @@
 #include "cstring.h"
 #include "unicode/localpointer.h"
 #include "islamcal.h"
+#include "gregoimp.h"
 
 #define mkcstr(U) u_austrcpy(calloc(8, u_strlen(U) + 1), U)
 
@@ -336,6 +337,13 @@ void CalendarTest::runIndexedTest( int32_t index, UBool exec, const char* &name,
             TestChineseCalendarMapping();
           }
           break;
+        case 37:
+          name = "TestGregorianCivilTime";
+          if(exec) {
+            logln("TestGregorianCivilTime---"); logln("");
+            TestGregorianCivilTime();
+          }
+          break;
         default: name = ""; break;
     }
 }
@@ -2074,7 +2082,6 @@ void CalendarTest::TestYWOY()
 void CalendarTest::TestJD()
 {
   int32_t jd;
-  static const int32_t kEpochStartAsJulianDay = 2440588;
   UErrorCode status = U_ZERO_ERROR;
   GregorianCalendar cal(status);
   if (failure(status, "construct GregorianCalendar", TRUE)) return;
@@ -3709,6 +3716,61 @@ void CalendarTest::TestChineseCalendarMapping() {
     }
 }
 
+void CalendarTest::TestGregorianCivilTime() {
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<TimeZone> zone(TimeZone::createTimeZone(UnicodeString("America/Santiago")));
+    GregorianCalendar cal(*zone, status);
+    TEST_CHECK_STATUS;
+
+    // The integer day conversion matches Grego::dayToFields()
+    static const int32_t days[] = {
+        -100000000, -719529, -719528, -719468, -1, 0, 1, 11016, 11017, 11323, 2932896, 100000000 };
+    for (int32_t i = 0; i < UPRV_LENGTHOF(days); ++i) {
+        int32_t year, month, dom, dow, doy;
+        int32_t gyear, gmonth, gdom, gdow, gdoy;
+        GregorianCivilTime::dayToFields(days[i], year, month, dom, dow, doy);
+        Grego::dayToFields(days[i], gyear, gmonth, gdom, gdow, gdoy);
+        if (year != gyear || month != gmonth || dom != gdom || dow != gdow || doy != gdoy) {
+            errln("Fail: day %d: got %d-%d-%d dow %d doy %d, expected %d-%d-%d dow %d doy %d",
+                  days[i], year, month + 1, dom, dow, doy, gyear, gmonth + 1, gdom, gdow, gdoy);
+        }
+    }
+
+    // All fields match GregorianCalendar, for dates every 97 days and a few hours from 1600
+    // to 2400 and for each day around the turn of recent years, with various week rules
+    UDate start = -11676096000000.0;  // 1600-01-01T00:00Z
+    for (int32_t firstDay = UCAL_SUNDAY; firstDay <= UCAL_SATURDAY; ++firstDay) {
+        for (int32_t minDays = 1; minDays <= 7; minDays += 3) {
+            cal.setFirstDayOfWeek((UCalendarDaysOfWeek)firstDay);
+            cal.setMinimalDaysInFirstWeek((uint8_t)minDays);
+            for (int32_t i = 0; i < 3000 + 32 * 16; ++i) {
+                UDate date;
+                if (i < 3000) {
+                    date = start + i * (97 * 86400000.0 + 12345678.5);
+                } else {
+                    int32_t year = 1999 + (i - 3000) / 16;
+                    date = Grego::fieldsToDay(year, UCAL_DECEMBER, 24 + (i - 3000) % 16) * 86400000.0 + 43200000.0;
+                }
+                int32_t rawOffset, dstOffset;
+                zone->getOffset(date, FALSE, rawOffset, dstOffset, status);
+                cal.setTime(date, status);
+                TEST_CHECK_STATUS;
+                GregorianCivilTime civil;
+                civil.set(date, rawOffset, dstOffset, firstDay, minDays);
+                for (int32_t f = 0; f < UCAL_FIELD_COUNT; ++f) {
+                    int32_t expected = cal.get((UCalendarDateFields)f, status);
+                    if (civil.get((UCalendarDateFields)f) != expected) {
+                        errln(UnicodeString("Fail: ") + calToStr(cal) + " first day " + firstDay +
+                              " minimal days " + minDays + ": " + fieldName((UCalendarDateFields)f) +
+                              "=" + civil.get((UCalendarDateFields)f));
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
 
 //eof
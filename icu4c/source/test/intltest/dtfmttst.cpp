@@ -20,9 +20,11 @@
 #include "unicode/simpletz.h"
 #include "unicode/strenum.h"
 #include "unicode/dtfmtsym.h"
+#include "unicode/decimfmt.h"
 #include "cmemory.h"
 #include "cstring.h"
 #include "caltest.h"  // for fieldName
+#include "simplethread.h"
 #include <stdio.h> // for sprintf
 
 #if U_PLATFORM_USES_ONLY_WIN32_API
@@ -122,6 +124,11 @@ void DateFormatTest::runIndexedTest( int32_t index, UBool exec, const char* &nam
     TESTCASE_AUTO(TestMinuteSecondFieldsInOddPlaces);
     TESTCASE_AUTO(TestDayPeriodParsing);
     TESTCASE_AUTO(TestParseRegression13744);
+    TESTCASE_AUTO(TestFormatCompiledPattern);
+    TESTCASE_AUTO(TestFormatCachedFields);
+    TESTCASE_AUTO(TestFormatCachedFieldsThreads);
+    TESTCASE_AUTO(TestFormatCivilTime);
+    TESTCASE_AUTO(TestParseNumericFields);
 
     TESTCASE_AUTO_END;
 }
@@ -5553,6 +5560,385 @@ void DateFormatTest::TestParseRegression13744() {
     assertEquals("Error index", inDate.length(), pos.getErrorIndex());
 }
 
+void DateFormatTest::TestFormatCompiledPattern() {
+    IcuTestErrorCode status(*this, "TestFormatCompiledPattern");
+    LocalPointer<Calendar> cal(Calendar::createInstance(TimeZone::getGMT()->clone(), "en", status));
+    if (status.errDataIfFailureAndReset()) { return; }
+    cal->clear();
+    cal->set(2018, UCAL_JULY, 4, 9, 5, 3);
+    cal->set(UCAL_MILLISECOND, 7);
+    UDate date = cal->getTime(status);
+
+    static const struct {
+        const char* locale;
+        const char16_t* pattern;
+        const char16_t* expected;
+    } cases[] = {
+        {"en", u"yyyy-MM-dd HH:mm:ss.SSS", u"2018-07-04 09:05:03.007"},
+        {"en", u"yy/M/d h:m:s a", u"18/7/4 9:5:3 AM"},
+        {"en", u"'It''s' h 'o''clock' ''", u"It's 9 o'clock '"},
+        {"en", u"hh'h'hh''", u"09h09'"},
+        {"en", u"EEEE, MMMM d, y G", u"Wednesday, July 4, 2018 AD"},
+        {"en", u"S SS SSSSS kk D", u"0 00 00700 09 185"},
+        {"en", u"yyyyyyyyyyyy", u"0000002018"},
+        {"en@numbers=arab", u"yyyy-MM-dd", u"٢٠١٨-٠٧-٠٤"},
+        {"en@numbers=hanidec", u"y/M/d", u"二〇一八/七/四"},
+        {"en@numbers=adlm", u"yy", u"𞥑𞥘"},
+    };
+    for (int32_t i = 0; i < UPRV_LENGTHOF(cases); i++) {
+        SimpleDateFormat sdf(cases[i].pattern, Locale(cases[i].locale), status);
+        if (status.errDataIfFailureAndReset("locale %s", cases[i].locale)) {
+            continue;
+        }
+        sdf.setTimeZone(*TimeZone::getGMT());
+        UnicodeString actual;
+        assertEquals(UnicodeString(cases[i].locale) + u" " + cases[i].pattern,
+                     cases[i].expected, sdf.format(date, actual));
+        // Copies keep the compiled pattern
+        SimpleDateFormat copy(sdf);
+        assertEquals(UnicodeString(u"copy ") + cases[i].pattern,
+                     cases[i].expected, copy.format(date, actual.remove()));
+    }
+
+    SimpleDateFormat sdf(u"d", Locale::getEnglish(), status);
+    if (status.errDataIfFailureAndReset()) { return; }
+    sdf.setTimeZone(*TimeZone::getGMT());
+    UnicodeString actual;
+
+    // Number formats with more than digits are still fully honored
+    sdf.adoptNumberFormat(new DecimalFormat(u"'#'0", new DecimalFormatSymbols(Locale::getEnglish(), status), status));
+    assertEquals("number format with prefix", u"#4", sdf.format(date, actual));
+    sdf.adoptNumberFormat(NumberFormat::createInstance(Locale::getEnglish(), status));
+    assertEquals("number format without prefix", u"4", sdf.format(date, actual.remove()));
+
+    // Negative numbers, here an extended year BC, go through the number format
+    sdf.applyPattern(u"u");
+    cal->set(UCAL_ERA, GregorianCalendar::BC);
+    cal->set(UCAL_YEAR, 50);
+    assertEquals("negative extended year", u"-49", sdf.format(cal->getTime(status), actual.remove()));
+
+    // Literal text longer than fits into one compiled literal item
+    UnicodeString longLiteral(u'\'');
+    longLiteral.padTrailing(40001, u'x');
+    longLiteral.append(u"'d").padTrailing(80003, u'.');
+    sdf.applyPattern(longLiteral);
+    UnicodeString expected;
+    expected.padTrailing(40000, u'x');
+    expected.append(u'4').padTrailing(80001, u'.');
+    assertTrue("long literal", expected == sdf.format(date, actual.remove()));
+
+    // applyLocalizedPattern() replaces the compiled pattern too
+    sdf.applyLocalizedPattern(u"yyyy", status);
+    assertEquals("applyLocalizedPattern", u"2018", sdf.format(date, actual.remove()));
+}
+
+void DateFormatTest::TestFormatCachedFields() {
+    IcuTestErrorCode status(*this, "TestFormatCachedFields");
+    static const char* const locales[] = {"en", "ar", "ja@calendar=japanese", "he@calendar=hebrew"};
+    static const char16_t* const patterns[] = {
+        u"yyyy-MM-dd'T'HH:mm:ss.SSSZ",
+        u"EEEE, MMMM d, y G h:mm:ss a xxx",
+        u"kk KK hh HH:mm:ss S SS SSSS A D w Q",
+        u"d VVVV OOOO XXX",
+        u"yyyy-MM-dd HH:mm zzzz",  // zone names are not cached
+        u"h:mm B",  // neither are day periods
+    };
+    // Dates around the DST transitions in the zones, in steps of 7:13.25 minutes
+    static const struct {
+        const char16_t* zone;
+        UDate start;
+    } zones[] = {
+        {u"America/New_York", 1520704800000.0},  // 2018-03-10T18:00Z
+        {u"Australia/Lord_Howe", 1522501200000.0},  // 2018-03-31T13:00Z
+        {u"Etc/GMT-14", -86400000.0 * 3},  // 1969-12-29T00:00Z
+    };
+    const double step = 433250.0;
+    const int32_t stepCount = 500;
+
+    for (int32_t li = 0; li < UPRV_LENGTHOF(locales); li++) {
+        for (int32_t pi = 0; pi < UPRV_LENGTHOF(patterns); pi++) {
+            SimpleDateFormat expectedFormat(patterns[pi], Locale(locales[li]), status);
+            if (status.errDataIfFailureAndReset("locale %s", locales[li])) {
+                continue;
+            }
+            SimpleDateFormat cachedFormat(expectedFormat);
+            assertFalse("cache off by default", cachedFormat.getBooleanAttribute(UDAT_FORMAT_CACHE_FIELDS, status));
+            cachedFormat.setBooleanAttribute(UDAT_FORMAT_CACHE_FIELDS, TRUE, status);
+            for (int32_t zi = 0; zi < UPRV_LENGTHOF(zones); zi++) {
+                LocalPointer<TimeZone> zone(TimeZone::createTimeZone(zones[zi].zone));
+                expectedFormat.setTimeZone(*zone);
+                cachedFormat.setTimeZone(*zone);
+                for (int32_t i = 0; i < stepCount; i++) {
+                    // Every tenth date jumps back a day, to refill the cache for earlier dates
+                    UDate date = zones[zi].start + i * step - ((i % 10 == 9) ? 86400000.0 : 0.0);
+                    UnicodeString expected, actual;
+                    FieldPositionIterator expectedFields, actualFields;
+                    expectedFormat.format(date, expected, &expectedFields, status);
+                    cachedFormat.format(date, actual, &actualFields, status);
+                    if (status.errIfFailureAndReset("%s pattern %d date %d", locales[li], (int)pi, (int)i)) {
+                        continue;
+                    }
+                    if (expected != actual || !(expectedFields == actualFields)) {
+                        errln(UnicodeString("locale ") + locales[li] + " pattern " + patterns[pi] +
+                              " zone " + zones[zi].zone + " date " + date +
+                              ": expected " + expected + " got " + actual);
+                        break;
+                    }
+                    FieldPosition expectedPos(UDAT_HOUR_OF_DAY0_FIELD), actualPos(UDAT_HOUR_OF_DAY0_FIELD);
+                    assertEquals("FieldPosition text", expectedFormat.format(date, expected.remove(), expectedPos),
+                                 cachedFormat.format(date, actual.remove(), actualPos));
+                    if (!(expectedPos == actualPos)) {
+                        errln(UnicodeString("FieldPosition differs for ") + patterns[pi]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Changes to the formatter are not hidden by the cache
+    SimpleDateFormat sdf(u"yyyy-MM-dd HH:mm", Locale::getEnglish(), status);
+    if (status.errDataIfFailureAndReset()) { return; }
+    sdf.setBooleanAttribute(UDAT_FORMAT_CACHE_FIELDS, TRUE, status);
+    sdf.setTimeZone(*TimeZone::getGMT());
+    UDate date = 1530695103007.0;  // 2018-07-04T09:05:03.007Z
+    UnicodeString actual;
+    assertEquals("GMT", u"2018-07-04 09:05", sdf.format(date, actual));
+    LocalPointer<TimeZone> tokyo(TimeZone::createTimeZone(u"Asia/Tokyo"));
+    sdf.setTimeZone(*tokyo);
+    assertEquals("setTimeZone", u"2018-07-04 18:05", sdf.format(date, actual.remove()));
+    sdf.adoptTimeZone(TimeZone::createTimeZone(u"Pacific/Honolulu"));
+    assertEquals("adoptTimeZone", u"2018-07-03 23:05", sdf.format(date, actual.remove()));
+    sdf.applyPattern(u"MMM d, HH:mm");
+    assertEquals("applyPattern", u"Jul 3, 23:05", sdf.format(date, actual.remove()));
+    sdf.adoptNumberFormat(NumberFormat::createInstance(Locale("en@numbers=arab"), status));
+    assertEquals("adoptNumberFormat", u"Jul ٣, ٢٣:٠٥", sdf.format(date, actual.remove()));
+    sdf.adoptCalendar(Calendar::createInstance(TimeZone::createTimeZone(u"Pacific/Honolulu"),
+                                               Locale("en@calendar=buddhist"), status));
+    sdf.applyPattern(u"y G");
+    assertEquals("adoptCalendar", u"٢٥٦١ BE", sdf.format(date, actual.remove()));
+
+    // Copies have their own cache, and the attribute can be turned off again
+    LocalPointer<SimpleDateFormat> clone(static_cast<SimpleDateFormat*>(sdf.clone()));
+    assertTrue("clone keeps the attribute", clone->getBooleanAttribute(UDAT_FORMAT_CACHE_FIELDS, status));
+    assertEquals("clone", u"٢٥٦١ BE", clone->format(date, actual.remove()));
+    SimpleDateFormat assigned(u"HH:mm", Locale::getEnglish(), status);
+    assigned = sdf;
+    assertEquals("operator=", u"٢٥٦١ BE", assigned.format(date, actual.remove()));
+    assigned.setBooleanAttribute(UDAT_FORMAT_CACHE_FIELDS, FALSE, status);
+    assigned.applyPattern(u"d");
+    assertEquals("attribute off", u"٣", assigned.format(date, actual.remove()));
+    assertEquals("original unchanged", u"٢٥٦١ BE", sdf.format(date, actual.remove()));
+}
+
+static const SimpleDateFormat *gCachedFormat = NULL;
+
+void DateFormatTest::threadFuncFormatCachedFields(int32_t threadNum) {
+    // Each thread formats dates of a different day with the shared formatter;
+    // whichever thread does not get the cache formats normally.
+    UDate start = 1530695103007.0 + threadNum * 86400000.0;  // 2018-07-04T09:05:03.007Z
+    UErrorCode status = U_ZERO_ERROR;
+    SimpleDateFormat expectedFormat(*gCachedFormat);
+    expectedFormat.setBooleanAttribute(UDAT_FORMAT_CACHE_FIELDS, FALSE, status);
+    for (int32_t i = 0; i < 2000; ++i) {
+        UDate date = start + i * 1234.5;
+        UnicodeString expected, actual;
+        expectedFormat.format(date, expected);
+        gCachedFormat->format(date, actual);
+        if (expected != actual) {
+            errln(UnicodeString("thread ") + threadNum + ": expected " + expected + ", got " + actual);
+            return;
+        }
+    }
+}
+
+void DateFormatTest::TestFormatCachedFieldsThreads() {
+    IcuTestErrorCode status(*this, "TestFormatCachedFieldsThreads");
+    SimpleDateFormat sdf(u"yyyy-MM-dd HH:mm:ss.SSS a", Locale::getEnglish(), status);
+    if (status.errDataIfFailureAndReset()) { return; }
+    sdf.adoptTimeZone(TimeZone::createTimeZone(u"Europe/Berlin"));
+    sdf.setBooleanAttribute(UDAT_FORMAT_CACHE_FIELDS, TRUE, status);
+    gCachedFormat = &sdf;
+    ThreadPool<DateFormatTest> threads(this, 8, &DateFormatTest::threadFuncFormatCachedFields);
+    threads.start();
+    threads.join();
+    gCachedFormat = NULL;
+}
+
+void DateFormatTest::TestFormatCivilTime() {
+    // Formatting a UDate computes Gregorian fields without the Calendar;
+    // the result must be the same as formatting through the Calendar.
+    IcuTestErrorCode status(*this, "TestFormatCivilTime");
+    static const char* const locales[] = {
+        "en", "de", "fr@fw=wed", "en@calendar=iso8601", "ar", "ja@calendar=japanese"};
+    static const char16_t* const patterns[] = {
+        u"GGGG y yy yyyy u U r MMMM LLL d D F EEEE e c a h H k K m s SSS",
+        u"Y-'W'ww-e w W YYYY",
+        u"QQQ qqq g A Z VVVV",
+    };
+    // Dates from the Gregorian cutover to 2300, in steps of 61 days and 3:35:24.25
+    // (the first few fall back to the Calendar), and around recent new years.
+    const UDate start = -12219292800000.0;  // 1582-10-15T00:00Z
+    const double step = 61 * 86400000.0 + 12924250.0;
+    const int32_t stepCount = 4000;
+    LocalPointer<TimeZone> zone(TimeZone::createTimeZone(u"America/Los_Angeles"));
+
+    for (int32_t li = 0; li < UPRV_LENGTHOF(locales); li++) {
+        for (int32_t pi = 0; pi < UPRV_LENGTHOF(patterns); pi++) {
+            SimpleDateFormat sdf(patterns[pi], Locale(locales[li]), status);
+            if (status.errDataIfFailureAndReset("locale %s", locales[li])) {
+                continue;
+            }
+            sdf.setTimeZone(*zone);
+            LocalPointer<Calendar> cal(sdf.getCalendar()->clone());
+            for (int32_t i = 0; i < stepCount + 100; i++) {
+                UDate date = (i < stepCount) ? start + i * step
+                                             : 1514764800000.0 + (i - stepCount - 50) * 33300000.0;
+                UnicodeString expected, actual;
+                FieldPositionIterator expectedFields, actualFields;
+                cal->setTime(date, status);
+                sdf.format(*cal, expected, &expectedFields, status);
+                sdf.format(date, actual, &actualFields, status);
+                if (status.errIfFailureAndReset("%s pattern %d date %d", locales[li], (int)pi, (int)i)) {
+                    continue;
+                }
+                if (expected != actual || !(expectedFields == actualFields)) {
+                    errln(UnicodeString("locale ") + locales[li] + " pattern " + patterns[pi] +
+                          " date " + date + ": expected " + expected + " got " + actual);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Week rules set on the calendar are used
+    SimpleDateFormat sdf(u"YYYY-'W'ww-e", Locale::getEnglish(), status);
+    if (status.errDataIfFailureAndReset()) { return; }
+    sdf.setTimeZone(*TimeZone::getGMT());
+    UDate date = 1514764800000.0;  // 2018-01-01T00:00Z, a Monday
+    UnicodeString actual;
+    assertEquals("US weeks", u"2018-W01-2", sdf.format(date, actual));
+    Calendar* cal = const_cast<Calendar*>(sdf.getCalendar());
+    cal->setFirstDayOfWeek(UCAL_MONDAY);
+    cal->setMinimalDaysInFirstWeek(4);
+    assertEquals("ISO weeks", u"2018-W01-1", sdf.format(date, actual.remove()));
+    assertEquals("ISO weeks, previous year", u"2017-W52-7", sdf.format(date - 1, actual.remove()));
+}
+
+void DateFormatTest::TestParseNumericFields() {
+    // Parsing a UDate scans the digits of numeric patterns directly;
+    // the result must be the same as parsing into a cleared Calendar.
+    IcuTestErrorCode status(*this, "TestParseNumericFields");
+    static const char16_t* const patterns[] = {
+        u"yyyy-MM-dd HH:mm:ss.SSS",
+        u"yyyyMMddHHmmss",
+        u"dd/MM/yyyy'T'kk:mm:ss.S",
+        u"yyy-M-d H:m:s.SSSSSS",
+        u"HH:mm",
+        u"yy-MM-dd HH:mm",  // not supported
+    };
+    static const char16_t* const texts[] = {
+        u"2018-03-11 02:30:00.000",  // skipped in New York
+        u"2018-11-04 01:30:00.000",  // repeated in New York
+        u"2018-10-07 02:15:00.000",  // 30 minutes skipped on Lord Howe Island
+        u"2018-07-04 09:05:03.007",
+        u"1583-01-01 00:00:00.000",
+        u"2000-02-29 23:59:59.999",
+        u"2001-02-29 12:00:00.000",
+        u"2018-13-01 12:00:00.000",
+        u"2018-00-10 12:00:00.000",
+        u"2018-01-00 12:00:00.000",
+        u"2018-07-04 24:00:00.000",
+        u"2018-07-04 12:60:00.000",
+        u"2018-07-04 12:00:60.000",
+        u"2018-07-04 12:00:00.00",
+        u"2018-07-04 12:00:00.0000",
+        u"2018-07-04 12:00:00.1E3",
+        u"2018-07-04 12:00:00.123 GMT",
+        u"2018-07-04  12:00:00.123",
+        u"2018-7-4 12:00:00.123",
+        u"02018-07-04 12:00:00.123",
+        u"20180704120000",
+        u"201807041200001",
+        u"2018070412000",
+        u"04/07/2018T24:00:00.5",
+        u"04/07/2018T00:00:00.5",
+        u"04/07/2018T12:00:00.5\u00A0",
+        u"2018-7-4 9:5:3.000007",
+        u"018-7-4 9:5:3.123456",
+        u"11:42",
+        u"11:42:00",
+        u"1:42",
+        u"18-07-04 11:42",
+        u"",
+    };
+    static const char16_t* const zones[] = {u"America/New_York", u"Australia/Lord_Howe", u"Etc/GMT-14"};
+    static const UCalendarWallTimeOption options[][2] = {
+        // Repeated, skipped
+        {UCAL_WALLTIME_LAST, UCAL_WALLTIME_LAST},
+        {UCAL_WALLTIME_FIRST, UCAL_WALLTIME_FIRST},
+        {UCAL_WALLTIME_LAST, UCAL_WALLTIME_NEXT_VALID},
+    };
+
+    for (int32_t pi = 0; pi < UPRV_LENGTHOF(patterns); pi++) {
+        SimpleDateFormat sdf(patterns[pi], Locale::getEnglish(), status);
+        if (status.errDataIfFailureAndReset()) {
+            return;
+        }
+        for (int32_t zi = 0; zi < UPRV_LENGTHOF(zones); zi++) {
+            sdf.adoptTimeZone(TimeZone::createTimeZone(zones[zi]));
+            for (int32_t oi = 0; oi < UPRV_LENGTHOF(options) * 2; oi++) {
+                sdf.setLenient(oi < UPRV_LENGTHOF(options));
+                Calendar* cal = const_cast<Calendar*>(sdf.getCalendar());
+                cal->setRepeatedWallTimeOption(options[oi % UPRV_LENGTHOF(options)][0]);
+                cal->setSkippedWallTimeOption(options[oi % UPRV_LENGTHOF(options)][1]);
+                for (int32_t ti = 0; ti < UPRV_LENGTHOF(texts); ti++) {
+                    UnicodeString text = UnicodeString(texts[ti]).unescape();
+                    for (int32_t start = 0; start <= 1; start++) {
+                        // Same as DateFormat::parse(text, pos) without the fast path
+                        LocalPointer<Calendar> expectedCal(sdf.getCalendar()->clone());
+                        expectedCal->clear();
+                        ParsePosition expectedPos(start);
+                        sdf.parse(text, *expectedCal, expectedPos);
+                        UErrorCode ec = U_ZERO_ERROR;
+                        UDate expected = (expectedPos.getIndex() != start) ? expectedCal->getTime(ec) : 0;
+                        if (U_FAILURE(ec)) {
+                            expectedPos.setIndex(start);
+                            expected = 0;
+                        }
+
+                        ParsePosition actualPos(start);
+                        UDate actual = sdf.parse(text, actualPos);
+                        if (expected != actual || expectedPos.getIndex() != actualPos.getIndex()) {
+                            errln(UnicodeString("pattern ") + patterns[pi] + " zone " + zones[zi] +
+                                  " option " + oi + " text \"" + text + "\" start " + start +
+                                  ": expected " + expected + " at " + expectedPos.getIndex() +
+                                  ", got " + actual + " at " + actualPos.getIndex());
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Round trip of formatted dates
+    SimpleDateFormat sdf(u"yyyy-MM-dd'T'HH:mm:ss.SSS", Locale::getEnglish(), status);
+    if (status.errDataIfFailureAndReset()) {
+        return;
+    }
+    LocalPointer<TimeZone> zone(TimeZone::createTimeZone(u"Europe/London"));
+    sdf.setTimeZone(*zone);
+    for (int32_t i = 0; i < 1000; i++) {
+        UDate date = 1514764800000.0 + i * 31234567.0;  // from 2018-01-01T00:00Z
+        UnicodeString text;
+        sdf.format(date, text);
+        UDate parsed = sdf.parse(text, status);
+        // The repeated hour parses as the later time by default
+        if (status.errIfFailureAndReset() || (parsed != date && parsed != date + 3600000.0)) {
+            errln(UnicodeString("round trip of ") + text + ": got " + parsed + " for " + date);
+        }
+    }
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
 
 //eof
@@ -262,6 +262,12 @@ class DateFormatTest: public CalendarTimeZoneTest {
     void TestMinuteSecondFieldsInOddPlaces();
     void TestDayPeriodParsing();
     void TestParseRegression13744();
+    void TestFormatCompiledPattern();
+    void TestFormatCachedFields();
+    void TestFormatCachedFieldsThreads();
+    void threadFuncFormatCachedFields(int32_t threadNum);
+    void TestFormatCivilTime();
+    void TestParseNumericFields();
 
 private:
     UBool showParse(DateFormat &format, const UnicodeString &formattedString);
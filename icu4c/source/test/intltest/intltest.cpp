@@ -40,6 +40,7 @@
 #include "itmajor.h"
 #include "mutex.h"
 #include "putilimp.h" // for uprv_getRawUTCtime()
+#include "testutil.h"
 #include "uassert.h"
 #include "udbgutil.h"
 #include "umutex.h"
@@ -1401,6 +1402,8 @@ main(int argc, char* argv[])
         defaultDataFound = TRUE;
     }
     u_cleanup();
+    // u_cleanup() removes heap functions, and ICU holds no memory at this point.
+    AllocationCounter::install(errorCode);
     if(utf8) {
       ucnv_setDefaultName("utf-8");
     }
@@ -72,6 +72,9 @@ class NumberFormatterApiTest : public IntlTest {
     void errors();
     void validRanges();
     void copyMove();
+    void compile();
+    void compileThreadFunc(int32_t threadNumber);
+    void formatToBuffer();
     void localPointerCAPI();
 
     void runIndexedTest(int32_t index, UBool exec, const char *&name, char *par = 0);
@@ -122,6 +125,7 @@ class DecimalQuantityTest : public IntlTest {
     void testCopyMove();
     void testAppend();
     void testConvertToAccurateDouble();
+    void testShortestDoubleDigits();
     void testUseApproximateDoubleWhenAble();
     void testHardDoubleConversion();
     void testToDouble();
@@ -223,6 +227,7 @@ class NumberParserTest : public IntlTest {
     void testAffixPatternMatcher();
     void testGroupingDisabled();
     void testCaseFolding();
+    void testSimpleNumbers();
 
     void runIndexedTest(int32_t index, UBool exec, const char *&name, char *par = 0);
 };
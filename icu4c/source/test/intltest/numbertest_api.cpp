@@ -14,6 +14,8 @@
 #include "number_types.h"
 #include "number_utils.h"
 #include "numbertest.h"
+#include "simplethread.h"
+#include "testutil.h"
 #include "unicode/utypes.h"
 
 // Horrible workaround for the lack of a status code in the constructor...
@@ -88,6 +90,8 @@ void NumberFormatterApiTest::runIndexedTest(int32_t index, UBool exec, const cha
         TESTCASE_AUTO(errors);
         TESTCASE_AUTO(validRanges);
         TESTCASE_AUTO(copyMove);
+        TESTCASE_AUTO(compile);
+        TESTCASE_AUTO(formatToBuffer);
         TESTCASE_AUTO(localPointerCAPI);
     TESTCASE_AUTO_END;
 }
@@ -2408,6 +2412,164 @@ void NumberFormatterApiTest::copyMove() {
     assertEquals("FormattedNumber move assignment", u"20%", result.toString());
 }
 
+static const LocalizedNumberFormatter *gCompileFormatter = nullptr;
+
+void NumberFormatterApiTest::compileThreadFunc(int32_t /*threadNumber*/) {
+    IcuTestErrorCode status(*this, "compileThreadFunc");
+    for (int32_t i = 0; i < 100; i++) {
+        gCompileFormatter->compile(status);
+        assertEquals("Format while compiling", u"1,234.5%",
+                     gCompileFormatter->formatDouble(1234.5, status).toString());
+    }
+}
+
+void NumberFormatterApiTest::compile() {
+    IcuTestErrorCode status(*this, "compile");
+
+    LocalizedNumberFormatter l1 = NumberFormatter::withLocale("en").unit(NoUnit::percent());
+    l1.compile(status);
+    status.errIfFailureAndReset();
+    assertEquals("Compiled", INT32_MIN, l1.getCallCount());
+    assertTrue("Compiled", l1.getCompiled() != nullptr);
+    assertEquals("Compiled behavior", u"10%", l1.formatInt(10, status).toString());
+    const number::impl::NumberFormatterImpl* compiled = l1.getCompiled();
+    l1.compile(status);
+    assertTrue("Compiling again has no effect", l1.getCompiled() == compiled);
+
+    // After some calls
+    LocalizedNumberFormatter l2 = NumberFormatter::withLocale("en").unit(NoUnit::percent()).threshold(3);
+    l2.formatInt(10, status);
+    l2.formatInt(10, status);
+    assertEquals("Not yet compiled", 2, l2.getCallCount());
+    l2.compile(status);
+    assertEquals("Compiled after calls", INT32_MIN, l2.getCallCount());
+    assertTrue("Compiled after calls", l2.getCompiled() != nullptr);
+    assertEquals("Compiled after calls behavior", u"10%", l2.formatInt(10, status).toString());
+
+    // A threshold of zero prevents compilation only by use
+    LocalizedNumberFormatter l3 = NumberFormatter::withLocale("en").unit(NoUnit::percent()).threshold(0);
+    l3.formatInt(10, status);
+    assertTrue("Threshold zero", l3.getCompiled() == nullptr);
+    l3.compile(status);
+    assertTrue("Threshold zero, compiled", l3.getCompiled() != nullptr);
+    assertEquals("Threshold zero behavior", u"10%", l3.formatInt(10, status).toString());
+
+    // Copies and moves
+    LocalizedNumberFormatter l4 = l1;
+    assertTrue("Copy is not compiled", l4.getCompiled() == nullptr);
+    LocalizedNumberFormatter l5 = std::move(l1);
+    assertTrue("Move stays compiled", l5.getCompiled() == compiled);
+    status.errIfFailureAndReset();
+
+    // Errors in the setter chain
+    LocalizedNumberFormatter l6 = NumberFormatter::withLocale("en").precision(Precision::fixedFraction(1000));
+    UErrorCode localStatus = U_ZERO_ERROR;
+    l6.compile(localStatus);
+    assertEquals("Error in the setter chain", U_NUMBER_ARG_OUTOFBOUNDS_ERROR, localStatus);
+    assertTrue("Error, not compiled", l6.getCompiled() == nullptr);
+
+    // Concurrent compile and format
+    LocalizedNumberFormatter l7 = NumberFormatter::withLocale("en").unit(NoUnit::percent());
+    gCompileFormatter = &l7;
+    ThreadPool<NumberFormatterApiTest> threads(this, 8, &NumberFormatterApiTest::compileThreadFunc);
+    threads.start();
+    threads.join();
+    gCompileFormatter = nullptr;
+    assertEquals("Compiled by threads", INT32_MIN, l7.getCallCount());
+}
+
+void NumberFormatterApiTest::formatToBuffer() {
+    IcuTestErrorCode status(*this, "formatToBuffer");
+    static const char16_t* const skeletons[] = {
+            u"",
+            u"percent",
+            u"currency/EUR unit-width-iso-code",
+            u"scientific precision-integer",
+            u"compact-short",
+            u"measure-unit/length-meter unit-width-full-name",
+            u"precision-increment/0.05 sign-always",
+            u"group-off decimal-always"};
+    static const char* const locales[] = {"en", "de", "ar", "hi"};
+    static const double values[] = {0.0, -0.0, 1.5, -1234.5678, 3.14159265358979, 1e-7, 987654321.25, 1e12};
+
+    for (auto skeleton : skeletons) {
+        for (auto locale : locales) {
+            LocalizedNumberFormatter f = NumberFormatter::forSkeleton(skeleton, status).locale(locale);
+            if (status.errDataIfFailureAndReset()) { return; }
+            for (double value : values) {
+                char16_t buffer[64];
+                char buffer8[128];
+                UnicodeString message = UnicodeString(skeleton) + u" " + UnicodeString(locale, -1, US_INV) + u" " + DoubleToUnicodeString(value);
+                UnicodeString expected = f.formatDouble(value, status).toString();
+                int32_t length = f.formatDoubleToBuffer(value, buffer, 64, status);
+                assertEquals(message, expected, UnicodeString(buffer, length));
+                assertEquals(message + u" NUL", 0, buffer[length]);
+                length = f.formatDoubleToUTF8(value, buffer8, 128, status);
+                std::string expected8;
+                expected.toUTF8String(expected8);
+                assertEquals(message + u" UTF-8", expected8.c_str(), std::string(buffer8, length).c_str());
+
+                auto intValue = static_cast<int64_t>(value);
+                expected = f.formatInt(intValue, status).toString();
+                length = f.formatIntToBuffer(intValue, buffer, 64, status);
+                assertEquals(message + u" int", expected, UnicodeString(buffer, length));
+                length = f.formatIntToUTF8(intValue, buffer8, 128, status);
+                expected8.clear();
+                expected.toUTF8String(expected8);
+                assertEquals(message + u" int UTF-8", expected8.c_str(), std::string(buffer8, length).c_str());
+            }
+            status.errIfFailureAndReset();
+        }
+    }
+
+    // Preflighting and overflow
+    LocalizedNumberFormatter f = NumberFormatter::withLocale("en");
+    char16_t buffer[8];
+    UErrorCode localStatus = U_ZERO_ERROR;
+    assertEquals("Preflight", 9, f.formatIntToBuffer(1234567, nullptr, 0, localStatus));
+    assertEquals("Preflight status", U_BUFFER_OVERFLOW_ERROR, localStatus);
+    localStatus = U_ZERO_ERROR;
+    assertEquals("Overflow", 9, f.formatIntToBuffer(1234567, buffer, 8, localStatus));
+    assertEquals("Overflow status", U_BUFFER_OVERFLOW_ERROR, localStatus);
+    localStatus = U_ZERO_ERROR;
+    assertEquals("Exact fit", 5, f.formatIntToBuffer(1234, buffer, 5, localStatus));
+    assertEquals("Exact fit status", U_STRING_NOT_TERMINATED_WARNING, localStatus);
+    localStatus = U_ZERO_ERROR;
+    assertEquals("UTF-8 preflight", 9, f.formatIntToUTF8(1234567, nullptr, 0, localStatus));
+    assertEquals("UTF-8 preflight status", U_BUFFER_OVERFLOW_ERROR, localStatus);
+    localStatus = U_ZERO_ERROR;
+    f.formatDoubleToBuffer(1.5, nullptr, 5, localStatus);
+    assertEquals("Null buffer", U_ILLEGAL_ARGUMENT_ERROR, localStatus);
+    localStatus = U_ZERO_ERROR;
+    f.formatDoubleToUTF8(1.5, reinterpret_cast<char*>(buffer), -1, localStatus);
+    assertEquals("Negative capacity", U_ILLEGAL_ARGUMENT_ERROR, localStatus);
+    localStatus = U_ZERO_ERROR;
+    LocalizedNumberFormatter bad = NumberFormatter::withLocale("en").precision(Precision::fixedFraction(1000));
+    assertEquals("Setter chain error", 0, bad.formatDoubleToBuffer(1.5, buffer, 8, localStatus));
+    assertEquals("Setter chain error status", U_NUMBER_ARG_OUTOFBOUNDS_ERROR, localStatus);
+
+    // No heap allocation after the first call
+    if (!AllocationCounter::isInstalled()) {
+        logln("Allocation counting is not available, skipping the heap use checks");
+        return;
+    }
+    for (auto skeleton : skeletons) {
+        LocalizedNumberFormatter f2 = NumberFormatter::forSkeleton(skeleton, status).locale("de");
+        char16_t buffer16[64];
+        char buffer8[128];
+        f2.formatDoubleToBuffer(1.5, buffer16, 64, status);
+        AllocationCounter counter;
+        for (double value : values) {
+            f2.formatDoubleToBuffer(value, buffer16, 64, status);
+            f2.formatDoubleToUTF8(value, buffer8, 128, status);
+            f2.formatIntToBuffer(static_cast<int64_t>(value), buffer16, 64, status);
+            f2.formatIntToUTF8(static_cast<int64_t>(value), buffer8, 128, status);
+        }
+        assertEquals(UnicodeString(u"Heap allocations: ") + skeleton, 0, counter.count());
+        status.errIfFailureAndReset();
+    }
+}
+
 void NumberFormatterApiTest::localPointerCAPI() {
     // NOTE: This is also the sample code in unumberformatter.h
     UErrorCode ec = U_ZERO_ERROR;
@@ -11,6 +11,9 @@
 #include <cmath>
 #include "number_utils.h"
 #include "numbertest.h"
+#include "double-conversion.h"
+
+using icu::double_conversion::DoubleToStringConverter;
 
 void DecimalQuantityTest::runIndexedTest(int32_t index, UBool exec, const char *&name, char *) {
     if (exec) {
@@ -22,6 +25,7 @@ void DecimalQuantityTest::runIndexedTest(int32_t index, UBool exec, const char *
         TESTCASE_AUTO(testCopyMove);
         TESTCASE_AUTO(testAppend);
         TESTCASE_AUTO(testConvertToAccurateDouble);
+        TESTCASE_AUTO(testShortestDoubleDigits);
         TESTCASE_AUTO(testUseApproximateDoubleWhenAble);
         TESTCASE_AUTO(testHardDoubleConversion);
         TESTCASE_AUTO(testToDouble);
@@ -278,6 +282,53 @@ void DecimalQuantityTest::testConvertToAccurateDouble() {
     }
 }
 
+void DecimalQuantityTest::testShortestDoubleDigits() {
+    IcuTestErrorCode status(*this, "testShortestDoubleDigits");
+
+    // Short decimals take a different path than other doubles; compare both with DoubleToAscii.
+    for (int32_t i = 0; i < 20000; i++) {
+        double d;
+        if (i % 2 == 0) {
+            int64_t mantissa = 1 + rand() % 9;
+            for (int32_t j = rand() % 17; j > 0; j--) {
+                mantissa = mantissa * 10 + rand() % 10;
+            }
+            char input[40];
+            sprintf(input, "%lldE%d", static_cast<long long>(mantissa), rand() % 60 - 40);
+            d = atof(input);
+        } else {
+            uint8_t bytes[8];
+            for (int32_t j = 0; j < 8; j++) {
+                bytes[j] = static_cast<uint8_t>(rand() % 256);
+            }
+            uprv_memcpy(&d, bytes, 8);
+            d = std::fabs(d);
+        }
+        if (std::isnan(d) || !std::isfinite(d) || d == 0) { continue; }
+
+        char buffer[DoubleToStringConverter::kBase10MaximalLength + 1];
+        bool sign;
+        int32_t length;
+        int32_t point;
+        DoubleToStringConverter::DoubleToAscii(
+                d, DoubleToStringConverter::DtoaMode::SHORTEST, 0, buffer, sizeof(buffer),
+                &sign, &length, &point);
+        char expectedString[40];
+        sprintf(expectedString, "%.*sE%d", static_cast<int>(length), buffer, point - length);
+        DecimalQuantity expected;
+        expected.setToDecNumber(expectedString, status);
+
+        DecimalQuantity fq;
+        fq.setToDouble(d);
+        fq.roundToInfinity();
+        assertEquals(
+                UnicodeString(expectedString, -1, US_INV),
+                expected.toScientificString(),
+                fq.toScientificString());
+        assertHealth(fq);
+    }
+}
+
 void DecimalQuantityTest::testUseApproximateDoubleWhenAble() {
     static const struct TestCase {
         double d;
@@ -25,6 +25,7 @@ void NumberParserTest::runIndexedTest(int32_t index, UBool exec, const char*& na
         TESTCASE_AUTO(testSeriesMatcher);
         TESTCASE_AUTO(testCombinedCurrencyMatcher);
         TESTCASE_AUTO(testAffixPatternMatcher);
+        TESTCASE_AUTO(testSimpleNumbers);
     TESTCASE_AUTO_END;
 }
 
@@ -351,4 +352,76 @@ void NumberParserTest::testAffixPatternMatcher() {
 }
 
 
+void NumberParserTest::testSimpleNumbers() {
+    IcuTestErrorCode status(*this, "testSimpleNumbers");
+
+    // Plain numbers take a fast path in greedy parsing. Compare each result with the full parse,
+    // which runs when the input is followed by a character that is not part of the number.
+    static const struct TestCase {
+        const char* localeName;
+        const char16_t* patternString;
+    } cases[] = {{"en", u"#,##0.###"},
+                 {"en", u"0.###"},
+                 {"en", u"#,##0.###;(#,##0.###)"},
+                 {"en_IN", u"#,##,##0.###"},
+                 {"de", u"#,##0.###"},
+                 {"fr", u"#,##0.###"},
+                 {"ar", u"#,##0.###"}};
+    // Written with en symbols, and localized below.
+    static const char16_t* inputs[] = {
+            u"0", u"7", u"007", u"-0", u"-5", u"1234", u"1,234", u"12,345,678", u"1,234.5", u"-1,234.5",
+            u"0.50", u"1.", u".5", u"-", u"1,23", u"1,2345", u"12,34,567", u"1234,567", u"1,234,",
+            u",123", u"1,,234", u"1.234.5", u"1,234.5,6", u"1.5e3", u"999999999999999999",
+            u"9999999999999999999", u"123456789012.345678", u"123,456,789,012.3456789",
+            u"0.000000000000000001"};
+
+    parse_flags_t flagSets[] = {
+            PARSE_FLAG_IGNORE_CASE | PARSE_FLAG_INCLUDE_UNPAIRED_AFFIXES,
+            PARSE_FLAG_STRICT_GROUPING_SIZE | PARSE_FLAG_STRICT_SEPARATORS | PARSE_FLAG_USE_FULL_AFFIXES,
+            PARSE_FLAG_INTEGER_ONLY | PARSE_FLAG_INCLUDE_UNPAIRED_AFFIXES,
+            PARSE_FLAG_GROUPING_DISABLED | PARSE_FLAG_INCLUDE_UNPAIRED_AFFIXES};
+    for (auto& cas : cases) {
+        Locale locale(cas.localeName);
+        DecimalFormatSymbols symbols(locale, status);
+        UnicodeString grouping = symbols.getSymbol(DecimalFormatSymbols::kGroupingSeparatorSymbol);
+        UnicodeString decimal = symbols.getSymbol(DecimalFormatSymbols::kDecimalSeparatorSymbol);
+        for (parse_flags_t parseFlags : flagSets) {
+            LocalPointer<const NumberParserImpl> parser(
+                    NumberParserImpl::createSimpleParser(locale, cas.patternString, parseFlags, status));
+            if (status.errDataIfFailureAndReset("createSimpleParser() failed")) {
+                continue;
+            }
+            for (const char16_t* input : inputs) {
+                UnicodeString inputString;
+                for (const char16_t* p = input; *p != 0; p++) {
+                    if (*p == u',') {
+                        inputString.append(grouping);
+                    } else if (*p == u'.') {
+                        inputString.append(decimal);
+                    } else {
+                        inputString.append(*p);
+                    }
+                }
+                UnicodeString message = UnicodeString(cas.localeName, -1, US_INV) + u" " +
+                        cas.patternString + u" <" + inputString + u"> flags " + Int64ToUnicodeString(parseFlags);
+
+                ParsedNumber actual;
+                parser->parse(inputString, true, actual, status);
+                ParsedNumber expected;
+                parser->parse(inputString + u"x", true, expected, status);
+
+                assertEquals(message, expected.success(), actual.success());
+                assertEquals(message, expected.charEnd, actual.charEnd);
+                assertEquals(message, expected.flags, actual.flags);
+                assertEquals(message, expected.quantity.bogus, actual.quantity.bogus);
+                if (!expected.quantity.bogus) {
+                    assertEquals(message, expected.quantity.toString(), actual.quantity.toString());
+                }
+                assertEquals(message, expected.prefix, actual.prefix);
+                assertEquals(message, expected.suffix, actual.suffix);
+            }
+        }
+    }
+}
+
 #endif
@@ -217,6 +217,7 @@ void NumberFormatTest::runIndexedTest( int32_t index, UBool exec, const char* &n
   TESTCASE_AUTO(Test13804_EmptyStringsWhenParsing);
   TESTCASE_AUTO(Test13840_ParseLongStringCrash);
   TESTCASE_AUTO(Test13850_EmptyStringCurrency);
+  TESTCASE_AUTO(TestParseDoubles);
   TESTCASE_AUTO_END;
 }
 
@@ -9207,4 +9208,120 @@ void NumberFormatTest::Test13850_EmptyStringCurrency() {
     assertEquals("Should unset the currency on nullptr", u"XXX\u00A01.00", actual);
 }
 
+void NumberFormatTest::TestParseDoubles() {
+    IcuTestErrorCode status(*this, "TestParseDoubles");
+
+    static const char16_t* const inputs[] = {
+        u"1234", u"-1,234.5", u"1.234,5", u"12 345", u"1 234,5", u"1 234,5",
+        u"١٢٣٫٤", u"", u"abc", u"12abc", u"-0", u"1E3", u"∞",
+        u"NaN", u"50%", u"12345678901234567890.5", u"  42", u"😀", u"0.000001"};
+    static const int32_t count = UPRV_LENGTHOF(inputs);
+    static const char* const locales[] = {"en", "de", "fr", "ar", "en", "en"};
+
+    for (int32_t l = 0; l < UPRV_LENGTHOF(locales); l++) {
+        UnicodeString message = UnicodeString("locale ") + locales[l] + " variant " + Int64ToUnicodeString(l);
+        LocalPointer<DecimalFormat> df(
+            dynamic_cast<DecimalFormat*>(NumberFormat::createInstance(locales[l], status)));
+        if (status.errDataIfFailureAndReset()) { return; }
+        if (l == 4) {
+            df->setParseIntegerOnly(TRUE);
+        } else if (l == 5) {
+            df->setLenient(FALSE);
+        }
+
+        // Expected values: one parse() per cell
+        UnicodeString texts[count];
+        double expected[count];
+        int32_t expectedEnds[count];
+        UBool expectedSuccess[count];
+        Formattable expectedFormattables[count];
+        int32_t expectedSuccessCount = 0;
+        for (int32_t i = 0; i < count; i++) {
+            texts[i] = inputs[i];
+            ParsePosition ppos(0);
+            df->parse(texts[i], expectedFormattables[i], ppos);
+            expectedSuccess[i] = ppos.getErrorIndex() == -1 && ppos.getIndex() > 0;
+            if (expectedSuccess[i]) {
+                expected[i] = expectedFormattables[i].getDouble(status);
+                expectedEnds[i] = ppos.getIndex();
+                expectedSuccessCount++;
+            } else {
+                expected[i] = 0.0;
+                expectedEnds[i] = uprv_max(ppos.getErrorIndex(), 0);
+                expectedFormattables[i].setLong(0);
+            }
+        }
+
+        double results[count];
+        int32_t parseEnds[count];
+        UErrorCode cellStatus[count];
+        int32_t successCount = df->parseDoubles(
+            inputs, nullptr, count, results, parseEnds, cellStatus, status);
+        assertEquals(message + " parseDoubles success count", expectedSuccessCount, successCount);
+        for (int32_t i = 0; i < count; i++) {
+            UnicodeString cellMessage = message + u" parseDoubles \"" + texts[i] + u"\"";
+            assertTrue(cellMessage + " value",
+                uprv_memcmp(&expected[i], &results[i], sizeof(double)) == 0);
+            assertEquals(cellMessage + " end", expectedEnds[i], parseEnds[i]);
+            assertEquals(cellMessage + " status",
+                expectedSuccess[i] ? U_ZERO_ERROR : U_PARSE_ERROR, cellStatus[i]);
+        }
+
+        // UTF-8 cells, with explicit lengths and with a trailing ill-formed byte
+        std::string utf8[count];
+        const char* utf8Texts[count];
+        int32_t utf8Lengths[count];
+        for (int32_t i = 0; i < count; i++) {
+            texts[i].toUTF8String(utf8[i]);
+            utf8[i] += "\xFF" "1";
+            utf8Texts[i] = utf8[i].data();
+            utf8Lengths[i] = static_cast<int32_t>(utf8[i].length());
+        }
+        successCount = df->parseDoublesUTF8(
+            utf8Texts, utf8Lengths, count, results, parseEnds, cellStatus, status);
+        assertEquals(message + " parseDoublesUTF8 success count", expectedSuccessCount, successCount);
+        for (int32_t i = 0; i < count; i++) {
+            UnicodeString cellMessage = message + u" parseDoublesUTF8 \"" + texts[i] + u"\"";
+            std::string expectedPrefix;
+            texts[i].tempSubString(0, expectedEnds[i]).toUTF8String(expectedPrefix);
+            assertTrue(cellMessage + " value",
+                uprv_memcmp(&expected[i], &results[i], sizeof(double)) == 0);
+            assertEquals(cellMessage + " end",
+                static_cast<int32_t>(expectedPrefix.length()), parseEnds[i]);
+            assertEquals(cellMessage + " status",
+                expectedSuccess[i] ? U_ZERO_ERROR : U_PARSE_ERROR, cellStatus[i]);
+        }
+
+        Formattable formattables[count];
+        successCount = df->parseNumbers(texts, count, formattables, nullptr, cellStatus, status);
+        assertEquals(message + " parseNumbers success count", expectedSuccessCount, successCount);
+        for (int32_t i = 0; i < count; i++) {
+            UnicodeString cellMessage = message + u" parseNumbers \"" + texts[i] + u"\"";
+            if (expectedFormattables[i].getType() == Formattable::kDouble
+                    && uprv_isNaN(expectedFormattables[i].getDouble())) {
+                assertTrue(cellMessage, uprv_isNaN(formattables[i].getDouble(status)));
+                continue;
+            }
+            assertTrue(cellMessage + " type", expectedFormattables[i].getType() == formattables[i].getType());
+            assertEquals(cellMessage + " decimal",
+                expectedFormattables[i].getDecimalNumber(status).data(),
+                formattables[i].getDecimalNumber(status).data());
+        }
+    }
+
+    // Argument errors
+    LocalPointer<DecimalFormat> df(
+        dynamic_cast<DecimalFormat*>(NumberFormat::createInstance("en", status)));
+    if (status.errDataIfFailureAndReset()) { return; }
+    double result;
+    assertEquals("Negative count", 0,
+        df->parseDoubles(inputs, nullptr, -1, &result, nullptr, nullptr, status));
+    assertEquals("Negative count status", U_ILLEGAL_ARGUMENT_ERROR, status.reset());
+    assertEquals("Missing results", 0,
+        df->parseDoubles(inputs, nullptr, 1, nullptr, nullptr, nullptr, status));
+    assertEquals("Missing results status", U_ILLEGAL_ARGUMENT_ERROR, status.reset());
+    assertEquals("Empty column", 0,
+        df->parseDoubles(nullptr, nullptr, 0, nullptr, nullptr, nullptr, status));
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
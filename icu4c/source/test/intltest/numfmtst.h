@@ -281,6 +281,7 @@ class NumberFormatTest: public CalendarTimeZoneTest {
     void Test13804_EmptyStringsWhenParsing();
     void Test13840_ParseLongStringCrash();
     void Test13850_EmptyStringCurrency();
+    void TestParseDoubles();
 
  private:
     UBool testFormattableAsUFormattable(const char *file, int line, Formattable &f);
@@ -29,6 +29,7 @@
 #endif
 #include "unicode/schriter.h"
 #include "unicode/uchar.h"
+#include "unicode/ucharstriebuilder.h"
 #include "unicode/utf16.h"
 #include "unicode/ucnv.h"
 #include "unicode/uniset.h"
@@ -39,12 +40,14 @@
 #include "charstr.h"
 #include "cmemory.h"
 #include "cstr.h"
+#include "dictionarydata.h"
 #include "intltest.h"
 #include "rbbitst.h"
 #include "rbbidata.h"
 #include "utypeinfo.h"  // for 'typeid' to work
 #include "uvector.h"
 #include "uvectr32.h"
+#include "unewdata.h"
 
 
 #if !UCONFIG_NO_FILTERED_BREAK_ITERATION
@@ -114,6 +117,10 @@ void RBBITest::runIndexedTest( int32_t index, UBool exec, const char* &name, cha
     TESTCASE_AUTO(TestBug13447);
     TESTCASE_AUTO(TestReverse);
     TESTCASE_AUTO(TestBug13692);
+    TESTCASE_AUTO(TestPartitions);
+    TESTCASE_AUTO(TestUserDictionary);
+    TESTCASE_AUTO(TestLazyCaches);
+    TESTCASE_AUTO(TestDictionaryBestPath);
     TESTCASE_AUTO_END;
 }
 
@@ -4561,6 +4568,351 @@ void RBBITest::TestBug13692() {
     assertSuccess(WHERE, status);
 }
 
+//  TestPartitions   Check that breaking the text one partition at a time, each
+//                   with its own clone of the break iterator, gives the same
+//                   boundaries as a single pass over the whole text.
+
+void RBBITest::TestPartitions() {
+    UErrorCode status = U_ZERO_ERROR;
+    UnicodeString text;
+    static const UChar *lines[] = {
+        u"The quick brown fox jumped over the lazy dog.\n",
+        u"การทดลองภาษาไทย\r\n",
+        u"日本語の文章です。 ",
+        u"  Leading spaces; (parens) and \"quotes\" 1,234.56 $7\r",
+        u"Mr. Smith went to Washington. He said \"Hi.\"  ",
+        u"\r\n",
+        u"¿¿Qué? 12.5% ¡¡Olé!! \u000C"
+    };
+    icu_rand randomGen;
+    for (int i=0; i<300; ++i) {
+        text.append(lines[randomGen() % UPRV_LENGTHOF(lines)], -1);
+    }
+
+    LocalPointer<RuleBasedBreakIterator> bi((RuleBasedBreakIterator *)
+            BreakIterator::createLineInstance(Locale::getEnglish(), status), status);
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    TestPartitions(bi.getAlias(), text);
+    bi.adoptInstead((RuleBasedBreakIterator *)BreakIterator::createWordInstance(Locale::getEnglish(), status));
+    if (assertSuccess(WHERE, status)) {
+        TestPartitions(bi.getAlias(), text);
+    }
+    bi.adoptInstead((RuleBasedBreakIterator *)BreakIterator::createSentenceInstance(Locale::getEnglish(), status));
+    if (assertSuccess(WHERE, status)) {
+        TestPartitions(bi.getAlias(), text);
+    }
+
+    // Text with no hard breaks is a single partition.
+    UnicodeString shortText(u"One sentence. Two sentences.");
+    bi->setText(shortText);
+    int32_t start = -1;
+    assertEquals(WHERE, 1, bi->getPartitions(5, &start, 1, status));
+    assertEquals(WHERE, 0, start);
+
+    // Argument checking.
+    bi->getPartitions(0, &start, 1, status);
+    assertEquals(WHERE, U_ILLEGAL_ARGUMENT_ERROR, status);
+    status = U_ZERO_ERROR;
+    bi->getBoundaries(5, 4, NULL, 0, status);
+    assertEquals(WHERE, U_ILLEGAL_ARGUMENT_ERROR, status);
+}
+
+void RBBITest::TestPartitions(RuleBasedBreakIterator *bi, const UnicodeString &text) {
+    UErrorCode status = U_ZERO_ERROR;
+    bi->setText(text);
+    std::vector<int32_t> expected;
+    for (int32_t pos = bi->next(); pos != UBRK_DONE; pos = bi->next()) {
+        expected.push_back(pos);
+    }
+
+    int32_t numPartitions = bi->getPartitions(200, NULL, 0, status);
+    assertEquals(WHERE, U_BUFFER_OVERFLOW_ERROR, status);
+    assertTrue(WHERE, numPartitions > 10);
+    status = U_ZERO_ERROR;
+    std::vector<int32_t> partitionStarts(numPartitions);
+    assertEquals(WHERE, numPartitions, bi->getPartitions(200, partitionStarts.data(), numPartitions, status));
+    assertSuccess(WHERE, status);
+    assertEquals(WHERE, 0, bi->current());
+    partitionStarts.push_back(text.length());
+
+    std::vector<int32_t> merged;
+    for (int32_t i=0; i<numPartitions; ++i) {
+        int32_t start = partitionStarts[i];
+        int32_t limit = partitionStarts[i+1];
+        if (i < numPartitions - 1) {
+            assertTrue(WHERE, limit - start >= 200);
+        }
+        LocalPointer<RuleBasedBreakIterator> clone((RuleBasedBreakIterator *)bi->clone());
+        int32_t count = clone->getBoundaries(start, limit, NULL, 0, status);
+        status = U_ZERO_ERROR;
+        std::vector<int32_t> boundaries(count);
+        assertEquals(WHERE, count, clone->getBoundaries(start, limit, boundaries.data(), count, status));
+        assertSuccess(WHERE, status);
+        if (count > 0) {
+            assertEquals(WHERE, limit, boundaries[count-1]);
+        }
+        merged.insert(merged.end(), boundaries.begin(), boundaries.end());
+    }
+    assertTrue(WHERE, expected == merged);
+}
+
+//  TestUserDictionary   Register dictionaries from files in the format written
+//                       by gendict, and replace them while a break iterator is in use.
+
+static void writeUserDictionary(const char *name, const UnicodeString &words, const uint8_t dataFormat[4],
+                                UErrorCode &status) {
+    UCharsTrieBuilder builder(status);
+    for (int32_t start = 0; start < words.length();) {
+        int32_t end = words.indexOf((UChar)0x20, start);
+        if (end < 0) {
+            end = words.length();
+        }
+        builder.add(words.tempSubStringBetween(start, end), 0, status);
+        start = end + 1;
+    }
+    UnicodeString trie;
+    builder.buildUnicodeString(USTRINGTRIE_BUILD_SMALL, trie, status);
+
+    UDataInfo dataInfo = {
+        sizeof(UDataInfo), 0, U_IS_BIG_ENDIAN, U_CHARSET_FAMILY, U_SIZEOF_UCHAR, 0,
+        { dataFormat[0], dataFormat[1], dataFormat[2], dataFormat[3] },
+        { 1, 0, 0, 0 }, { 0, 0, 0, 0 }
+    };
+    UNewDataMemory *pData = udata_create(NULL, "dict", name, &dataInfo, NULL, &status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    int32_t indexes[DictionaryData::IX_COUNT] = {
+        DictionaryData::IX_COUNT * sizeof(int32_t), 0, 0, 0, 0, 0, 0, 0
+    };
+    int32_t size = trie.length() * U_SIZEOF_UCHAR + indexes[DictionaryData::IX_STRING_TRIE_OFFSET];
+    indexes[DictionaryData::IX_RESERVED1_OFFSET] = size;
+    indexes[DictionaryData::IX_RESERVED2_OFFSET] = size;
+    indexes[DictionaryData::IX_TOTAL_SIZE] = size;
+    indexes[DictionaryData::IX_TRIE_TYPE] = DictionaryData::TRIE_TYPE_UCHARS;
+    indexes[DictionaryData::IX_TRANSFORM] = DictionaryData::TRANSFORM_NONE;
+    udata_writeBlock(pData, indexes, sizeof(indexes));
+    udata_writeBlock(pData, trie.getBuffer(), trie.length() * U_SIZEOF_UCHAR);
+    udata_finish(pData, &status);
+}
+
+// Copy the first length bytes of a dictionary file to another one.
+static void truncateUserDictionary(const char *from, const char *to, int32_t length, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    std::vector<char> bytes(length);
+    FILE *in = fopen(from, "rb");
+    FILE *out = fopen(to, "wb");
+    if (in == NULL || out == NULL ||
+            fread(bytes.data(), 1, length, in) != (size_t)length ||
+            fwrite(bytes.data(), 1, length, out) != (size_t)length) {
+        status = U_FILE_ACCESS_ERROR;
+    }
+    if (in != NULL) {
+        fclose(in);
+    }
+    if (out != NULL) {
+        fclose(out);
+    }
+}
+
+static std::vector<int32_t> getBoundaries(BreakIterator *bi, const UnicodeString &text) {
+    std::vector<int32_t> boundaries;
+    bi->setText(text);
+    for (int32_t pos = bi->first(); pos != UBRK_DONE; pos = bi->next()) {
+        boundaries.push_back(pos);
+    }
+    return boundaries;
+}
+
+void RBBITest::TestUserDictionary() {
+    static const uint8_t dictFormat[4] = { 0x44, 0x69, 0x63, 0x74 };    // "Dict"
+    static const uint8_t otherFormat[4] = { 0x54, 0x65, 0x73, 0x74 };   // "Test"
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<BreakIterator> bi(BreakIterator::createWordInstance(Locale("th"), status), status);
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    const UnicodeString w1(u"กขค"), w2(u"ฆงจฉ"), w3(u"ชซฌ");
+    const UnicodeString text = w1 + w2 + w3;
+    const std::vector<int32_t> builtIn = getBoundaries(bi.getAlias(), text);
+
+    writeUserDictionary("rbbitst_user_a", w1 + u" " + w2 + u" " + w3, dictFormat, status);
+    writeUserDictionary("rbbitst_user_b", w1 + w2 + u" " + w3, dictFormat, status);
+    writeUserDictionary("rbbitst_user_c", w1, otherFormat, status);
+    if (!assertSuccess(WHERE, status)) {
+        return;
+    }
+
+    RuleBasedBreakIterator::registerDictionary(USCRIPT_THAI, "rbbitst_user_a.dict", status);
+    assertSuccess(WHERE, status);
+    std::vector<int32_t> expected = { 0, 3, 7, 10 };
+    assertTrue(WHERE, expected == getBoundaries(bi.getAlias(), text));
+
+    // Replace the dictionary while the break iterator, and a clone of it, hold the old one.
+    LocalPointer<BreakIterator> clone(bi->clone());
+    RuleBasedBreakIterator::registerDictionary(USCRIPT_THAI, "rbbitst_user_b.dict", status);
+    assertSuccess(WHERE, status);
+    expected = { 0, 7, 10 };
+    assertTrue(WHERE, expected == getBoundaries(bi.getAlias(), text));
+    assertTrue(WHERE, expected == getBoundaries(clone.getAlias(), text));
+
+    assertTrue(WHERE, RuleBasedBreakIterator::unregisterDictionary(USCRIPT_THAI, status));
+    assertFalse(WHERE, RuleBasedBreakIterator::unregisterDictionary(USCRIPT_THAI, status));
+    assertSuccess(WHERE, status);
+    assertTrue(WHERE, builtIn == getBoundaries(bi.getAlias(), text));
+    assertTrue(WHERE, builtIn == getBoundaries(clone.getAlias(), text));
+
+    // Error handling. None of these changes the registration.
+    RuleBasedBreakIterator::registerDictionary(USCRIPT_LATIN, "rbbitst_user_a.dict", status);
+    assertEquals(WHERE, U_ILLEGAL_ARGUMENT_ERROR, status);
+    status = U_ZERO_ERROR;
+    RuleBasedBreakIterator::registerDictionary(USCRIPT_THAI, "rbbitst_no_such_file.dict", status);
+    assertEquals(WHERE, U_FILE_ACCESS_ERROR, status);
+    status = U_ZERO_ERROR;
+    RuleBasedBreakIterator::registerDictionary(USCRIPT_THAI, "rbbitst_user_c.dict", status);
+    assertEquals(WHERE, U_INVALID_FORMAT_ERROR, status);
+    status = U_ZERO_ERROR;
+
+    // Truncated files: within the data header, within the indexes, and within the trie.
+    // The header of a file written by udata_create() is 32 bytes long.
+    static const int32_t truncatedLengths[] = { 16, 40, 72 };
+    for (int32_t length : truncatedLengths) {
+        truncateUserDictionary("rbbitst_user_a.dict", "rbbitst_user_d.dict", length, status);
+        if (!assertSuccess(WHERE, status)) {
+            break;
+        }
+        RuleBasedBreakIterator::registerDictionary(USCRIPT_THAI, "rbbitst_user_d.dict", status);
+        assertEquals(WHERE, U_INVALID_FORMAT_ERROR, status);
+        status = U_ZERO_ERROR;
+    }
+    assertFalse(WHERE, RuleBasedBreakIterator::unregisterDictionary(USCRIPT_THAI, status));
+    assertSuccess(WHERE, status);
+
+    remove("rbbitst_user_a.dict");
+    remove("rbbitst_user_b.dict");
+    remove("rbbitst_user_c.dict");
+    remove("rbbitst_user_d.dict");
+}
+
+//  TestLazyCaches   A break iterator that has only been moved forward has no break cache.
+//                   Check that it gives the same results as one that does, and that
+//                   switching to random access part way through the text works.
+
+void RBBITest::TestLazyCaches() {
+    UErrorCode status = U_ZERO_ERROR;
+    const UnicodeString text(u"Hello, world. \"Quoted\" 12.5%. การทดลองภาษาไทย 日本語の文章です。 Done! ");
+    LocalPointer<BreakIterator> word(BreakIterator::createWordInstance(Locale::getEnglish(), status), status);
+    LocalPointer<BreakIterator> line(BreakIterator::createLineInstance(Locale::getEnglish(), status), status);
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    BreakIterator *prototypes[] = { word.getAlias(), line.getAlias() };
+    for (BreakIterator *proto : prototypes) {
+        // Expected boundaries and rule status values, from the last boundary backwards,
+        // so that the break cache is used throughout.
+        proto->setText(text);
+        std::vector<int32_t> boundaries;
+        std::vector<int32_t> statuses;
+        for (int32_t pos = proto->last(); pos != UBRK_DONE; pos = proto->previous()) {
+            boundaries.insert(boundaries.begin(), pos);
+            statuses.insert(statuses.begin(), proto->getRuleStatus());
+        }
+        int32_t count = (int32_t)boundaries.size();
+
+        for (int32_t i = 0; i < count; ++i) {
+            LocalPointer<BreakIterator> bi(proto->clone());
+            bi->setText(text);
+            assertEquals(WHERE, 0, bi->first());
+            for (int32_t j = 1; j <= i; ++j) {
+                assertEquals(WHERE, boundaries[j], bi->next());
+                assertEquals(WHERE, statuses[j], bi->getRuleStatus());
+            }
+            // Switch to random access.
+            if (i > 0) {
+                assertEquals(WHERE, boundaries[i-1], bi->previous());
+                assertEquals(WHERE, statuses[i-1], bi->getRuleStatus());
+                assertEquals(WHERE, boundaries[i], bi->next());
+            }
+            assertEquals(WHERE, i + 1 < count ? boundaries[i+1] : UBRK_DONE, bi->next());
+            assertEquals(WHERE, i + 1 < count ? boundaries[i+1] : text.length(), bi->current());
+        }
+
+        // Forward iteration, running off the end, then backing up.
+        LocalPointer<BreakIterator> bi(proto->clone());
+        bi->setText(text);
+        int32_t pos;
+        while ((pos = bi->next()) != UBRK_DONE) {}
+        assertEquals(WHERE, UBRK_DONE, bi->next());
+        assertEquals(WHERE, text.length(), bi->current());
+        assertEquals(WHERE, boundaries[count-2], bi->previous());
+        assertEquals(WHERE, boundaries[1], bi->following(0));
+    }
+}
+
+//  TestDictionaryBestPath   Dictionary text divided up by the default heuristic, and
+//                           by the best-path search of setDictionaryBestPath().
+
+void RBBITest::TestDictionaryBestPath() {
+    static const uint8_t dictFormat[4] = { 0x44, 0x69, 0x63, 0x74 };    // "Dict"
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<RuleBasedBreakIterator> bi(
+        (RuleBasedBreakIterator *)BreakIterator::createWordInstance(Locale("th"), status), status);
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    assertFalse(WHERE, bi->getDictionaryBestPath());
+
+    // With these words, the longest first word is followed by two more words, but the
+    // text after them is not in the dictionary. Shorter words cover all of the text.
+    writeUserDictionary("rbbitst_best_path", u"กข กขค คฆ ฆง งจ จฉ ฉช", dictFormat, status);
+    RuleBasedBreakIterator::registerDictionary(USCRIPT_THAI, "rbbitst_best_path.dict", status);
+    if (!assertSuccess(WHERE, status)) {
+        return;
+    }
+    const UnicodeString text(u"กขคฆงจฉช");
+    const std::vector<int32_t> heuristic = { 0, 3, 5, 8 };
+    const std::vector<int32_t> bestPath = { 0, 2, 4, 6, 8 };
+    assertTrue(WHERE, heuristic == getBoundaries(bi.getAlias(), text));
+
+    bi->setDictionaryBestPath(TRUE);
+    assertTrue(WHERE, bi->getDictionaryBestPath());
+    assertTrue(WHERE, bestPath == getBoundaries(bi.getAlias(), text));
+
+    // Changing the setting starts over at the beginning of the text.
+    bi->setText(text);
+    bi->last();
+    bi->setDictionaryBestPath(FALSE);
+    assertEquals(WHERE, 0, bi->current());
+    assertEquals(WHERE, 3, bi->next());
+    bi->setDictionaryBestPath(TRUE);
+    assertEquals(WHERE, 2, bi->next());
+    assertEquals(WHERE, 8, bi->last());
+    assertEquals(WHERE, 6, bi->previous());
+
+    // The setting is copied with the break iterator.
+    LocalPointer<BreakIterator> clone(bi->clone());
+    assertTrue(WHERE, bestPath == getBoundaries(clone.getAlias(), text));
+    RuleBasedBreakIterator copy(*bi);
+    assertTrue(WHERE, copy.getDictionaryBestPath());
+
+    // Code points outside of the dictionary stay together, and combining
+    // marks stay with the code points before them.
+    const UnicodeString unmatched(u"กขฎฏคฆ\u0E48งจ");
+    const std::vector<int32_t> unmatchedBestPath = { 0, 2, 4, 7, 9 };
+    assertTrue(WHERE, unmatchedBestPath == getBoundaries(bi.getAlias(), unmatched));
+
+    bi->setDictionaryBestPath(FALSE);
+    assertTrue(WHERE, heuristic == getBoundaries(bi.getAlias(), text));
+
+    RuleBasedBreakIterator::unregisterDictionary(USCRIPT_THAI, status);
+    assertSuccess(WHERE, status);
+    remove("rbbitst_best_path.dict");
+}
+
 //
 //  TestDebug    -  A place-holder test for debugging purposes.
 //                  For putting in fragments of other tests that can be invoked
@@ -82,6 +82,11 @@ class RBBITest: public IntlTest {
     void TestReverse();
     void TestReverse(std::unique_ptr<RuleBasedBreakIterator>bi);
     void TestBug13692();
+    void TestPartitions();
+    void TestPartitions(RuleBasedBreakIterator *bi, const UnicodeString &text);
+    void TestUserDictionary();
+    void TestLazyCaches();
+    void TestDictionaryBestPath();
 
     void TestDebug();
     void TestProperties();
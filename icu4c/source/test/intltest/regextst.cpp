@@ -28,6 +28,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <string>
 
 #include "unicode/localpointer.h"
 #include "unicode/regex.h"
@@ -39,6 +40,7 @@
 #include "unicode/ustring.h"
 #include "unicode/utext.h"
 #include "unicode/utf16.h"
+#include "unicode/utf8.h"
 #include "cstr.h"
 #include "regextst.h"
 #include "regexcmp.h"
@@ -47,6 +49,8 @@
 #include "cmemory.h"
 #include "cstring.h"
 #include "uinvchar.h"
+#include "simplethread.h"
+#include "testutil.h"
 
 #define SUPPORT_MUTATING_INPUT_STRING   0
 
@@ -104,6 +108,14 @@ void RegexTest::runIndexedTest( int32_t index, UBool exec, const char* &name, ch
     TESTCASE_AUTO(TestBug12884);
     TESTCASE_AUTO(TestBug13631);
     TESTCASE_AUTO(TestBug13632);
+    TESTCASE_AUTO(TestDFAMatchEngine);
+    TESTCASE_AUTO(TestRegexSet);
+    TESTCASE_AUTO(TestLiteralSearch);
+    TESTCASE_AUTO(TestUTF8Input);
+    TESTCASE_AUTO(TestBinaryPattern);
+    TESTCASE_AUTO(TestMemoizeBacktracking);
+    TESTCASE_AUTO(TestMatcherPool);
+    TESTCASE_AUTO(TestStackReserve);
     TESTCASE_AUTO_END;
 }
 
@@ -5851,4 +5863,978 @@ void RegexTest::TestBug13632() {
     uregex_close(re);
 }
 
+//
+//  TestDFAMatchEngine   Patterns that need no backtracking are normally run by the lazy DFA
+//                       engine. Check that it produces exactly the results of the
+//                       backtracking engine, for find(), lookingAt(), matches() and hitEnd(),
+//                       with UnicodeString and UTF-8 input and with regions.
+//
+
+// Compare the results of two matchers, one with the DFA disabled, over the current input.
+// Returns FALSE on the first mismatch.
+static UBool compareDFAMatchers(RegexMatcher &dfa, RegexMatcher &bt, UnicodeString &why) {
+    UErrorCode status = U_ZERO_ERROR;
+    for (int32_t i = 0; ; ++i) {
+        UBool found = dfa.find(status);
+        if (found != bt.find(status)) {
+            why = UnicodeString("find result, iteration ") + i;
+            return FALSE;
+        }
+        if (dfa.hitEnd() != bt.hitEnd() || dfa.requireEnd() != bt.requireEnd()) {
+            why = UnicodeString("find hitEnd / requireEnd, iteration ") + i;
+            return FALSE;
+        }
+        if (!found) {
+            break;
+        }
+        for (int32_t g = 0; g <= bt.groupCount(); ++g) {
+            if (dfa.start64(g, status) != bt.start64(g, status) ||
+                    dfa.end64(g, status) != bt.end64(g, status)) {
+                why = UnicodeString("find group ") + g + ", iteration " + i;
+                return FALSE;
+            }
+        }
+    }
+    dfa.resetPreserveRegion();
+    bt.resetPreserveRegion();
+    UBool looking = dfa.lookingAt(status);
+    if (looking != bt.lookingAt(status) || dfa.hitEnd() != bt.hitEnd() ||
+            (looking && dfa.end64(status) != bt.end64(status))) {
+        why = "lookingAt";
+        return FALSE;
+    }
+    dfa.resetPreserveRegion();
+    bt.resetPreserveRegion();
+    if (dfa.matches(status) != bt.matches(status) || dfa.hitEnd() != bt.hitEnd()) {
+        why = "matches";
+        return FALSE;
+    }
+    if (U_FAILURE(status)) {
+        why = UnicodeString("status ") + u_errorName(status);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void RegexTest::TestDFAMatchEngine() {
+    static const char *const patterns[] = {
+        "abc", "a*", "a*?b", "(a|ab)(c|bcd)(d*)", "a+b+c", "(a|aa)*b", "x?y??z",
+        "[a-c]+", "[^a]+b", "\\d+(\\.\\d*)?", "\\w+@\\w+", "\\s*", "(?i)Ab+C", ".*c", "(?s).*c",
+        "(?d).b", "a.c|b", "(ab|a)(bc|c)?", "[\\u00e0-\\u00ff\\u4e00-\\u9fff]+", "\\x{1f600}+a?",
+        "(?:a|b)*?c", "(a*)*b", "(?x) a b | c", "\\p{L}\\p{Nd}", "\\R", "\\h+", "\\V\\V",
+        "\\X", "", "(a)|b", "[ab][^ab]"
+    };
+    static const char *const inputs[] = {
+        "", "a", "abc", "aababcabcd", "xxabcdxx", "aaaaaaaab", "aaaaaaaa", "12.5 and 7.",
+        "joe@example x@", "  \t \n\r\n", "AbBbBcabbc", "a\nb\rc\n\nc", "xyzxzyz",
+        "\\u00e0\\u4e00\\U0001f600\\U0001f600a\\u00ff", "baccab", "a1b22c333"
+    };
+
+    UErrorCode status = U_ZERO_ERROR;
+    for (int32_t p = 0; p < UPRV_LENGTHOF(patterns); ++p) {
+        UnicodeString pattern(patterns[p], -1, US_INV);
+        LocalPointer<RegexPattern> pat(RegexPattern::compile(pattern, 0, status));
+        REGEX_CHECK_STATUS;
+        LocalPointer<RegexMatcher> dfa(pat->matcher(status));
+        LocalPointer<RegexMatcher> bt(pat->matcher(status));
+        REGEX_CHECK_STATUS;
+        bt->setUseDFA(FALSE);
+
+        for (int32_t i = 0; i < UPRV_LENGTHOF(inputs); ++i) {
+            UnicodeString input = UnicodeString(inputs[i], -1, US_INV).unescape();
+            UnicodeString why;
+
+            // UnicodeString input, then each region.
+            dfa->reset(input);
+            bt->reset(input);
+            if (!compareDFAMatchers(*dfa, *bt, why)) {
+                errln("%s:%d: DFA mismatch, pattern /%s/, input #%d: %s", __FILE__, __LINE__,
+                      patterns[p], i, extractToAssertBuf(why));
+                continue;
+            }
+            // Regions begin and end on code point boundaries.
+            for (int32_t start = 0; start <= input.length(); ++start) {
+                if (U16_IS_TRAIL(input.charAt(start))) {
+                    continue;
+                }
+                for (int32_t limit = start; limit <= input.length(); ++limit) {
+                    if (U16_IS_TRAIL(input.charAt(limit))) {
+                        continue;
+                    }
+                    dfa->reset(input).region(start, limit, status);
+                    bt->reset(input).region(start, limit, status);
+                    REGEX_CHECK_STATUS;
+                    if (!compareDFAMatchers(*dfa, *bt, why)) {
+                        errln("%s:%d: DFA mismatch, pattern /%s/, input #%d, region [%d, %d): %s",
+                              __FILE__, __LINE__, patterns[p], i, start, limit, extractToAssertBuf(why));
+                        start = limit = input.length() + 1;
+                    }
+                }
+            }
+
+            // UTF-8 input, accessed through a UText.
+            std::string utf8;
+            input.toUTF8String(utf8);
+            UText *ut = utext_openUTF8(NULL, utf8.data(), (int64_t)utf8.length(), &status);
+            REGEX_CHECK_STATUS;
+            dfa->reset(ut);
+            bt->reset(ut);
+            if (!compareDFAMatchers(*dfa, *bt, why)) {
+                errln("%s:%d: DFA mismatch (UTF-8), pattern /%s/, input #%d: %s", __FILE__, __LINE__,
+                      patterns[p], i, extractToAssertBuf(why));
+            }
+            dfa->reset(UnicodeString());
+            bt->reset(UnicodeString());
+            utext_close(ut);
+        }
+    }
+
+    // A pattern that takes exponential time with the backtracking engine must
+    // run in linear time with the DFA engine.
+    UnicodeString text;
+    for (int32_t i = 0; i < 5000; ++i) {
+        text.append((UChar)0x61);   // 'a'
+    }
+    RegexMatcher m(UNICODE_STRING_SIMPLE("(a|aa)+(a+)+b"), text, 0, status);
+    REGEX_CHECK_STATUS;
+    REGEX_ASSERT(m.find(status) == FALSE);
+    REGEX_ASSERT(m.hitEnd());
+    REGEX_ASSERT(m.matches(status) == FALSE);
+    REGEX_CHECK_STATUS;
+}
+
+//
+//  TestRegexSet   RegexSet::findAll() must report exactly the patterns for which
+//                 RegexMatcher::find() finds a match, and the same first match positions.
+//
+void RegexTest::TestRegexSet() {
+    static const char *const patterns[] = {
+        "abc", "a+b", "(a|ab)(c|bcd)", "[0-9]+\\.[0-9]+", "x*", "\\w+@\\w+", "^abc", "c$",
+        "\\bcat\\b", "(a)\\1", "(?i)ABC", "q", "\\p{Han}+", "b.d", "(?=ab)a", "d{2,3}", "[^a-z]"
+    };
+    static const char *const inputs[] = {
+        "", "abc", "xabcdd", "version 1.25 of cat", "cathy@home", "aa", "\\u4e00\\u4e8c c",
+        "ABC", "qqq", "b\\nd"
+    };
+
+    UErrorCode status = U_ZERO_ERROR;
+    RegexSet set(status);
+    REGEX_CHECK_STATUS;
+    REGEX_ASSERT(set.size() == 0);
+    LocalPointer<RegexMatcher> matchers[UPRV_LENGTHOF(patterns)];
+    for (int32_t p = 0; p < UPRV_LENGTHOF(patterns); ++p) {
+        UnicodeString pattern(patterns[p], -1, US_INV);
+        REGEX_ASSERT(set.add(pattern, 0, status) == p);
+        matchers[p].adoptInsteadAndCheckErrorCode(new RegexMatcher(pattern, 0, status), status);
+        REGEX_CHECK_STATUS;
+    }
+    REGEX_ASSERT(set.size() == UPRV_LENGTHOF(patterns));
+    REGEX_ASSERT(set.getPattern(1)->pattern() == UNICODE_STRING_SIMPLE("a+b"));
+    REGEX_ASSERT(set.getPattern(-1) == NULL && set.getPattern(set.size()) == NULL);
+
+    for (int32_t i = 0; i < UPRV_LENGTHOF(inputs); ++i) {
+        UnicodeString input = UnicodeString(inputs[i], -1, US_INV).unescape();
+        int32_t expected[UPRV_LENGTHOF(patterns)];
+        int64_t expectedStarts[UPRV_LENGTHOF(patterns)];
+        int64_t expectedEnds[UPRV_LENGTHOF(patterns)];
+        int32_t expectedCount = 0;
+        for (int32_t p = 0; p < UPRV_LENGTHOF(patterns); ++p) {
+            matchers[p]->reset(input);
+            if (matchers[p]->find(status)) {
+                expected[expectedCount] = p;
+                expectedStarts[expectedCount] = matchers[p]->start64(status);
+                expectedEnds[expectedCount] = matchers[p]->end64(status);
+                ++expectedCount;
+            }
+        }
+        REGEX_CHECK_STATUS;
+
+        int32_t found[UPRV_LENGTHOF(patterns)];
+        int32_t count = set.findAll(input, found, UPRV_LENGTHOF(found), status);
+        REGEX_CHECK_STATUS;
+        if (count != expectedCount || uprv_memcmp(found, expected, count * sizeof(int32_t)) != 0) {
+            errln("%s:%d: RegexSet::findAll() input #%d: %d patterns found, %d expected",
+                  __FILE__, __LINE__, i, count, expectedCount);
+            continue;
+        }
+
+        // Positions, with UTF-8 input.
+        std::string utf8;
+        input.toUTF8String(utf8);
+        UText *ut = utext_openUTF8(NULL, utf8.data(), (int64_t)utf8.length(), &status);
+        int64_t starts[UPRV_LENGTHOF(patterns)];
+        int64_t ends[UPRV_LENGTHOF(patterns)];
+        count = set.findAll(ut, found, starts, ends, UPRV_LENGTHOF(found), status);
+        REGEX_CHECK_STATUS;
+        REGEX_ASSERT(count == expectedCount);
+        for (int32_t j = 0; j < count && j < expectedCount; ++j) {
+            // Map the UTF-16 positions of the expected match to UTF-8.
+            std::string prefix;
+            UnicodeString(input, 0, (int32_t)expectedStarts[j]).toUTF8String(prefix);
+            int32_t s8 = (int32_t)prefix.length();
+            UnicodeString(input, (int32_t)expectedStarts[j],
+                          (int32_t)(expectedEnds[j] - expectedStarts[j])).toUTF8String(prefix);
+            int32_t e8 = (int32_t)prefix.length();
+            if (found[j] != expected[j] || starts[j] != s8 || ends[j] != e8) {
+                errln("%s:%d: RegexSet::findAll() input #%d, pattern %d: match [%d, %d), expected [%d, %d)",
+                      __FILE__, __LINE__, i, found[j], (int)starts[j], (int)ends[j], s8, e8);
+            }
+        }
+        utext_close(ut);
+
+        // Preflighting.
+        if (expectedCount > 0) {
+            count = set.findAll(input, NULL, 0, status);
+            REGEX_ASSERT(status == U_BUFFER_OVERFLOW_ERROR && count == expectedCount);
+            status = U_ZERO_ERROR;
+        }
+    }
+
+    // Adding a pattern after matching includes it in the next findAll().
+    int32_t found[UPRV_LENGTHOF(patterns) + 1];
+    REGEX_ASSERT(set.findAll(UNICODE_STRING_SIMPLE("zzz"), found, UPRV_LENGTHOF(found), status) == 1);
+    REGEX_ASSERT(set.add(UNICODE_STRING_SIMPLE("z+"), 0, status) == UPRV_LENGTHOF(patterns));
+    REGEX_ASSERT(set.findAll(UNICODE_STRING_SIMPLE("zzz"), found, UPRV_LENGTHOF(found), status) == 2);
+    REGEX_ASSERT(found[1] == UPRV_LENGTHOF(patterns));
+    REGEX_CHECK_STATUS;
+
+    // Errors.
+    UParseError pe;
+    REGEX_ASSERT(set.add(UNICODE_STRING_SIMPLE("a(b"), 0, pe, status) == -1);
+    REGEX_ASSERT(status == U_REGEX_MISMATCHED_PAREN);
+    status = U_ZERO_ERROR;
+    REGEX_ASSERT(set.size() == UPRV_LENGTHOF(patterns) + 1);
+    set.findAll(UNICODE_STRING_SIMPLE("zzz"), NULL, 1, status);
+    REGEX_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+    status = U_ZERO_ERROR;
+
+    // Many patterns, key0=[0-9]+x ... key399=[0-9]+x, of which every seventh has a match.
+    RegexSet bigSet(status);
+    UnicodeString text;
+    for (int32_t p = 0; p < 400; ++p) {
+        UnicodeString pattern = UnicodeString("key") + p + "=[0-9]+x";
+        REGEX_ASSERT(bigSet.add(pattern, 0, status) == p);
+        if (p % 7 == 3) {
+            text.append(UnicodeString("key") + p + "=" + (p * 31) + "x ");
+        }
+    }
+    REGEX_CHECK_STATUS;
+    int32_t bigFound[400];
+    int32_t count = bigSet.findAll(text, bigFound, UPRV_LENGTHOF(bigFound), status);
+    REGEX_CHECK_STATUS;
+    // key3, key10, key17 ... key395.
+    REGEX_ASSERT(count == (400 - 3 + 6) / 7);
+    for (int32_t j = 0; j < count; ++j) {
+        REGEX_ASSERT(bigFound[j] % 7 == 3);
+    }
+}
+
+//
+//  TestLiteralSearch   find() skips over input that does not contain the literal prefix
+//                      of a pattern, or a literal string required within every match.
+//                      A find progress callback must see every position, so a matcher
+//                      with one does not skip; it provides the expected results.
+//
+
+U_CDECL_BEGIN
+static UBool U_CALLCONV
+continueFindCallback(const void * /*context*/, int64_t /*matchIndex*/) {
+    return TRUE;
+}
+U_CDECL_END
+
+void RegexTest::TestLiteralSearch() {
+    static const char *const patterns[] = {
+        "hello", "hello world", "a[bc]+xyz", "\\w+@example\\.com", "(foo|bar)baz",
+        "x(ab){0,2}yz", "x(ab){1,2}yz", "(?:abc)+d", "q\\d+q", "[a-z]+ing\\b", "z", "zz|y",
+        "\\u00e9t\\u00e9", "\\U0001f600x", "x\\U0001f600", "\\ude00", "(?i)hello", "a(?=bc)",
+        "abc|x", "(a)(b)?c\\1", "\\u4e00\\u0100+", "[^a]*?ab"
+    };
+    static const char *const inputs[] = {
+        "", "hello", "say hello world, hello", "xxabcbxyz abxyz axyz", "me@example.com x@example.org",
+        "foobaz barbaz bazbaz", "xyz xabyz xababyz xabababyz", "abcabcd abd", "q12q qq q3",
+        "singing sing ring", "\\u00e9t\\u00e9 \\u00e9t\\u00e9s",
+        "\\U0001f600x x\\U0001f600 \\ud83d\\ude00", "HeLLo hello", "abcabc", "abac aabaca",
+        "\\u4e00\\u0100\\u4e00\\u4e00\\u0100\\u0100", "zzzzzz yz"
+    };
+
+    UErrorCode status = U_ZERO_ERROR;
+    for (int32_t p = 0; p < UPRV_LENGTHOF(patterns); ++p) {
+        UnicodeString pattern(patterns[p], -1, US_INV);
+        LocalPointer<RegexPattern> pat(RegexPattern::compile(pattern, 0, status));
+        REGEX_CHECK_STATUS;
+        LocalPointer<RegexMatcher> skip(pat->matcher(status));
+        LocalPointer<RegexMatcher> skipBt(pat->matcher(status));
+        LocalPointer<RegexMatcher> all(pat->matcher(status));
+        REGEX_CHECK_STATUS;
+        skipBt->setUseDFA(FALSE);
+        all->setFindProgressCallback(continueFindCallback, NULL, status);
+        REGEX_CHECK_STATUS;
+
+        for (int32_t i = 0; i < UPRV_LENGTHOF(inputs); ++i) {
+            UnicodeString input = UnicodeString(inputs[i], -1, US_INV).unescape();
+            UnicodeString why;
+            for (int32_t start = 0; start <= input.length(); ++start) {
+                if (U16_IS_TRAIL(input.charAt(start))) {
+                    continue;
+                }
+                for (int32_t limit = start; limit <= input.length(); ++limit) {
+                    if (U16_IS_TRAIL(input.charAt(limit))) {
+                        continue;
+                    }
+                    skip->reset(input).region(start, limit, status);
+                    skipBt->reset(input).region(start, limit, status);
+                    all->reset(input).region(start, limit, status);
+                    REGEX_CHECK_STATUS;
+                    if (!compareDFAMatchers(*skip, *all, why)) {
+                        errln("%s:%d: mismatch, pattern /%s/, input #%d, region [%d, %d): %s",
+                              __FILE__, __LINE__, patterns[p], i, start, limit, extractToAssertBuf(why));
+                        start = limit = input.length() + 1;
+                        continue;
+                    }
+                    all->reset(input).region(start, limit, status);
+                    if (!compareDFAMatchers(*skipBt, *all, why)) {
+                        errln("%s:%d: mismatch (backtracking), pattern /%s/, input #%d, region [%d, %d): %s",
+                              __FILE__, __LINE__, patterns[p], i, start, limit, extractToAssertBuf(why));
+                        start = limit = input.length() + 1;
+                    }
+                }
+            }
+            // find(start) restarts the search for the required string.
+            skip->reset(input);
+            all->reset(input);
+            for (int32_t start = input.length(); start >= 0; --start) {
+                if (U16_IS_TRAIL(input.charAt(start))) {
+                    continue;
+                }
+                UBool found = skip->find(start, status);
+                if (found != all->find(start, status) ||
+                        (found && skip->start(status) != all->start(status))) {
+                    errln("%s:%d: find(%d) mismatch, pattern /%s/, input #%d",
+                          __FILE__, __LINE__, start, patterns[p], i);
+                    break;
+                }
+            }
+            REGEX_CHECK_STATUS;
+        }
+    }
+
+    // A required string that occurs only at the end of a long input.
+    UnicodeString text;
+    for (int32_t i = 0; i < 10000; ++i) {
+        text.append(u"abcdefgh ", -1);
+    }
+    text.append(u"tail-marker", -1);
+    RegexMatcher m(UNICODE_STRING_SIMPLE("\\w+-marker"), text, 0, status);
+    REGEX_CHECK_STATUS;
+    REGEX_ASSERT(m.find(status));
+    REGEX_ASSERT(m.start(status) == text.length() - 11);
+    REGEX_ASSERT(!m.find(status));
+    REGEX_CHECK_STATUS;
+}
+
+
+//
+//  TestUTF8Input   Matching reads a UText from utext_openUTF8() directly, with native
+//                  indexes that are byte offsets. The results must be those for the
+//                  same text in a UnicodeString, with ill-formed sequences read as U+FFFD.
+//
+void RegexTest::TestUTF8Input() {
+    static const char *const patterns[] = {
+        "\\w+", "(?i)stra(ss|\\u00df)e", "(?<=a)b+", "\\X", "(\\w)\\1", "(?i)(\\w+) \\1",
+        "\\bx\\b", "[^a-z ]+", ".", "a\\R?b", "\\p{L}+(?=\\d)", "(?<!x)y", "\\uFFFD+",
+        "(?m)^\\S+$", "e\\u0301+"
+    };
+    static const char *const inputs[] = {
+        "Stra\xc3\x9f" "e strasse STRASSE",
+        "ab\xf0\x9f\x98\x80" "bb aab abab",
+        "x\xe2\x82\xacy \xffy \xe2\x82y xy",
+        "e\xcc\x81\xcc\x81 a\r\nb a\nb ab x",
+        "\xed\xa0\x80 xx \xc0\xaf yy",
+        "aa bb \xce\xb1\xce\xb1 \xf4\x90\x80\x80 \xce\xb1" "1",
+        "\xe2\x82"
+    };
+
+    UErrorCode status = U_ZERO_ERROR;
+    for (int32_t i = 0; i < UPRV_LENGTHOF(inputs); ++i) {
+        // Decode the input the way the UText does, and map UTF-16 indexes to byte offsets.
+        const char *s8 = inputs[i];
+        int32_t length8 = (int32_t)uprv_strlen(s8);
+        UnicodeString input;
+        int32_t nativeIndex[100];
+        for (int32_t i8 = 0; i8 < length8;) {
+            int32_t start8 = i8;
+            UChar32 c;
+            U8_NEXT_OR_FFFD(s8, i8, length8, c);
+            for (int32_t u = input.append(c).length() - U16_LENGTH(c); u < input.length(); ++u) {
+                nativeIndex[u] = start8;
+            }
+        }
+        nativeIndex[input.length()] = length8;
+        LocalUTextPointer text8(utext_openUTF8(NULL, s8, length8, &status));
+        REGEX_CHECK_STATUS;
+
+        for (int32_t p = 0; p < UPRV_LENGTHOF(patterns); ++p) {
+            UnicodeString pattern(patterns[p], -1, US_INV);
+            LocalPointer<RegexPattern> pat(RegexPattern::compile(pattern, 0, status));
+            REGEX_CHECK_STATUS;
+            LocalPointer<RegexMatcher> expected(pat->matcher(input, status));
+            LocalPointer<RegexMatcher> dfa(pat->matcher(status));
+            LocalPointer<RegexMatcher> backtrack(pat->matcher(status));
+            REGEX_CHECK_STATUS;
+            expected->setUseDFA(FALSE);
+            backtrack->setUseDFA(FALSE);
+            dfa->reset(text8.getAlias());
+            backtrack->reset(text8.getAlias());
+
+            RegexMatcher *matchers[] = { dfa.getAlias(), backtrack.getAlias() };
+            for (int32_t m = 0; m < UPRV_LENGTHOF(matchers); ++m) {
+                RegexMatcher &actual = *matchers[m];
+                expected->reset();
+                int32_t numMatches = 0;
+                for (;;) {
+                    UBool found = expected->find(status);
+                    if (actual.find(status) != found) {
+                        errln("%s:%d: pattern /%s/, input #%d, match #%d: find() differs",
+                              __FILE__, __LINE__, patterns[p], i, numMatches);
+                        break;
+                    }
+                    REGEX_CHECK_STATUS;
+                    if (!found) {
+                        break;
+                    }
+                    for (int32_t g = 0; g <= expected->groupCount(); ++g) {
+                        int32_t start = expected->start(g, status);
+                        int32_t end = expected->end(g, status);
+                        if (actual.start64(g, status) != (start < 0 ? -1 : nativeIndex[start]) ||
+                                actual.end64(g, status) != (end < 0 ? -1 : nativeIndex[end])) {
+                            errln("%s:%d: pattern /%s/, input #%d, match #%d: group %d is [%d, %d), expected [%d, %d)",
+                                  __FILE__, __LINE__, patterns[p], i, numMatches, g,
+                                  (int32_t)actual.start64(g, status), (int32_t)actual.end64(g, status),
+                                  start < 0 ? -1 : nativeIndex[start], end < 0 ? -1 : nativeIndex[end]);
+                        }
+                    }
+                    ++numMatches;
+                }
+                REGEX_CHECK_STATUS;
+
+                // matches() and lookingAt() over regions between code point boundaries.
+                for (int32_t start = 0; start <= input.length(); ++start) {
+                    if (U16_IS_TRAIL(input.charAt(start))) {
+                        continue;
+                    }
+                    for (int32_t limit = start; limit <= input.length(); ++limit) {
+                        if (U16_IS_TRAIL(input.charAt(limit))) {
+                            continue;
+                        }
+                        expected->region(start, limit, status);
+                        actual.region(nativeIndex[start], nativeIndex[limit], status);
+                        if (expected->matches(status) != actual.matches(status) ||
+                                expected->lookingAt(status) != actual.lookingAt(status) ||
+                                (expected->lookingAt(status) &&
+                                    nativeIndex[expected->end(status)] != actual.end64(status))) {
+                            errln("%s:%d: pattern /%s/, input #%d, region [%d, %d): matches() or lookingAt() differs",
+                                  __FILE__, __LINE__, patterns[p], i, start, limit);
+                            start = limit = input.length() + 1;
+                        }
+                    }
+                }
+                REGEX_CHECK_STATUS;
+                actual.reset();
+            }
+        }
+    }
+}
+
+
+//
+//  TestBinaryPattern   RegexPattern::cloneBinary() and createFromBinary().
+//                      A pattern recreated from its binary form must match as the
+//                      original does, and have the same binary form.
+//
+void RegexTest::TestBinaryPattern() {
+    static const struct {
+        const char *pattern;
+        uint32_t    flags;
+    } patterns[] = {
+        { "abc", 0 },
+        { "[a-z]+ing\\b", 0 },
+        { "(?<year>\\d{4})-(?<month>\\d\\d)", 0 },
+        { "(\\w+)\\s+\\1", UREGEX_CASE_INSENSITIVE },
+        { "^\\s*(\\p{Lu}[^.]*)\\.$", UREGEX_MULTILINE },
+        { "(?<=\\$)\\d+(\\.\\d\\d)?", 0 },
+        { "(?<!x)[\\u00e0-\\u00ff\\U0001f600-\\U0001f64f]{2,}", 0 },
+        { "a.*?z|\\X", UREGEX_DOTALL },
+        { "(?i)stra(ss|\\u00df)e", 0 },
+        { "x+(?=y)|[^\\p{L}\\s]+", UREGEX_UWORD },
+        { "a.b", UREGEX_LITERAL | UREGEX_CASE_INSENSITIVE }
+    };
+    static const char *const inputs[] = {
+        "abc abcd xabc", "singing sing ring", "2018-07 and 1999-12-31", "the The cat cat",
+        "  Hello world.\nnot this.\nYes.", "$12.50 and $3", "\\u00e0\\u00e9 \\U0001f600\\U0001f601 x\\u00e0\\u00e0",
+        "abz a\nz e\\u0301", "STRASSE stra\\u00dfe", "xxy 12-34 a.b A.B"
+    };
+
+    UErrorCode status = U_ZERO_ERROR;
+    for (int32_t p = 0; p < UPRV_LENGTHOF(patterns); ++p) {
+        UnicodeString pattern(patterns[p].pattern, -1, US_INV);
+        LocalPointer<RegexPattern> pat(RegexPattern::compile(pattern, patterns[p].flags, status));
+        REGEX_CHECK_STATUS;
+
+        int32_t length = pat->cloneBinary(NULL, 0, status);
+        REGEX_ASSERT(status == U_BUFFER_OVERFLOW_ERROR);
+        REGEX_ASSERT(length > 0 && length % 8 == 0);
+        status = U_ZERO_ERROR;
+        MaybeStackArray<uint64_t, 256> buffer(length / 8);
+        uint8_t *bin = (uint8_t *)buffer.getAlias();
+        REGEX_ASSERT(pat->cloneBinary(bin, length - 1, status) == length);
+        REGEX_ASSERT(status == U_BUFFER_OVERFLOW_ERROR);
+        status = U_ZERO_ERROR;
+        REGEX_ASSERT(pat->cloneBinary(bin, length, status) == length);
+        REGEX_CHECK_STATUS;
+
+        LocalPointer<RegexPattern> fromBin(RegexPattern::createFromBinary(bin, length, status));
+        REGEX_CHECK_STATUS;
+        REGEX_ASSERT(*fromBin == *pat);
+        REGEX_ASSERT(fromBin->pattern() == pat->pattern());
+        REGEX_ASSERT(fromBin->flags() == pat->flags());
+
+        // The binary form of the recreated pattern, and of a copy of it, is the same.
+        LocalPointer<RegexPattern> copy(fromBin->clone());
+        MaybeStackArray<uint64_t, 256> buffer2(length / 8);
+        REGEX_ASSERT(copy->cloneBinary((uint8_t *)buffer2.getAlias(), length, status) == length);
+        REGEX_CHECK_STATUS;
+        REGEX_ASSERT(uprv_memcmp(bin, buffer2.getAlias(), length) == 0);
+        // The pattern does not alias the binary data.
+        uprv_memset(bin, 0, length);
+
+        if (pattern.startsWith(u"(?<year>", -1)) {
+            REGEX_ASSERT(fromBin->groupNumberFromName(UnicodeString(u"month"), status) == 2);
+            REGEX_CHECK_STATUS;
+        }
+        LocalPointer<RegexMatcher> expected(pat->matcher(status));
+        LocalPointer<RegexMatcher> actual(fromBin->matcher(status));
+        LocalPointer<RegexMatcher> actualCopy(copy->matcher(status));
+        REGEX_CHECK_STATUS;
+        for (int32_t i = 0; i < UPRV_LENGTHOF(inputs); ++i) {
+            UnicodeString input = UnicodeString(inputs[i], -1, US_INV).unescape();
+            expected->reset(input);
+            actual->reset(input);
+            actualCopy->reset(input);
+            int32_t numMatches = 0;
+            for (;;) {
+                UBool found = expected->find(status);
+                if (actual->find(status) != found || actualCopy->find(status) != found) {
+                    errln("%s:%d: pattern /%s/, input #%d, match #%d: find() differs",
+                          __FILE__, __LINE__, patterns[p].pattern, i, numMatches);
+                    break;
+                }
+                if (!found) {
+                    break;
+                }
+                for (int32_t g = 0; g <= expected->groupCount(); ++g) {
+                    if (actual->start(g, status) != expected->start(g, status) ||
+                            actual->end(g, status) != expected->end(g, status)) {
+                        errln("%s:%d: pattern /%s/, input #%d, match #%d: group %d differs",
+                              __FILE__, __LINE__, patterns[p].pattern, i, numMatches, g);
+                    }
+                }
+                ++numMatches;
+            }
+            REGEX_CHECK_STATUS;
+        }
+    }
+
+    // Data that is not the binary form of a pattern.
+    LocalPointer<RegexPattern> pat(RegexPattern::compile(u"a[bc]+", 0, status));
+    REGEX_CHECK_STATUS;
+    uint64_t buffer[200];
+    uint8_t *bin = (uint8_t *)buffer;
+    int32_t length = pat->cloneBinary(bin, (int32_t)sizeof(buffer), status);
+    REGEX_CHECK_STATUS;
+    LocalPointer<RegexPattern> bad(RegexPattern::createFromBinary(bin, length - 8, status));
+    REGEX_ASSERT(status == U_INVALID_FORMAT_ERROR && bad.isNull());
+    status = U_ZERO_ERROR;
+    bad.adoptInstead(RegexPattern::createFromBinary(bin, 16, status));
+    REGEX_ASSERT(status == U_INVALID_FORMAT_ERROR && bad.isNull());
+    status = U_ZERO_ERROR;
+    bad.adoptInstead(RegexPattern::createFromBinary(NULL, length, status));
+    REGEX_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR && bad.isNull());
+    status = U_ZERO_ERROR;
+    bin[0] ^= 1;
+    bad.adoptInstead(RegexPattern::createFromBinary(bin, length, status));
+    REGEX_ASSERT(status == U_INVALID_FORMAT_ERROR && bad.isNull());
+    status = U_ZERO_ERROR;
+    bin[0] ^= 1;
+    // A corrupted byte in the header, which holds the scalar fields and the locations
+    //   of the tables, is either rejected or yields a pattern that can be used.
+    //   The compiled code itself is checked only for references to data that does not exist.
+    pat.adoptInstead(RegexPattern::compile(u"(?<n>a[bc]+){2,3}?(?<!x)\\1\\w*", 0, status));
+    REGEX_CHECK_STATUS;
+    length = pat->cloneBinary(bin, (int32_t)sizeof(buffer), status);
+    REGEX_CHECK_STATUS;
+    UnicodeString input(u"xabcbcabcbc abbab");
+    static const uint8_t masks[] = { 0x01, 0x5a, 0x80, 0xff };
+    for (int32_t i = 0; i < 64; ++i) {
+        for (int32_t m = 0; m < UPRV_LENGTHOF(masks); ++m) {
+            bin[i] ^= masks[m];
+            bad.adoptInstead(RegexPattern::createFromBinary(bin, length, status));
+            if (U_SUCCESS(status)) {
+                LocalPointer<RegexMatcher> matcher(bad->matcher(input, status));
+                while (U_SUCCESS(status) && matcher->find(status)) {}
+            }
+            status = U_ZERO_ERROR;
+            bin[i] ^= masks[m];
+        }
+    }
+    bad.adoptInstead(RegexPattern::createFromBinary(bin, length, status));
+    REGEX_CHECK_STATUS;
+}
+
+
+//
+//  TestMemoizeBacktracking   RegexMatcher::setMemoizeBacktracking().
+//                            Memoization must not change the results of any match
+//                            operation, and must keep patterns that take exponential
+//                            time without it from doing so.
+//
+void RegexTest::TestMemoizeBacktracking() {
+    static const char *const patterns[] = {
+        "(a+)+b", "(a|aa)*b", "(x+x+)+y", "^(\\w+\\s?)*$", "(\\w+\\s?)+\\.", "(a|ab)(c|bcd)(d*)",
+        "\\b(\\w+)(,\\s*\\w+)*;", "[a-z]*?ing", ".*(\\d+)x", "(?m)^(a|b)*?c$", "(\\w)\\1",
+        "(?:a*)*b", "(a{1,3}){2}", "(?>a+)b", "(?<=a)b+"
+    };
+    static const char *const inputs[] = {
+        "aaaaab aab", "aaaaaaaaaaaaaaaa", "xxxxxxy xxy", "hello there world", "one two three.",
+        "abcd abcbcd", "x, y,z; w ,v", "sing a song of singing", "a1x 123x 12", "ab\nbabc\nc",
+        "aabbcd", ""
+    };
+    UErrorCode status = U_ZERO_ERROR;
+    for (int32_t p = 0; p < UPRV_LENGTHOF(patterns); ++p) {
+        UnicodeString pattern(patterns[p], -1, US_INV);
+        LocalPointer<RegexPattern> pat(RegexPattern::compile(pattern, 0, status));
+        REGEX_CHECK_STATUS;
+        LocalPointer<RegexMatcher> expected(pat->matcher(status));
+        LocalPointer<RegexMatcher> actual(pat->matcher(status));
+        REGEX_CHECK_STATUS;
+        expected->setUseDFA(FALSE);
+        actual->setUseDFA(FALSE);
+        REGEX_ASSERT(!actual->getMemoizeBacktracking());
+        actual->setMemoizeBacktracking(TRUE, status);
+        REGEX_CHECK_STATUS;
+        REGEX_ASSERT(actual->getMemoizeBacktracking());
+        for (int32_t i = 0; i < UPRV_LENGTHOF(inputs); ++i) {
+            UnicodeString input(inputs[i], -1, US_INV);
+            expected->reset(input);
+            actual->reset(input);
+            int32_t numMatches = 0;
+            for (;;) {
+                UBool found = expected->find(status);
+                if (actual->find(status) != found) {
+                    errln("%s:%d: pattern /%s/, input \"%s\", match #%d: find() differs",
+                          __FILE__, __LINE__, patterns[p], inputs[i], numMatches);
+                    break;
+                }
+                if (!found) {
+                    break;
+                }
+                for (int32_t g = 0; g <= expected->groupCount(); ++g) {
+                    if (actual->start(g, status) != expected->start(g, status) ||
+                            actual->end(g, status) != expected->end(g, status)) {
+                        errln("%s:%d: pattern /%s/, input \"%s\", match #%d: group %d differs",
+                              __FILE__, __LINE__, patterns[p], inputs[i], numMatches, g);
+                    }
+                }
+                ++numMatches;
+            }
+            REGEX_ASSERT(actual->matches(status) == expected->matches(status));
+            REGEX_ASSERT(actual->lookingAt(status) == expected->lookingAt(status));
+            if (input.length() > 2) {
+                expected->region(1, input.length() - 1, status);
+                actual->region(1, input.length() - 1, status);
+                REGEX_ASSERT(actual->find(status) == expected->find(status));
+                REGEX_ASSERT(actual->matches(status) == expected->matches(status));
+                REGEX_ASSERT(actual->lookingAt(1, status) == expected->lookingAt(1, status));
+                REGEX_ASSERT(actual->hitEnd() == expected->hitEnd());
+            }
+            REGEX_CHECK_STATUS;
+        }
+    }
+
+    // Patterns that take exponential time with backtracking alone fail to match quickly.
+    UnicodeString longInput;
+    for (int32_t i = 0; i < 5000; ++i) {
+        longInput.append((UChar)0x61);
+    }
+    static const char *const pathological[] = { "(a+)+b", "(a|aa)*b", "(a|a)*b", "^(a+)+$|c", "(.|a)*b" };
+    for (int32_t p = 0; p < UPRV_LENGTHOF(pathological); ++p) {
+        RegexMatcher m(UnicodeString(pathological[p], -1, US_INV), 0, status);
+        REGEX_CHECK_STATUS;
+        m.setUseDFA(FALSE);
+        m.setTimeLimit(200, status);
+        m.setMemoizeBacktracking(TRUE, status);
+        m.reset(longInput + UnicodeString(u"!"));
+        REGEX_ASSERT(!m.matches(status));
+        REGEX_ASSERT(!m.find(status));
+        REGEX_CHECK_STATUS;
+    }
+
+    // The memo is limited by the stack limit.
+    {
+        RegexMatcher m(UnicodeString(u"(a+)+b"), longInput, 0, status);
+        REGEX_CHECK_STATUS;
+        m.setUseDFA(FALSE);
+        m.setMemoizeBacktracking(TRUE, status);
+        m.setStackLimit(100, status);
+        m.setTimeLimit(10, status);
+        REGEX_ASSERT(!m.matches(status));
+        REGEX_ASSERT(status == U_REGEX_TIME_OUT || status == U_REGEX_STACK_OVERFLOW);
+        status = U_ZERO_ERROR;
+        m.setMemoizeBacktracking(FALSE, status);
+        REGEX_ASSERT(!m.getMemoizeBacktracking());
+    }
+}
+
+
+//
+//  TestMatcherPool   RegexPattern::acquireMatcher() and releaseMatcher().
+//
+static const RegexPattern *gPoolPattern = NULL;
+
+void RegexTest::threadFuncMatcherPool(int32_t threadNum) {
+    UErrorCode status = U_ZERO_ERROR;
+    UnicodeString input = UnicodeString(u"user") + (threadNum + 1) + u"@example.org";
+    for (int32_t i = 0; i < 500; ++i) {
+        RegexMatcher *m = gPoolPattern->acquireMatcher(status);
+        REGEX_CHECK_STATUS;
+        m->reset(input);
+        if (!m->find(status) || m->group(1, status) != UnicodeString(u"user") + (threadNum + 1) ||
+                m->group(2, status) != u"example") {
+            errln("%s:%d thread %d: wrong match in iteration %d", __FILE__, __LINE__, threadNum, i);
+            gPoolPattern->releaseMatcher(m);
+            return;
+        }
+        // A setting made here must not be seen by the next user of the matcher.
+        m->setTimeLimit(threadNum + 1, status);
+        gPoolPattern->releaseMatcher(m);
+        REGEX_CHECK_STATUS;
+    }
+}
+
+void RegexTest::TestMatcherPool() {
+    UErrorCode status = U_ZERO_ERROR;
+    UParseError pe;
+    LocalPointer<RegexPattern> pat(RegexPattern::compile(u"(\\w+)@(\\w+)", 0, pe, status));
+    REGEX_CHECK_STATUS;
+
+    RegexMatcher *m1 = pat->acquireMatcher(status);
+    RegexMatcher *m2 = pat->acquireMatcher(status);
+    REGEX_CHECK_STATUS;
+    REGEX_ASSERT(m1 != NULL && m2 != NULL && m1 != m2);
+    REGEX_ASSERT(&m1->pattern() == pat.getAlias());
+    UnicodeString input(u"mail ann@example or bob@example");
+    m1->reset(input);
+    m2->reset(input);
+    REGEX_ASSERT(m1->find(status));
+    REGEX_ASSERT(m1->group(1, status) == u"ann");
+    REGEX_ASSERT(m2->find(status));
+    REGEX_ASSERT(m2->find(status));
+    REGEX_ASSERT(m2->group(1, status) == u"bob");
+    REGEX_CHECK_STATUS;
+
+    // A released matcher is reused, with no input and its settings restored.
+    m1->setTimeLimit(5, status);
+    m1->setStackLimit(1000, status);
+    m1->useTransparentBounds(TRUE);
+    m1->useAnchoringBounds(FALSE);
+    m1->setMemoizeBacktracking(TRUE, status);
+    m1->setStackReserve(4096, status);
+    m1->region(5, 10, status);
+    REGEX_CHECK_STATUS;
+    pat->releaseMatcher(m1);
+    RegexMatcher *m3 = pat->acquireMatcher(status);
+    REGEX_CHECK_STATUS;
+    REGEX_ASSERT(m3 == m1);
+    REGEX_ASSERT(m3->getTimeLimit() == 0);
+    REGEX_ASSERT(m3->getStackLimit() == 8000000);
+    REGEX_ASSERT(!m3->hasTransparentBounds());
+    REGEX_ASSERT(m3->hasAnchoringBounds());
+    REGEX_ASSERT(!m3->getMemoizeBacktracking());
+    REGEX_ASSERT(m3->getStackReserve() == 0);
+    REGEX_ASSERT(m3->input().isEmpty());
+    REGEX_ASSERT(!m3->find(status));
+    m3->reset(input);
+    REGEX_ASSERT(m3->find() && m3->start(status) == 5);
+    REGEX_CHECK_STATUS;
+    pat->releaseMatcher(m3);
+    pat->releaseMatcher(m2);
+    pat->releaseMatcher(NULL);
+
+    // Matchers of other patterns, and matchers that own their pattern, are deleted.
+    LocalPointer<RegexPattern> other(RegexPattern::compile(u"x", 0, pe, status));
+    REGEX_CHECK_STATUS;
+    pat->releaseMatcher(other->matcher(status));
+    pat->releaseMatcher(new RegexMatcher(u"x", 0, status));
+    REGEX_CHECK_STATUS;
+    RegexMatcher *m4 = pat->acquireMatcher(status);
+    RegexMatcher *m5 = pat->acquireMatcher(status);
+    REGEX_CHECK_STATUS;
+    REGEX_ASSERT(&m4->pattern() == pat.getAlias() && &m5->pattern() == pat.getAlias());
+    REGEX_ASSERT((m4 == m2 && m5 == m1) || (m4 == m1 && m5 == m2));
+    pat->releaseMatcher(m4);
+    pat->releaseMatcher(m5);
+
+    // More matchers than the pool holds.
+    RegexMatcher *many[40];
+    for (int32_t i = 0; i < UPRV_LENGTHOF(many); ++i) {
+        many[i] = pat->acquireMatcher(status);
+    }
+    REGEX_CHECK_STATUS;
+    for (int32_t i = 0; i < UPRV_LENGTHOF(many); ++i) {
+        pat->releaseMatcher(many[i]);
+    }
+
+    // The pool of a copied pattern is its own.
+    {
+        RegexPattern copy(*pat);
+        RegexMatcher *m6 = copy.acquireMatcher(status);
+        REGEX_CHECK_STATUS;
+        REGEX_ASSERT(&m6->pattern() == &copy);
+        copy.releaseMatcher(m6);
+    }
+
+    // Concurrent use of the pool.
+    gPoolPattern = pat.getAlias();
+    ThreadPool<RegexTest> threads(this, 8, &RegexTest::threadFuncMatcherPool);
+    threads.start();
+    threads.join();
+    gPoolPattern = NULL;
+
+    // Errors.
+    status = U_ILLEGAL_ARGUMENT_ERROR;
+    REGEX_ASSERT(pat->acquireMatcher(status) == NULL);
+    REGEX_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+}
+
+
+//
+//  TestStackReserve   RegexMatcher::setStackReserve(), and matching without
+//                     heap allocation.  Heap use is counted with the
+//                     AllocationCounter that intltest installs at startup.
+//
+void RegexTest::TestStackReserve() {
+    UErrorCode status = U_ZERO_ERROR;
+    RegexMatcher m(u"a*b", 0, status);
+    REGEX_CHECK_STATUS;
+    REGEX_ASSERT(m.getStackReserve() == 0);
+    m.setStackReserve(4096, status);
+    REGEX_ASSERT(m.getStackReserve() == 4096);
+    m.setStackReserve(-1, status);
+    REGEX_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+    status = U_ZERO_ERROR;
+    REGEX_ASSERT(m.getStackReserve() == 4096);
+    // A reserve beyond the stack limit is limited by it.
+    m.setStackLimit(1000, status);
+    m.setStackReserve(100000, status);
+    REGEX_CHECK_STATUS;
+    m.setStackLimit(0, status);
+    REGEX_CHECK_STATUS;
+
+    if (!AllocationCounter::isInstalled()) {
+        infoln("%s:%d Allocation counting is not available, skipping the heap use checks", __FILE__, __LINE__);
+        return;
+    }
+
+    static const char *const patterns[] = {
+        "(\\w+)@(\\w+)\\.com", "\\b(\\w+)\\s+\\1\\b", "(?i)colou?r", "(a|b|c)*?d",
+        "(?<=\\s)\\d+(?=\\s)", "^.*$", "(?m)^\\s*#.*$", "[\\p{L}&&[^a]]+"
+    };
+    UnicodeString inputs[] = {
+        u"Mail to ann@example.com, bob@example.org or carol@test.com today",
+        u"the the cat sat on on the mat",
+        u"Colour, COLOR and colr",
+        u"abcabcabcd abd cd",
+        u"lines 12 and 345 of\n# comment\n  # indented\ncode",
+        u"\u00e9t\u00e9 a \u0431\u0443\u043a\u0432\u0430 \U0001D400"
+    };
+    for (int32_t p = 0; p < UPRV_LENGTHOF(patterns); ++p) {
+        for (int32_t useDFA = 0; useDFA <= 1; ++useDFA) {
+            RegexMatcher m(UnicodeString(patterns[p], -1, US_INV), 0, status);
+            REGEX_CHECK_STATUS;
+            m.setUseDFA(useDFA);
+            m.setStackReserve(65536, status);
+            REGEX_CHECK_STATUS;
+            // The first pass lets the DFA engine create its states.
+            int32_t allocations = 0;
+            for (int32_t pass = 0; pass < 2; ++pass) {
+                AllocationCounter counter;
+                for (int32_t i = 0; i < UPRV_LENGTHOF(inputs); ++i) {
+                    m.reset(inputs[i]);
+                    while (m.find(status)) {}
+                    m.reset(inputs[i]);
+                    m.matches(status);
+                    m.lookingAt(status);
+                    m.reset(inputs[i]);
+                    m.region(2, inputs[i].length() - 2, status);
+                    m.find(status);
+                }
+                allocations = counter.count();
+                REGEX_CHECK_STATUS;
+                if (!useDFA) {
+                    break;
+                }
+            }
+            if (allocations != 0) {
+                errln("%s:%d pattern \"%s\", DFA %d: %d heap allocations while matching",
+                      __FILE__, __LINE__, patterns[p], useDFA, allocations);
+            }
+        }
+    }
+
+    // Without a reserve, a deep backtrack stack is allocated as it grows, and then kept.
+    {
+        RegexMatcher m(u"(a|b)*c", 0, status);
+        REGEX_CHECK_STATUS;
+        m.setUseDFA(FALSE);
+        UnicodeString input;
+        for (int32_t i = 0; i < 2000; ++i) {
+            input.append(u"ab");
+        }
+        m.reset(input);
+        {
+            AllocationCounter counter;
+            REGEX_ASSERT(!m.matches(status));
+            REGEX_ASSERT(counter.count() > 0);
+        }
+        m.reset(input);
+        {
+            AllocationCounter counter;
+            REGEX_ASSERT(!m.matches(status));
+            REGEX_ASSERT(counter.count() == 0);
+        }
+        REGEX_CHECK_STATUS;
+    }
+
+    // A matcher from the pool keeps its storage.
+    {
+        UParseError pe;
+        LocalPointer<RegexPattern> pat(RegexPattern::compile(u"(\\w+)@(\\w+)", 0, pe, status));
+        REGEX_CHECK_STATUS;
+        RegexMatcher *pm = pat->acquireMatcher(status);
+        REGEX_CHECK_STATUS;
+        pm->setUseDFA(FALSE);
+        pm->reset(inputs[0]);
+        REGEX_ASSERT(pm->find(status));
+        pat->releaseMatcher(pm);
+        AllocationCounter counter;
+        pm = pat->acquireMatcher(status);
+        pm->setUseDFA(FALSE);
+        pm->reset(inputs[0]);
+        REGEX_ASSERT(pm->find(status));
+        pat->releaseMatcher(pm);
+        REGEX_ASSERT(counter.count() == 0);
+        REGEX_CHECK_STATUS;
+    }
+}
+
 #endif  /* !UCONFIG_NO_REGULAR_EXPRESSIONS  */
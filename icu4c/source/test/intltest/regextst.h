@@ -59,8 +59,17 @@ class RegexTest: public IntlTest {
     virtual void TestBug12884();
     virtual void TestBug13631();
     virtual void TestBug13632();
+    virtual void TestDFAMatchEngine();
+    virtual void TestRegexSet();
+    virtual void TestLiteralSearch();
+    virtual void TestUTF8Input();
+    virtual void TestBinaryPattern();
+    virtual void TestMemoizeBacktracking();
+    virtual void TestMatcherPool();
+    virtual void TestStackReserve();
 
     // The following functions are internal to the regexp tests.
+    void threadFuncMatcherPool(int32_t threadNum);
     virtual void assertUText(const char *expected, UText *actual, const char *file, int line);
     virtual void assertUTextInvariant(const char *invariant, UText *actual, const char *file, int line);
     virtual UBool doRegexLMTest(const char *pat, const char *text, UBool looking, UBool match, int32_t line);
@@ -10,10 +10,13 @@
 **********************************************************************
 */
 
+#include <stdlib.h>
 #include <algorithm>
+#include <atomic>
 #include <vector>
 #include "unicode/utypes.h"
 #include "unicode/edits.h"
+#include "unicode/uclean.h"
 #include "unicode/unistr.h"
 #include "unicode/utf16.h"
 #include "cmemory.h"
@@ -301,3 +304,51 @@ void TestUtility::checkEditsIter(
         }
     }
 }
+
+namespace {
+
+UBool gAllocationCounterInstalled = FALSE;
+std::atomic<int32_t> gCountingScopes(0);
+std::atomic<int32_t> gAllocationCount(0);
+
+void * U_CALLCONV countingAlloc(const void * /*context*/, size_t size) {
+    if (gCountingScopes.load(std::memory_order_relaxed) > 0) {
+        gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return malloc(size);
+}
+
+void * U_CALLCONV countingRealloc(const void * /*context*/, void *mem, size_t size) {
+    if (gCountingScopes.load(std::memory_order_relaxed) > 0) {
+        gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return realloc(mem, size);
+}
+
+void U_CALLCONV countingFree(const void * /*context*/, void *mem) {
+    free(mem);
+}
+
+}  // namespace
+
+AllocationCounter::AllocationCounter() {
+    gAllocationCount.store(0);
+    gCountingScopes.fetch_add(1);
+}
+
+AllocationCounter::~AllocationCounter() {
+    gCountingScopes.fetch_sub(1);
+}
+
+int32_t AllocationCounter::count() const {
+    return gAllocationCount.load();
+}
+
+void AllocationCounter::install(UErrorCode &errorCode) {
+    u_setMemoryFunctions(nullptr, countingAlloc, countingRealloc, countingFree, &errorCode);
+    gAllocationCounterInstalled = U_SUCCESS(errorCode);
+}
+
+UBool AllocationCounter::isInstalled() {
+    return gAllocationCounterInstalled;
+}
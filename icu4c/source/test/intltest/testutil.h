@@ -50,4 +50,30 @@ class TestUtility {
     TestUtility() = delete;  // Prevent instantiation
 };
 
+/**
+ * Counts heap allocations made through ICU while an instance is in scope.
+ * install() replaces ICU's memory functions with counting wrappers around
+ * malloc/realloc/free; it must be called while ICU holds no memory, which
+ * intltest does in main() before initializing ICU. If it has not been installed,
+ * isInstalled() returns FALSE and count() stays 0.
+ * Allocations on all threads are counted.
+ */
+class AllocationCounter {
+public:
+    /** Starts counting from zero. */
+    AllocationCounter();
+    /** Stops counting. */
+    ~AllocationCounter();
+
+    /** @return the number of allocations and reallocations since construction */
+    int32_t count() const;
+
+    static void install(UErrorCode &errorCode);
+    static UBool isInstalled();
+
+private:
+    AllocationCounter(const AllocationCounter &) = delete;
+    AllocationCounter &operator=(const AllocationCounter &) = delete;
+};
+
 #endif
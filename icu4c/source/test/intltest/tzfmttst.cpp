@@ -85,6 +85,7 @@ TimeZoneFormatTest::runIndexedTest( int32_t index, UBool exec, const char* &name
         TESTCASE(5, TestFormatTZDBNames);
         TESTCASE(6, TestFormatCustomZone);
         TESTCASE(7, TestFormatTZDBNamesAllZoneCoverage);
+        TESTCASE(8, TestFindNames);
     default: name = ""; break;
     }
 }
@@ -1302,4 +1303,93 @@ TimeZoneFormatTest::TestFormatTZDBNamesAllZoneCoverage(void) {
     }
 }
 
+static const struct {
+    const char *text;
+    uint32_t types;
+    const char *mzID;   // or NULL for a time zone ID
+    const char *tzID;
+    UTimeZoneNameType nameType;
+    int32_t length;
+} FIND_NAMES_DATA[] = {
+    {"Pacific Standard Time", UTZNM_LONG_STANDARD, "America_Pacific", NULL, UTZNM_LONG_STANDARD, 21},
+    {"Central European Summer Time!", UTZNM_LONG_DAYLIGHT, "Europe_Central", NULL, UTZNM_LONG_DAYLIGHT, 28},
+    {"Hawaii-Aleutian Standard Time", UTZNM_LONG_STANDARD | UTZNM_LONG_DAYLIGHT, "Hawaii_Aleutian", NULL, UTZNM_LONG_STANDARD, 29},
+    {"Los Angeles", UTZNM_EXEMPLAR_LOCATION, NULL, "America/Los_Angeles", UTZNM_EXEMPLAR_LOCATION, 11},
+    {"No Such Time", UTZNM_LONG_STANDARD | UTZNM_LONG_DAYLIGHT, NULL, NULL, UTZNM_UNKNOWN, 0},
+};
+
+static TimeZoneNames *gFindNames = NULL;
+
+// Checks TimeZoneNames::find() with gFindNames; returns FALSE on failure.
+static UBool checkFindNames(UnicodeString &message) {
+    for (int32_t i = 0; i < UPRV_LENGTHOF(FIND_NAMES_DATA); i++) {
+        UErrorCode status = U_ZERO_ERROR;
+        UnicodeString text(FIND_NAMES_DATA[i].text, -1, US_INV);
+        LocalPointer<TimeZoneNames::MatchInfoCollection> matches(
+            gFindNames->find(text, 0, FIND_NAMES_DATA[i].types, status));
+        if (U_FAILURE(status)) {
+            message = UnicodeString("find(") + text + ") failed: " + u_errorName(status);
+            return FALSE;
+        }
+        if (FIND_NAMES_DATA[i].nameType == UTZNM_UNKNOWN) {
+            if (matches.isValid() && matches->size() > 0) {
+                message = UnicodeString("find(") + text + ") should not match";
+                return FALSE;
+            }
+            continue;
+        }
+        UBool found = FALSE;
+        for (int32_t j = 0; matches.isValid() && j < matches->size() && !found; j++) {
+            UnicodeString id;
+            if (FIND_NAMES_DATA[i].mzID != NULL) {
+                matches->getMetaZoneIDAt(j, id);
+                found = (id == UnicodeString(FIND_NAMES_DATA[i].mzID, -1, US_INV));
+            } else {
+                matches->getTimeZoneIDAt(j, id);
+                found = (id == UnicodeString(FIND_NAMES_DATA[i].tzID, -1, US_INV));
+            }
+            found = found && matches->getNameTypeAt(j) == FIND_NAMES_DATA[i].nameType &&
+                matches->getMatchLengthAt(j) == FIND_NAMES_DATA[i].length;
+        }
+        if (!found) {
+            message = UnicodeString("find(") + text + ") did not give the expected match";
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+void
+TimeZoneFormatTest::TestFindNames(void) {
+    // Names are found before and after all of them are loaded,
+    // and in parallel once the names trie is complete.
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<TimeZoneNames> tzn(TimeZoneNames::createInstance(Locale::getEnglish(), status));
+    if (U_FAILURE(status)) {
+        dataerrln("Fail: TimeZoneNames::createInstance failed: %s", u_errorName(status));
+        return;
+    }
+    gFindNames = tzn.getAlias();
+    UnicodeString message;
+    for (int32_t i = 0; i < 2; i++) {
+        if (!checkFindNames(message)) {
+            errln("Fail: " + message);
+        }
+    }
+    ThreadPool<TimeZoneFormatTest> threads(this, threadCount, &TimeZoneFormatTest::RunFindNamesTests);
+    threads.start();
+    threads.join();
+    gFindNames = NULL;
+}
+
+void TimeZoneFormatTest::RunFindNamesTests(int32_t /*threadNumber*/) {
+    UnicodeString message;
+    for (int32_t i = 0; i < 200; i++) {
+        if (!checkFindNames(message)) {
+            errln("Fail: " + message);
+            return;
+        }
+    }
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
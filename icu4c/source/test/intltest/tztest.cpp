@@ -12,11 +12,15 @@
 
 #include "unicode/timezone.h"
 #include "unicode/simpletz.h"
+#include "unicode/basictz.h"
+#include "unicode/tzrule.h"
+#include "unicode/tztrans.h"
 #include "unicode/calendar.h"
 #include "unicode/gregocal.h"
 #include "unicode/resbund.h"
 #include "unicode/strenum.h"
 #include "unicode/uversion.h"
+#include "unicode/vtzone.h"
 #include "tztest.h"
 #include "cmemory.h"
 #include "putilimp.h"
@@ -74,6 +78,10 @@ void TimeZoneTest::runIndexedTest( int32_t index, UBool exec, const char* &name,
     TESTCASE_AUTO(TestGetUnknown);
     TESTCASE_AUTO(TestGetWindowsID);
     TESTCASE_AUTO(TestGetIDForWindowsID);
+    TESTCASE_AUTO(TestGetOffsetAtTransitions);
+    TESTCASE_AUTO(TestCreateTimeZoneShared);
+    TESTCASE_AUTO(TestGetOffsets);
+    TESTCASE_AUTO(TestGetLocalFields);
     TESTCASE_AUTO_END;
 }
 
@@ -2478,4 +2486,299 @@ void TimeZoneTest::TestGetIDForWindowsID(void) {
     }
 }
 
+void TimeZoneTest::TestGetOffsetAtTransitions(void) {
+    // Check the offsets on both sides of each historical transition,
+    // jumping between early and late transitions.
+    static const char* const ZONES[] = {
+        "America/New_York", "Europe/London", "Asia/Kolkata", "Australia/Lord_Howe",
+        "America/Sao_Paulo", "Pacific/Apia", "Africa/Casablanca", "Europe/Moscow"
+    };
+    const UDate start = -2524521600000.0;  // 1890-01-01T00:00Z
+    const UDate end = 2145916800000.0;  // 2038-01-01T00:00Z
+    for (int32_t i = 0; i < UPRV_LENGTHOF(ZONES); i++) {
+        LocalPointer<BasicTimeZone> tz(dynamic_cast<BasicTimeZone*>(TimeZone::createTimeZone(ZONES[i])));
+        if (tz.isNull()) {
+            dataerrln(UnicodeString("Fail: cannot create ") + ZONES[i]);
+            continue;
+        }
+        // Transition times, and the offsets after them
+        UDate transTimes[1000];
+        int32_t transRaw[1000];
+        int32_t transDst[1000];
+        int32_t count = 0;
+        TimeZoneTransition trans;
+        for (UDate t = start; count < UPRV_LENGTHOF(transTimes) && tz->getNextTransition(t, FALSE, trans) &&
+                trans.getTime() < end; t = trans.getTime()) {
+            transTimes[count] = trans.getTime();
+            transRaw[count] = trans.getTo()->getRawOffset();
+            transDst[count] = trans.getTo()->getDSTSavings();
+            count++;
+        }
+        if (count < 2) {
+            errln(UnicodeString("Fail: too few transitions for ") + ZONES[i]);
+            continue;
+        }
+        for (int32_t j = 0; j < count; j++) {
+            int32_t k = (j % 2 == 0) ? j / 2 : count - 1 - j / 2;
+            UErrorCode status = U_ZERO_ERROR;
+            int32_t raw, dst;
+            tz->getOffset(transTimes[k], FALSE, raw, dst, status);
+            if (U_FAILURE(status) || raw != transRaw[k] || dst != transDst[k]) {
+                errln(UnicodeString("Fail: ") + ZONES[i] + " at transition " + transTimes[k] +
+                      ": raw=" + raw + " dst=" + dst + ", expected " + transRaw[k] + "/" + transDst[k]);
+            }
+            if (k > 0) {
+                tz->getOffset(transTimes[k] - 1, FALSE, raw, dst, status);
+                if (U_FAILURE(status) || raw != transRaw[k - 1] || dst != transDst[k - 1]) {
+                    errln(UnicodeString("Fail: ") + ZONES[i] + " before transition " + transTimes[k] +
+                          ": raw=" + raw + " dst=" + dst + ", expected " + transRaw[k - 1] + "/" + transDst[k - 1]);
+                }
+            }
+            // A local time far from the transitions
+            if (k + 1 < count && transTimes[k + 1] - transTimes[k] > 4 * U_MILLIS_PER_DAY) {
+                UDate local = (transTimes[k] + transTimes[k + 1]) / 2 + transRaw[k] + transDst[k];
+                tz->getOffset(local, TRUE, raw, dst, status);
+                if (U_FAILURE(status) || raw != transRaw[k] || dst != transDst[k]) {
+                    errln(UnicodeString("Fail: ") + ZONES[i] + " at local time " + local +
+                          ": raw=" + raw + " dst=" + dst + ", expected " + transRaw[k] + "/" + transDst[k]);
+                }
+            }
+        }
+    }
+}
+
+void TimeZoneTest::TestCreateTimeZoneShared(void) {
+    // Zones created for the same ID share their data, but changing one
+    // must not affect the others, or zones created later.
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<StringEnumeration> ids(TimeZone::createEnumeration());
+    if (ids.isNull()) {
+        dataerrln("Fail: cannot create the time zone enumeration");
+        return;
+    }
+    const UnicodeString *id;
+    while ((id = ids->snext(status)) != NULL && U_SUCCESS(status)) {
+        LocalPointer<TimeZone> tz1(TimeZone::createTimeZone(*id));
+        LocalPointer<TimeZone> tz2(TimeZone::createTimeZone(*id));
+        UnicodeString id1, id2;
+        if (tz1->getID(id1) != *id || tz2->getID(id2) != *id || *tz1 != *tz2) {
+            errln("Fail: zones created for " + *id + " differ: " + id1 + ", " + id2);
+        }
+        // Asking twice must give the same canonical ID
+        UnicodeString canonical1, canonical2;
+        UBool isSystem1 = FALSE, isSystem2 = FALSE;
+        TimeZone::getCanonicalID(*id, canonical1, isSystem1, status);
+        TimeZone::getCanonicalID(*id, canonical2, isSystem2, status);
+        if (U_FAILURE(status) || canonical1 != canonical2 || !isSystem1 || !isSystem2) {
+            errln("Fail: canonical IDs for " + *id + " differ: " + canonical1 + ", " + canonical2);
+            status = U_ZERO_ERROR;
+        }
+    }
+    if (U_FAILURE(status)) {
+        errln(UnicodeString("Fail: enumerating time zones - ") + u_errorName(status));
+        return;
+    }
+
+    LocalPointer<TimeZone> ny(TimeZone::createTimeZone("America/New_York"));
+    LocalPointer<TimeZone> nyClone(ny->clone());
+    ny->setID("Test/Changed");
+    LocalPointer<TimeZone> ny2(TimeZone::createTimeZone("America/New_York"));
+    UnicodeString id2, cloneID;
+    if (ny2->getID(id2) != "America/New_York" || nyClone->getID(cloneID) != "America/New_York" ||
+            *ny2 != *nyClone) {
+        errln("Fail: changing a zone affected a zone created later, or its clone: " + id2 + ", " + cloneID);
+    }
+    // Unknown IDs still give the unknown zone
+    LocalPointer<TimeZone> unknown(TimeZone::createTimeZone("Test/NoSuchZone"));
+    if (*unknown != TimeZone::getUnknown()) {
+        errln("Fail: Test/NoSuchZone should give the unknown zone");
+    }
+}
+
+void TimeZoneTest::TestGetOffsets(void) {
+    // BasicTimeZone::getOffsets() must give the same offsets as getOffset() for each date:
+    // sorted dates around transitions, sorted dates a day apart, and scattered dates.
+    static const char* const ZONES[] = {
+        "America/New_York", "Europe/London", "Australia/Lord_Howe", "Pacific/Apia", "Asia/Tokyo"
+    };
+    const UDate start = -2524521600000.0;  // 1890-01-01T00:00Z
+    const UDate end = 2145916800000.0;  // 2038-01-01T00:00Z
+    const int32_t capacity = 40000;
+    LocalArray<UDate> dates(new UDate[capacity]);
+    LocalArray<int32_t> rawOffsets(new int32_t[capacity]);
+    LocalArray<int32_t> dstOffsets(new int32_t[capacity]);
+    for (int32_t z = 0; z < UPRV_LENGTHOF(ZONES) + 2; z++) {
+        UErrorCode status = U_ZERO_ERROR;
+        LocalPointer<BasicTimeZone> tz;
+        if (z < UPRV_LENGTHOF(ZONES)) {
+            tz.adoptInstead(dynamic_cast<BasicTimeZone*>(TimeZone::createTimeZone(ZONES[z])));
+        } else if (z == UPRV_LENGTHOF(ZONES)) {
+            tz.adoptInstead(new SimpleTimeZone(-8 * U_MILLIS_PER_HOUR, "Test/Simple",
+                UCAL_MARCH, 8, -UCAL_SUNDAY, 2 * U_MILLIS_PER_HOUR,
+                UCAL_NOVEMBER, 1, -UCAL_SUNDAY, 2 * U_MILLIS_PER_HOUR, status));
+        } else {
+            tz.adoptInstead(VTimeZone::createVTimeZoneByID("America/Sao_Paulo"));
+        }
+        if (tz.isNull() || U_FAILURE(status)) {
+            dataerrln("Fail: cannot create time zone #%d - %s", (int)z, u_errorName(status));
+            continue;
+        }
+        UnicodeString id;
+        if (tz->getID(id).isEmpty()) {
+            id = "VTimeZone";
+        }
+
+        int32_t count = 0;
+        TimeZoneTransition trans;
+        for (UDate t = start; count + 13 <= capacity / 2 && tz->getNextTransition(t, FALSE, trans) &&
+                trans.getTime() < end; t = trans.getTime()) {
+            for (int32_t k = -6; k <= 6; k++) {
+                dates[count++] = trans.getTime() + k * 30 * U_MILLIS_PER_MINUTE;
+            }
+        }
+        for (UDate t = 946684800000.0; t < end; t += U_MILLIS_PER_DAY + 1234) {  // from 2000-01-01T00:00Z
+            dates[count++] = t;
+        }
+        uint32_t seed = 1;
+        while (count < capacity) {
+            seed = seed * 1103515245 + 12345;
+            dates[count++] = start + uprv_floor((end - start) * ((seed >> 8) / 16777216.0));
+        }
+
+        for (int32_t local = 0; local < 2; local++) {
+            tz->getOffsets(dates.getAlias(), count, (UBool)local, rawOffsets.getAlias(), dstOffsets.getAlias(), status);
+            if (U_FAILURE(status)) {
+                errln("Fail: " + id + " getOffsets failed: " + u_errorName(status));
+                break;
+            }
+            int32_t errors = 0;
+            for (int32_t i = 0; i < count && errors < 10; i++) {
+                int32_t raw, dst;
+                tz->getOffset(dates[i], (UBool)local, raw, dst, status);
+                if (U_FAILURE(status) || raw != rawOffsets[i] || dst != dstOffsets[i]) {
+                    errln(UnicodeString("Fail: ") + id + " at " + (local ? "local " : "") + dates[i] +
+                          ": raw=" + rawOffsets[i] + " dst=" + dstOffsets[i] + ", expected " + raw + "/" + dst);
+                    errors++;
+                }
+            }
+        }
+
+        int32_t raw, dst;
+        tz->getOffsets(dates.getAlias(), 0, FALSE, &raw, &dst, status);
+        if (U_FAILURE(status)) {
+            errln("Fail: " + id + " getOffsets for no dates failed: " + u_errorName(status));
+        }
+        tz->getOffsets(dates.getAlias(), -1, FALSE, &raw, &dst, status);
+        if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+            errln("Fail: " + id + " getOffsets with a negative count should fail: " + u_errorName(status));
+        }
+    }
+}
+
+void TimeZoneTest::TestGetLocalFields(void) {
+    // BasicTimeZone::getLocalFields() must give the same fields as a Gregorian calendar,
+    // and getDatesFromLocalFields() must map them back as getOffset() with local=TRUE does.
+    static const char* const ZONES[] = {"America/New_York", "Australia/Lord_Howe", "Asia/Kolkata"};
+    const UDate start = -11676096000000.0;  // 1600-01-01T00:00Z
+    const UDate end = 4102444800000.0;  // 2100-01-01T00:00Z
+    const int32_t capacity = 3000;
+    LocalArray<UDate> dates(new UDate[capacity]);
+    LocalArray<int32_t> years(new int32_t[capacity]);
+    LocalArray<int32_t> months(new int32_t[capacity]);
+    LocalArray<int32_t> days(new int32_t[capacity]);
+    LocalArray<int32_t> millis(new int32_t[capacity]);
+    LocalArray<UDate> utc(new UDate[capacity]);
+    for (int32_t z = 0; z < UPRV_LENGTHOF(ZONES); z++) {
+        UErrorCode status = U_ZERO_ERROR;
+        LocalPointer<BasicTimeZone> tz(dynamic_cast<BasicTimeZone*>(TimeZone::createTimeZone(ZONES[z])));
+        GregorianCalendar cal(*tz, status);
+        if (tz.isNull() || U_FAILURE(status)) {
+            dataerrln("Fail: cannot create time zone %s - %s", ZONES[z], u_errorName(status));
+            continue;
+        }
+
+        // Sorted dates around transitions, then scattered dates
+        int32_t count = 0;
+        TimeZoneTransition trans;
+        for (UDate t = 1104537600000.0; count + 9 <= capacity / 2 && tz->getNextTransition(t, FALSE, trans) &&
+                trans.getTime() < end; t = trans.getTime()) {  // from 2005-01-01T00:00Z
+            for (int32_t k = -4; k <= 4; k++) {
+                dates[count++] = trans.getTime() + k * 20 * U_MILLIS_PER_MINUTE + 7;
+            }
+        }
+        uint32_t seed = 1;
+        while (count < capacity) {
+            seed = seed * 1103515245 + 12345;
+            dates[count++] = start + uprv_floor((end - start) * ((seed >> 8) / 16777216.0));
+        }
+
+        tz->getLocalFields(dates.getAlias(), count, years.getAlias(), months.getAlias(),
+                           days.getAlias(), millis.getAlias(), status);
+        tz->getDatesFromLocalFields(years.getAlias(), months.getAlias(), days.getAlias(),
+                                    millis.getAlias(), count, utc.getAlias(), status);
+        if (U_FAILURE(status)) {
+            errln(UnicodeString("Fail: ") + ZONES[z] + " local fields failed: " + u_errorName(status));
+            continue;
+        }
+        int32_t errors = 0;
+        for (int32_t i = 0; i < count && errors < 10; i++) {
+            cal.setTime(dates[i], status);
+            if (years[i] != cal.get(UCAL_EXTENDED_YEAR, status) || months[i] != cal.get(UCAL_MONTH, status) ||
+                    days[i] != cal.get(UCAL_DATE, status) ||
+                    millis[i] != cal.get(UCAL_MILLISECONDS_IN_DAY, status)) {
+                errln(UnicodeString("Fail: ") + ZONES[z] + " getLocalFields at " + dates[i] + ": " +
+                      years[i] + "-" + (months[i] + 1) + "-" + days[i] + " " + millis[i]);
+                errors++;
+            }
+            int32_t raw, dst;
+            UDate localMillis = dates[i] + cal.get(UCAL_ZONE_OFFSET, status) + cal.get(UCAL_DST_OFFSET, status);
+            tz->getOffset(localMillis, TRUE, raw, dst, status);
+            if (utc[i] != localMillis - raw - dst) {
+                errln(UnicodeString("Fail: ") + ZONES[z] + " getDatesFromLocalFields at " + dates[i] +
+                      ": " + utc[i] + ", expected " + (localMillis - raw - dst));
+                errors++;
+            }
+        }
+    }
+
+    // Out-of-range days and milliseconds carry over; errors
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<BasicTimeZone> tz(dynamic_cast<BasicTimeZone*>(TimeZone::createTimeZone("Asia/Tokyo")));
+    const int32_t y[] = {2018, 2018, 2020}, m[] = {UCAL_JANUARY, UCAL_MARCH, UCAL_FEBRUARY}, d[] = {32, 1, 30};
+    const int32_t ms[] = {0, -1, 3 * U_MILLIS_PER_HOUR};
+    const UDate expected[] = {
+        1517410800000.0,  // 2018-02-01T00:00+09:00
+        1519830000000.0 - 1,  // 2018-02-28T23:59:59.999+09:00
+        1582999200000.0  // 2020-03-01T03:00+09:00
+    };
+    UDate result[3];
+    tz->getDatesFromLocalFields(y, m, d, ms, 3, result, status);
+    for (int32_t i = 0; U_SUCCESS(status) && i < 3; i++) {
+        if (result[i] != expected[i]) {
+            errln(UnicodeString("Fail: getDatesFromLocalFields #") + i + ": " + result[i] + ", expected " + expected[i]);
+        }
+    }
+    int32_t year, month;
+    tz->getLocalFields(expected, 1, &year, &month, NULL, NULL, status);
+    if (U_FAILURE(status) || year != 2018 || month != UCAL_FEBRUARY) {
+        errln(UnicodeString("Fail: getLocalFields with NULL arrays: ") + year + "-" + (month + 1) + " " + u_errorName(status));
+    }
+    const int32_t badMonth[] = {12}, badYear[] = {6000000};
+    tz->getDatesFromLocalFields(y, badMonth, d, ms, 1, result, status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln(UnicodeString("Fail: getDatesFromLocalFields with month 12 should fail: ") + u_errorName(status));
+    }
+    status = U_ZERO_ERROR;
+    tz->getDatesFromLocalFields(badYear, m, d, ms, 1, result, status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln(UnicodeString("Fail: getDatesFromLocalFields with year 6000000 should fail: ") + u_errorName(status));
+    }
+    status = U_ZERO_ERROR;
+    const UDate farDate = 1e18;
+    tz->getLocalFields(&farDate, 1, &year, NULL, NULL, NULL, status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln(UnicodeString("Fail: getLocalFields out of range should fail: ") + u_errorName(status));
+    }
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
@@ -102,6 +102,10 @@ class TimeZoneTest: public CalendarTimeZoneTest {
 
     void TestGetWindowsID(void);
     void TestGetIDForWindowsID(void);
+    void TestGetOffsetAtTransitions(void);
+    void TestCreateTimeZoneShared(void);
+    void TestGetOffsets(void);
+    void TestGetLocalFields(void);
 
     static const UDate INTERVAL;
 
@@ -60,6 +60,28 @@ UPerfFunction* DateFormatPerfTest::runIndexedTest(int32_t index, UBool exec,cons
         TESTCASE(22,DateFmtCopy10000);
         TESTCASE(23,DateFmtCreate250);
         TESTCASE(24,DateFmtCreate10000);
+        TESTCASE(25,DateFmtFormatNumeric10000);
+        TESTCASE(26,DateFmtFormatNames10000);
+        TESTCASE(27,DateFmtFormatLog10000);
+        TESTCASE(28,DateFmtFormatLogCached10000);
+        TESTCASE(29,DateFmtFormatSpread10000);
+        TESTCASE(30,DateFmtFormatSpreadCalendar10000);
+        TESTCASE(31,DateFmtParseNumeric10000);
+        TESTCASE(32,DateFmtParseNumericCalendar10000);
+        TESTCASE(33,TimeZoneGetOffset10000);
+        TESTCASE(34,TimeZoneGetOffsetLocal10000);
+        TESTCASE(35,TimeZoneGetOffsetNearby10000);
+        TESTCASE(36,TimeZoneCreateIDs10000);
+        TESTCASE(37,TimeZoneCanonicalID10000);
+        TESTCASE(38,TimeZoneParseSpecific10000);
+        TESTCASE(39,TimeZoneParseLocation10000);
+        TESTCASE(40,TimeZoneGetOffsets10000);
+        TESTCASE(41,TimeZoneGetOffsetsLocal10000);
+        TESTCASE(42,TimeZoneGetOffsetsNearby10000);
+        TESTCASE(43,TimeZoneLocalFieldsCalendar10000);
+        TESTCASE(44,TimeZoneLocalFields10000);
+        TESTCASE(45,TimeZoneLocalFieldsNearbyCalendar10000);
+        TESTCASE(46,TimeZoneLocalFieldsNearby10000);
 
 
         default: 
@@ -184,6 +206,100 @@ UPerfFunction* DateFormatPerfTest::DateFmtCreate10000(){
     return new DateFmtCreateFunction(10000, locale);
 }
 
+UPerfFunction* DateFormatPerfTest::DateFmtFormatNumeric10000(){
+    return new DateFmtFormatFunction(40, locale, UnicodeString("yyyy-MM-dd HH:mm:ss.SSS"));
+}
+
+UPerfFunction* DateFormatPerfTest::DateFmtFormatNames10000(){
+    return new DateFmtFormatFunction(40, locale, UnicodeString("EEE, d MMM yyyy HH:mm:ss"));
+}
+
+UPerfFunction* DateFormatPerfTest::DateFmtFormatLog10000(){
+    return new DateFmtFormatLogFunction(10000, locale, FALSE);
+}
+
+UPerfFunction* DateFormatPerfTest::DateFmtFormatLogCached10000(){
+    return new DateFmtFormatLogFunction(10000, locale, TRUE);
+}
+
+UPerfFunction* DateFormatPerfTest::DateFmtFormatSpread10000(){
+    return new DateFmtFormatSpreadFunction(10000, locale, FALSE);
+}
+
+UPerfFunction* DateFormatPerfTest::DateFmtFormatSpreadCalendar10000(){
+    return new DateFmtFormatSpreadFunction(10000, locale, TRUE);
+}
+
+UPerfFunction* DateFormatPerfTest::DateFmtParseNumeric10000(){
+    return new DateFmtParseNumericFunction(10000, locale, FALSE);
+}
+
+UPerfFunction* DateFormatPerfTest::DateFmtParseNumericCalendar10000(){
+    return new DateFmtParseNumericFunction(10000, locale, TRUE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneGetOffset10000(){
+    return new TimeZoneGetOffsetFunction(10000, FALSE, FALSE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneGetOffsetLocal10000(){
+    return new TimeZoneGetOffsetFunction(10000, TRUE, FALSE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneGetOffsetNearby10000(){
+    return new TimeZoneGetOffsetFunction(10000, FALSE, TRUE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneGetOffsets10000(){
+    return new TimeZoneGetOffsetFunction(10000, FALSE, FALSE, TRUE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneGetOffsetsLocal10000(){
+    return new TimeZoneGetOffsetFunction(10000, TRUE, FALSE, TRUE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneGetOffsetsNearby10000(){
+    return new TimeZoneGetOffsetFunction(10000, FALSE, TRUE, TRUE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneLocalFieldsCalendar10000(){
+    return new TimeZoneLocalFieldsFunction(10000, FALSE, FALSE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneLocalFields10000(){
+    return new TimeZoneLocalFieldsFunction(10000, FALSE, TRUE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneLocalFieldsNearbyCalendar10000(){
+    return new TimeZoneLocalFieldsFunction(10000, TRUE, FALSE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneLocalFieldsNearby10000(){
+    return new TimeZoneLocalFieldsFunction(10000, TRUE, TRUE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneCreateIDs10000(){
+    return new TimeZoneLookupFunction(10000, FALSE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneCanonicalID10000(){
+    return new TimeZoneLookupFunction(10000, TRUE);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneParseSpecific10000(){
+    static const char* const names[] = {
+        "Pacific Standard Time", "Central European Summer Time", "India Standard Time", "Japan Standard Time"
+    };
+    return new TimeZoneParseFunction(10000, UTZFMT_STYLE_SPECIFIC_LONG, names);
+}
+
+UPerfFunction* DateFormatPerfTest::TimeZoneParseLocation10000(){
+    static const char* const names[] = {
+        "Los Angeles Time", "Germany Time", "India Time", "Sao Paulo Time"
+    };
+    return new TimeZoneParseFunction(10000, UTZFMT_STYLE_GENERIC_LOCATION, names);
+}
+
 
 int main(int argc, const char* argv[]){
 
@@ -21,11 +21,14 @@
 #include "unicode/dtitvfmt.h"
 #include "unicode/utypes.h"
 #include "unicode/datefmt.h"
+#include "unicode/smpdtfmt.h"
 #include "unicode/calendar.h"
 #include "unicode/uclean.h"
 #include "unicode/brkiter.h"
 #include "unicode/numfmt.h"
 #include "unicode/coll.h"
+#include "unicode/tzfmt.h"
+#include "unicode/basictz.h"
 #include "util.h"
 
 #include "datedata.h"
@@ -236,6 +239,486 @@ class DateFmtFunction : public UPerfFunction
 
 };
 
+// Formats the dates with one SimpleDateFormat that is created up front,
+// so that only the format() calls are measured.
+class DateFmtFormatFunction : public UPerfFunction
+{
+
+private:
+    int num;
+    Calendar *cal;
+    SimpleDateFormat *fmt;
+    UDate dates[250];
+
+public:
+
+    DateFmtFormatFunction(int a, const char* loc, const UnicodeString& pattern)
+    {
+        num = a;
+        UErrorCode status = U_ZERO_ERROR;
+        cal = Calendar::createInstance(TimeZone::createTimeZone("GMT"), status);
+        fmt = new SimpleDateFormat(pattern, Locale(loc), status);
+        check(status, "SimpleDateFormat::SimpleDateFormat");
+        fmt->setCalendar(*cal);
+        for(int i = 0; i < NUM_DATES; i++)
+        {
+            cal->clear();
+            cal->set(years[i], months[i], days[i], (i * 7) % 24, (i * 13) % 60, (i * 17) % 60);
+            dates[i] = cal->getTime(status) + i;
+        }
+        check(status, "Calendar::getTime");
+    }
+
+    ~DateFmtFormatFunction()
+    {
+        delete fmt;
+        delete cal;
+    }
+
+    virtual void call(UErrorCode* status)
+    {
+        UnicodeString str;
+        for(int j = 0; j < num; j++)
+            for(int i = 0; i < NUM_DATES; i++)
+            {
+                str.remove();
+                fmt->format(dates[i], str, *status);
+            }
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return NUM_DATES * num;
+    }
+
+    // Verify that a UErrorCode is successful; exit(1) if not
+    void check(UErrorCode& status, const char* msg) {
+        if (U_FAILURE(status)) {
+            printf("ERROR: %s (%s)\n", u_errorName(status), msg);
+            exit(1);
+        }
+    }
+
+};
+
+// Formats consecutive timestamps a few milliseconds apart, like an access log,
+// optionally with UDAT_FORMAT_CACHE_FIELDS.
+class DateFmtFormatLogFunction : public UPerfFunction
+{
+
+private:
+    int num;
+    SimpleDateFormat *fmt;
+    UDate start;
+
+public:
+
+    DateFmtFormatLogFunction(int a, const char* loc, UBool cacheFields)
+    {
+        num = a;
+        UErrorCode status = U_ZERO_ERROR;
+        fmt = new SimpleDateFormat(UnicodeString("dd/MMM/yyyy:HH:mm:ss.SSS Z"), Locale(loc), status);
+        check(status, "SimpleDateFormat::SimpleDateFormat");
+        fmt->adoptTimeZone(TimeZone::createTimeZone("America/Los_Angeles"));
+        fmt->setBooleanAttribute(UDAT_FORMAT_CACHE_FIELDS, cacheFields, status);
+        check(status, "SimpleDateFormat::setBooleanAttribute");
+        start = 1530695103007.0;  // 2018-07-04T09:05:03.007Z
+    }
+
+    ~DateFmtFormatLogFunction()
+    {
+        delete fmt;
+    }
+
+    virtual void call(UErrorCode* /* status */)
+    {
+        UnicodeString str;
+        for(int j = 0; j < num; j++)
+        {
+            str.remove();
+            fmt->format(start + j * 37.0, str);
+        }
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return num;
+    }
+
+    // Verify that a UErrorCode is successful; exit(1) if not
+    void check(UErrorCode& status, const char* msg) {
+        if (U_FAILURE(status)) {
+            printf("ERROR: %s (%s)\n", u_errorName(status), msg);
+            exit(1);
+        }
+    }
+
+};
+
+class DateFmtFormatSpreadFunction : public UPerfFunction
+{
+
+private:
+    int num;
+    SimpleDateFormat *fmt;
+    Calendar *cal;
+    UBool useCalendar;
+
+public:
+
+    DateFmtFormatSpreadFunction(int a, const char* loc, UBool formatCalendar)
+    {
+        num = a;
+        useCalendar = formatCalendar;
+        UErrorCode status = U_ZERO_ERROR;
+        fmt = new SimpleDateFormat(UnicodeString("EEE, yyyy-MM-dd HH:mm:ss 'week' w"), Locale(loc), status);
+        check(status, "SimpleDateFormat::SimpleDateFormat");
+        fmt->adoptTimeZone(TimeZone::createTimeZone("America/Los_Angeles"));
+        cal = fmt->getCalendar()->clone();
+    }
+
+    ~DateFmtFormatSpreadFunction()
+    {
+        delete cal;
+        delete fmt;
+    }
+
+    virtual void call(UErrorCode* status)
+    {
+        // Dates about 3.7 days apart, so no two share their fields
+        UnicodeString str;
+        UDate start = 946684800000.0;  // 2000-01-01T00:00Z
+        for(int j = 0; j < num; j++)
+        {
+            UDate date = start + j * 321987654.0;
+            str.remove();
+            if (useCalendar) {
+                // The path taken before UDate formatting computed Gregorian fields directly
+                cal->setTime(date, *status);
+                FieldPosition pos(FieldPosition::DONT_CARE);
+                fmt->format(*cal, str, pos);
+            } else {
+                fmt->format(date, str);
+            }
+        }
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return num;
+    }
+
+    // Verify that a UErrorCode is successful; exit(1) if not
+    void check(UErrorCode& status, const char* msg) {
+        if (U_FAILURE(status)) {
+            printf("ERROR: %s (%s)\n", u_errorName(status), msg);
+            exit(1);
+        }
+    }
+
+};
+
+class DateFmtParseNumericFunction : public UPerfFunction
+{
+
+private:
+    int num;
+    SimpleDateFormat *fmt;
+    Calendar *cal;
+    UBool useCalendar;
+    UnicodeString *texts;
+
+public:
+
+    DateFmtParseNumericFunction(int a, const char* loc, UBool parseCalendar)
+    {
+        num = a;
+        useCalendar = parseCalendar;
+        UErrorCode status = U_ZERO_ERROR;
+        fmt = new SimpleDateFormat(UnicodeString("yyyy-MM-dd HH:mm:ss.SSS"), Locale(loc), status);
+        check(status, "SimpleDateFormat::SimpleDateFormat");
+        fmt->adoptTimeZone(TimeZone::createTimeZone("America/Los_Angeles"));
+        cal = fmt->getCalendar()->clone();
+        // Log timestamps, formatted before the timing starts
+        texts = new UnicodeString[num];
+        for(int j = 0; j < num; j++)
+        {
+            fmt->format(1530695103007.0 + j * 3456789.0, texts[j]);
+        }
+    }
+
+    ~DateFmtParseNumericFunction()
+    {
+        delete[] texts;
+        delete cal;
+        delete fmt;
+    }
+
+    virtual void call(UErrorCode* status)
+    {
+        for(int j = 0; j < num; j++)
+        {
+            ParsePosition pos(0);
+            if (useCalendar) {
+                // The path taken before numeric patterns were scanned directly
+                cal->clear();
+                fmt->parse(texts[j], *cal, pos);
+                cal->getTime(*status);
+            } else {
+                fmt->parse(texts[j], pos);
+            }
+            if (pos.getIndex() == 0) {
+                *status = U_PARSE_ERROR;
+            }
+        }
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return num;
+    }
+
+    // Verify that a UErrorCode is successful; exit(1) if not
+    void check(UErrorCode& status, const char* msg) {
+        if (U_FAILURE(status)) {
+            printf("ERROR: %s (%s)\n", u_errorName(status), msg);
+            exit(1);
+        }
+    }
+
+};
+
+class TimeZoneGetOffsetFunction : public UPerfFunction
+{
+
+private:
+    int num;
+    BasicTimeZone *zone;
+    UBool local;
+    UBool bulk;
+    UDate *dates;
+    int32_t *rawOffsets;
+    int32_t *dstOffsets;
+
+public:
+
+    TimeZoneGetOffsetFunction(int a, UBool localTime, UBool nearby, UBool bulkLookup = FALSE)
+    {
+        num = a;
+        local = localTime;
+        bulk = bulkLookup;
+        zone = (BasicTimeZone *)TimeZone::createTimeZone("America/New_York");
+        rawOffsets = new int32_t[num];
+        dstOffsets = new int32_t[num];
+        // Historical dates (before the zone's final rule), scattered over 1900..2006,
+        // or a minute apart
+        dates = new UDate[num];
+        for(int j = 0; j < num; j++)
+        {
+            if (nearby) {
+                dates[j] = 946684800000.0 + j * 60000.0;  // from 2000-01-01T00:00Z
+            } else {
+                dates[j] = -2208988800000.0 + ((j * 7919) % num) * (3376598400000.0 / num);
+            }
+        }
+    }
+
+    ~TimeZoneGetOffsetFunction()
+    {
+        delete[] dates;
+        delete[] rawOffsets;
+        delete[] dstOffsets;
+        delete zone;
+    }
+
+    virtual void call(UErrorCode* status)
+    {
+        if (bulk) {
+            zone->getOffsets(dates, num, local, rawOffsets, dstOffsets, *status);
+            return;
+        }
+        for(int j = 0; j < num; j++)
+        {
+            zone->getOffset(dates[j], local, rawOffsets[j], dstOffsets[j], *status);
+        }
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return num;
+    }
+
+};
+
+class TimeZoneLocalFieldsFunction : public UPerfFunction
+{
+
+private:
+    int num;
+    BasicTimeZone *zone;
+    Calendar *cal;
+    UBool bulk;
+    UDate *dates;
+    int32_t *years;
+    int32_t *months;
+    int32_t *days;
+    int32_t *millis;
+
+public:
+
+    TimeZoneLocalFieldsFunction(int a, UBool nearby, UBool bulkLookup)
+    {
+        num = a;
+        bulk = bulkLookup;
+        zone = (BasicTimeZone *)TimeZone::createTimeZone("America/New_York");
+        UErrorCode status = U_ZERO_ERROR;
+        cal = Calendar::createInstance(*zone, Locale::getUS(), status);
+        if (U_FAILURE(status)) {
+            fprintf(stderr, "Failed to create a calendar: %s\n", u_errorName(status));
+            exit(1);
+        }
+        years = new int32_t[num];
+        months = new int32_t[num];
+        days = new int32_t[num];
+        millis = new int32_t[num];
+        // The same dates as TimeZoneGetOffsetFunction
+        dates = new UDate[num];
+        for(int j = 0; j < num; j++)
+        {
+            if (nearby) {
+                dates[j] = 946684800000.0 + j * 60000.0;  // from 2000-01-01T00:00Z
+            } else {
+                dates[j] = -2208988800000.0 + ((j * 7919) % num) * (3376598400000.0 / num);
+            }
+        }
+    }
+
+    ~TimeZoneLocalFieldsFunction()
+    {
+        delete[] dates;
+        delete[] years;
+        delete[] months;
+        delete[] days;
+        delete[] millis;
+        delete cal;
+        delete zone;
+    }
+
+    virtual void call(UErrorCode* status)
+    {
+        if (bulk) {
+            zone->getLocalFields(dates, num, years, months, days, millis, *status);
+            return;
+        }
+        for(int j = 0; j < num; j++)
+        {
+            cal->setTime(dates[j], *status);
+            years[j] = cal->get(UCAL_EXTENDED_YEAR, *status);
+            months[j] = cal->get(UCAL_MONTH, *status);
+            days[j] = cal->get(UCAL_DATE, *status);
+            millis[j] = cal->get(UCAL_MILLISECONDS_IN_DAY, *status);
+        }
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return num;
+    }
+
+};
+
+class TimeZoneLookupFunction : public UPerfFunction
+{
+
+private:
+    int num;
+    UBool canonical;
+    UnicodeString ids[8];
+
+public:
+
+    TimeZoneLookupFunction(int a, UBool canonicalID)
+    {
+        num = a;
+        canonical = canonicalID;
+        static const char* const IDS[] = {
+            "America/New_York", "Europe/London", "Asia/Tokyo", "America/Los_Angeles",
+            "US/Eastern", "Europe/Paris", "Asia/Calcutta", "Australia/Sydney"
+        };
+        for(int i = 0; i < 8; i++)
+        {
+            ids[i] = UnicodeString(IDS[i], -1, US_INV);
+        }
+    }
+
+    virtual void call(UErrorCode* status)
+    {
+        UnicodeString canonicalID;
+        for(int j = 0; j < num; j++)
+        {
+            if (canonical) {
+                TimeZone::getCanonicalID(ids[j % 8], canonicalID, *status);
+            } else {
+                delete TimeZone::createTimeZone(ids[j % 8]);
+            }
+        }
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return num;
+    }
+
+};
+
+class TimeZoneParseFunction : public UPerfFunction
+{
+
+private:
+    int num;
+    UTimeZoneFormatStyle style;
+    TimeZoneFormat *tzfmt;
+    UnicodeString names[4];
+
+public:
+
+    TimeZoneParseFunction(int a, UTimeZoneFormatStyle parseStyle, const char* const texts[4])
+    {
+        num = a;
+        style = parseStyle;
+        UErrorCode status = U_ZERO_ERROR;
+        tzfmt = TimeZoneFormat::createInstance(Locale::getUS(), status);
+        for(int i = 0; i < 4; i++)
+        {
+            names[i] = UnicodeString(texts[i], -1, US_INV);
+        }
+        if (U_FAILURE(status)) {
+            printf("ERROR: %s (TimeZoneFormat::createInstance)\n", u_errorName(status));
+            exit(1);
+        }
+    }
+
+    ~TimeZoneParseFunction()
+    {
+        delete tzfmt;
+    }
+
+    virtual void call(UErrorCode* /* status */)
+    {
+        for(int j = 0; j < num; j++)
+        {
+            ParsePosition pos(0);
+            delete tzfmt->parse(style, names[j % 4], pos);
+        }
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return num;
+    }
+
+};
+
 class DateFmtCreateFunction : public UPerfFunction
 {
 
@@ -826,6 +1309,28 @@ class DateFormatPerfTest : public UPerfTest
 	UPerfFunction* DateFmtCreate10000();
 	UPerfFunction* DateFmtCopy250();
 	UPerfFunction* DateFmtCopy10000();
+	UPerfFunction* DateFmtFormatNumeric10000();
+	UPerfFunction* DateFmtFormatNames10000();
+	UPerfFunction* DateFmtFormatLog10000();
+	UPerfFunction* DateFmtFormatLogCached10000();
+	UPerfFunction* DateFmtFormatSpread10000();
+	UPerfFunction* DateFmtFormatSpreadCalendar10000();
+	UPerfFunction* DateFmtParseNumeric10000();
+	UPerfFunction* DateFmtParseNumericCalendar10000();
+	UPerfFunction* TimeZoneGetOffset10000();
+	UPerfFunction* TimeZoneGetOffsetLocal10000();
+	UPerfFunction* TimeZoneGetOffsetNearby10000();
+	UPerfFunction* TimeZoneCreateIDs10000();
+	UPerfFunction* TimeZoneCanonicalID10000();
+	UPerfFunction* TimeZoneParseSpecific10000();
+	UPerfFunction* TimeZoneParseLocation10000();
+	UPerfFunction* TimeZoneGetOffsets10000();
+	UPerfFunction* TimeZoneGetOffsetsLocal10000();
+	UPerfFunction* TimeZoneGetOffsetsNearby10000();
+	UPerfFunction* TimeZoneLocalFieldsCalendar10000();
+	UPerfFunction* TimeZoneLocalFields10000();
+	UPerfFunction* TimeZoneLocalFieldsNearbyCalendar10000();
+	UPerfFunction* TimeZoneLocalFieldsNearby10000();
 	UPerfFunction* BreakItWord250();
 	UPerfFunction* BreakItWord10000();
 	UPerfFunction* BreakItChar250();
@@ -24,13 +24,20 @@
  *  ./dicttrieperf --sourcedir <ICU build tree>/data/out/tmp --passes 3 --iterations 1000
  * or
  *  ./dicttrieperf -f <ICU source tree>/source/data/brkitr/thaidict.txt --passes 3 --iterations 250
+ * The dictbreak test measures word break iteration throughput of the dictionary-based
+ * break engines, over the words of the dictionary file concatenated without spaces:
+ *  ./dicttrieperf -f <ICU source tree>/source/data/brkitr/dictionaries/thaidict.txt --passes 3 --iterations 10 dictbreak
+ * The dictbreakbestpath test does the same with RuleBasedBreakIterator::setDictionaryBestPath(TRUE).
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "unicode/brkiter.h"
+#include "unicode/rbbi.h"
 #include "unicode/bytestrie.h"
 #include "unicode/bytestriebuilder.h"
 #include "unicode/localpointer.h"
+#include "unicode/locid.h"
 #include "unicode/ucharstrie.h"
 #include "unicode/ucharstriebuilder.h"
 #include "unicode/uperf.h"
@@ -642,6 +649,62 @@ class BytesTrieDictContains : public BytesTrieDictLookup {
     }
 };
 
+// Word break iteration over all of the dictionary words, concatenated without spaces
+// the way Thai, Lao, Khmer and Burmese text is written.
+// Exercises the dictionary break engine for the script of the dictionary file.
+class DictBreakIteration : public UPerfFunction {
+public:
+    DictBreakIteration(const DictionaryTriePerfTest &perfTest, UBool bestPath=FALSE) : numBreaks(0) {
+        IcuToolErrorCode errorCode("DictBreakIteration()");
+        const ULine *lines=perfTest.getCachedLines();
+        int32_t numLines=perfTest.getNumLines();
+        for(int32_t i=0; i<numLines; ++i) {
+            // Skip comment lines (start with a character below 'A').
+            if(lines[i].name[0]<0x41) {
+                continue;
+            }
+            // Words may be followed by a tab and a value (cjdict.txt).
+            int32_t wordLength=0;
+            while(wordLength<lines[i].len && lines[i].name[wordLength]!=9) {
+                ++wordLength;
+            }
+            text.append(lines[i].name, wordLength);
+        }
+        bi.adoptInstead(BreakIterator::createWordInstance(Locale::getRoot(), errorCode));
+        if(errorCode.isFailure()) {
+            fprintf(stderr, "BreakIterator::createWordInstance() failed: %s\n", errorCode.errorName());
+            return;
+        }
+        ((RuleBasedBreakIterator *)bi.getAlias())->setDictionaryBestPath(bestPath);
+    }
+
+    virtual void call(UErrorCode * /*pErrorCode*/) {
+        if(bi.isNull()) {
+            return;
+        }
+        // Resetting the text discards the break iterator's cached boundaries.
+        bi->setText(text);
+        int32_t count=0;
+        for(int32_t pos=bi->first(); pos!=UBRK_DONE; pos=bi->next()) {
+            ++count;
+        }
+        numBreaks=count;
+    }
+
+    virtual long getOperationsPerIteration() {
+        return text.length();
+    }
+
+    virtual long getEventsPerIteration() {
+        return numBreaks;
+    }
+
+protected:
+    UnicodeString text;
+    LocalPointer<BreakIterator> bi;
+    int32_t numBreaks;
+};
+
 UPerfFunction *DictionaryTriePerfTest::runIndexedTest(int32_t index, UBool exec,
                                                       const char *&name, char * /*par*/) {
     if(hasFile()) {
@@ -670,6 +733,18 @@ UPerfFunction *DictionaryTriePerfTest::runIndexedTest(int32_t index, UBool exec,
                 return new BytesTrieDictContains(*this);
             }
             break;
+        case 4:
+            name="dictbreak";
+            if(exec) {
+                return new DictBreakIteration(*this);
+            }
+            break;
+        case 5:
+            name="dictbreakbestpath";
+            if(exec) {
+                return new DictBreakIteration(*this, TRUE);
+            }
+            break;
         default:
             name="";
             break;
@@ -741,6 +741,69 @@ OpenCloseTest(gb18030,ucnv,open,{},("gb18030",&setupStatus),{})
 #include "unicode/ures.h"
 OpenCloseTest(root,ures,open,{},(NULL,"root",&setupStatus),{})
 
+#if !UCONFIG_NO_BREAK_ITERATION
+#include "unicode/brkiter.h"
+#include "unicode/localpointer.h"
+
+/* ------- break iterator creation ------------- */
+
+/**
+ * Cost of obtaining a word break iterator per request, and optionally
+ * iterating forward over a short text with it, which is all that many
+ * callers do.
+ */
+class BrkIterTest : public HowExpensiveTest {
+public:
+  enum EMode { kCreate, kClone, kCloneNext };
+private:
+  EMode fMode;
+  LocalPointer<BreakIterator> fProto;
+  UnicodeString fText;
+  char name[100];
+public:
+  BrkIterTest(EMode mode, const char *FILE, int LINE)
+    : HowExpensiveTest("(n/a)", FILE, LINE),
+      fMode(mode),
+      fText(u"The quick (\"brown\") fox can't jump 32.3 feet, right?")
+  {
+    name[0]=0;
+  }
+  virtual const char *getName() {
+    if(name[0]==0) {
+      sprintf(name,"Test_BreakIterator_%s",
+              fMode==kCreate ? "createWordInstance" : fMode==kClone ? "clone" : "clone_next");
+    }
+    return name;
+  }
+  void warmup() {
+    fProto.adoptInstead(BreakIterator::createWordInstance(Locale(TEST_LOCALE), setupStatus));
+    if(U_SUCCESS(setupStatus)) {
+      run();
+    }
+  }
+  int32_t run() {
+    int32_t i;
+    for(i=0;i<U_LOTS_OF_TIMES;i++) {
+      BreakIterator *bi;
+      if(fMode==kCreate) {
+        bi = BreakIterator::createWordInstance(Locale(TEST_LOCALE), setupStatus);
+      } else {
+        bi = fProto->clone();
+        if(fMode==kCloneNext) {
+          bi->setText(fText);
+          while(bi->next()!=BreakIterator::DONE) {}
+        }
+      }
+      delete bi;
+    }
+    return i;
+  }
+  virtual ~BrkIterTest(){}
+};
+
+#define DO_BrkIterTest(m) { BrkIterTest t(BrkIterTest::m,__FILE__,__LINE__); runTestOn(t); }
+#endif
+
 void runTests() {
   {
     SieveTest t;
@@ -865,6 +928,12 @@ void runTests() {
     runTestOn(t);
   }
 
+#if !UCONFIG_NO_BREAK_ITERATION
+  DO_BrkIterTest(kCreate);
+  DO_BrkIterTest(kClone);
+  DO_BrkIterTest(kCloneNext);
+#endif
+
   if(testhit==0) {
     fprintf(stderr, "ERROR: no tests matched.\n");
   }
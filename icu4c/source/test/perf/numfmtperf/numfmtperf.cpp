@@ -0,0 +1,397 @@
+/*
+ ***********************************************************************
+ * © 2018 and later: Unicode, Inc. and others.
+ * License & terms of use: http://www.unicode.org/copyright.html#License
+ ***********************************************************************
+ *  file name:  numfmtperf.cpp
+ *  encoding:   UTF-8
+ *  tab size:   8 (not used)
+ *  indentation:4
+ *
+ *  Performance test program for number formatting.
+ *  Compares DecimalFormat, LocalizedNumberFormatter and the UNumberFormatter C API,
+ *  including the functions that format into a caller's buffer.
+ *
+ * Usage from within <ICU build tree>/test/perf/numfmtperf/ :
+ * (Linux)
+ *  make
+ *  export LD_LIBRARY_PATH=../../../lib:../../../stubdata:../../../tools/ctestfw
+ *  ./numfmtperf --passes 3 --iterations 100
+ *
+ * Each test formats the same set of numbers: doubles with up to two fraction
+ * digits and integers, of magnitudes from 1 to 10^9.
+ * The Unlimited tests print all digits of the shortest representation, for
+ * those doubles and for random doubles with 16 or 17 digits.
+ * The DecimalFormat tests format into a reused UnicodeString.
+ * The formatter tests format to a FormattedNumber and get its string,
+ * and the ToBuffer and ToUTF8 tests format into a char16_t or char buffer.
+ * openFormatClose opens, uses and closes a UNumberFormatter for each number.
+ * The Parse tests parse the "en" formatted doubles back, leniently and strictly,
+ * and with the C API one string at a time or as one column.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "unicode/decimfmt.h"
+#include "unicode/localpointer.h"
+#include "unicode/numberformatter.h"
+#include "unicode/unum.h"
+#include "unicode/unumberformatter.h"
+#include "unicode/uperf.h"
+#include "unicode/ustring.h"
+#include "unicode/utypes.h"
+#include "cmemory.h" // for UPRV_LENGTHOF
+
+#if !UCONFIG_NO_FORMATTING
+
+using namespace icu::number;
+
+static const int32_t NUM_VALUES = 1000;
+
+// Test object.
+class NumFmtPerfTest : public UPerfTest {
+public:
+    NumFmtPerfTest(int32_t argc, const char *argv[], UErrorCode &status)
+            : UPerfTest(argc, argv, NULL, 0, "", status) {
+        // Spread the numbers over magnitudes, with and without fraction digits.
+        uint32_t seed=1;
+        for(int32_t i=0; i<NUM_VALUES; ++i) {
+            seed=seed*1103515245+12345;
+            int64_t digits=(seed>>8)%1000000000;
+            int64_t scale=1;
+            for(int32_t m=(int32_t)((seed>>4)%9); m>0; --m) {
+                scale*=10;
+            }
+            ints[i]=(digits%(scale*10))*((i&1) ? -1 : 1);
+            doubles[i]=(i%3)==0 ? (double)ints[i] : (double)ints[i]/100.0;
+            seed=seed*1103515245+12345;
+            randomDoubles[i]=((double)seed/4294967296.0+(double)(i+1))*1e-3;
+        }
+    }
+
+    virtual UPerfFunction *runIndexedTest(int32_t index, UBool exec, const char *&name, char *par = NULL);
+
+    double doubles[NUM_VALUES];
+    double randomDoubles[NUM_VALUES];
+    int64_t ints[NUM_VALUES];
+};
+
+class NumFmtPerfFunction : public UPerfFunction {
+public:
+    NumFmtPerfFunction(const NumFmtPerfTest &test) : test(test) {}
+
+    virtual long getOperationsPerIteration() {
+        return NUM_VALUES;
+    }
+
+protected:
+    const NumFmtPerfTest &test;
+};
+
+// Formats with a DecimalFormat.
+class DecimalFormatPerfFunction : public NumFmtPerfFunction {
+public:
+    DecimalFormatPerfFunction(const NumFmtPerfTest &test, NumberFormat *fmt, UBool useInts,
+                              UErrorCode &status)
+            : NumFmtPerfFunction(test), useInts(useInts) {
+        format.adoptInsteadAndCheckErrorCode(fmt, status);
+    }
+
+    virtual void call(UErrorCode * /*pErrorCode*/) {
+        for(int32_t i=0; i<NUM_VALUES; ++i) {
+            result.remove();
+            if(useInts) {
+                format->format(test.ints[i], result);
+            } else {
+                format->format(test.doubles[i], result);
+            }
+        }
+    }
+
+protected:
+    LocalPointer<NumberFormat> format;
+    UnicodeString result;
+    UBool useInts;
+};
+
+// Parses the doubles as formatted by a DecimalFormat.
+class DecimalFormatParsePerfFunction : public NumFmtPerfFunction {
+public:
+    DecimalFormatParsePerfFunction(const NumFmtPerfTest &test, UBool lenient, UErrorCode &status)
+            : NumFmtPerfFunction(test) {
+        format.adoptInsteadAndCheckErrorCode(NumberFormat::createInstance("en", status), status);
+        if(U_FAILURE(status)) {
+            return;
+        }
+        format->setLenient(lenient);
+        for(int32_t i=0; i<NUM_VALUES; ++i) {
+            format->format(test.doubles[i], strings[i]);
+        }
+    }
+
+    virtual void call(UErrorCode *pErrorCode) {
+        Formattable result;
+        for(int32_t i=0; i<NUM_VALUES; ++i) {
+            format->parse(strings[i], result, *pErrorCode);
+        }
+    }
+
+protected:
+    LocalPointer<NumberFormat> format;
+    UnicodeString strings[NUM_VALUES];
+};
+
+// Parses the "en" formatted doubles with the UNumberFormat C API,
+// one string at a time or as one column of UTF-16 or UTF-8 strings.
+class UNumberFormatParsePerfFunction : public NumFmtPerfFunction {
+public:
+    enum Mode { kParseDouble, kParseDoubles, kParseDoublesUTF8 };
+
+    UNumberFormatParsePerfFunction(const NumFmtPerfTest &test, Mode mode, UErrorCode &status)
+            : NumFmtPerfFunction(test), mode(mode) {
+        format.adoptInstead(unum_open(UNUM_DECIMAL, NULL, 0, "en", NULL, &status));
+        if(U_FAILURE(status)) {
+            return;
+        }
+        for(int32_t i=0; i<NUM_VALUES; ++i) {
+            lengths[i]=unum_formatDouble(format.getAlias(), test.doubles[i],
+                                         strings[i], UPRV_LENGTHOF(strings[i]), NULL, &status);
+            u_strToUTF8(utf8Strings[i], UPRV_LENGTHOF(utf8Strings[i]), &utf8Lengths[i],
+                        strings[i], lengths[i], &status);
+            texts[i]=strings[i];
+            utf8Texts[i]=utf8Strings[i];
+        }
+    }
+
+    virtual void call(UErrorCode *pErrorCode) {
+        switch(mode) {
+            case kParseDouble:
+                for(int32_t i=0; i<NUM_VALUES; ++i) {
+                    results[i]=unum_parseDouble(format.getAlias(), strings[i], lengths[i], NULL, pErrorCode);
+                }
+                break;
+            case kParseDoubles:
+                unum_parseDoubles(format.getAlias(), texts, lengths, NUM_VALUES,
+                                  results, NULL, cellStatus, pErrorCode);
+                break;
+            case kParseDoublesUTF8:
+                unum_parseDoublesUTF8(format.getAlias(), utf8Texts, utf8Lengths, NUM_VALUES,
+                                      results, NULL, cellStatus, pErrorCode);
+                break;
+        }
+    }
+
+protected:
+    Mode mode;
+    LocalUNumberFormatPointer format;
+    UChar strings[NUM_VALUES][32];
+    char utf8Strings[NUM_VALUES][32];
+    const UChar *texts[NUM_VALUES];
+    const char *utf8Texts[NUM_VALUES];
+    int32_t lengths[NUM_VALUES];
+    int32_t utf8Lengths[NUM_VALUES];
+    double results[NUM_VALUES];
+    UErrorCode cellStatus[NUM_VALUES];
+};
+
+// Formats with a LocalizedNumberFormatter, in one of several ways.
+class NumberFormatterPerfFunction : public NumFmtPerfFunction {
+public:
+    enum Mode { kFormattedNumber, kToBuffer, kToUTF8, kIntToBuffer, kRandomToBuffer };
+
+    NumberFormatterPerfFunction(const NumFmtPerfTest &test, const char16_t *skeleton, Mode mode,
+                                UErrorCode &status)
+            : NumFmtPerfFunction(test), mode(mode) {
+        formatter=NumberFormatter::forSkeleton(skeleton, status).locale("en");
+        formatter.compile(status);
+    }
+
+    virtual void call(UErrorCode *pErrorCode) {
+        for(int32_t i=0; i<NUM_VALUES; ++i) {
+            switch(mode) {
+            case kFormattedNumber:
+                result=formatter.formatDouble(test.doubles[i], *pErrorCode).toString();
+                break;
+            case kToBuffer:
+                formatter.formatDoubleToBuffer(test.doubles[i], buffer, UPRV_LENGTHOF(buffer), *pErrorCode);
+                break;
+            case kToUTF8:
+                formatter.formatDoubleToUTF8(test.doubles[i], buffer8, UPRV_LENGTHOF(buffer8), *pErrorCode);
+                break;
+            case kIntToBuffer:
+                formatter.formatIntToBuffer(test.ints[i], buffer, UPRV_LENGTHOF(buffer), *pErrorCode);
+                break;
+            case kRandomToBuffer:
+                formatter.formatDoubleToBuffer(test.randomDoubles[i], buffer, UPRV_LENGTHOF(buffer),
+                                               *pErrorCode);
+                break;
+            }
+        }
+    }
+
+protected:
+    LocalizedNumberFormatter formatter;
+    Mode mode;
+    UnicodeString result;
+    char16_t buffer[64];
+    char buffer8[128];
+};
+
+// Formats with the UNumberFormatter C API.
+class UNumberFormatterPerfFunction : public NumFmtPerfFunction {
+public:
+    enum Mode { kResult, kToBuffer, kOpenFormatClose };
+
+    UNumberFormatterPerfFunction(const NumFmtPerfTest &test, const char16_t *skeleton, Mode mode,
+                                 UErrorCode &status)
+            : NumFmtPerfFunction(test), skeleton(skeleton), mode(mode) {
+        formatter.adoptInstead(unumf_openForSkeletonAndLocale(skeleton, -1, "en", &status));
+        result.adoptInstead(unumf_openResult(&status));
+    }
+
+    virtual void call(UErrorCode *pErrorCode) {
+        for(int32_t i=0; i<NUM_VALUES; ++i) {
+            switch(mode) {
+            case kResult:
+                unumf_formatDouble(formatter.getAlias(), test.doubles[i], result.getAlias(), pErrorCode);
+                unumf_resultToString(result.getAlias(), buffer, UPRV_LENGTHOF(buffer), pErrorCode);
+                break;
+            case kToBuffer:
+                unumf_formatDoubleToBuffer(formatter.getAlias(), test.doubles[i],
+                                           buffer, UPRV_LENGTHOF(buffer), pErrorCode);
+                break;
+            case kOpenFormatClose: {
+                UNumberFormatter *f=unumf_openForSkeletonAndLocale(skeleton, -1, "en", pErrorCode);
+                unumf_formatDoubleToBuffer(f, test.doubles[i], buffer, UPRV_LENGTHOF(buffer), pErrorCode);
+                unumf_close(f);
+                break;
+            }
+            }
+        }
+    }
+
+protected:
+    const char16_t *skeleton;
+    Mode mode;
+    LocalUNumberFormatterPointer formatter;
+    LocalUFormattedNumberPointer result;
+    UChar buffer[64];
+};
+
+UPerfFunction *NumFmtPerfTest::runIndexedTest(int32_t index, UBool exec,
+                                              const char *&name, char * /*par*/) {
+    static const char *const names[]={
+        "decimalFormatDouble", "decimalFormatInt64", "decimalFormatCurrency", "decimalFormatPattern",
+        "formatterDouble", "formatterDoubleToBuffer", "formatterDoubleToUTF8", "formatterInt64ToBuffer",
+        "formatterCurrencyToBuffer", "formatterDoubleUnlimited", "formatterRandomDoubleUnlimited",
+        "unumfFormatDouble", "unumfFormatDoubleToBuffer", "unumfOpenFormatClose",
+        "decimalFormatParse", "decimalFormatParseStrict",
+        "unumParseDouble", "unumParseDoubles", "unumParseDoublesUTF8"
+    };
+    if(index<0 || index>=UPRV_LENGTHOF(names)) {
+        name="";
+        return NULL;
+    }
+    name=names[index];
+    if(!exec) {
+        return NULL;
+    }
+    UErrorCode status=U_ZERO_ERROR;
+    UPerfFunction *fn=NULL;
+    switch(index) {
+    case 0:
+        fn=new DecimalFormatPerfFunction(*this, NumberFormat::createInstance("en", status), FALSE, status);
+        break;
+    case 1:
+        fn=new DecimalFormatPerfFunction(*this, NumberFormat::createInstance("en", status), TRUE, status);
+        break;
+    case 2:
+        fn=new DecimalFormatPerfFunction(*this, NumberFormat::createCurrencyInstance("en_US", status),
+                                         FALSE, status);
+        break;
+    case 3:
+        fn=new DecimalFormatPerfFunction(
+            *this, new DecimalFormat(u"#,##0.00", new DecimalFormatSymbols("en", status), status),
+            FALSE, status);
+        break;
+    case 4:
+        fn=new NumberFormatterPerfFunction(*this, u"", NumberFormatterPerfFunction::kFormattedNumber, status);
+        break;
+    case 5:
+        fn=new NumberFormatterPerfFunction(*this, u"", NumberFormatterPerfFunction::kToBuffer, status);
+        break;
+    case 6:
+        fn=new NumberFormatterPerfFunction(*this, u"", NumberFormatterPerfFunction::kToUTF8, status);
+        break;
+    case 7:
+        fn=new NumberFormatterPerfFunction(*this, u"", NumberFormatterPerfFunction::kIntToBuffer, status);
+        break;
+    case 8:
+        fn=new NumberFormatterPerfFunction(*this, u"currency/USD",
+                                           NumberFormatterPerfFunction::kToBuffer, status);
+        break;
+    case 9:
+        fn=new NumberFormatterPerfFunction(*this, u"precision-unlimited",
+                                           NumberFormatterPerfFunction::kToBuffer, status);
+        break;
+    case 10:
+        fn=new NumberFormatterPerfFunction(*this, u"precision-unlimited",
+                                           NumberFormatterPerfFunction::kRandomToBuffer, status);
+        break;
+    case 11:
+        fn=new UNumberFormatterPerfFunction(*this, u"", UNumberFormatterPerfFunction::kResult, status);
+        break;
+    case 12:
+        fn=new UNumberFormatterPerfFunction(*this, u"", UNumberFormatterPerfFunction::kToBuffer, status);
+        break;
+    case 13:
+        fn=new UNumberFormatterPerfFunction(*this, u"precision-integer",
+                                            UNumberFormatterPerfFunction::kOpenFormatClose, status);
+        break;
+    case 14:
+        fn=new DecimalFormatParsePerfFunction(*this, TRUE, status);
+        break;
+    case 15:
+        fn=new DecimalFormatParsePerfFunction(*this, FALSE, status);
+        break;
+    case 16:
+        fn=new UNumberFormatParsePerfFunction(*this, UNumberFormatParsePerfFunction::kParseDouble, status);
+        break;
+    case 17:
+        fn=new UNumberFormatParsePerfFunction(*this, UNumberFormatParsePerfFunction::kParseDoubles, status);
+        break;
+    default:
+        fn=new UNumberFormatParsePerfFunction(*this, UNumberFormatParsePerfFunction::kParseDoublesUTF8,
+                                              status);
+        break;
+    }
+    if(U_FAILURE(status)) {
+        fprintf(stderr, "error: %s setup failed - %s\n", name, u_errorName(status));
+        delete fn;
+        return NULL;
+    }
+    return fn;
+}
+
+int main(int argc, const char *argv[]) {
+    UErrorCode status=U_ZERO_ERROR;
+    NumFmtPerfTest test(argc, argv, status);
+    if(U_FAILURE(status)) {
+        fprintf(stderr, "error: NumFmtPerfTest setup failed - %s\n", u_errorName(status));
+        return status;
+    }
+    if(test.run()==FALSE){
+        fprintf(stderr, "FAILED: Tests could not be run, please check the arguments.\n");
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main(int /*argc*/, const char * /*argv*/[]) {
+    fprintf(stderr, "numfmtperf: formatting is disabled in this build of ICU\n");
+    return 0;
+}
+
+#endif  // !UCONFIG_NO_FORMATTING
@@ -0,0 +1,349 @@
+/*
+ ***********************************************************************
+ * © 2016 and later: Unicode, Inc. and others.
+ * License & terms of use: http://www.unicode.org/copyright.html#License
+ ***********************************************************************
+ *  file name:  regexperf.cpp
+ *  encoding:   UTF-8
+ *  tab size:   8 (not used)
+ *  indentation:4
+ *
+ *  Performance test program for regular expression matching.
+ *  Each test runs once with the DFA match engine, for those patterns that
+ *  it supports, and once with the backtracking match engine only.
+ *
+ * Usage from within <ICU build tree>/test/perf/regexperf/ :
+ * (Linux)
+ *  make
+ *  export LD_LIBRARY_PATH=../../../lib:../../../stubdata:../../../tools/ctestfw
+ *  ./regexperf -f <text file> -e UTF-8 --passes 3 --iterations 100
+ *
+ * The find tests count all matches of a pattern over the text of the file.
+ * The UTF-8 find tests do the same over a UTF-8 copy of the text, read through
+ * utext_openUTF8().
+ * The literal, suffix and absent tests exercise the search for literal text that
+ * lets find() skip over input that can not contain a match.
+ * The set tests classify each line of the file with a few hundred patterns, with a
+ * RegexSet and with a separate RegexMatcher per pattern.
+ * The pathological tests do not need a file; they run patterns that take
+ * exponential time with the backtracking engine over short inputs, also with
+ * memoization in the backtracking engine.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include "unicode/localpointer.h"
+#include "unicode/regex.h"
+#include "unicode/uchar.h"
+#include "unicode/uperf.h"
+#include "unicode/utext.h"
+#include "unicode/utypes.h"
+#include "cmemory.h" // for UPRV_LENGTHOF
+#include "ucbuf.h"  // struct ULine
+
+#if !UCONFIG_NO_REGULAR_EXPRESSIONS
+
+// Test object.
+class RegexPerfTest : public UPerfTest {
+public:
+    RegexPerfTest(int32_t argc, const char *argv[], UErrorCode &status)
+            : UPerfTest(argc, argv, NULL, 0, "", status), text(NULL), textLength(0) {
+        if(U_SUCCESS(status) && ucharBuf!=NULL) {
+            text=getBuffer(textLength, status);
+            getLines(status);
+        }
+    }
+
+    // Patterns for the set tests: the distinct words of at least 5 letters in the text,
+    // in order of appearance, each followed by the rest of its word.
+    void getWordPatterns(UnicodeString *patterns, int32_t capacity, int32_t &count) const {
+        count=0;
+        int32_t i=0;
+        while(i<textLength && count<capacity) {
+            int32_t start=i;
+            while(i<textLength && u_isalpha(text[i])) {
+                ++i;
+            }
+            if(i-start>=5) {
+                UnicodeString pattern(text+start, i-start);
+                pattern.append(u"\\w*", -1);
+                int32_t j;
+                for(j=0; j<count && patterns[j]!=pattern; ++j) {}
+                if(j==count) {
+                    patterns[count++]=pattern;
+                }
+            }
+            if(i==start) {
+                ++i;
+            }
+        }
+    }
+
+    virtual UPerfFunction *runIndexedTest(int32_t index, UBool exec, const char *&name, char *par=NULL);
+
+    const ULine *getCachedLines() const { return lines; }
+    int32_t getNumLines() const { return numLines; }
+
+    const UChar *text;
+    int32_t textLength;
+};
+
+// Finds all matches of a pattern over the file text, in UTF-16 or in UTF-8.
+class RegexFindPerfFunction : public UPerfFunction {
+public:
+    RegexFindPerfFunction(const RegexPerfTest &test, const char *pattern, UBool useDFA, UBool useUTF8,
+                          UErrorCode &status)
+            : text8(NULL), textLength(test.textLength), numMatches(0) {
+        if(U_FAILURE(status)) {
+            return;
+        }
+        if(test.text==NULL) {
+            fprintf(stderr, "error: the find tests require a text file (-f)\n");
+            status=U_ILLEGAL_ARGUMENT_ERROR;
+            return;
+        }
+        matcher.adoptInsteadAndCheckErrorCode(
+            new RegexMatcher(UnicodeString(pattern, -1, US_INV), 0, status), status);
+        if(U_FAILURE(status)) {
+            return;
+        }
+        matcher->setUseDFA(useDFA);
+        input.setTo(FALSE, test.text, test.textLength);
+        if(useUTF8) {
+            input.toUTF8String(input8);
+            text8=utext_openUTF8(NULL, input8.data(), (int64_t)input8.length(), &status);
+            if(U_FAILURE(status)) {
+                return;
+            }
+            matcher->reset(text8);
+        } else {
+            matcher->reset(input);
+        }
+    }
+
+    virtual ~RegexFindPerfFunction() {
+        utext_close(text8);
+    }
+
+    virtual void call(UErrorCode *pErrorCode) {
+        matcher->reset();
+        int32_t count=0;
+        while(matcher->find(*pErrorCode)) {
+            ++count;
+        }
+        numMatches=count;
+    }
+
+    virtual long getOperationsPerIteration() {
+        return textLength;
+    }
+
+    virtual long getEventsPerIteration() {
+        return numMatches;
+    }
+
+protected:
+    LocalPointer<RegexMatcher> matcher;
+    UnicodeString input;
+    std::string input8;
+    UText *text8;
+    int32_t textLength;
+    int32_t numMatches;
+};
+
+// Runs matches() with a pattern that needs exponential time with a backtracking
+// engine, on a string of 'a' that does not match.
+class RegexPathologicalPerfFunction : public UPerfFunction {
+public:
+    RegexPathologicalPerfFunction(const char *pattern, int32_t length, UBool useDFA, UBool memoize,
+                                  UErrorCode &status)
+            : inputLength(length) {
+        if(U_FAILURE(status)) {
+            return;
+        }
+        for(int32_t i=0; i<length; ++i) {
+            input.append((UChar)0x61);
+        }
+        matcher.adoptInsteadAndCheckErrorCode(
+            new RegexMatcher(UnicodeString(pattern, -1, US_INV), input, 0, status), status);
+        if(U_SUCCESS(status)) {
+            matcher->setUseDFA(useDFA);
+            matcher->setMemoizeBacktracking(memoize, status);
+        }
+    }
+
+    virtual void call(UErrorCode *pErrorCode) {
+        matcher->reset();
+        if(matcher->matches(*pErrorCode)) {
+            fprintf(stderr, "error: unexpected match\n");
+        }
+    }
+
+    virtual long getOperationsPerIteration() {
+        return inputLength;
+    }
+
+protected:
+    LocalPointer<RegexMatcher> matcher;
+    UnicodeString input;
+    int32_t inputLength;
+};
+
+// Classifies each line of the file with a set of patterns.
+class RegexSetPerfFunction : public UPerfFunction {
+public:
+    RegexSetPerfFunction(const RegexPerfTest &test, UBool useSet, UErrorCode &status)
+            : useSet(useSet), set(status), textLength(test.textLength), numMatches(0) {
+        if(U_FAILURE(status)) {
+            return;
+        }
+        if(test.text==NULL) {
+            fprintf(stderr, "error: the set tests require a text file (-f)\n");
+            status=U_ILLEGAL_ARGUMENT_ERROR;
+            return;
+        }
+        int32_t count;
+        test.getWordPatterns(patterns, UPRV_LENGTHOF(patterns), count);
+        for(int32_t i=0; i<count && U_SUCCESS(status); ++i) {
+            set.add(patterns[i], 0, status);
+            matchers[i].adoptInsteadAndCheckErrorCode(new RegexMatcher(patterns[i], 0, status), status);
+        }
+        numLines=test.getNumLines();
+        if(numLines>UPRV_LENGTHOF(lines)) {
+            numLines=UPRV_LENGTHOF(lines);
+        }
+        for(int32_t i=0; i<numLines; ++i) {
+            const ULine &line=test.getCachedLines()[i];
+            lines[i].setTo(FALSE, line.name, line.len);
+        }
+    }
+
+    virtual void call(UErrorCode *pErrorCode) {
+        int32_t count=0;
+        int32_t found[UPRV_LENGTHOF(patterns)];
+        for(int32_t i=0; i<numLines; ++i) {
+            if(useSet) {
+                count+=set.findAll(lines[i], found, UPRV_LENGTHOF(found), *pErrorCode);
+            } else {
+                for(int32_t p=0; p<set.size(); ++p) {
+                    matchers[p]->reset(lines[i]);
+                    if(matchers[p]->find(*pErrorCode)) {
+                        ++count;
+                    }
+                }
+            }
+        }
+        numMatches=count;
+    }
+
+    virtual long getOperationsPerIteration() {
+        return textLength;
+    }
+
+    virtual long getEventsPerIteration() {
+        return numMatches;
+    }
+
+protected:
+    UBool useSet;
+    RegexSet set;
+    UnicodeString patterns[300];
+    LocalPointer<RegexMatcher> matchers[300];
+    UnicodeString lines[5000];
+    int32_t numLines;
+    int32_t textLength;
+    int32_t numMatches;
+};
+
+// Patterns for the find tests.
+static const char *const findPatterns[]={
+    "[A-Za-z]+ing",                         // words
+    "\\p{Lu}\\p{Ll}+ \\p{Lu}\\p{Ll}+",      // name-like word pairs
+    "[\\w.]+@\\w+(\\.\\w+)+",               // email-like, with a capture group
+    "\\d+(\\.\\d+)?%?",                     // numbers
+    "(?i)(the|of|and) +\\w+",               // case-insensitive alternation
+    "Unicode",                              // literal
+    "\\w+ization",                          // required literal after a repetition
+    "[\\w.]+@example\\.org"                 // required literal that does not occur
+};
+
+// Patterns for the UTF-8 find tests.
+static const char *const findUTF8Patterns[]={
+    "[A-Za-z]+ing",                         // words
+    "(?i)(the|of|and) +\\w+"                // case-insensitive alternation
+};
+
+UPerfFunction *RegexPerfTest::runIndexedTest(int32_t index, UBool exec,
+                                             const char *&name, char * /*par*/) {
+    static const char *const names[]={
+        "findWordsDFA", "findWordsBacktrack",
+        "findNamesDFA", "findNamesBacktrack",
+        "findEmailDFA", "findEmailBacktrack",
+        "findNumbersDFA", "findNumbersBacktrack",
+        "findCaselessDFA", "findCaselessBacktrack",
+        "findLiteralDFA", "findLiteralBacktrack",
+        "findSuffixDFA", "findSuffixBacktrack",
+        "findAbsentDFA", "findAbsentBacktrack",
+        "findWordsUTF8DFA", "findWordsUTF8Backtrack",
+        "findCaselessUTF8DFA", "findCaselessUTF8Backtrack",
+        "nestedPlusDFA", "nestedPlusBacktrack", "nestedPlusMemo",
+        "alternationStarDFA", "alternationStarBacktrack", "alternationStarMemo",
+        "classifyLinesRegexSet", "classifyLinesMatchers"
+    };
+    if(index<0 || index>=UPRV_LENGTHOF(names)) {
+        name="";
+        return NULL;
+    }
+    name=names[index];
+    if(!exec) {
+        return NULL;
+    }
+    UErrorCode status=U_ZERO_ERROR;
+    UBool useDFA=(index&1)==0;
+    UPerfFunction *fn;
+    const int32_t numFind=2*UPRV_LENGTHOF(findPatterns);
+    const int32_t numFindUTF8=2*UPRV_LENGTHOF(findUTF8Patterns);
+    if(index<numFind) {
+        fn=new RegexFindPerfFunction(*this, findPatterns[index/2], useDFA, FALSE, status);
+    } else if(index<numFind+numFindUTF8) {
+        fn=new RegexFindPerfFunction(*this, findUTF8Patterns[(index-numFind)/2], useDFA, TRUE, status);
+    } else if(index<numFind+numFindUTF8+6) {
+        // DFA, backtracking, and backtracking with memoization.
+        int32_t variant=(index-numFind-numFindUTF8)%3;
+        const char *pattern=index<numFind+numFindUTF8+3 ? "(a+)+b" : "(a|aa)*b";
+        int32_t length=index<numFind+numFindUTF8+3 ? 22 : 28;
+        fn=new RegexPathologicalPerfFunction(pattern, length, variant==0, variant==2, status);
+    } else {
+        fn=new RegexSetPerfFunction(*this, index==numFind+numFindUTF8+6, status);
+    }
+    if(U_FAILURE(status)) {
+        fprintf(stderr, "error: %s setup failed - %s\n", name, u_errorName(status));
+        delete fn;
+        return NULL;
+    }
+    return fn;
+}
+
+int main(int argc, const char *argv[]) {
+    UErrorCode status=U_ZERO_ERROR;
+    RegexPerfTest test(argc, argv, status);
+    if(U_FAILURE(status)) {
+        fprintf(stderr, "error: RegexPerfTest setup failed - %s\n", u_errorName(status));
+        return status;
+    }
+    if(test.run()==FALSE){
+        fprintf(stderr, "FAILED: Tests could not be run, please check the arguments.\n");
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main(int /*argc*/, const char * /*argv*/[]) {
+    fprintf(stderr, "regexperf: regular expressions are not configured in this build.\n");
+    return 0;
+}
+
+#endif  // !UCONFIG_NO_REGULAR_EXPRESSIONS
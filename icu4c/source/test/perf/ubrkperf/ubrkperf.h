@@ -15,6 +15,10 @@
 #include "unicode/uperf.h"
 
 #include <unicode/brkiter.h>
+#include <unicode/rbbi.h>
+
+#include <thread>
+#include <vector>
 
 class ICUBreakFunction : public UPerfFunction {
 protected:
@@ -107,6 +111,69 @@ class ICUForward : public ICUBreakFunction {
   }
 };
 
+// Break the text in partitions, each partition in its own thread with a cloned
+// break iterator, then merge the boundaries.
+// Includes the cost of partitioning the text and cloning the iterators.
+class ICUPartitioned : public ICUBreakFunction {
+private:
+  int32_t m_numThreads_;
+  UnicodeString m_text_;
+  std::vector<int32_t> m_boundaries_;
+
+  void breakPartitions(RuleBasedBreakIterator *bi, const std::vector<int32_t> &starts,
+                       int32_t first, int32_t step, std::vector<std::vector<int32_t>> &results) {
+    UErrorCode status = U_ZERO_ERROR;
+    for (int32_t i = first; i + 1 < (int32_t)starts.size(); i += step) {
+      std::vector<int32_t> &boundaries = results[i];
+      boundaries.resize(starts[i+1] - starts[i]);
+      int32_t count = bi->getBoundaries(starts[i], starts[i+1], boundaries.data(),
+                                        (int32_t)boundaries.size(), status);
+      boundaries.resize(count);
+    }
+  }
+
+public:
+  ICUPartitioned(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUBreakFunction(locale, mode, file, file_len),
+      m_text_(FALSE, file, file_len)
+  {
+    m_numThreads_ = (int32_t)std::thread::hardware_concurrency();
+    if (m_numThreads_ < 1) {
+      m_numThreads_ = 1;
+    }
+    m_brkIt_->setText(m_text_);
+    UErrorCode status = U_ZERO_ERROR;
+    call(&status);
+  }
+  virtual void call(UErrorCode *status)
+  {
+    RuleBasedBreakIterator *bi = (RuleBasedBreakIterator *)m_brkIt_;
+    int32_t minPartitionLength = m_fileLen_ / (4 * m_numThreads_) + 1;
+    std::vector<int32_t> starts(bi->getPartitions(minPartitionLength, NULL, 0, *status));
+    *status = U_ZERO_ERROR;
+    bi->getPartitions(minPartitionLength, starts.data(), (int32_t)starts.size(), *status);
+    starts.push_back(m_fileLen_);
+
+    std::vector<std::vector<int32_t>> results(starts.size());
+    std::vector<std::thread> threads;
+    std::vector<BreakIterator *> clones;
+    for (int32_t t = 0; t < m_numThreads_; ++t) {
+      clones.push_back(bi->clone());
+      threads.push_back(std::thread(&ICUPartitioned::breakPartitions, this,
+          (RuleBasedBreakIterator *)clones[t], std::cref(starts), t, m_numThreads_, std::ref(results)));
+    }
+    m_boundaries_.clear();
+    for (int32_t t = 0; t < m_numThreads_; ++t) {
+      threads[t].join();
+      delete clones[t];
+    }
+    for (const std::vector<int32_t> &boundaries : results) {
+      m_boundaries_.insert(m_boundaries_.end(), boundaries.begin(), boundaries.end());
+    }
+    m_noBreaks_ = (int32_t)m_boundaries_.size();
+  }
+};
+
 class DarwinBreakFunction : public UPerfFunction {
 public:
   virtual void call(UErrorCode *status) {};
@@ -127,6 +194,7 @@ class BreakIteratorPerformanceTest : public UPerfTest {
 
   UPerfFunction* TestICUForward();
   UPerfFunction* TestICUIsBound();
+  UPerfFunction* TestICUPartitioned();
 
   UPerfFunction* TestDarwinForward();
   UPerfFunction* TestDarwinIsBound();